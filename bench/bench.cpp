@@ -0,0 +1,393 @@
+/*
+Geometry library benchmarks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Times the Matrix<T> paths (constructors, assignments, operators, type and
+layout conversions, transposes, product) for int, float and double on
+square matrices, and writes one JSON record per case:
+    {"name": "add/double/1024x1024", "ns_per_op": ..., "gb_per_s": ...,
+     "gflop_per_s": ..., "allocations": ..., "iterations": ...}
+gb_per_s counts the bytes the operation has to read and write, allocations
+the operator new calls per operation (thread pool included).
+
+Usage: bench [--filter TEXT] [--max-size N] [--max-product N]
+             [--min-time SECONDS] [--out FILE]
+             [--baseline FILE] [--threshold RATIO]
+Sizes go from 2x2 to --max-size (4096 by default, 16384 for the full sweep:
+three 16k x 16k double matrices need 6 GB), products up to --max-product
+(1024). With --baseline, every case slower than the baseline by more than
+--threshold (0.10) is reported on stderr and the exit status is 1. On a
+shared or frequency-scaling host, raise --min-time and --threshold.
+*/
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrix.hpp"
+#include "matrixOperations.hpp"
+#include "matrixProduct.hpp"
+
+using namespace geometry;
+
+// ------------------------------ ALLOCATIONS ---------------------------------
+namespace {
+    std::atomic<std::size_t> allocationCount{0};
+
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        bytes = std::max<std::size_t>(bytes, 1);
+        void* p = (alignment <= alignof(std::max_align_t))
+                  ? std::malloc(bytes)
+                  : std::aligned_alloc(alignment, (bytes + alignment - 1)/alignment*alignment);
+        if(!p)
+            throw std::bad_alloc();
+        return p;
+    }
+}
+
+void* operator new(std::size_t bytes) {return allocate(bytes, 0);}
+void* operator new(std::size_t bytes, std::align_val_t alignment) {
+    return allocate(bytes, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* p) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t) noexcept {std::free(p);}
+void operator delete(void* p, std::align_val_t) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {std::free(p);}
+
+namespace {
+
+    // Keeps the compiler from dropping a result nobody reads.
+    template<typename T>
+    inline void sink(const T* p)
+    {
+        asm volatile("" : : "g"(p) : "memory");
+    }
+
+    // ------------------------------- OPTIONS --------------------------------
+    struct Options
+    {
+        std::string filter{};
+        std::size_t maxSize{4096};
+        std::size_t maxProduct{1024};
+        double minTime{0.05}; // seconds of timed runs per case
+        std::string out{};
+        std::string baseline{};
+        double threshold{0.10};
+    };
+
+    struct Result
+    {
+        std::string name;
+        double nsPerOp;
+        double bytes;  // per operation
+        double flops;  // per operation
+        double allocations;
+        std::size_t iterations;
+    };
+
+    // -------------------------------- SUITE ---------------------------------
+    class Suite
+    {
+    public:
+        explicit Suite(const Options& options): m_options{options} {}
+
+        const Options& options() const {return m_options;}
+        const std::vector<Result>& results() const {return m_results;}
+
+        // body() is one operation. After a warm-up run, iterations are
+        // calibrated so that a batch lasts minTime/batches, and the fastest
+        // batch gives ns/op: noise only ever adds time.
+        template<class Body>
+        void run(const std::string& name, double bytes, double flops, Body&& body)
+        {
+            if(!m_options.filter.empty() && (name.find(m_options.filter) == std::string::npos))
+                return;
+            constexpr std::size_t batches = 5;
+            const double warmUp = time(body, 1);
+            const double target = m_options.minTime/batches;
+            const std::size_t iterations = (warmUp >= target) ? 1
+                : static_cast<std::size_t>(std::min(target/std::max(warmUp, 1e-9), 1e8)) + 1;
+
+            std::vector<double> samples;
+            samples.reserve(batches);
+            const std::size_t firstAllocation = allocationCount.load();
+            for(std::size_t batch=0; batch<batches; batch++)
+                samples.push_back(time(body, iterations)/iterations);
+            const std::size_t allocations = allocationCount.load() - firstAllocation;
+
+            m_results.push_back({name, *std::min_element(samples.begin(), samples.end())*1e9, bytes, flops,
+                                 static_cast<double>(allocations)/(batches*iterations), batches*iterations});
+            std::cerr << name << ": " << m_results.back().nsPerOp << " ns/op\n";
+        }
+
+    protected:
+        template<class Body>
+        static double time(Body& body, std::size_t iterations)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for(std::size_t i=0; i<iterations; i++)
+                body();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        Options m_options;
+        std::vector<Result> m_results{};
+    };
+
+    template<typename T> const char* typeName();
+    template<> const char* typeName<int>() {return "int";}
+    template<> const char* typeName<float>() {return "float";}
+    template<> const char* typeName<double>() {return "double";}
+    template<> const char* typeName<Float16>() {return "float16";}
+    template<> const char* typeName<BFloat16>() {return "bfloat16";}
+
+    // --------------------------------- CASES --------------------------------
+    template<typename T>
+    void benchType(Suite& suite, std::size_t n)
+    {
+        using Other = std::conditional_t<std::is_same_v<T, double>, float, double>;
+        auto name = [&](const char* operation)
+        {
+            return std::string(operation) + "/" + typeName<T>() + "/" + std::to_string(n) + "x" + std::to_string(n);
+        };
+        const double elements = static_cast<double>(n)*n;
+        const double bytes = elements*sizeof(T);
+
+        // a, b in [1, 7] so that int division is defined, ones for the
+        // in-place operators so that repeated runs neither overflow nor
+        // reach denormals. column and row are broadcast against a.
+        Matrix<T> a(n, n), b(n, n), c(n, n), ones(n, n), column(n, 1), row(1, n), onesColumn(n, 1);
+        std::size_t k = 0;
+        for(T& x: a) x = static_cast<T>(1 + (k++)%7);
+        for(T& x: b) x = static_cast<T>(1 + (k++)%5);
+        for(T& x: ones) x = static_cast<T>(1);
+        for(T& x: onesColumn) x = static_cast<T>(1);
+        for(T& x: column) x = static_cast<T>(1 + (k++)%5);
+        for(T& x: row) x = static_cast<T>(1 + (k++)%5);
+        const Matrix<Other> other(a);
+        const T value = static_cast<T>(3);
+        const T one = static_cast<T>(1);
+
+        // Constructors and conversions
+        suite.run(name("construct/zero"), bytes, 0, [&]{Matrix<T> m(n, n); sink(m.data());});
+        suite.run(name("construct/padded"), bytes, 0, [&]{Matrix<T> m = Matrix<T>::padded(n, n); sink(m.data());});
+        suite.run(name("construct/copy"), 2*bytes, 0, [&]{Matrix<T> m(a); sink(m.data());});
+        suite.run(name("construct/move"), 0, 0, [&]{Matrix<T> m(std::move(a)); a = std::move(m); sink(a.data());});
+        suite.run(name("construct/expression"), 3*bytes, elements, [&]{Matrix<T> m(a + b); sink(m.data());});
+        suite.run(name(std::is_same_v<Other, float> ? "convert/from_float" : "convert/from_double"),
+                  elements*(sizeof(T) + sizeof(Other)), 0, [&]{Matrix<T> m(other); sink(m.data());});
+        suite.run(name("convert/layout"), 2*bytes, 0, [&]{RowMatrix<T> m(a); sink(m.data());});
+
+        // Assignments and operators
+        suite.run(name("assign/copy"), 2*bytes, 0, [&]{c = a; sink(c.data());});
+        suite.run(name("add"), 3*bytes, elements, [&]{c = a + b; sink(c.data());});
+        suite.run(name("sub"), 3*bytes, elements, [&]{c = a - b; sink(c.data());});
+        suite.run(name("mul"), 3*bytes, elements, [&]{c = a*b; sink(c.data());});
+        suite.run(name("div"), 3*bytes, elements, [&]{c = a/b; sink(c.data());});
+        suite.run(name("add_scalar"), 2*bytes, elements, [&]{c = a + value; sink(c.data());});
+        suite.run(name("sub_scalar"), 2*bytes, elements, [&]{c = a - value; sink(c.data());});
+        suite.run(name("mul_scalar"), 2*bytes, elements, [&]{c = a*value; sink(c.data());});
+        suite.run(name("div_scalar"), 2*bytes, elements, [&]{c = a/value; sink(c.data());});
+        suite.run(name("fused"), 3*bytes, 3*elements, [&]{c = (a + b)*value - a; sink(c.data());});
+        suite.run(name("add_column"), 2*bytes, elements, [&]{c = a + column; sink(c.data());});
+        suite.run(name("div_row"), 2*bytes, elements, [&]{c = a/row; sink(c.data());});
+        suite.run(name("sub_outer"), bytes, elements, [&]{c = column - row; sink(c.data());});
+        c = a;
+        suite.run(name("add_assign"), 3*bytes, elements, [&]{c += ones; sink(c.data());});
+        suite.run(name("sub_assign"), 3*bytes, elements, [&]{c -= ones; sink(c.data());});
+        suite.run(name("mul_assign"), 3*bytes, elements, [&]{c *= ones; sink(c.data());});
+        suite.run(name("div_assign"), 3*bytes, elements, [&]{c /= ones; sink(c.data());});
+        suite.run(name("add_assign_scalar"), 2*bytes, elements, [&]{c += one; sink(c.data());});
+        suite.run(name("sub_assign_scalar"), 2*bytes, elements, [&]{c -= one; sink(c.data());});
+        suite.run(name("mul_assign_scalar"), 2*bytes, elements, [&]{c *= one; sink(c.data());});
+        suite.run(name("div_assign_scalar"), 2*bytes, elements, [&]{c /= one; sink(c.data());});
+        suite.run(name("mul_assign_column"), 2*bytes, elements, [&]{c *= onesColumn; sink(c.data());});
+
+        // Transposes
+        suite.run(name("transpose/lazy"), 2*bytes, 0, [&]{c = transpose(a); sink(c.data());});
+        suite.run(name("transpose/out"), 2*bytes, 0, [&]{transpose(a, c); sink(c.data());});
+        suite.run(name("transpose/in_place"), 2*bytes, 0, [&]{c.transposeInPlace(); sink(c.data());});
+
+        // Reductions
+        T result{};
+        utils::accumulator_t<T> total{};
+        suite.run(name("sum"), bytes, elements, [&]{total = a.sum(); sink(&total);});
+        suite.run(name("sum/kahan"), bytes, elements, [&]{total = a.sum(utils::Summation::Kahan); sink(&total);});
+        suite.run(name("max"), bytes, elements, [&]{result = a.max(); sink(&result);});
+        suite.run(name("norm"), bytes, elements, [&]{total = a.norm(); sink(&total);});
+        const Matrix<T> zeros(n, n); // no early exit
+        suite.run(name("is_zero"), bytes, elements, [&]{const bool zero = zeros.isZero(); sink(&zero);});
+        suite.run(name("reduce_lines"), bytes, elements, [&]{
+            const Matrix<T> lines = a.template reduceLines<utils::ReduceOp::Sum>(); sink(lines.data());
+        });
+
+        // Product
+        if(n <= suite.options().maxProduct)
+            suite.run(name("matmul"), 3*bytes, 2*elements*n, [&]{c = matmul(a, b); sink(c.data());});
+    }
+
+    template<typename T>
+    void benchSizes(Suite& suite)
+    {
+        for(std::size_t n: {2, 4, 16, 64, 256, 1024, 4096, 16384})
+        {
+            if(n > suite.options().maxSize)
+                break;
+            try
+            {
+                benchType<T>(suite, n);
+            }
+            catch(const std::bad_alloc&)
+            {
+                std::cerr << typeName<T>() << "/" << n << "x" << n << ": skipped, out of memory\n";
+            }
+        }
+    }
+
+    // -------------------------------- BASELINE ------------------------------
+    // Reads what writeJson() wrote: one result per line.
+    std::map<std::string, double> readBaseline(const std::string& path)
+    {
+        std::ifstream file(path);
+        if(!file)
+        {
+            std::cerr << "cannot read the baseline " << path << "\n";
+            std::exit(2);
+        }
+        std::map<std::string, double> baseline;
+        std::string line;
+        const std::string nameKey = "\"name\": \"";
+        const std::string timeKey = "\"ns_per_op\": ";
+        while(std::getline(file, line))
+        {
+            const std::size_t name = line.find(nameKey);
+            const std::size_t time = line.find(timeKey);
+            if((name == std::string::npos) || (time == std::string::npos))
+                continue;
+            const std::size_t first = name + nameKey.size();
+            baseline[line.substr(first, line.find('"', first) - first)] =
+                std::strtod(line.c_str() + time + timeKey.size(), nullptr);
+        }
+        return baseline;
+    }
+
+    void writeJson(std::ostream& out, const Suite& suite, const std::map<std::string, double>& baseline)
+    {
+        out << "{\n"
+            << "  \"isa\": \"" << utils::isaName(utils::activeIsa()) << "\",\n"
+            << "  \"threads\": " << utils::executionBackend().concurrency() << ",\n"
+            << "  \"results\": [\n";
+        const std::vector<Result>& results = suite.results();
+        for(std::size_t i=0; i<results.size(); i++)
+        {
+            const Result& result = results[i];
+            out << "    {\"name\": \"" << result.name << "\""
+                << ", \"ns_per_op\": " << result.nsPerOp
+                << ", \"gb_per_s\": " << result.bytes/result.nsPerOp
+                << ", \"gflop_per_s\": " << result.flops/result.nsPerOp
+                << ", \"allocations\": " << result.allocations
+                << ", \"iterations\": " << result.iterations;
+            const auto previous = baseline.find(result.name);
+            if(previous != baseline.end())
+            {
+                const double change = result.nsPerOp/previous->second - 1;
+                out << ", \"baseline_ns_per_op\": " << previous->second
+                    << ", \"change\": " << change
+                    << ", \"regression\": " << ((change > suite.options().threshold) ? "true" : "false");
+            }
+            out << "}" << ((i + 1 < results.size()) ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Number of regressions, reported on stderr.
+    std::size_t compare(const Suite& suite, const std::map<std::string, double>& baseline)
+    {
+        std::size_t regressions = 0, compared = 0;
+        for(const Result& result: suite.results())
+        {
+            const auto previous = baseline.find(result.name);
+            if(previous == baseline.end())
+                continue;
+            compared++;
+            const double ratio = result.nsPerOp/previous->second;
+            if(ratio > 1 + suite.options().threshold)
+            {
+                regressions++;
+                std::cerr << "REGRESSION " << result.name << ": " << ratio << "x slower ("
+                          << previous->second << " -> " << result.nsPerOp << " ns/op)\n";
+            }
+        }
+        std::cerr << regressions << " regression(s) over " << compared << " case(s) in the baseline\n";
+        return regressions;
+    }
+
+    Options parse(int argc, char** argv)
+    {
+        Options options;
+        for(int i=1; i<argc; i++)
+        {
+            const std::string argument = argv[i];
+            if(i + 1 >= argc)
+            {
+                std::cerr << "missing value after " << argument << "\n";
+                std::exit(2);
+            }
+            const char* next = argv[++i];
+            if(argument == "--filter") options.filter = next;
+            else if(argument == "--max-size") options.maxSize = std::strtoull(next, nullptr, 10);
+            else if(argument == "--max-product") options.maxProduct = std::strtoull(next, nullptr, 10);
+            else if(argument == "--min-time") options.minTime = std::strtod(next, nullptr);
+            else if(argument == "--out") options.out = next;
+            else if(argument == "--baseline") options.baseline = next;
+            else if(argument == "--threshold") options.threshold = std::strtod(next, nullptr);
+            else
+            {
+                std::cerr << "unknown option " << argument << "\n";
+                std::exit(2);
+            }
+        }
+        return options;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(parse(argc, argv));
+    const std::map<std::string, double> baseline = suite.options().baseline.empty()
+        ? std::map<std::string, double>{} : readBaseline(suite.options().baseline);
+
+    benchSizes<int>(suite);
+    benchSizes<float>(suite);
+    benchSizes<double>(suite);
+    benchSizes<Float16>(suite);
+    benchSizes<BFloat16>(suite);
+
+    if(suite.options().out.empty())
+        writeJson(std::cout, suite, baseline);
+    else
+    {
+        std::ofstream out(suite.options().out);
+        writeJson(out, suite, baseline);
+    }
+    if(!baseline.empty() && (compare(suite, baseline) > 0))
+        return 1;
+    return 0;
+}
@@ -8,12 +8,28 @@ Author: R. Tonneau (romain.tonneau@gmail.com)
 #define GEOMETRY_EXCEPTIONS_GUARD_2207
 
 // STANDARD INCLUDES
+#include <array>
+#include <cstddef>
 #include <exception>
+#include <stdexcept>
 #include <string>
 
 
 // MESHSUBSTRATE INCLUDES
 
+// Access checking policy. Operations always validate the shapes of their
+// operands once, on entry (-> Exeptions::SizeMismatch()), then run
+// unchecked loops the compiler can vectorize. Element access (operator()
+// and operator[] of matrices, views, vectors, batches and tensors) is
+// unchecked too, unless the program is built with -DGEOMETRY_CHECKED (the
+// whole program, the accessors are inline): every index is then validated
+// (-> Exeptions::OutOfRange()). at() is always checked.
+#ifdef GEOMETRY_CHECKED
+    #define GEOMETRY_CHECK_INDEX(index, size) ::geometry::Exeptions::checkIndex(index, size)
+#else
+    #define GEOMETRY_CHECK_INDEX(index, size) ((void)0)
+#endif
+
 namespace geometry{
     namespace Exeptions{
         class GeometryException: public std::exception
@@ -43,6 +59,57 @@ namespace geometry{
             }
         };
 
+        class SingularMatrix: public GeometryException
+        {
+        public:
+            SingularMatrix():
+                GeometryException("Singular matrix: no inverse / no unique solution")
+            {}
+        };
+
+        class NotPositiveDefinite: public GeometryException
+        {
+        public:
+            NotPositiveDefinite():
+                GeometryException("Matrix not positive definite: no Cholesky factorization")
+            {}
+        };
+
+        class FileError: public GeometryException
+        {
+        public:
+            FileError(std::string_view path, std::string_view reason):
+                GeometryException("File error: ")
+            {
+                m_error += std::string(path) + ": " + std::string(reason);
+            }
+        };
+
+        // A std::out_of_range, as thrown by at() before the checked mode.
+        class OutOfRange: public std::out_of_range
+        {
+        public:
+            OutOfRange(std::size_t index, std::size_t size):
+                std::out_of_range("Error: Index out of range: index: " + std::to_string(index)
+                                  + " & size: " + std::to_string(size))
+            {}
+        };
+
+        // -> Exeptions::OutOfRange() unless index < size (every dimension).
+        constexpr void checkIndex(std::size_t index, std::size_t size)
+        {
+            if(index >= size)
+                throw OutOfRange(index, size);
+        }
+
+        template<std::size_t Rank>
+        constexpr void checkIndex(const std::array<std::size_t, Rank>& index,
+                                  const std::array<std::size_t, Rank>& shape)
+        {
+            for(std::size_t d=0; d<Rank; d++)
+                checkIndex(index[d], shape[d]);
+        }
+
     }
 }
 
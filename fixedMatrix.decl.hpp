@@ -0,0 +1,162 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__FIXEDMATRIX_DECL__GUARD__2610
+#define GEOMETRY__FIXEDMATRIX_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "matrixExpressions.decl.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    // Matrix whose shape is known at compile time (2x2, 3x3, 4x4 transforms).
+    // Storage is an inline std::array, column-major like Matrix, so it never
+    // allocates and every loop has constant bounds the compiler unrolls.
+    // Element-wise operators follow Matrix (operator* is element-wise, the
+    // product is matmul()). It also is a MatrixExpression, so it mixes with
+    // dynamic matrices: Matrix<T> m = fixed; m += fixed;
+    template<class T, std::size_t R, std::size_t C>
+    class FixedMatrix: public utils::MatrixExpression<FixedMatrix<T, R, C>>
+    {
+    public: // types
+        using value_type = T;
+
+    public: // attributes
+        std::array<T, R*C> m_data{};
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        constexpr FixedMatrix() {} // --> all zeros
+
+        // Values in column-major order, like Matrix.
+        // -> Exceptions::SizeMismatch()
+        constexpr FixedMatrix(std::initializer_list<T> list);
+
+        // From a dynamic matrix of the same shape.
+        // -> Exceptions::SizeMismatch()
+        template<class Alloc, Layout Order>
+        explicit FixedMatrix(const Matrix<T, Alloc, Order>& other);
+
+        static constexpr FixedMatrix identity();
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        constexpr T operator()(std::size_t line, std::size_t col) const {
+            GEOMETRY_CHECK_INDEX(line, R);
+            GEOMETRY_CHECK_INDEX(col, C);
+            return m_data[line + col*R];
+        }
+        constexpr T& operator()(std::size_t line, std::size_t col) {
+            GEOMETRY_CHECK_INDEX(line, R);
+            GEOMETRY_CHECK_INDEX(col, C);
+            return m_data[line + col*R];
+        }
+
+        // -> Math operations with single value
+        constexpr FixedMatrix& operator*=(T value);
+        constexpr FixedMatrix& operator+=(T value);
+        constexpr FixedMatrix& operator/=(T value);
+        constexpr FixedMatrix& operator-=(T value);
+
+        // -> Math operations with other Matrices (element-wise)
+        constexpr FixedMatrix& operator*=(const FixedMatrix& value);
+        constexpr FixedMatrix& operator+=(const FixedMatrix& value);
+        constexpr FixedMatrix& operator/=(const FixedMatrix& value);
+        constexpr FixedMatrix& operator-=(const FixedMatrix& value);
+
+        constexpr bool operator==(const FixedMatrix& other) const;
+        constexpr bool operator!=(const FixedMatrix& other) const {return !(*this == other);}
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        static constexpr std::size_t nLines()   {return R;}
+        static constexpr std::size_t nColumns() {return C;}
+        static constexpr std::size_t length()   {return R*C;}
+        constexpr bool isZero() const;
+        constexpr T at(std::size_t index) const { // -> Exeptions::OutOfRange()
+            Exeptions::checkIndex(index, R*C);
+            return m_data[index];
+        }
+        constexpr const T* data() const {return m_data.data();}
+
+        void print() const;
+        Matrix<T> toMatrix() const;
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        constexpr void clear() {for(auto& elt: m_data) elt = static_cast<T>(0);}
+        constexpr T* data() {return m_data.data();}
+
+        // ----------------------------- ITERATORS ----------------------------
+        constexpr auto begin() {return m_data.begin();}
+        constexpr auto end()   {return m_data.end();}
+        constexpr auto begin() const {return m_data.begin();}
+        constexpr auto end()   const {return m_data.end();}
+    };
+
+    template<class T> using Matrix2 = FixedMatrix<T, 2, 2>;
+    template<class T> using Matrix3 = FixedMatrix<T, 3, 3>;
+    template<class T> using Matrix4 = FixedMatrix<T, 4, 4>;
+
+    // -> Element-wise math, eager (no expression tree for a handful of values)
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator+(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs);
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs);
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs);
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator/(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs);
+
+    // -> Single value (not deduced: converted to T like for Matrix)
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator+(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs);
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs);
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs);
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator/(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs);
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(const typename FixedMatrix<T, R, C>::value_type& lhs, FixedMatrix<T, R, C> rhs);
+
+    // -> Linear algebra
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    constexpr FixedMatrix<T, R, C> matmul(const FixedMatrix<T, R, K>& A, const FixedMatrix<T, K, C>& B);
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, C, R> transpose(const FixedMatrix<T, R, C>& obj);
+
+    // Closed forms up to 4x4, fraction-free elimination (Bareiss) above, so
+    // integer matrices get an exact result.
+    template<class T, std::size_t N>
+    constexpr T determinant(const FixedMatrix<T, N, N>& obj);
+
+    // Adjugate over determinant up to 4x4, Gauss-Jordan above.
+    // -> Exceptions::SingularMatrix()
+    template<class T, std::size_t N>
+    constexpr FixedMatrix<T, N, N> inverse(const FixedMatrix<T, N, N>& obj);
+
+    namespace utils{
+
+        // Inside expressions a FixedMatrix is read like any column-major buffer.
+        template<class T, std::size_t R, std::size_t C>
+        struct ExpressionOperand<FixedMatrix<T, R, C>>
+        {
+            using type = MatrixOperand<T>;
+            static type make(const MatrixExpression<FixedMatrix<T, R, C>>& expr) {
+                return type(expr.self().data(), R, C);
+            }
+        };
+
+    }
+}
+#endif
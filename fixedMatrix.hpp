@@ -0,0 +1,13 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__FIXEDMATRIX__GUARD__2610
+#define GEOMETRY__FIXEDMATRIX__GUARD__2610
+
+#include "fixedMatrix.decl.hpp"
+#include "fixedMatrix.impl.hpp"
+
+#endif
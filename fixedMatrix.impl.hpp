@@ -0,0 +1,428 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__FIXEDMATRIX_IMPL__GUARD__2610
+#define GEOMETRY__FIXEDMATRIX_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+// LOCAL INCLUDES
+#include "fixedMatrix.decl.hpp"
+#include "matrix.decl.hpp"
+#include "matrixTranspose.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    // ============================ PUBLIC METHODS ============================
+    // ----------------------------- CONSTRUCTORS -----------------------------
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>::FixedMatrix(std::initializer_list<T> list)
+    {
+        if(list.size() != R*C)
+            throw Exeptions::SizeMismatch(R*C, list.size());
+        std::size_t i = 0;
+        for(const T& value: list)
+            m_data[i++] = value;
+    }
+
+    template<class T, std::size_t R, std::size_t C> template<class Alloc, Layout Order>
+    FixedMatrix<T, R, C>::FixedMatrix(const Matrix<T, Alloc, Order>& other)
+    {
+        if((other.nLines() != R) || (other.nColumns() != C))
+            throw Exeptions::SizeMismatch(R*C, other.length());
+        if constexpr (Order == Layout::RowMajor)
+        {
+            utils::transpose(C, R, other.data(), other.leadingDimension(), m_data.data(), R);
+            return;
+        }
+        for(std::size_t col=0; col<C; col++)
+            std::copy(other.data() + col*other.leadingDimension(),
+                      other.data() + col*other.leadingDimension() + R, m_data.begin() + col*R);
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::identity()
+    {
+        FixedMatrix<T, R, C> out;
+        for(std::size_t i=0; i<std::min(R, C); i++)
+            out(i, i) = static_cast<T>(1);
+        return out;
+    }
+
+    // ------------------------ OPERATORS OVERLOADING -------------------------
+    // -> Math operations with single value
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator*=(T value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] *= value;
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator+=(T value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] += value;
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator/=(T value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] /= value;
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator-=(T value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] -= value;
+        return *this;
+    }
+
+    // -> Math operations with other Matrices
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator*=(const FixedMatrix& value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] *= value.m_data[i];
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator+=(const FixedMatrix& value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] += value.m_data[i];
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator/=(const FixedMatrix& value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] /= value.m_data[i];
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator-=(const FixedMatrix& value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i] -= value.m_data[i];
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr bool FixedMatrix<T, R, C>::operator==(const FixedMatrix& other) const
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            if(!(m_data[i] == other.m_data[i]))
+                return false;
+        return true;
+    }
+
+    // --------------------- ASK INFO MEMBERS (-> const) ----------------------
+    template<class T, std::size_t R, std::size_t C>
+    constexpr bool FixedMatrix<T, R, C>::isZero() const
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            if(m_data[i] != static_cast<T>(0))
+                return false;
+        return true;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    void FixedMatrix<T, R, C>::print() const
+    {
+        std::cout << R
+                  << " X "
+                  << C
+                  << " matrix:\n";
+        for(std::size_t line=0; line<R; line++)
+        {
+            for(std::size_t col=0; col<C; col++)
+                std::cout << (*this)(line, col) << " ";
+            std::cout << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    Matrix<T> FixedMatrix<T, R, C>::toMatrix() const
+    {
+        Matrix<T> out(R, C);
+        std::copy(m_data.begin(), m_data.end(), out.data());
+        return out;
+    }
+
+    // ============================ FREE FUNCTIONS ============================
+    // -> Element-wise math
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator+(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs)
+    {
+        return lhs += rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator/(FixedMatrix<T, R, C> lhs, const FixedMatrix<T, R, C>& rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator+(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs)
+    {
+        return lhs += rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator/(FixedMatrix<T, R, C> lhs, const typename FixedMatrix<T, R, C>::value_type& rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(const typename FixedMatrix<T, R, C>::value_type& lhs, FixedMatrix<T, R, C> rhs)
+    {
+        return rhs *= lhs;
+    }
+
+    // -> Linear algebra
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    constexpr FixedMatrix<T, R, C> matmul(const FixedMatrix<T, R, K>& A, const FixedMatrix<T, K, C>& B)
+    {
+        // Column j of the result is a combination of the columns of A: the
+        // inner loop runs down a column, which is what vectorizes.
+        FixedMatrix<T, R, C> out;
+        for(std::size_t j=0; j<C; j++)
+            for(std::size_t p=0; p<K; p++)
+                for(std::size_t i=0; i<R; i++)
+                    out(i, j) += A(i, p)*B(p, j);
+        return out;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, C, R> transpose(const FixedMatrix<T, R, C>& obj)
+    {
+        FixedMatrix<T, C, R> out;
+        for(std::size_t j=0; j<C; j++)
+            for(std::size_t i=0; i<R; i++)
+                out(j, i) = obj(i, j);
+        return out;
+    }
+
+    template<class T, std::size_t N>
+    constexpr T determinant(const FixedMatrix<T, N, N>& a)
+    {
+        if constexpr (N == 0)
+            return static_cast<T>(1);
+        else if constexpr (N == 1)
+            return a(0,0);
+        else if constexpr (N == 2)
+            return a(0,0)*a(1,1) - a(0,1)*a(1,0);
+        else if constexpr (N == 3)
+            return a(0,0)*(a(1,1)*a(2,2) - a(1,2)*a(2,1))
+                 - a(0,1)*(a(1,0)*a(2,2) - a(1,2)*a(2,0))
+                 + a(0,2)*(a(1,0)*a(2,1) - a(1,1)*a(2,0));
+        else if constexpr (N == 4)
+        {
+            // Laplace expansion along lines (0,1) against lines (2,3).
+            const T s0 = a(0,0)*a(1,1) - a(1,0)*a(0,1);
+            const T s1 = a(0,0)*a(1,2) - a(1,0)*a(0,2);
+            const T s2 = a(0,0)*a(1,3) - a(1,0)*a(0,3);
+            const T s3 = a(0,1)*a(1,2) - a(1,1)*a(0,2);
+            const T s4 = a(0,1)*a(1,3) - a(1,1)*a(0,3);
+            const T s5 = a(0,2)*a(1,3) - a(1,2)*a(0,3);
+            const T c5 = a(2,2)*a(3,3) - a(3,2)*a(2,3);
+            const T c4 = a(2,1)*a(3,3) - a(3,1)*a(2,3);
+            const T c3 = a(2,1)*a(3,2) - a(3,1)*a(2,2);
+            const T c2 = a(2,0)*a(3,3) - a(3,0)*a(2,3);
+            const T c1 = a(2,0)*a(3,2) - a(3,0)*a(2,2);
+            const T c0 = a(2,0)*a(3,1) - a(3,0)*a(2,1);
+            return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+        }
+        else
+        {
+            // Bareiss: every division is exact, so integers stay exact.
+            FixedMatrix<T, N, N> m{a};
+            T sign = static_cast<T>(1);
+            T previous = static_cast<T>(1);
+            for(std::size_t k=0; k+1<N; k++)
+            {
+                if(m(k,k) == static_cast<T>(0))
+                {
+                    std::size_t pivot = k+1;
+                    while((pivot < N) && (m(pivot,k) == static_cast<T>(0)))
+                        pivot++;
+                    if(pivot == N)
+                        return static_cast<T>(0);
+                    for(std::size_t j=0; j<N; j++)
+                    {
+                        const T tmp = m(k,j);
+                        m(k,j) = m(pivot,j);
+                        m(pivot,j) = tmp;
+                    }
+                    sign = -sign;
+                }
+                for(std::size_t i=k+1; i<N; i++)
+                    for(std::size_t j=k+1; j<N; j++)
+                        m(i,j) = (m(i,j)*m(k,k) - m(i,k)*m(k,j))/previous;
+                previous = m(k,k);
+            }
+            return sign*m(N-1,N-1);
+        }
+    }
+
+    template<class T, std::size_t N>
+    constexpr FixedMatrix<T, N, N> inverse(const FixedMatrix<T, N, N>& a)
+    {
+        static_assert(std::is_floating_point_v<T>, "inverse() needs a floating point matrix");
+        FixedMatrix<T, N, N> out;
+        if constexpr (N == 1)
+        {
+            if(a(0,0) == static_cast<T>(0))
+                throw Exeptions::SingularMatrix();
+            out(0,0) = static_cast<T>(1)/a(0,0);
+        }
+        else if constexpr (N == 2)
+        {
+            const T det = determinant(a);
+            if(det == static_cast<T>(0))
+                throw Exeptions::SingularMatrix();
+            const T inv = static_cast<T>(1)/det;
+            out(0,0) =  a(1,1)*inv; out(0,1) = -a(0,1)*inv;
+            out(1,0) = -a(1,0)*inv; out(1,1) =  a(0,0)*inv;
+        }
+        else if constexpr (N == 3)
+        {
+            // Adjugate (transposed cofactors).
+            out(0,0) = a(1,1)*a(2,2) - a(1,2)*a(2,1);
+            out(0,1) = a(0,2)*a(2,1) - a(0,1)*a(2,2);
+            out(0,2) = a(0,1)*a(1,2) - a(0,2)*a(1,1);
+            out(1,0) = a(1,2)*a(2,0) - a(1,0)*a(2,2);
+            out(1,1) = a(0,0)*a(2,2) - a(0,2)*a(2,0);
+            out(1,2) = a(0,2)*a(1,0) - a(0,0)*a(1,2);
+            out(2,0) = a(1,0)*a(2,1) - a(1,1)*a(2,0);
+            out(2,1) = a(0,1)*a(2,0) - a(0,0)*a(2,1);
+            out(2,2) = a(0,0)*a(1,1) - a(0,1)*a(1,0);
+            const T det = a(0,0)*out(0,0) + a(0,1)*out(1,0) + a(0,2)*out(2,0);
+            if(det == static_cast<T>(0))
+                throw Exeptions::SingularMatrix();
+            out *= static_cast<T>(1)/det;
+        }
+        else if constexpr (N == 4)
+        {
+            // Same 2x2 minors as determinant(), reused for the adjugate.
+            const T s0 = a(0,0)*a(1,1) - a(1,0)*a(0,1);
+            const T s1 = a(0,0)*a(1,2) - a(1,0)*a(0,2);
+            const T s2 = a(0,0)*a(1,3) - a(1,0)*a(0,3);
+            const T s3 = a(0,1)*a(1,2) - a(1,1)*a(0,2);
+            const T s4 = a(0,1)*a(1,3) - a(1,1)*a(0,3);
+            const T s5 = a(0,2)*a(1,3) - a(1,2)*a(0,3);
+            const T c5 = a(2,2)*a(3,3) - a(3,2)*a(2,3);
+            const T c4 = a(2,1)*a(3,3) - a(3,1)*a(2,3);
+            const T c3 = a(2,1)*a(3,2) - a(3,1)*a(2,2);
+            const T c2 = a(2,0)*a(3,3) - a(3,0)*a(2,3);
+            const T c1 = a(2,0)*a(3,2) - a(3,0)*a(2,2);
+            const T c0 = a(2,0)*a(3,1) - a(3,0)*a(2,1);
+            const T det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+            if(det == static_cast<T>(0))
+                throw Exeptions::SingularMatrix();
+            const T inv = static_cast<T>(1)/det;
+            out(0,0) = ( a(1,1)*c5 - a(1,2)*c4 + a(1,3)*c3)*inv;
+            out(0,1) = (-a(0,1)*c5 + a(0,2)*c4 - a(0,3)*c3)*inv;
+            out(0,2) = ( a(3,1)*s5 - a(3,2)*s4 + a(3,3)*s3)*inv;
+            out(0,3) = (-a(2,1)*s5 + a(2,2)*s4 - a(2,3)*s3)*inv;
+            out(1,0) = (-a(1,0)*c5 + a(1,2)*c2 - a(1,3)*c1)*inv;
+            out(1,1) = ( a(0,0)*c5 - a(0,2)*c2 + a(0,3)*c1)*inv;
+            out(1,2) = (-a(3,0)*s5 + a(3,2)*s2 - a(3,3)*s1)*inv;
+            out(1,3) = ( a(2,0)*s5 - a(2,2)*s2 + a(2,3)*s1)*inv;
+            out(2,0) = ( a(1,0)*c4 - a(1,1)*c2 + a(1,3)*c0)*inv;
+            out(2,1) = (-a(0,0)*c4 + a(0,1)*c2 - a(0,3)*c0)*inv;
+            out(2,2) = ( a(3,0)*s4 - a(3,1)*s2 + a(3,3)*s0)*inv;
+            out(2,3) = (-a(2,0)*s4 + a(2,1)*s2 - a(2,3)*s0)*inv;
+            out(3,0) = (-a(1,0)*c3 + a(1,1)*c1 - a(1,2)*c0)*inv;
+            out(3,1) = ( a(0,0)*c3 - a(0,1)*c1 + a(0,2)*c0)*inv;
+            out(3,2) = (-a(3,0)*s3 + a(3,1)*s1 - a(3,2)*s0)*inv;
+            out(3,3) = ( a(2,0)*s3 - a(2,1)*s1 + a(2,2)*s0)*inv;
+        }
+        else
+        {
+            // Gauss-Jordan with partial pivoting on [a | I].
+            FixedMatrix<T, N, N> m{a};
+            out = FixedMatrix<T, N, N>::identity();
+            for(std::size_t k=0; k<N; k++)
+            {
+                std::size_t pivot = k;
+                for(std::size_t i=k+1; i<N; i++)
+                    if(((m(i,k) < 0) ? -m(i,k) : m(i,k)) > ((m(pivot,k) < 0) ? -m(pivot,k) : m(pivot,k)))
+                        pivot = i;
+                if(m(pivot,k) == static_cast<T>(0))
+                    throw Exeptions::SingularMatrix();
+                if(pivot != k)
+                    for(std::size_t j=0; j<N; j++)
+                    {
+                        T tmp = m(k,j); m(k,j) = m(pivot,j); m(pivot,j) = tmp;
+                        tmp = out(k,j); out(k,j) = out(pivot,j); out(pivot,j) = tmp;
+                    }
+                const T inv = static_cast<T>(1)/m(k,k);
+                for(std::size_t j=0; j<N; j++)
+                {
+                    m(k,j) *= inv;
+                    out(k,j) *= inv;
+                }
+                for(std::size_t i=0; i<N; i++)
+                {
+                    if(i == k)
+                        continue;
+                    const T factor = m(i,k);
+                    for(std::size_t j=0; j<N; j++)
+                    {
+                        m(i,j) -= factor*m(k,j);
+                        out(i,j) -= factor*out(k,j);
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+}
+
+#endif
@@ -6,10 +6,6 @@ Date: 13/07/2022
 Author: R. Tonneau (romain.tonneau@gmail.com)
 
 Next to do:
-    - implement cross-product
-    - implement dot-product
-    - implement vector only case
-    - implement norm (which one? different possibility? at least the cartesian one!)
     - what about power operation?
     - implement transpose
 */
@@ -82,7 +78,7 @@ int main()
 
 
     /*
-    geometry::Matrix<int> xx(geometry::utils::AdditionMCH<int>(50, &x.m_data, &x.m_size));
+    geometry::Matrix<int> xx(x + 50);
     geometry::Matrix<int> yy;
 
     xx.print();
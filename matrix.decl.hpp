@@ -9,121 +9,276 @@ Author: R. Tonneau (romain.tonneau@gmail.com)
 
 // STANDARD INCLUDES
 #include <array>
+#include <string>
 #include <vector>
 #include <algorithm>
 #include <numeric>
 #include <functional>
 #include <iterator> // For std::forward_iterator_tag
 #include <cstddef>  // For std::ptrdiff_t
+#include <type_traits>
+#include <utility>
 
 // LOCAL INCLUDES
-//#include "matrix.forward.hpp"
+#include "matrix.forward.hpp"
+#include "matrixHalf.hpp"
 //#include "matrixUtils.forward.hpp"
 #include "matrixUtils.hpp"
+#include "matrixExpressions.hpp"
+#include "matrixView.decl.hpp"
+#include "matrixReduction.decl.hpp"
 #include "exceptions.hpp"
 
 namespace geometry{
 
     using utils::Coord;
 
-    template<class T=double>
-    class Matrix
+    namespace utils{
+
+        // True for matrices stored in another order than Order, which only
+        // convert through the explicit constructor of Matrix.
+        template<class E, Layout Order>
+        struct IsOtherLayout: std::false_type {};
+
+        template<class T, class A, Layout O, Layout Order>
+        struct IsOtherLayout<Matrix<T, A, O>, Order>: std::bool_constant<O != Order> {};
+
+    }
+
+    // Alloc provides the storage of the elements: 64-byte aligned by default,
+    // or one of matrixAllocator.decl.hpp (arena, pool, std::pmr) to take the
+    // short-lived matrices of a hot loop off malloc. The default arguments
+    // live in matrix.forward.hpp.
+    //
+    // Storage is column-major by default. Column c starts at
+    // data() + c*leadingDimension(), the leading dimension being nLines()
+    // unless the matrix is padded (see padded() and setLeadingDimension()):
+    // the padding elements at the end of each column are never part of the
+    // matrix, every operation skips them.
+    //
+    // With Order == Layout::RowMajor the same holds for lines: line l starts
+    // at data() + l*leadingDimension(), brace initializers, at(), setValues()
+    // and the iterators go line after line. The kernels see the storage as
+    // the column-major transpose (storageLines() x storageColumns()), so
+    // operations between row-major matrices run the same contiguous passes.
+    // Mixing layouts is allowed, the conversion is explicit.
+    //
+    // The elements are always in memory: matrices larger than it go in a
+    // TiledMatrix (tiledMatrix.hpp), which keeps them on disk.
+    template<class T, class Alloc, Layout Order>
+    class Matrix: public utils::MatrixExpression<Matrix<T, Alloc, Order>>
     {
-        using MatrixType = std::vector<T>;
+        using MatrixType = std::vector<T, Alloc>;
+
+    public: // types
+        using value_type = T;
+        using allocator_type = Alloc;
+        static constexpr Layout layout = Order;
 
     public: // attributes
-        std::vector<T> m_data{};
-        std::vector<std::size_t> m_size{0, 0};
+        std::vector<T, Alloc> m_data{};
+        std::array<std::size_t, 2> m_size{0, 0}; // {lines, columns}
+        std::size_t m_lead{0}; // distance between two columns (lines) in m_data
 
     public: // METHODS
         // --------------------------- CONSTRUCTORS ---------------------------
         Matrix() {} // --> (0,0) size with no data in it.
+        explicit Matrix(const Alloc& alloc): m_data(alloc) {}
 
         // Specify size but no data to populate with, still m_data is allocated
         // with correct size and sets to 0.
-        Matrix(std::size_t line, std::size_t col):
+        Matrix(std::size_t line, std::size_t col, const Alloc& alloc = Alloc()):
+            m_data(line*col, 0, alloc),
             m_size{line, col},
-            m_data(line*col, 0)
+            m_lead{storageLines(line, col)}
             {}
 
-        // Specify size and give data from brace initialization.
-        Matrix(std::size_t line, std::size_t col, std::initializer_list<T> list):
-            Matrix(line, col)
+        // Specify size and give data from brace initialization, in storage
+        // order (column after column, line after line for RowMajor).
+        Matrix(std::size_t line, std::size_t col, std::initializer_list<T> list,
+               const Alloc& alloc = Alloc()):
+            Matrix(line, col, alloc)
         {
             std::copy(list.begin(), list.end(), m_data.begin());
         }
 
-        // Copy constructor.
-        Matrix(const Matrix<T>& other);
+        // Copy constructor (same allocator unless given).
+        Matrix(const Matrix<T, Alloc, Order>& other);
+        Matrix(const Matrix<T, Alloc, Order>& other, const Alloc& alloc);
 
-        // Advanced copy constructor to support creation with math operations.
-        Matrix(const utils::MatrixConstructorHelper<T>& ope);
+        // Move constructor: steals the buffer, other is left (0,0). With a
+        // different allocator the elements are moved one by one.
+        Matrix(Matrix<T, Alloc, Order>&& other) noexcept;
+        Matrix(Matrix<T, Alloc, Order>&& other, const Alloc& alloc);
 
-        // Type conversion from U to T.
-        template<typename U>
-        Matrix(const Matrix<U>& other);
+        // Evaluate a lazy math expression (see matrixExpressions.decl.hpp).
+        template<class E, class = std::enable_if_t<!utils::IsOtherLayout<E, Order>::value>>
+        Matrix(const utils::MatrixExpression<E>& expr, const Alloc& alloc = Alloc());
+
+        // Type (or allocator) conversion from Matrix<U, A> to Matrix<T, Alloc>.
+        template<typename U, class A>
+        Matrix(const Matrix<U, A, Order>& other);
+
+        // Layout conversion, one pass of the tiled transpose kernel (see
+        // matrixTranspose.decl.hpp). Explicit so that it never happens behind
+        // a function call:
+        //     RowMatrix<> out(columnMajor);
+        template<typename U, class A, Layout O, class = std::enable_if_t<O != Order>>
+        explicit Matrix(const Matrix<U, A, O>& other);
+
+        // Zero matrix whose leading dimension is utils::paddedLeadingDimension:
+        // every column starts on a cache line and neighbouring columns do not
+        // compete for the same cache sets.
+        static Matrix<T, Alloc, Order> padded(std::size_t line, std::size_t col, const Alloc& alloc = Alloc());
 
         // --------------------------- DESTRUCTORS ----------------------------
         virtual ~Matrix() {}
 
         // ---------------------- OPERATORS OVERLOADING -----------------------
-        // -> Assignement
-        template<typename U>
-        Matrix<T>& operator=(const Matrix<U>& mat);
-        Matrix<T>& operator=(const Matrix<T>& mat);
-        Matrix<T>& operator=(std::initializer_list<T> list);
-
-        // -> Math operations with single value
-        Matrix<T> operator*(T value) {
-            return Matrix<T>(utils::MultiplicationMCH<T>(value, &m_data, &m_size));
-        }
-        Matrix<T> operator+(T value) {
-            return Matrix<T>(utils::AdditionMCH<T>(value, &m_data, &m_size));
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        T operator()(std::size_t line, std::size_t col) const {
+            return m_data[this->offset(line, col)];
         }
-        Matrix<T> operator/(T value) {
-            return Matrix<T>(utils::DivisionMCH<T>(value, &m_data, &m_size));
+        T& operator()(std::size_t line, std::size_t col) {
+            return m_data[this->offset(line, col)];
         }
-        Matrix<T> operator-(T value) {
-            return Matrix<T>(utils::SoustractionMCH<T>(value, &m_data, &m_size));
-        }
-        Matrix<T>& operator*=(T value);
-        Matrix<T>& operator+=(T value);
-        Matrix<T>& operator/=(T value);
-        Matrix<T>& operator-=(T value);
-
-        // -> Math operations with other Matrices
-        Matrix<T> operator*(const Matrix<T>& value);
-        Matrix<T> operator+(const Matrix<T>& value);
-        Matrix<T> operator/(const Matrix<T>& value);
-        Matrix<T> operator-(const Matrix<T>& value);
-        Matrix<T>& operator*=(Matrix<T>& value);
-        Matrix<T>& operator+=(Matrix<T>& value);
-        Matrix<T>& operator/=(Matrix<T>& value);
-        Matrix<T>& operator-=(Matrix<T>& value);
+
+        // -> Assignement
+        template<typename U, class A, Layout O>
+        Matrix<T, Alloc, Order>& operator=(const Matrix<U, A, O>& mat);
+        // Copy reuses the current buffer when it is big enough, move takes
+        // the buffer of mat (element by element if the allocators differ and
+        // do not propagate).
+        Matrix<T, Alloc, Order>& operator=(const Matrix<T, Alloc, Order>& mat);
+        Matrix<T, Alloc, Order>& operator=(Matrix<T, Alloc, Order>&& mat)
+            noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value
+                     || std::allocator_traits<Alloc>::is_always_equal::value);
+        Matrix<T, Alloc, Order>& operator=(std::initializer_list<T> list);
+        template<class E>
+        Matrix<T, Alloc, Order>& operator=(const utils::MatrixExpression<E>& expr);
+
+        // -> Math operations (+, -, *, /) with single value or other Matrices
+        //    are free functions building lazy expressions, see
+        //    matrixExpressions.decl.hpp. Only in-place versions live here.
+        Matrix<T, Alloc, Order>& operator*=(T value);
+        Matrix<T, Alloc, Order>& operator+=(T value);
+        Matrix<T, Alloc, Order>& operator/=(T value);
+        Matrix<T, Alloc, Order>& operator-=(T value);
+
+        template<class E>
+        Matrix<T, Alloc, Order>& operator*=(const utils::MatrixExpression<E>& value);
+        template<class E>
+        Matrix<T, Alloc, Order>& operator+=(const utils::MatrixExpression<E>& value);
+        template<class E>
+        Matrix<T, Alloc, Order>& operator/=(const utils::MatrixExpression<E>& value);
+        template<class E>
+        Matrix<T, Alloc, Order>& operator-=(const utils::MatrixExpression<E>& value);
 
         // ------------------- ASK INFO MEMBERS (-> const) --------------------
-        std::size_t nLines()   const {return m_size.at(0);}
-        std::size_t nColumns() const {return m_size.at(1);}
-        std::size_t length() const {return utils::multiplyElements(m_size);}
-        const std::vector<std::size_t>& dimension() const {return m_size;}
-        bool isZero() const {return utils::areAllElementsZero(m_data);}
-        T at(std::size_t index) const {return m_data.at(index);}
+        std::size_t nLines()   const {return m_size[0];}
+        std::size_t nColumns() const {return m_size[1];}
+        std::size_t length() const {return m_size[0]*m_size[1];}
+        const std::array<std::size_t, 2>& dimension() const {return m_size;}
+        bool isZero() const; // stops at the first non-zero block
+        T at(std::size_t index) const; // index in storage order, padding skipped, -> Exeptions::OutOfRange()
+        std::size_t leadingDimension() const {return m_lead;}
+        bool isContiguous() const {return m_lead == this->storageLines();} // no padding
+        // Shape of the storage seen as a column-major buffer: the matrix
+        // itself, or its transpose for RowMajor.
+        std::size_t storageLines()   const {return storageLines(m_size[0], m_size[1]);}
+        std::size_t storageColumns() const {return storageLines(m_size[1], m_size[0]);}
+        static std::size_t storageLines(std::size_t line, std::size_t col) {
+            return (Order == Layout::ColumnMajor) ? line : col;
+        }
+
+        // -> Reductions (see matrixReduction.decl.hpp): SIMD, split across
+        //    threads above parallelThreshold(). min(), max() and mean() of
+        //    an empty matrix are T(), argMin() and argMax() give {line, col}
+        //    of the first smallest (largest) element in storage order.
+        //    Sums come in utils::accumulator_t<T>: float for Float16 and
+        //    BFloat16, which would overflow at 65504, 64 bits for integers.
+        //    Means and norms come in utils::real_t<T>, double for integers.
+        utils::accumulator_t<T> sum(utils::Summation summation = utils::Summation::Fast) const;
+        utils::real_t<T> mean(utils::Summation summation = utils::Summation::Fast) const;
+        T min() const;
+        T max() const;
+        Coord argMin() const;
+        Coord argMax() const;
+        utils::real_t<T> norm(Norm kind = Norm::L2) const; // L2: Frobenius
+        // predicate(element) for any (every) element, with early exit.
+        // predicate is called from several threads.
+        template<class Predicate>
+        bool any(Predicate predicate) const;
+        template<class Predicate>
+        bool all(Predicate predicate) const;
+        // One result per line (nLines() x 1) or per column (1 x nColumns()):
+        //     Matrix<double> columnSums = a.reduceColumns<utils::ReduceOp::Sum>();
+        template<utils::ReduceOp Op>
+        Matrix<T, Alloc, Order> reduceLines(utils::Summation summation = utils::Summation::Fast) const;
+        template<utils::ReduceOp Op>
+        Matrix<T, Alloc, Order> reduceColumns(utils::Summation summation = utils::Summation::Fast) const;
 
         void print() const;
         std::vector<T> getLine (const std::size_t line) const;
-        std::vector<T> getColumn (const std::size_t line) const;
-        const std::vector<T>& getElements() const {return m_data;}
+        std::vector<T> getColumn (const std::size_t col) const;
+        const std::vector<T, Alloc>& getElements() const {return m_data;} // padding included
+        Alloc get_allocator() const {return m_data.get_allocator();}
+        const T* data() const {return m_data.data();} // storage in Order
+
+        // ------------------------------ FILES -------------------------------
+        // Binary format of matrixFile.decl.hpp: header, then the storage as
+        // is (padding dropped). load() reads files of either layout and
+        // converts them to Order; the element type must match. The other
+        // layout is read in slabs of lines transposed into place, so only
+        // the result is held in full.
+        // -> Exceptions::FileError()
+        void save(const std::string& path) const;
+        static Matrix<T, Alloc, Order> load(const std::string& path, const Alloc& alloc = Alloc());
+
+        // ------------------------------ VIEWS -------------------------------
+        // O(1), no copy (see matrixView.decl.hpp). Views of a matrix are
+        // invalidated when its storage is reallocated.
+        // -> Exceptions::SizeMismatch() for lines / columns out of the matrix
+        MatrixView<T> view() {return MatrixView<T>(*this);}
+        ConstMatrixView<T> view() const {return ConstMatrixView<T>(*this);}
+        MatrixView<T> row(std::size_t line) {return this->view().row(line);}
+        ConstMatrixView<T> row(std::size_t line) const {return this->view().row(line);}
+        MatrixView<T> column(std::size_t col) {return this->view().column(col);}
+        ConstMatrixView<T> column(std::size_t col) const {return this->view().column(col);}
+        MatrixView<T> block(std::size_t line, std::size_t col, std::size_t nLines, std::size_t nColumns) {
+            return this->view().block(line, col, nLines, nColumns);
+        }
+        ConstMatrixView<T> block(std::size_t line, std::size_t col, std::size_t nLines, std::size_t nColumns) const {
+            return this->view().block(line, col, nLines, nColumns);
+        }
 
         // ----------------------- DATA MODIFIER MEMBERS ----------------------
-        void clear() {std::fill(m_data.begin(), m_data.end(), 0);}
-        void reset() {m_data.clear(); m_size.clear();}
+        void clear() {utils::broadcast(m_data.size(), static_cast<T>(0), m_data.data());}
+        void reset() {m_data.clear(); m_size = {0, 0}; m_lead = 0;}
+        // Allocators must compare equal unless they propagate on swap.
+        void swap(Matrix<T, Alloc, Order>& other) noexcept {
+            m_data.swap(other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_lead, other.m_lead);
+        }
         void setValues(const std::vector<T> &values);
+        T* data() {return m_data.data();}
+        // Transpose without a second buffer (see utils::transposeInPlace).
+        // A padded matrix goes through a new padded buffer instead.
+        void transposeInPlace();
+        // Move the columns (lines for RowMajor) to a buffer with lead
+        // elements between them (lead == storageLines() removes the padding).
+        // Values are kept.
+        // -> Exceptions::SizeMismatch() if lead < storageLines()
+        void setLeadingDimension(std::size_t lead);
 
         // ----------------------------- ITERATORS ----------------------------
-        typename MatrixType::iterator begin() { return m_data.begin(); }
-        typename MatrixType::iterator end()   { return m_data.end(); }
-        typename MatrixType::const_iterator cbegin() const { return m_data.cbegin(); }
-        typename MatrixType::const_iterator cend()   const { return m_data.cend(); }
+        // Storage order (column after column, line after line for RowMajor),
+        // over the elements only (not the padding).
+        typename MatrixView<T>::iterator begin() { return this->storageView().begin(); }
+        typename MatrixView<T>::iterator end()   { return this->storageView().end(); }
+        typename ConstMatrixView<T>::const_iterator cbegin() const { return this->storageView().begin(); }
+        typename ConstMatrixView<T>::const_iterator cend()   const { return this->storageView().end(); }
 
         //TO BE IMPLEMENTED
         void resize(const std::size_t line, const std::size_t column);
@@ -131,12 +286,29 @@ namespace geometry{
     // --------------------------- PROTECTED METHODS --------------------------
     protected:
         // ------------------- ASK INFO MEMBERS (-> const) --------------------
-        bool isSameSize(const Matrix<T>& other) const {
+        bool isSameSize(const Matrix<T, Alloc, Order>& other) const {
             return (this->nLines()==other.nLines()) & (this->nColumns()==other.nColumns());
         }
 
+        // Storage offset of (line, col), padding included.
+        std::size_t offset(const std::size_t line, const std::size_t col) const {
+            GEOMETRY_CHECK_INDEX(line, this->nLines());
+            GEOMETRY_CHECK_INDEX(col, this->nColumns());
+            if constexpr (Order == Layout::ColumnMajor)
+                return line + col * m_lead;
+            else
+                return line * m_lead + col;
+        }
         int flatCoord(const std::size_t line, const std::size_t col) const {
-            return line + col * m_size.at(0);
+            return static_cast<int>(this->offset(line, col));
+        }
+
+        // The storage as a column-major view (the transposed view for RowMajor).
+        MatrixView<T> storageView() {
+            return MatrixView<T>(m_data.data(), this->storageLines(), this->storageColumns(), 1, m_lead);
+        }
+        ConstMatrixView<T> storageView() const {
+            return ConstMatrixView<T>(m_data.data(), this->storageLines(), this->storageColumns(), 1, m_lead);
         }
 
         int flatCoord(const Coord coord) const;
@@ -146,7 +318,7 @@ namespace geometry{
         // ---> all these methods can throws exceptions
 
         // -> Exceptions::SizeMismatch()
-        void checkSize(const Matrix<T>& other) const{
+        void checkSize(const Matrix<T, Alloc, Order>& other) const{
             if(other.length() != this->length())
                 throw Exeptions::SizeMismatch(this->length(), other.length());
         }
@@ -156,10 +328,99 @@ namespace geometry{
                 throw Exeptions::SizeMismatch(this->length(), length);
         }
 
+        // other has the shape of this matrix, or broadcasts to it (see
+        // utils::broadcastShape).
+        // -> Exceptions::SizeMismatch()
+        template<class E>
+        void checkShape(const utils::MatrixExpression<E>& other) const{
+            const auto& expr = other.self();
+            if(!utils::broadcastsTo(expr.nLines(), this->nLines())
+               || !utils::broadcastsTo(expr.nColumns(), this->nColumns()))
+                throw Exeptions::SizeMismatch(this->length(), expr.nLines()*expr.nColumns());
+        }
+
         // ----------------------- DATA MODIFIER MEMBERS ----------------------
         void setSize(std::initializer_list<std::size_t> list);
+
+        // Elements of other (same shape, storage allocated) into m_data:
+        // a conversion pass, or the tiled transpose across layouts.
+        template<typename U, class A, Layout O>
+        void copyStorage(const Matrix<U, A, O>& other);
+
+        // Evaluate expr into m_data with assign(element, value). When expr
+        // reads m_data at other coordinates (e.g. x = transpose(x)) it is
+        // first evaluated into a temporary.
+        template<class E, class Assign>
+        void evaluate(const utils::MatrixExpression<E>& expr, Assign assign);
+
+        // this op= expr, expr being broadcast to the shape of this matrix
+        // (m += column adds it to every column). A plain matrix of the same
+        // type goes through the SIMD kernel Op, anything else through
+        // evaluate(expr, assign).
+        // -> Exceptions::SizeMismatch()
+        template<utils::ElementOp Op, class E, class Assign>
+        void compound(const utils::MatrixExpression<E>& expr, Assign assign);
     };
 
+    // ------------------- OPERATORS ON EXPIRING MATRICES ---------------------
+    // A temporary (or std::move'd) operand lends its buffer to the result
+    // instead of allocating a new one:
+    //     Matrix<> c = std::move(a) + b;   // c takes a's storage
+    //     x = (x * 2.0) + std::move(y);    // written in y's storage
+    // Only when the element type stays T, mixed types go through the lazy
+    // operators of matrixExpressions.decl.hpp. A recycled operand which
+    // broadcasts to a bigger result (std::move(column) + m) is too small and
+    // the result gets a new buffer.
+    template<class T, class A, Layout O, class E>
+    using RecycledMatrix = std::enable_if_t<std::is_same_v<typename E::value_type, T>, Matrix<T, A, O>>;
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator+(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs);
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator-(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs);
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator*(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs);
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator/(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs);
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator+(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator-(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator*(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator/(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs);
+
+    // Both expiring: the left one is recycled.
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator+(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator-(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator*(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator/(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs);
+
+    // -> Math operations with single value
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator+(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator-(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator*(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator/(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs);
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator+(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator-(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator*(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs);
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator/(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs);
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIX_FORWARD__GUARD__2610
+#define GEOMETRY__MATRIX_FORWARD__GUARD__2610
+
+// STANDARD INCLUDES
+#include <memory_resource>
+
+// LOCAL INCLUDES
+#include "matrixAllocator.decl.hpp"
+
+namespace geometry{
+
+    // Storage order of a Matrix. Element (line, col) lives at
+    //     ColumnMajor: line + col*leadingDimension()
+    //     RowMajor:    line*leadingDimension() + col
+    // An R x C row-major buffer is the C x R column-major buffer of the
+    // transpose, which is how the kernels handle it.
+    enum class Layout {ColumnMajor, RowMajor};
+
+    // Declared once here so that every header can name Matrix<T> before its
+    // definition without repeating the default arguments. Storage is 64-byte
+    // aligned by default (see matrixAllocator.decl.hpp) and column-major.
+    template<class T=double, class Alloc=utils::AlignedAllocator<T>,
+             Layout Order=Layout::ColumnMajor> class Matrix;
+
+    // Row-major matrices, for data coming from (or going to) C arrays and
+    // row-major files without a transpose pass:
+    //     RowMatrix<> m(2, 3, {1, 2, 3,
+    //                          4, 5, 6});
+    template<class T=double, class Alloc=utils::AlignedAllocator<T>>
+    using RowMatrix = Matrix<T, Alloc, Layout::RowMajor>;
+
+    // Matrices over any std::pmr::memory_resource (including utils::Arena
+    // and utils::Pool):
+    //     pmr::Matrix<> m(3, 3, &arena);
+    namespace pmr{
+
+        template<class T=double, Layout Order=Layout::ColumnMajor>
+        using Matrix = geometry::Matrix<T, std::pmr::polymorphic_allocator<T>, Order>;
+
+    }
+}
+#endif
@@ -17,6 +17,8 @@ Author: R. Tonneau (romain.tonneau@gmail.com)
 #include <iostream>
 #include <iterator>
 #include <cstring>
+#include <cmath>
+#include <type_traits>
 
 // LOCAL INCLUDES
 //#include "matrix.decl.hpp"
@@ -24,226 +26,517 @@ Author: R. Tonneau (romain.tonneau@gmail.com)
 #include "matrix.decl.hpp"
 #include "exceptions.hpp"
 #include "matrixUtils.hpp"
+#include "matrixTranspose.hpp"
+#include "matrixSimd.hpp"
+#include "matrixReduction.hpp"
+#include "matrixView.hpp"
+#include "matrixAllocator.hpp"
+#include "matrixFile.hpp"
+#include "matrixInstrumentation.hpp"
 
 namespace geometry{
 
     // ============================ PUBLIC METHODS ============================
     // ----------------------------- CONSTRUCTORS -----------------------------
-    template<class T>
-    Matrix<T>::Matrix(const Matrix<T>& other)
-        :Matrix<T>::Matrix(other.nLines(), other.nColumns())
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order>::Matrix(const Matrix<T, Alloc, Order>& other)
+        :m_data(other.m_data),
+         m_size(other.m_size),
+         m_lead(other.m_lead)
     {
-        this->setValues(other.getElements());
+        GEOMETRY_COUNT_COPY(m_data.size()*sizeof(T));
     }
 
-    template<class T>
-    Matrix<T>::Matrix(const utils::MatrixConstructorHelper<T>& ope)
-        :Matrix<T>::Matrix(ope.nLines(), ope.nColumns())
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order>::Matrix(const Matrix<T, Alloc, Order>& other, const Alloc& alloc)
+        :m_data(other.m_data, alloc),
+         m_size(other.m_size),
+         m_lead(other.m_lead)
     {
-        for(std::size_t i=0; i<ope.nLines()*ope.nColumns(); i++)
-            m_data.at(i) = ope.at(i);
+        GEOMETRY_COUNT_COPY(m_data.size()*sizeof(T));
     }
 
-    template<class T> template<typename U>
-    Matrix<T>::Matrix(const Matrix<U>& other)
-        :Matrix<T>::Matrix(other.nLines(), other.nColumns())
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order>::Matrix(Matrix<T, Alloc, Order>&& other) noexcept
+        :m_data(std::move(other.m_data)),
+         m_size(other.m_size),
+         m_lead(other.m_lead)
     {
-        for(std::size_t i=0; i<other.nLines()*other.nColumns(); i++)
-            m_data.at(i) = static_cast<T>(other.at(i));
+        GEOMETRY_COUNT_MOVE();
+        other.m_size = {0, 0};
+        other.m_lead = 0;
+    }
+
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order>::Matrix(Matrix<T, Alloc, Order>&& other, const Alloc& alloc)
+        :m_data(std::move(other.m_data), alloc),
+         m_size(other.m_size),
+         m_lead(other.m_lead)
+    {
+        GEOMETRY_COUNT_MOVE();
+        other.m_data.clear();
+        other.m_size = {0, 0};
+        other.m_lead = 0;
+    }
+
+    template<class T, class Alloc, Layout Order> template<class E, class>
+    Matrix<T, Alloc, Order>::Matrix(const utils::MatrixExpression<E>& expr, const Alloc& alloc)
+        :Matrix<T, Alloc, Order>::Matrix(expr.self().nLines(), expr.self().nColumns(), alloc)
+    {
+        GEOMETRY_TRACE("Matrix(expression)", this->nLines(), this->nColumns());
+        utils::evaluate(utils::makeStorageOperand<Order>(expr), m_data.data(), utils::AssignOp{});
+    }
+
+    template<class T, class Alloc, Layout Order> template<typename U, class A>
+    Matrix<T, Alloc, Order>::Matrix(const Matrix<U, A, Order>& other)
+        :Matrix<T, Alloc, Order>::Matrix(other.nLines(), other.nColumns())
+    {
+        GEOMETRY_TRACE("Matrix::convert", this->nLines(), this->nColumns());
+        GEOMETRY_COUNT_COPY(this->length()*sizeof(T));
+        this->copyStorage(other);
+    }
+
+    template<class T, class Alloc, Layout Order> template<typename U, class A, Layout O, class>
+    Matrix<T, Alloc, Order>::Matrix(const Matrix<U, A, O>& other)
+        :Matrix<T, Alloc, Order>::Matrix(other.nLines(), other.nColumns())
+    {
+        GEOMETRY_TRACE("Matrix::convertLayout", this->nLines(), this->nColumns());
+        GEOMETRY_COUNT_COPY(this->length()*sizeof(T));
+        this->copyStorage(other);
+    }
+
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> Matrix<T, Alloc, Order>::padded(std::size_t line, std::size_t col, const Alloc& alloc)
+    {
+        Matrix<T, Alloc, Order> out(alloc);
+        out.m_size = {line, col};
+        out.m_lead = utils::paddedLeadingDimension<T>(out.storageLines());
+        out.m_data.resize(out.m_lead*out.storageColumns());
+        return out;
     }
 
     // ----------------------------- DESTRUCTORS ------------------------------
 
     // ------------------------ OPERATORS OVERLOADING -------------------------
     // -> Assignement
-    template<class T> template<typename U>
-    Matrix<T>& Matrix<T>::operator=(const Matrix<U>& mat)
-    {
-        this->reset();
-        for(auto dim: mat.dimension())
-            this->m_size.push_back(dim);
-        for(auto elt: mat)
-            this->m_data.push_back(static_cast<T>(elt));
+    template<class T, class Alloc, Layout Order> template<typename U, class A, Layout O>
+    Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator=(const Matrix<U, A, O>& mat)
+    {
+        GEOMETRY_TRACE("Matrix::operator=(convert)", mat.nLines(), mat.nColumns());
+        GEOMETRY_COUNT_COPY(mat.length()*sizeof(T));
+        m_size = mat.dimension();
+        m_lead = this->storageLines();
+        m_data.resize(mat.length());
+        this->copyStorage(mat);
         return *this;
     }
 
-    template<class T>
-    Matrix<T>& Matrix<T>::operator=(const Matrix<T>& mat)
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator=(const Matrix<T, Alloc, Order>& mat)
     {
-        this->reset();
-        for(auto dim: mat.dimension())
-            this->m_size.push_back(dim);
-        for(auto elt: mat.getElements())
-            this->m_data.push_back(elt);
+        if(this == &mat)
+            return *this;
+        GEOMETRY_COUNT_COPY(mat.m_data.size()*sizeof(T));
+        m_size = mat.m_size;
+        m_lead = mat.m_lead;
+        m_data.assign(mat.m_data.begin(), mat.m_data.end()); // keeps capacity
         return *this;
     }
 
-    template<class T>
-    Matrix<T>& Matrix<T>::operator=(std::initializer_list<T> list)
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator=(Matrix<T, Alloc, Order>&& mat)
+        noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value
+                 || std::allocator_traits<Alloc>::is_always_equal::value)
+    {
+        if(this == &mat)
+            return *this;
+        GEOMETRY_COUNT_MOVE();
+        m_data = std::move(mat.m_data);
+        m_size = mat.m_size;
+        m_lead = mat.m_lead;
+        mat.m_data.clear();
+        mat.m_size = {0, 0};
+        mat.m_lead = 0;
+        return *this;
+    }
+
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator=(std::initializer_list<T> list)
     {
         // If the new list is a different size, reallocate it
         this->checkLength(static_cast<std::size_t>(list.size()));
         // Now initialize our array from the list
-        std::copy(list.begin(), list.end(), m_data.begin());
+        std::copy(list.begin(), list.end(), this->begin());
+        return *this;
+    }
+
+    template<class T, class Alloc, Layout Order> template<class E>
+    Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator=(const utils::MatrixExpression<E>& expr)
+    {
+        GEOMETRY_TRACE("Matrix::operator=(expression)", expr.self().nLines(), expr.self().nColumns());
+        // x = transpose(x): no temporary at all.
+        if constexpr (std::is_same_v<utils::storage_operand_t<Order, E>,
+                                     utils::TransposeExpression<utils::MatrixOperand<T>>>)
+            if(utils::makeStorageOperand<Order>(expr).inner().data() == m_data.data())
+            {
+                this->transposeInPlace();
+                return *this;
+            }
+
+        const auto& node = expr.self();
+        if((node.nLines()!=this->nLines()) || (node.nColumns()!=this->nColumns()))
+        {
+            // Shape changes: build the result aside if expr reads m_data,
+            // else resize in place (no allocation while capacity suffices).
+            auto operand = utils::makeStorageOperand<Order>(expr);
+            if(operand.references(m_data.data(), m_data.data() + m_data.size()))
+            {
+                Matrix<T, Alloc, Order> result(utils::makeOperand(expr), this->get_allocator());
+                this->swap(result);
+                return *this;
+            }
+            m_size = {node.nLines(), node.nColumns()};
+            m_lead = this->storageLines();
+            m_data.resize(this->length());
+            utils::evaluate(operand, m_data.data(), utils::AssignOp{});
+            return *this;
+        }
+        this->evaluate(expr, utils::AssignOp{});
         return *this;
     }
 
     // -> Math operations with single value
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator*=(T value)
+    template<class T, class Alloc, Layout Order>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator*=(T value)
     {
-        for(int i=0; i<m_data.size(); i++)
-            m_data.at(i) *= value;
+        GEOMETRY_TRACE("Matrix::operator*=(value)", this->nLines(), this->nColumns());
+        utils::elementWise<utils::ElementOp::Mul>(this->storageLines(), this->storageColumns(),
+                                                  m_data.data(), m_lead, value, m_data.data(), m_lead);
         return *this;
     }
 
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator+=(T value)
+    template<class T, class Alloc, Layout Order>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator+=(T value)
     {
-        for(int i=0; i<m_data.size(); i++)
-            m_data.at(i) += value;
+        GEOMETRY_TRACE("Matrix::operator+=(value)", this->nLines(), this->nColumns());
+        utils::elementWise<utils::ElementOp::Add>(this->storageLines(), this->storageColumns(),
+                                                  m_data.data(), m_lead, value, m_data.data(), m_lead);
         return *this;
     }
 
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator-=(T value)
+    template<class T, class Alloc, Layout Order>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator-=(T value)
     {
-        for(int i=0; i<m_data.size(); i++)
-            m_data.at(i) -= value;
+        GEOMETRY_TRACE("Matrix::operator-=(value)", this->nLines(), this->nColumns());
+        utils::elementWise<utils::ElementOp::Sub>(this->storageLines(), this->storageColumns(),
+                                                  m_data.data(), m_lead, value, m_data.data(), m_lead);
         return *this;
     }
 
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator/=(T value)
+    template<class T, class Alloc, Layout Order>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator/=(T value)
     {
-        for(int i=0; i<m_data.size(); i++)
-            m_data.at(i) /= value;
+        GEOMETRY_TRACE("Matrix::operator/=(value)", this->nLines(), this->nColumns());
+        utils::elementWise<utils::ElementOp::Div>(this->storageLines(), this->storageColumns(),
+                                                  m_data.data(), m_lead, value, m_data.data(), m_lead);
         return *this;
     }
 
-    // -> Math operations with other Matrices
+    // -> Math operations with other Matrices (or expressions)
+    template<class T, class Alloc, Layout Order> template<class E>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator*=(const utils::MatrixExpression<E>& value)
+    {
+        GEOMETRY_TRACE("Matrix::operator*=", this->nLines(), this->nColumns());
+        this->template compound<utils::ElementOp::Mul>(value, [](T& elt, const auto& v){ elt *= v; });
+        return *this;
+    }
 
-    template<class T>
-    Matrix<T> Matrix<T>::operator*(const Matrix<T>& value)
+    template<class T, class Alloc, Layout Order> template<class E>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator+=(const utils::MatrixExpression<E>& value)
     {
-        this->checkSize(value);
-        return Matrix<T>(utils::MultiplicationMCH<T>(&value.getElements(), &m_data, &m_size));
+        GEOMETRY_TRACE("Matrix::operator+=", this->nLines(), this->nColumns());
+        this->template compound<utils::ElementOp::Add>(value, [](T& elt, const auto& v){ elt += v; });
+        return *this;
     }
 
-    template<class T>
-    Matrix<T> Matrix<T>::operator+(const Matrix<T>& value)
+    template<class T, class Alloc, Layout Order> template<class E>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator-=(const utils::MatrixExpression<E>& value)
     {
-        this->checkSize(value);
-        return Matrix<T>(utils::AdditionMCH<T>(&value.getElements(), &m_data, &m_size));
+        GEOMETRY_TRACE("Matrix::operator-=", this->nLines(), this->nColumns());
+        this->template compound<utils::ElementOp::Sub>(value, [](T& elt, const auto& v){ elt -= v; });
+        return *this;
     }
 
-    template<class T>
-    Matrix<T> Matrix<T>::operator-(const Matrix<T>& value)
+    template<class T, class Alloc, Layout Order> template<class E>
+    inline Matrix<T, Alloc, Order>& Matrix<T, Alloc, Order>::operator/=(const utils::MatrixExpression<E>& value)
     {
-        this->checkSize(value);
-        return Matrix<T>(utils::SoustractionMCH<T>(&value.getElements(), &m_data, &m_size));
+        GEOMETRY_TRACE("Matrix::operator/=", this->nLines(), this->nColumns());
+        this->template compound<utils::ElementOp::Div>(value, [](T& elt, const auto& v){ elt /= v; });
+        return *this;
     }
 
-    template<class T>
-    Matrix<T> Matrix<T>::operator/(const Matrix<T>& value)
+    // --------------------- ASK INFO MEMBERS (-> const) ----------------------
+    template<class T, class Alloc, Layout Order>
+    bool Matrix<T, Alloc, Order>::isZero() const
     {
-        this->checkSize(value);
-        return Matrix<T>(utils::DivisionMCH<T>(&value.getElements(), &m_data, &m_size));
+        return utils::allZero(this->storageLines(), this->storageColumns(), m_data.data(), m_lead);
     }
 
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator*=(Matrix<T>& value)
+    template<class T, class Alloc, Layout Order>
+    utils::accumulator_t<T> Matrix<T, Alloc, Order>::sum(utils::Summation summation) const
     {
-        this->checkSize(value);
-        for(std::size_t i=0; i<m_data.size(); i++)
-            m_data.at(i) *= value.at(i);
-        return *this;
+        GEOMETRY_TRACE("Matrix::sum", this->nLines(), this->nColumns());
+        return utils::reduce<utils::ReduceOp::Sum>(this->storageLines(), this->storageColumns(),
+                                                   m_data.data(), m_lead, summation);
     }
 
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator+=(Matrix<T>& value)
+    template<class T, class Alloc, Layout Order>
+    utils::real_t<T> Matrix<T, Alloc, Order>::mean(utils::Summation summation) const
     {
-        this->checkSize(value);
-        for(std::size_t i=0; i<m_data.size(); i++)
-            m_data.at(i) += value.at(i);
-        return *this;
+        using Real = utils::real_t<T>;
+        if(this->length() == 0)
+            return Real{};
+        return static_cast<Real>(this->sum(summation))/static_cast<Real>(this->length());
     }
 
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator-=(Matrix<T>& value)
+    template<class T, class Alloc, Layout Order>
+    T Matrix<T, Alloc, Order>::min() const
     {
-        this->checkSize(value);
-        for(int i=0; i<m_data.size(); i++)
-            m_data.at(i) -= value.at(i);
-        return *this;
+        GEOMETRY_TRACE("Matrix::min", this->nLines(), this->nColumns());
+        return static_cast<T>(utils::reduce<utils::ReduceOp::Min>(this->storageLines(), this->storageColumns(),
+                                                                  m_data.data(), m_lead));
     }
 
-    template<class T>
-    inline Matrix<T>& Matrix<T>::operator/=(Matrix<T>& value)
+    template<class T, class Alloc, Layout Order>
+    T Matrix<T, Alloc, Order>::max() const
     {
-        this->checkSize(value);
-        for(int i=0; i<m_data.size(); i++)
-            m_data.at(i) /= value.at(i);
-        return *this;
+        GEOMETRY_TRACE("Matrix::max", this->nLines(), this->nColumns());
+        return static_cast<T>(utils::reduce<utils::ReduceOp::Max>(this->storageLines(), this->storageColumns(),
+                                                                  m_data.data(), m_lead));
     }
 
-    // --------------------- ASK INFO MEMBERS (-> const) ----------------------
+    template<class T, class Alloc, Layout Order>
+    Coord Matrix<T, Alloc, Order>::argMin() const
+    {
+        const Coord coord = utils::argMin(this->storageLines(), this->storageColumns(), m_data.data(), m_lead);
+        if constexpr (Order == Layout::ColumnMajor)
+            return coord;
+        else
+            return {coord[1], coord[0]};
+    }
 
-    template<class T>
-    void Matrix<T>::print() const
+    template<class T, class Alloc, Layout Order>
+    Coord Matrix<T, Alloc, Order>::argMax() const
     {
-        std::cout << m_size.at(0)
-                  << " X "
-                  << m_size.at(1)
-                  << " matrix:\n";
-        for(int i=0; i<m_size.at(0); i++) // Loop over lines
-        {
-            auto line = this->getLine(i);
-            std::copy(line.begin(), line.end(), std::ostream_iterator<T>(std::cout, " "));
-            std::cout << "\n";
-        }
-        std::cout << "\n";
+        const Coord coord = utils::argMax(this->storageLines(), this->storageColumns(), m_data.data(), m_lead);
+        if constexpr (Order == Layout::ColumnMajor)
+            return coord;
+        else
+            return {coord[1], coord[0]};
+    }
+
+    template<class T, class Alloc, Layout Order>
+    utils::real_t<T> Matrix<T, Alloc, Order>::norm(Norm kind) const
+    {
+        GEOMETRY_TRACE("Matrix::norm", this->nLines(), this->nColumns());
+        using Accumulator = utils::accumulator_t<T>;
+        using Real = utils::real_t<T>;
+        if(kind == Norm::L2)
+            return static_cast<Real>(std::sqrt(utils::sumSquares(this->storageLines(), this->storageColumns(),
+                                                                 m_data.data(), m_lead)));
+        // Largest sum of |a_ij| over the columns (L1) or the lines (Linf),
+        // the sums kept in the accumulator type.
+        using SumAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Accumulator>;
+        const bool storageColumns = ((kind == Norm::L1) == (Order == Layout::ColumnMajor));
+        std::vector<Accumulator, SumAlloc> sums(storageColumns ? this->storageColumns() : this->storageLines(),
+                                                SumAlloc(m_data.get_allocator()));
+        if(storageColumns)
+            utils::reduceColumns<utils::ReduceOp::AbsSum>(this->storageLines(), this->storageColumns(),
+                                                          m_data.data(), m_lead, sums.data());
+        else
+            utils::reduceLines<utils::ReduceOp::AbsSum>(this->storageLines(), this->storageColumns(),
+                                                        m_data.data(), m_lead, sums.data());
+        return static_cast<Real>(utils::reduce<utils::ReduceOp::Max>(sums.size(), sums.data()));
+    }
+
+    template<class T, class Alloc, Layout Order>
+    template<class Predicate>
+    bool Matrix<T, Alloc, Order>::any(Predicate predicate) const
+    {
+        return utils::anyOf(this->storageLines(), this->storageColumns(), m_data.data(), m_lead, predicate);
     }
 
-    template<class T>
-    std::vector<T> Matrix<T>::getLine(const std::size_t line) const
+    template<class T, class Alloc, Layout Order>
+    template<class Predicate>
+    bool Matrix<T, Alloc, Order>::all(Predicate predicate) const
     {
-        std::vector<T> out(m_size.at(1));
-        for(int i=0; i<m_size.at(1); i++)
-            out.at(i) = m_data.at(line+i*m_size.at(0));
+        return utils::allOf(this->storageLines(), this->storageColumns(), m_data.data(), m_lead, predicate);
+    }
+
+    // Lines of a row-major matrix are the columns of its storage.
+    template<class T, class Alloc, Layout Order>
+    template<utils::ReduceOp Op>
+    Matrix<T, Alloc, Order> Matrix<T, Alloc, Order>::reduceLines(utils::Summation summation) const
+    {
+        GEOMETRY_TRACE("Matrix::reduceLines", this->nLines(), 1);
+        Matrix<T, Alloc, Order> out(this->nLines(), 1, m_data.get_allocator());
+        if constexpr (Order == Layout::ColumnMajor)
+            utils::reduceLines<Op>(this->storageLines(), this->storageColumns(), m_data.data(), m_lead,
+                                   out.data(), summation);
+        else
+            utils::reduceColumns<Op>(this->storageLines(), this->storageColumns(), m_data.data(), m_lead,
+                                     out.data(), summation);
         return out;
     }
 
-    template<class T>
-    std::vector<T> Matrix<T>::getColumn(const std::size_t col) const
+    template<class T, class Alloc, Layout Order>
+    template<utils::ReduceOp Op>
+    Matrix<T, Alloc, Order> Matrix<T, Alloc, Order>::reduceColumns(utils::Summation summation) const
+    {
+        GEOMETRY_TRACE("Matrix::reduceColumns", 1, this->nColumns());
+        Matrix<T, Alloc, Order> out(1, this->nColumns(), m_data.get_allocator());
+        if constexpr (Order == Layout::ColumnMajor)
+            utils::reduceColumns<Op>(this->storageLines(), this->storageColumns(), m_data.data(), m_lead,
+                                     out.data(), summation);
+        else
+            utils::reduceLines<Op>(this->storageLines(), this->storageColumns(), m_data.data(), m_lead,
+                                   out.data(), summation);
+        return out;
+    }
+
+    template<class T, class Alloc, Layout Order>
+    T Matrix<T, Alloc, Order>::at(std::size_t index) const
+    {
+        Exeptions::checkIndex(index, this->length());
+        if(this->isContiguous())
+            return m_data[index];
+        return m_data[index % this->storageLines() + (index / this->storageLines())*m_lead];
+    }
+
+    template<class T, class Alloc, Layout Order>
+    void Matrix<T, Alloc, Order>::print() const
     {
-        std::vector<T> out{};
-        out.reserve(m_size.at(1));
+        this->view().print();
+    }
 
-        auto index = this->flatCoord(0, col);
+    template<class T, class Alloc, Layout Order>
+    std::vector<T> Matrix<T, Alloc, Order>::getLine(const std::size_t line) const
+    {
+        const ConstMatrixView<T> values = this->row(line);
+        GEOMETRY_COUNT_COPY(values.length()*sizeof(T));
+        return std::vector<T>(values.begin(), values.end());
+    }
 
-        typename std::vector<T>::iterator it_begin =
-            std::next(m_data.begin(), index);
+    template<class T, class Alloc, Layout Order>
+    std::vector<T> Matrix<T, Alloc, Order>::getColumn(const std::size_t col) const
+    {
+        const ConstMatrixView<T> values = this->column(col);
+        GEOMETRY_COUNT_COPY(values.length()*sizeof(T));
+        if constexpr (Order == Layout::ColumnMajor)
+            return std::vector<T>(values.data(), values.data() + values.length());
+        else
+            return std::vector<T>(values.begin(), values.end());
+    }
 
-        typename std::vector<T>::iterator it_end =
-            std::next(m_data.begin(), index+m_size.at(1));
+    // -------------------------------- FILES ---------------------------------
+    template<class T, class Alloc, Layout Order>
+    void Matrix<T, Alloc, Order>::save(const std::string& path) const
+    {
+        static_assert(utils::dtypeOf<T>() != DType::Unknown, "save() needs an arithmetic element type");
+        GEOMETRY_TRACE("Matrix::save", this->nLines(), this->nColumns());
+        utils::File file(path, "wb");
+        utils::writeHeader(file, utils::makeHeader(utils::dtypeOf<T>(), sizeof(T), Order, this->nLines(), this->nColumns()));
+        utils::writeStorage(file, m_data.data(), this->storageLines(), this->storageColumns(), m_lead);
+        file.close();
+    }
 
-        std::copy(it_begin, it_end, std::back_inserter(out));
+    template<class T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> Matrix<T, Alloc, Order>::load(const std::string& path, const Alloc& alloc)
+    {
+        static_assert(utils::dtypeOf<T>() != DType::Unknown, "load() needs an arithmetic element type");
+        utils::File file(path, "rb");
+        const MatrixFileHeader header = utils::readHeader(file, utils::dtypeOf<T>(), sizeof(T));
+        GEOMETRY_TRACE("Matrix::load", header.nLines, header.nColumns);
+        Matrix<T, Alloc, Order> out(header.nLines, header.nColumns, alloc);
+        if(utils::layoutOf(header) == Order)
+        {
+            utils::readStorage(file, out.data(), out.storageLines(), out.storageColumns(), out.m_lead, header.lead);
+            return out;
+        }
+        // The file storage is the transpose of ours: read it a slab of its
+        // columns at a time (about utils::fileChunk bytes, at least 8
+        // columns for the SIMD sub-tiles) and transpose each slab into our
+        // lines.
+        const std::size_t fileLines = utils::storageLines(header);
+        const std::size_t fileColumns = utils::storageColumns(header);
+        if(fileLines*fileColumns == 0)
+            return out;
+        const std::size_t slab = std::min(fileColumns, std::max<std::size_t>(
+            8, utils::fileChunk/(fileLines*sizeof(T))));
+        using SlabAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+        std::vector<T, SlabAlloc> buffer(fileLines*slab, SlabAlloc(alloc));
+        for(std::size_t first=0; first<fileColumns; first+=slab)
+        {
+            const std::size_t count = std::min(slab, fileColumns - first);
+            if(first > 0)
+                file.skip((header.lead - fileLines)*sizeof(T));
+            utils::readStorage(file, buffer.data(), fileLines, count, fileLines, header.lead);
+            utils::transpose(fileLines, count, buffer.data(), fileLines, out.data() + first, out.m_lead);
+        }
         return out;
     }
 
     // ------------------------- DATA MODIFIER MEMBERS ------------------------
-    template<class T>
-    void Matrix<T>::setValues(const std::vector<T> &values)
+    template<class T, class Alloc, Layout Order>
+    void Matrix<T, Alloc, Order>::setValues(const std::vector<T> &values)
     {
         this->checkLength(values.size());
         std::copy(std::begin(values), std::end(values), std::begin(*this));
     }
 
+    template<class T, class Alloc, Layout Order>
+    void Matrix<T, Alloc, Order>::transposeInPlace()
+    {
+        GEOMETRY_TRACE("Matrix::transposeInPlace", this->nColumns(), this->nLines());
+        // The storage of the transpose is the transposed storage, whatever
+        // the layout.
+        if(!this->isContiguous())
+        {
+            Matrix<T, Alloc, Order> result = Matrix<T, Alloc, Order>::padded(this->nColumns(), this->nLines(),
+                                                                             this->get_allocator());
+            utils::transpose(this->storageLines(), this->storageColumns(), m_data.data(), m_lead,
+                             result.m_data.data(), result.m_lead);
+            this->swap(result);
+            return;
+        }
+        utils::transposeInPlace(this->storageLines(), this->storageColumns(), m_data.data(),
+                                this->get_allocator());
+        std::swap(m_size[0], m_size[1]);
+        m_lead = this->storageLines();
+    }
+
+    template<class T, class Alloc, Layout Order>
+    void Matrix<T, Alloc, Order>::setLeadingDimension(std::size_t lead)
+    {
+        if(lead < this->storageLines())
+            throw Exeptions::SizeMismatch(this->storageLines(), lead);
+        if(lead == m_lead)
+            return;
+        GEOMETRY_TRACE("Matrix::setLeadingDimension", this->nLines(), this->nColumns());
+        GEOMETRY_COUNT_COPY(this->length()*sizeof(T));
+        Matrix<T, Alloc, Order> result(this->get_allocator());
+        result.m_size = m_size;
+        result.m_lead = lead;
+        result.m_data.resize(lead*this->storageColumns());
+        utils::convert(this->storageLines(), this->storageColumns(), m_data.data(), m_lead,
+                       result.m_data.data(), lead);
+        this->swap(result);
+    }
+
     //TO BE IMPLEMENTED
     /*
-    template<class T>
-    void Matrix<T>::resize(const std::size_t line, const std::size_t column)
+    template<class T, class Alloc, Layout Order>
+    void Matrix<T, Alloc, Order>::resize(const std::size_t line, const std::size_t column)
     {
         //Total size must be equals
         if (line*column != this->length())
@@ -255,35 +548,221 @@ namespace geometry{
 
     // =========================== PROTECTED METHODS ==========================
     // --------------------- ASK INFO MEMBERS (-> const) ----------------------
-    // (X,Y,Z) -> (X + Y * DX + Z * DY * DX)
-    template<class T>
-    int Matrix<T>::flatCoord(const Coord coord) const
+    // (line, col) -> position in m_data. N-D arrays are Tensor, see
+    // utils::flatIndex.
+    template<class T, class Alloc, Layout Order>
+    int Matrix<T, Alloc, Order>::flatCoord(const Coord coord) const
     {
-        int out{coord.front()};
-        for (int i=1; i<m_size.size(); i++)
-            out += (coord.at(i) * m_size.at(i));
-        return out;
+        return this->flatCoord(coord[0], coord[1]);
     }
 
-    template<class T>
-    Coord Matrix<T>::coord2D(const std::size_t flat) const
+    template<class T, class Alloc, Layout Order>
+    Coord Matrix<T, Alloc, Order>::coord2D(const std::size_t flat) const
     {
-        if (m_size.at(1)==0) return {flat, 0};
-        return {flat%m_size.at(0), (flat/m_size.at(0))%m_size.at(1)};
+        if (m_size[1]==0) return {flat, 0};
+        return {flat%m_size[0], (flat/m_size[0])%m_size[1]};
     }
 
     // ------------------ SANITY CHECKS MEMBERS (-> const) --------------------
 
     // ----------------------- DATA MODIFIER MEMBERS ----------------------
-    template<class T>
-    void Matrix<T>::setSize(std::initializer_list<std::size_t> list){
+    template<class T, class Alloc, Layout Order> template<typename U, class A, Layout O>
+    void Matrix<T, Alloc, Order>::copyStorage(const Matrix<U, A, O>& other)
+    {
+        if constexpr (O == Order)
+            utils::convert(other.storageLines(), other.storageColumns(), other.data(),
+                           other.leadingDimension(), m_data.data(), m_lead);
+        else if constexpr (std::is_same_v<U, T>)
+            utils::transpose(other.storageLines(), other.storageColumns(), other.data(),
+                             other.leadingDimension(), m_data.data(), m_lead);
+        else
+            utils::evaluate(utils::makeStorageOperand<Order>(other), m_data.data(), m_lead,
+                            utils::AssignOp{});
+    }
+
+    template<class T, class Alloc, Layout Order>
+    void Matrix<T, Alloc, Order>::setSize(std::initializer_list<std::size_t> list){
+            if(list.size() != m_size.size())
+                throw Exeptions::SizeMismatch(m_size.size(), list.size());
             this->checkLength(utils::multiplyElements(std::vector<std::size_t>{list}));
-            m_size.clear();
-            std::copy(std::begin(list), std::end(list), std::back_inserter(m_size));
+            this->setLeadingDimension(this->storageLines()); // reshaping needs contiguous storage
+            std::copy(std::begin(list), std::end(list), std::begin(m_size));
+            m_lead = this->storageLines();
+        }
+
+    template<class T, class Alloc, Layout Order> template<class E, class Assign>
+    void Matrix<T, Alloc, Order>::evaluate(const utils::MatrixExpression<E>& expr, Assign assign)
+    {
+        auto operand = utils::makeStorageOperand<Order>(expr);
+        if(!decltype(operand)::isElementWise
+           && operand.references(m_data.data(), m_data.data() + m_data.size()))
+        {
+            const Matrix<T, Alloc, Order> copy(utils::makeOperand(expr), this->get_allocator());
+            utils::evaluate(utils::makeStorageOperand<Order>(copy), m_data.data(), m_lead, assign);
+            return;
         }
+        utils::evaluate(operand, m_data.data(), m_lead, assign);
+    }
+
+    template<class T, class Alloc, Layout Order> template<utils::ElementOp Op, class E, class Assign>
+    void Matrix<T, Alloc, Order>::compound(const utils::MatrixExpression<E>& expr, Assign assign)
+    {
+        this->checkShape(expr);
+        const auto operand = utils::makeOperand(expr).broadcastTo(this->nLines(), this->nColumns());
+        if constexpr (std::is_same_v<utils::storage_operand_t<Order, E>, utils::MatrixOperand<T>>)
+        {
+            const utils::MatrixOperand<T> other = utils::makeStorageOperand<Order>(operand);
+            utils::elementWise<Op>(this->storageLines(), this->storageColumns(), m_data.data(), 1, m_lead,
+                                   other.data(), other.lineStride(), other.lead(), m_data.data(), m_lead);
+        }
+        else
+            this->evaluate(operand, assign);
+    }
 
     //TO BE IMPLEMENTED
 
+    // ==================== OPERATORS ON EXPIRING MATRICES ====================
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator+(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs)
+    {
+        lhs = lhs + rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator-(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs)
+    {
+        lhs = lhs - rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator*(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs)
+    {
+        lhs = lhs * rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator/(Matrix<T, A, O>&& lhs, const utils::MatrixExpression<E>& rhs)
+    {
+        lhs = lhs / rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator+(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs + rhs;
+        return std::move(rhs);
+    }
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator-(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs - rhs;
+        return std::move(rhs);
+    }
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator*(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs * rhs;
+        return std::move(rhs);
+    }
+
+    template<class T, class A, Layout O, class E>
+    RecycledMatrix<T, A, O, E> operator/(const utils::MatrixExpression<E>& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs / rhs;
+        return std::move(rhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator+(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs)
+    {
+        lhs = lhs + rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator-(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs)
+    {
+        lhs = lhs - rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator*(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs)
+    {
+        lhs = lhs * rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator/(Matrix<T, A, O>&& lhs, Matrix<T, A, O>&& rhs)
+    {
+        lhs = lhs / rhs;
+        return std::move(lhs);
+    }
+
+    // -> Math operations with single value
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator+(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator-(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator*(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs)
+    {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator/(Matrix<T, A, O>&& lhs, const typename Matrix<T, A, O>::value_type& rhs)
+    {
+        lhs /= rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator+(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs + rhs;
+        return std::move(rhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator-(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs - rhs;
+        return std::move(rhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator*(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs * rhs;
+        return std::move(rhs);
+    }
+
+    template<class T, class A, Layout O>
+    Matrix<T, A, O> operator/(const typename Matrix<T, A, O>::value_type& lhs, Matrix<T, A, O>&& rhs)
+    {
+        rhs = lhs / rhs;
+        return std::move(rhs);
+    }
+
 }
 
 #endif
\ No newline at end of file
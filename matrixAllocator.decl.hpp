@@ -0,0 +1,238 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXALLOCATOR_DECL__GUARD__2610
+#define GEOMETRY__MATRIXALLOCATOR_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrixInstrumentation.decl.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // ------------------------------- ALIGNMENT --------------------------
+        // Alignment of matrix storage: one cache line, one AVX-512 register.
+        constexpr std::size_t storageAlignment = 64;
+
+        // Leading dimension (distance between two columns, in elements) for
+        // nLines lines: rounded up to a whole number of cache lines, plus one
+        // more line when the column size in bytes is a multiple of 512, which
+        // would put the same lines of neighbouring columns in the same cache
+        // sets.
+        template<typename T>
+        constexpr std::size_t paddedLeadingDimension(std::size_t nLines);
+
+        // Default allocator of Matrix: operator new with storageAlignment.
+        template<class T, std::size_t Alignment = storageAlignment>
+        class AlignedAllocator
+        {
+        public: // types
+            using value_type = T;
+            using is_always_equal = std::true_type;
+
+            template<class U>
+            struct rebind {using other = AlignedAllocator<U, Alignment>;};
+
+        public: // METHODS
+            AlignedAllocator() noexcept {}
+            template<class U>
+            AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+            T* allocate(std::size_t n);
+            void deallocate(T* p, std::size_t n) noexcept {
+                GEOMETRY_COUNT_DEALLOCATION(n*sizeof(T));
+                ::operator delete(p, std::align_val_t(Alignment));
+            }
+
+            template<class U>
+            bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {return true;}
+            template<class U>
+            bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {return false;}
+        };
+
+        // -------------------------------- ARENA -----------------------------
+        // Monotonic buffer for the temporaries of one request: allocating is
+        // a pointer bump, freeing does nothing and reset() drops everything
+        // at once while keeping the blocks for the next request, so a loop
+        // that resets its arena stops calling upstream after the first turn.
+        // Not thread-safe. Usable as a std::pmr resource.
+        class Arena: public std::pmr::memory_resource
+        {
+        public:
+            explicit Arena(std::size_t blockSize = std::size_t(1) << 20,
+                           std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+            ~Arena();
+
+            Arena(const Arena&) = delete;
+            Arena& operator=(const Arena&) = delete;
+
+            void* take(std::size_t bytes, std::size_t alignment) {
+                const std::uintptr_t first = (m_current + alignment - 1) & ~(alignment - 1);
+                if((first >= m_current) && (bytes <= m_end - first))
+                {
+                    m_current = first + bytes;
+                    return reinterpret_cast<void*>(first);
+                }
+                return this->grow(bytes, alignment);
+            }
+            void give(void*, std::size_t, std::size_t) {}
+
+            // Everything taken so far is invalid afterwards.
+            void reset();
+            // reset() and hand the blocks back to upstream.
+            void release();
+
+            std::size_t capacity() const; // bytes held from upstream
+
+        protected:
+            struct Block
+            {
+                void* data;
+                std::size_t size;
+            };
+
+            std::vector<Block> m_blocks;
+            std::size_t m_block{0}; // block being filled
+            std::uintptr_t m_current{0};
+            std::uintptr_t m_end{0};
+            std::size_t m_blockSize;
+            std::pmr::memory_resource* mp_upstream;
+
+            void* grow(std::size_t bytes, std::size_t alignment);
+
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+                return this->take(bytes, alignment);
+            }
+            void do_deallocate(void*, std::size_t, std::size_t) override {}
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+        };
+
+        // --------------------------------- POOL -----------------------------
+        // Free lists of power of two size classes, from 64 bytes up to
+        // maxPooled: a matrix of a shape seen before gets the block a previous
+        // one gave back, with no call to upstream. Blocks are 64-byte aligned,
+        // bigger requests go straight to upstream. Memory returns to upstream
+        // in release() or with the pool. Not thread-safe. Usable as a
+        // std::pmr resource.
+        class Pool: public std::pmr::memory_resource
+        {
+        public:
+            static constexpr std::size_t minBlock = 64;
+
+            explicit Pool(std::size_t maxPooled = std::size_t(1) << 20,
+                          std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+            ~Pool();
+
+            Pool(const Pool&) = delete;
+            Pool& operator=(const Pool&) = delete;
+
+            void* take(std::size_t bytes, std::size_t alignment);
+            void give(void* p, std::size_t bytes, std::size_t alignment);
+
+            void release();
+
+        protected:
+            struct Node
+            {
+                Node* next;
+            };
+            struct Slab
+            {
+                void* data;
+                std::size_t size;
+            };
+
+            std::vector<Node*> m_free; // one list per size class
+            std::vector<Slab> m_slabs;
+            std::size_t m_maxPooled;
+            std::pmr::memory_resource* mp_upstream;
+
+            // Size class of a request, m_free.size() when not pooled.
+            std::size_t sizeClass(std::size_t bytes, std::size_t alignment) const;
+            void refill(std::size_t sizeClass);
+
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+                return this->take(bytes, alignment);
+            }
+            void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+                this->give(p, bytes, alignment);
+            }
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+        };
+
+        // ------------------------------ ALLOCATORS --------------------------
+        // Standard allocator drawing from a Resource (Arena or Pool) without
+        // going through virtual calls:
+        //     utils::Arena arena;
+        //     utils::ArenaAllocator<double> alloc(arena);
+        //     Matrix<double, utils::ArenaAllocator<double>> m(3, 3, alloc);
+        // Like std::pmr, a matrix keeps its resource when assigned to, and
+        // the resource must outlive the matrices using it. Blocks are aligned
+        // on storageAlignment.
+        template<class T, class Resource>
+        class ResourceAllocator
+        {
+        public: // types
+            using value_type = T;
+            using propagate_on_container_copy_assignment = std::false_type;
+            using propagate_on_container_move_assignment = std::false_type;
+            using propagate_on_container_swap = std::false_type;
+            using is_always_equal = std::false_type;
+
+            template<class U>
+            struct rebind {using other = ResourceAllocator<U, Resource>;};
+
+        protected: // attributes
+            static constexpr std::size_t alignment = (alignof(T) > storageAlignment) ? alignof(T) : storageAlignment;
+            Resource* mp_resource;
+
+        public: // METHODS
+            ResourceAllocator(Resource& resource) noexcept: mp_resource{&resource} {}
+            template<class U>
+            ResourceAllocator(const ResourceAllocator<U, Resource>& other) noexcept:
+                mp_resource{other.resource()}
+                {}
+
+            T* allocate(std::size_t n);
+            void deallocate(T* p, std::size_t n) noexcept {
+                GEOMETRY_COUNT_DEALLOCATION(n*sizeof(T));
+                mp_resource->give(p, n*sizeof(T), alignment);
+            }
+
+            Resource* resource() const noexcept {return mp_resource;}
+
+            template<class U>
+            bool operator==(const ResourceAllocator<U, Resource>& other) const noexcept {
+                return mp_resource == other.resource();
+            }
+            template<class U>
+            bool operator!=(const ResourceAllocator<U, Resource>& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
+        template<class T>
+        using ArenaAllocator = ResourceAllocator<T, Arena>;
+
+        template<class T>
+        using PoolAllocator = ResourceAllocator<T, Pool>;
+
+    }
+}
+#endif
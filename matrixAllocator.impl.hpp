@@ -0,0 +1,191 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXALLOCATOR_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXALLOCATOR_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <limits>
+#include <new>
+
+// LOCAL INCLUDES
+#include "matrixAllocator.decl.hpp"
+#include "matrixInstrumentation.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // ------------------------------- ALIGNMENT --------------------------
+        template<typename T>
+        constexpr std::size_t paddedLeadingDimension(std::size_t nLines)
+        {
+            if(storageAlignment % sizeof(T) != 0)
+                return nLines;
+            const std::size_t perLine = storageAlignment/sizeof(T);
+            std::size_t lead = (nLines + perLine - 1)/perLine*perLine;
+            if((lead*sizeof(T)) % 512 == 0)
+                lead += perLine;
+            return lead;
+        }
+
+        template<class T, std::size_t Alignment>
+        T* AlignedAllocator<T, Alignment>::allocate(std::size_t n)
+        {
+            if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+            T* p = static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(Alignment)));
+            GEOMETRY_COUNT_ALLOCATION(n*sizeof(T));
+            return p;
+        }
+
+        // -------------------------------- ARENA -----------------------------
+        inline Arena::Arena(std::size_t blockSize, std::pmr::memory_resource* upstream):
+            m_blockSize{std::max<std::size_t>(blockSize, 64)},
+            mp_upstream{upstream}
+            {}
+
+        inline Arena::~Arena()
+        {
+            this->release();
+        }
+
+        inline void Arena::reset()
+        {
+            m_block = 0;
+            m_current = m_blocks.empty() ? 0 : reinterpret_cast<std::uintptr_t>(m_blocks.front().data);
+            m_end = m_blocks.empty() ? 0 : m_current + m_blocks.front().size;
+        }
+
+        inline void Arena::release()
+        {
+            for(const Block& block: m_blocks)
+                mp_upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+            m_blocks.clear();
+            this->reset();
+        }
+
+        inline std::size_t Arena::capacity() const
+        {
+            std::size_t total = 0;
+            for(const Block& block: m_blocks)
+                total += block.size;
+            return total;
+        }
+
+        inline void* Arena::grow(std::size_t bytes, std::size_t alignment)
+        {
+            // Next kept block that fits, else a new one (big requests get a
+            // block of their own size).
+            const std::size_t needed = bytes + alignment;
+            if(needed < bytes)
+                throw std::bad_alloc();
+            const std::size_t first = m_blocks.empty() ? 0 : m_block + 1;
+            std::size_t next = first;
+            while((next < m_blocks.size()) && (m_blocks[next].size < needed))
+                next++;
+            if(next == m_blocks.size())
+            {
+                const std::size_t size = std::max(m_blockSize, needed);
+                m_blocks.push_back({mp_upstream->allocate(size, alignof(std::max_align_t)), size});
+            }
+            std::swap(m_blocks[next], m_blocks[first]); // smaller ones stay for later
+            m_block = first;
+            m_current = reinterpret_cast<std::uintptr_t>(m_blocks[m_block].data);
+            m_end = m_current + m_blocks[m_block].size;
+            return this->take(bytes, alignment);
+        }
+
+        // --------------------------------- POOL -----------------------------
+        inline Pool::Pool(std::size_t maxPooled, std::pmr::memory_resource* upstream):
+            m_maxPooled{std::max(maxPooled, minBlock)},
+            mp_upstream{upstream}
+        {
+            std::size_t nClasses = 1;
+            for(std::size_t size = minBlock; size < m_maxPooled; size *= 2)
+                nClasses++;
+            m_free.assign(nClasses, nullptr);
+        }
+
+        inline Pool::~Pool()
+        {
+            this->release();
+        }
+
+        inline std::size_t Pool::sizeClass(std::size_t bytes, std::size_t alignment) const
+        {
+            if((bytes > m_maxPooled) || (alignment > minBlock))
+                return m_free.size();
+            std::size_t index = 0;
+            for(std::size_t size = minBlock; size < bytes; size *= 2)
+                index++;
+            return (index < m_free.size()) ? index : m_free.size();
+        }
+
+        inline void Pool::refill(std::size_t sizeClass)
+        {
+            // Small classes are carved out of 64 KiB slabs.
+            const std::size_t block = minBlock << sizeClass;
+            const std::size_t size = std::max<std::size_t>(block, std::size_t(1) << 16);
+            char* data = static_cast<char*>(mp_upstream->allocate(size, minBlock));
+            m_slabs.push_back({data, size});
+            for(std::size_t offset = size; offset >= block; offset -= block)
+            {
+                Node* node = reinterpret_cast<Node*>(data + offset - block);
+                node->next = m_free[sizeClass];
+                m_free[sizeClass] = node;
+            }
+        }
+
+        inline void* Pool::take(std::size_t bytes, std::size_t alignment)
+        {
+            const std::size_t index = this->sizeClass(bytes, alignment);
+            if(index == m_free.size())
+                return mp_upstream->allocate(bytes, alignment);
+            if(!m_free[index])
+                this->refill(index);
+            Node* node = m_free[index];
+            m_free[index] = node->next;
+            return node;
+        }
+
+        inline void Pool::give(void* p, std::size_t bytes, std::size_t alignment)
+        {
+            const std::size_t index = this->sizeClass(bytes, alignment);
+            if(index == m_free.size())
+            {
+                mp_upstream->deallocate(p, bytes, alignment);
+                return;
+            }
+            Node* node = static_cast<Node*>(p);
+            node->next = m_free[index];
+            m_free[index] = node;
+        }
+
+        inline void Pool::release()
+        {
+            for(const Slab& slab: m_slabs)
+                mp_upstream->deallocate(slab.data, slab.size, minBlock);
+            m_slabs.clear();
+            std::fill(m_free.begin(), m_free.end(), nullptr);
+        }
+
+        // ------------------------------ ALLOCATORS --------------------------
+        template<class T, class Resource>
+        T* ResourceAllocator<T, Resource>::allocate(std::size_t n)
+        {
+            if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+            T* p = static_cast<T*>(mp_resource->take(n*sizeof(T), alignment));
+            GEOMETRY_COUNT_ALLOCATION(n*sizeof(T));
+            return p;
+        }
+
+    }
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXBATCH_DECL__GUARD__2610
+#define GEOMETRY__MATRIXBATCH_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrixAllocator.decl.hpp"
+#include "fixedMatrix.decl.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    // Many small matrices of the same shape (per-vertex or per-particle
+    // transforms) stored as a structure of arrays: element (line, col) of
+    // every matrix is one contiguous array, so the batched kernels below
+    // load the same element of 8 matrices (doubles, AVX-512) in a single
+    // register and run one matrix per lane. Entry (line, col) starts at
+    // data() + (line + col*R)*stride(), matrix index is the lane inside it.
+    // stride() is size() rounded up to a cache line and grows like the
+    // capacity of a vector; the lanes above size() are never read back.
+    template<class T, std::size_t R, std::size_t C>
+    class MatrixBatch
+    {
+    public: // types
+        using value_type = T;
+        using matrix_type = FixedMatrix<T, R, C>;
+
+        // Matrices per cache line: the granularity of stride() and of the
+        // chunks given to each thread.
+        static constexpr std::size_t lanes = std::max<std::size_t>(1, utils::storageAlignment/sizeof(T));
+
+    protected: // attributes
+        std::vector<T, utils::AlignedAllocator<T>> m_data{};
+        std::size_t m_size{0};
+        std::size_t m_stride{0};
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        MatrixBatch() {} // --> empty batch
+
+        explicit MatrixBatch(std::size_t size); // --> size zero matrices
+        MatrixBatch(std::size_t size, const matrix_type& value);
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element (line, col) of matrix index (unchecked, see GEOMETRY_CHECKED)
+        T operator()(std::size_t index, std::size_t line, std::size_t col) const {
+            GEOMETRY_CHECK_INDEX(index, m_size);
+            GEOMETRY_CHECK_INDEX(line, R);
+            GEOMETRY_CHECK_INDEX(col, C);
+            return m_data[(line + col*R)*m_stride + index];
+        }
+        T& operator()(std::size_t index, std::size_t line, std::size_t col) {
+            GEOMETRY_CHECK_INDEX(index, m_size);
+            GEOMETRY_CHECK_INDEX(line, R);
+            GEOMETRY_CHECK_INDEX(col, C);
+            return m_data[(line + col*R)*m_stride + index];
+        }
+
+        // -> Math operations in place, on every matrix (element-wise)
+        // -> Exceptions::SizeMismatch()
+        MatrixBatch& operator+=(const MatrixBatch& other);
+        MatrixBatch& operator-=(const MatrixBatch& other);
+        MatrixBatch& operator*=(T value);
+        MatrixBatch& operator/=(T value);
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        static constexpr std::size_t nLines()   {return R;}
+        static constexpr std::size_t nColumns() {return C;}
+        std::size_t size()   const {return m_size;}
+        std::size_t stride() const {return m_stride;}
+        bool empty() const {return m_size == 0;}
+
+        const T* data() const {return m_data.data();}
+        // size() values: element (line, col) of every matrix.
+        const T* entry(std::size_t line, std::size_t col) const {return data() + (line + col*R)*m_stride;}
+
+        // Copy of one matrix (unchecked, see GEOMETRY_CHECKED).
+        matrix_type get(std::size_t index) const;
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        T* data() {return m_data.data();}
+        T* entry(std::size_t line, std::size_t col) {return data() + (line + col*R)*m_stride;}
+
+        // (unchecked, see GEOMETRY_CHECKED)
+        void set(std::size_t index, const matrix_type& value);
+        void fill(const matrix_type& value);
+        void push_back(const matrix_type& value);
+
+        // Keeps the first matrices, the new ones are zero.
+        void resize(std::size_t size);
+        void reserve(std::size_t size);
+        void clear() {m_size = 0;}
+
+        void swap(MatrixBatch& other) noexcept;
+
+    protected:
+        // Moves the entries to a buffer of the given stride (>= size()).
+        void reallocate(std::size_t stride);
+    };
+
+    template<class T> using Matrix2Batch = MatrixBatch<T, 2, 2>;
+    template<class T> using Matrix3Batch = MatrixBatch<T, 3, 3>;
+    template<class T> using Matrix4Batch = MatrixBatch<T, 4, 4>;
+
+    // -> Batched linear algebra, matrix by matrix. Each call is vectorized
+    // across the matrices of the batch and split across threads like the
+    // other kernels. out is resized and may be one of the operands.
+    // -> Exceptions::SizeMismatch() when batch sizes differ
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    void matmul(const MatrixBatch<T, R, K>& A, const MatrixBatch<T, K, C>& B, MatrixBatch<T, R, C>& out);
+    // Same left (right) operand for every matrix of the batch.
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    void matmul(const FixedMatrix<T, R, K>& A, const MatrixBatch<T, K, C>& B, MatrixBatch<T, R, C>& out);
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    void matmul(const MatrixBatch<T, R, K>& A, const FixedMatrix<T, K, C>& B, MatrixBatch<T, R, C>& out);
+
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    MatrixBatch<T, R, C> matmul(const MatrixBatch<T, R, K>& A, const MatrixBatch<T, K, C>& B);
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    MatrixBatch<T, R, C> matmul(const FixedMatrix<T, R, K>& A, const MatrixBatch<T, K, C>& B);
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    MatrixBatch<T, R, C> matmul(const MatrixBatch<T, R, K>& A, const FixedMatrix<T, K, C>& B);
+
+    template<class T, std::size_t R, std::size_t C>
+    void transpose(const MatrixBatch<T, R, C>& batch, MatrixBatch<T, C, R>& out);
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, C, R> transpose(const MatrixBatch<T, R, C>& batch);
+
+    // Closed forms, up to 4x4. out holds batch.size() values.
+    template<class T, std::size_t N>
+    void determinant(const MatrixBatch<T, N, N>& batch, T* out);
+    template<class T, std::size_t N>
+    std::vector<T> determinant(const MatrixBatch<T, N, N>& batch);
+
+    // Adjugate over determinant, up to 4x4. out is left unspecified when
+    // it throws.
+    // -> Exceptions::SingularMatrix() if any matrix has a zero determinant
+    template<class T, std::size_t N>
+    void inverse(const MatrixBatch<T, N, N>& batch, MatrixBatch<T, N, N>& out);
+    template<class T, std::size_t N>
+    MatrixBatch<T, N, N> inverse(const MatrixBatch<T, N, N>& batch);
+
+}
+#endif
@@ -0,0 +1,561 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXBATCH_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXBATCH_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+// LOCAL INCLUDES
+#include "matrixBatch.decl.hpp"
+#include "matrixAllocator.hpp"
+#include "fixedMatrix.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    // ============================ PUBLIC METHODS ============================
+    // ----------------------------- CONSTRUCTORS -----------------------------
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, R, C>::MatrixBatch(std::size_t size)
+    {
+        this->resize(size);
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, R, C>::MatrixBatch(std::size_t size, const matrix_type& value)
+    {
+        this->resize(size);
+        this->fill(value);
+    }
+
+    // ------------------------ OPERATORS OVERLOADING -------------------------
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, R, C>& MatrixBatch<T, R, C>::operator+=(const MatrixBatch& other)
+    {
+        if(other.m_size != m_size)
+            throw Exeptions::SizeMismatch(m_size, other.m_size);
+        // One "column" per entry, the lanes above size() are skipped.
+        utils::elementWise<utils::ElementOp::Add>(m_size, R*C, data(), m_stride,
+                                                  other.data(), other.m_stride, data(), m_stride);
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, R, C>& MatrixBatch<T, R, C>::operator-=(const MatrixBatch& other)
+    {
+        if(other.m_size != m_size)
+            throw Exeptions::SizeMismatch(m_size, other.m_size);
+        utils::elementWise<utils::ElementOp::Sub>(m_size, R*C, data(), m_stride,
+                                                  other.data(), other.m_stride, data(), m_stride);
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, R, C>& MatrixBatch<T, R, C>::operator*=(T value)
+    {
+        utils::elementWise<utils::ElementOp::Mul>(m_size, R*C, data(), m_stride, value, data(), m_stride);
+        return *this;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, R, C>& MatrixBatch<T, R, C>::operator/=(T value)
+    {
+        utils::elementWise<utils::ElementOp::Div>(m_size, R*C, data(), m_stride, value, data(), m_stride);
+        return *this;
+    }
+
+    // --------------------- ASK INFO MEMBERS (-> const) ----------------------
+    template<class T, std::size_t R, std::size_t C>
+    typename MatrixBatch<T, R, C>::matrix_type MatrixBatch<T, R, C>::get(std::size_t index) const
+    {
+        GEOMETRY_CHECK_INDEX(index, m_size);
+        matrix_type out;
+        for(std::size_t i=0; i<R*C; i++)
+            out.m_data[i] = m_data[i*m_stride + index];
+        return out;
+    }
+
+    // ------------------------ DATA MODIFIER MEMBERS -------------------------
+    template<class T, std::size_t R, std::size_t C>
+    void MatrixBatch<T, R, C>::set(std::size_t index, const matrix_type& value)
+    {
+        GEOMETRY_CHECK_INDEX(index, m_size);
+        for(std::size_t i=0; i<R*C; i++)
+            m_data[i*m_stride + index] = value.m_data[i];
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    void MatrixBatch<T, R, C>::fill(const matrix_type& value)
+    {
+        for(std::size_t i=0; i<R*C; i++)
+            utils::broadcast(m_size, value.m_data[i], data() + i*m_stride);
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    void MatrixBatch<T, R, C>::push_back(const matrix_type& value)
+    {
+        if(m_size == m_stride)
+            this->reallocate(std::max(lanes, 2*m_stride));
+        this->set(m_size++, value);
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    void MatrixBatch<T, R, C>::resize(std::size_t size)
+    {
+        this->reserve(size);
+        for(std::size_t i=0; (i<R*C) && (size > m_size); i++)
+            std::fill(entry(0, 0) + i*m_stride + m_size, entry(0, 0) + i*m_stride + size, static_cast<T>(0));
+        m_size = size;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    void MatrixBatch<T, R, C>::reserve(std::size_t size)
+    {
+        const std::size_t stride = (size + lanes - 1)/lanes*lanes;
+        if(stride > m_stride)
+            this->reallocate(stride);
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    void MatrixBatch<T, R, C>::swap(MatrixBatch& other) noexcept
+    {
+        m_data.swap(other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_stride, other.m_stride);
+    }
+
+    // =========================== PROTECTED METHODS ==========================
+    template<class T, std::size_t R, std::size_t C>
+    void MatrixBatch<T, R, C>::reallocate(std::size_t stride)
+    {
+        std::vector<T, utils::AlignedAllocator<T>> buffer(R*C*stride);
+        for(std::size_t i=0; i<R*C; i++)
+            std::copy_n(data() + i*m_stride, m_size, buffer.data() + i*stride);
+        m_data.swap(buffer);
+        m_stride = stride;
+    }
+
+    namespace utils{
+
+        // --------------------------- BATCH KERNELS --------------------------
+        // Each kernel runs the matrices [first, last) of a batch, V::width at
+        // a time: register lane j holds matrix i + j. Entry e of the matrices
+        // starts at e*stride. first and last are multiples of
+        // MatrixBatch::lanes, so whole registers never leave the buffer. Same
+        // stamping as the element-wise kernels (see matrixSimd), with a plain
+        // scalar copy for the other types.
+#define GEOMETRY_BATCH_KERNELS(NAME, ATTRIBUTE)                                                   \
+        /* a*b - c*d */                                                                           \
+        template<class V>                                                                         \
+        ATTRIBUTE typename V::reg batchMsub##NAME(typename V::reg a, typename V::reg b,           \
+                                                  typename V::reg c, typename V::reg d)           \
+        {                                                                                         \
+            return V::sub(V::mul(a, b), V::mul(c, d));                                            \
+        }                                                                                         \
+                                                                                                  \
+        /* x0*y0 - x1*y1 + x2*y2 */                                                               \
+        template<class V>                                                                         \
+        ATTRIBUTE typename V::reg batchTerm3##NAME(typename V::reg x0, typename V::reg y0,        \
+                                                   typename V::reg x1, typename V::reg y1,        \
+                                                   typename V::reg x2, typename V::reg y2)        \
+        {                                                                                         \
+            return V::fmadd(x2, y2, V::sub(V::mul(x0, y0), V::mul(x1, y1)));                      \
+        }                                                                                         \
+                                                                                                  \
+        /* Operands flagged Fixed are one column-major matrix for the whole batch. */             \
+        template<class V, std::size_t R, std::size_t K, std::size_t C, bool FixedA, bool FixedB>  \
+        ATTRIBUTE void batchMatmul##NAME(const typename V::value_type* a, std::size_t strideA,    \
+                                         const typename V::value_type* b, std::size_t strideB,    \
+                                         typename V::value_type* out, std::size_t strideOut,      \
+                                         std::size_t first, std::size_t last)                     \
+        {                                                                                         \
+            using reg = typename V::reg;                                                          \
+            reg fixedA[FixedA ? R*K : 1];                                                         \
+            reg fixedB[FixedB ? K*C : 1];                                                         \
+            if constexpr (FixedA)                                                                 \
+                for(std::size_t e=0; e<R*K; e++)                                                  \
+                    fixedA[e] = V::set1(a[e]);                                                    \
+            if constexpr (FixedB)                                                                 \
+                for(std::size_t e=0; e<K*C; e++)                                                  \
+                    fixedB[e] = V::set1(b[e]);                                                    \
+            for(std::size_t i=first; i<last; i+=V::width)                                         \
+            {                                                                                     \
+                /* Every entry is loaded before the first store: out may be a or b. */            \
+                reg result[R*C];                                                                  \
+                for(std::size_t col=0; col<C; col++)                                              \
+                    for(std::size_t line=0; line<R; line++)                                       \
+                    {                                                                             \
+                        reg acc = V::set1(static_cast<typename V::value_type>(0));                \
+                        for(std::size_t k=0; k<K; k++)                                            \
+                        {                                                                         \
+                            reg lhs, rhs;                                                         \
+                            if constexpr (FixedA) lhs = fixedA[line + k*R];                       \
+                            else                  lhs = V::load(a + (line + k*R)*strideA + i);    \
+                            if constexpr (FixedB) rhs = fixedB[k + col*K];                        \
+                            else                  rhs = V::load(b + (k + col*K)*strideB + i);     \
+                            acc = V::fmadd(lhs, rhs, acc);                                        \
+                        }                                                                         \
+                        result[line + col*R] = acc;                                               \
+                    }                                                                             \
+                for(std::size_t e=0; e<R*C; e++)                                                  \
+                    V::store(out + e*strideOut + i, result[e]);                                   \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        /* m holds the N*N entries of V::width matrices. */                                       \
+        template<class V, std::size_t N>                                                          \
+        ATTRIBUTE typename V::reg batchDeterminant##NAME(const typename V::reg* m)                \
+        {                                                                                         \
+            const auto a = [m](std::size_t line, std::size_t col) -> const typename V::reg& {     \
+                return m[line + col*N];                                                           \
+            };                                                                                    \
+            if constexpr (N == 1)                                                                 \
+                return a(0,0);                                                                    \
+            else if constexpr (N == 2)                                                            \
+                return batchMsub##NAME<V>(a(0,0), a(1,1), a(0,1), a(1,0));                        \
+            else if constexpr (N == 3)                                                            \
+                return batchTerm3##NAME<V>(                                                       \
+                    a(0,0), batchMsub##NAME<V>(a(1,1), a(2,2), a(1,2), a(2,1)),                   \
+                    a(0,1), batchMsub##NAME<V>(a(1,0), a(2,2), a(1,2), a(2,0)),                   \
+                    a(0,2), batchMsub##NAME<V>(a(1,0), a(2,1), a(1,1), a(2,0)));                  \
+            else                                                                                  \
+            {                                                                                     \
+                /* 2x2 minors of the first two and last two lines. */                             \
+                const typename V::reg s0 = batchMsub##NAME<V>(a(0,0), a(1,1), a(1,0), a(0,1));    \
+                const typename V::reg s1 = batchMsub##NAME<V>(a(0,0), a(1,2), a(1,0), a(0,2));    \
+                const typename V::reg s2 = batchMsub##NAME<V>(a(0,0), a(1,3), a(1,0), a(0,3));    \
+                const typename V::reg s3 = batchMsub##NAME<V>(a(0,1), a(1,2), a(1,1), a(0,2));    \
+                const typename V::reg s4 = batchMsub##NAME<V>(a(0,1), a(1,3), a(1,1), a(0,3));    \
+                const typename V::reg s5 = batchMsub##NAME<V>(a(0,2), a(1,3), a(1,2), a(0,3));    \
+                const typename V::reg c5 = batchMsub##NAME<V>(a(2,2), a(3,3), a(3,2), a(2,3));    \
+                const typename V::reg c4 = batchMsub##NAME<V>(a(2,1), a(3,3), a(3,1), a(2,3));    \
+                const typename V::reg c3 = batchMsub##NAME<V>(a(2,1), a(3,2), a(3,1), a(2,2));    \
+                const typename V::reg c2 = batchMsub##NAME<V>(a(2,0), a(3,3), a(3,0), a(2,3));    \
+                const typename V::reg c1 = batchMsub##NAME<V>(a(2,0), a(3,2), a(3,0), a(2,2));    \
+                const typename V::reg c0 = batchMsub##NAME<V>(a(2,0), a(3,1), a(3,0), a(2,1));    \
+                return V::add(batchTerm3##NAME<V>(s0, c5, s1, c4, s2, c3),                        \
+                              batchTerm3##NAME<V>(s3, c2, s4, c1, s5, c0));                       \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        /* out holds count values, count <= last. */                                              \
+        template<class V, std::size_t N>                                                          \
+        ATTRIBUTE void batchDeterminant##NAME(const typename V::value_type* a, std::size_t stride,\
+                                              std::size_t first, std::size_t last,                \
+                                              std::size_t count, typename V::value_type* out)     \
+        {                                                                                         \
+            for(std::size_t i=first; (i<last) && (i<count); i+=V::width)                          \
+            {                                                                                     \
+                typename V::reg m[N*N];                                                           \
+                for(std::size_t e=0; e<N*N; e++)                                                  \
+                    m[e] = V::load(a + e*stride + i);                                             \
+                const typename V::reg det = batchDeterminant##NAME<V, N>(m);                      \
+                if(i + V::width <= count)                                                         \
+                    V::store(out + i, det);                                                       \
+                else                                                                              \
+                {                                                                                 \
+                    typename V::value_type values[V::width];                                      \
+                    V::store(values, det);                                                        \
+                    std::copy(values, values + (count - i), out + i);                             \
+                }                                                                                 \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        /* Only the lanes below count are real matrices that may be singular. */                  \
+        template<class V, std::size_t N>                                                          \
+        ATTRIBUTE void batchInverse##NAME(const typename V::value_type* a, std::size_t strideA,   \
+                                          typename V::value_type* out, std::size_t strideOut,     \
+                                          std::size_t first, std::size_t last, std::size_t count) \
+        {                                                                                         \
+            using reg = typename V::reg;                                                          \
+            using value_type = typename V::value_type;                                            \
+            for(std::size_t i=first; i<last; i+=V::width)                                         \
+            {                                                                                     \
+                reg m[N*N];                                                                       \
+                for(std::size_t e=0; e<N*N; e++)                                                  \
+                    m[e] = V::load(a + e*strideA + i);                                            \
+                const auto x = [&m](std::size_t line, std::size_t col) -> const reg& {            \
+                    return m[line + col*N];                                                       \
+                };                                                                                \
+                /* Adjugate, without the (-1)^(line+col) signs for N = 2 and 4. */                \
+                reg b[N*N];                                                                       \
+                reg det;                                                                          \
+                if constexpr (N == 1)                                                             \
+                {                                                                                 \
+                    b[0] = V::set1(static_cast<value_type>(1));                                   \
+                    det = x(0,0);                                                                 \
+                }                                                                                 \
+                else if constexpr (N == 2)                                                        \
+                {                                                                                 \
+                    b[0] = x(1,1); b[1] = x(1,0);                                                 \
+                    b[2] = x(0,1); b[3] = x(0,0);                                                 \
+                    det = batchDeterminant##NAME<V, N>(m);                                        \
+                }                                                                                 \
+                else if constexpr (N == 3)                                                        \
+                {                                                                                 \
+                    b[0] = batchMsub##NAME<V>(x(1,1), x(2,2), x(1,2), x(2,1));                    \
+                    b[1] = batchMsub##NAME<V>(x(1,2), x(2,0), x(1,0), x(2,2));                    \
+                    b[2] = batchMsub##NAME<V>(x(1,0), x(2,1), x(1,1), x(2,0));                    \
+                    b[3] = batchMsub##NAME<V>(x(0,2), x(2,1), x(0,1), x(2,2));                    \
+                    b[4] = batchMsub##NAME<V>(x(0,0), x(2,2), x(0,2), x(2,0));                    \
+                    b[5] = batchMsub##NAME<V>(x(0,1), x(2,0), x(0,0), x(2,1));                    \
+                    b[6] = batchMsub##NAME<V>(x(0,1), x(1,2), x(0,2), x(1,1));                    \
+                    b[7] = batchMsub##NAME<V>(x(0,2), x(1,0), x(0,0), x(1,2));                    \
+                    b[8] = batchMsub##NAME<V>(x(0,0), x(1,1), x(0,1), x(1,0));                    \
+                    det = V::fmadd(x(0,0), b[0], V::fmadd(x(0,1), b[1], V::mul(x(0,2), b[2])));   \
+                }                                                                                 \
+                else                                                                              \
+                {                                                                                 \
+                    const reg s0 = batchMsub##NAME<V>(x(0,0), x(1,1), x(1,0), x(0,1));            \
+                    const reg s1 = batchMsub##NAME<V>(x(0,0), x(1,2), x(1,0), x(0,2));            \
+                    const reg s2 = batchMsub##NAME<V>(x(0,0), x(1,3), x(1,0), x(0,3));            \
+                    const reg s3 = batchMsub##NAME<V>(x(0,1), x(1,2), x(1,1), x(0,2));            \
+                    const reg s4 = batchMsub##NAME<V>(x(0,1), x(1,3), x(1,1), x(0,3));            \
+                    const reg s5 = batchMsub##NAME<V>(x(0,2), x(1,3), x(1,2), x(0,3));            \
+                    const reg c5 = batchMsub##NAME<V>(x(2,2), x(3,3), x(3,2), x(2,3));            \
+                    const reg c4 = batchMsub##NAME<V>(x(2,1), x(3,3), x(3,1), x(2,3));            \
+                    const reg c3 = batchMsub##NAME<V>(x(2,1), x(3,2), x(3,1), x(2,2));            \
+                    const reg c2 = batchMsub##NAME<V>(x(2,0), x(3,3), x(3,0), x(2,3));            \
+                    const reg c1 = batchMsub##NAME<V>(x(2,0), x(3,2), x(3,0), x(2,2));            \
+                    const reg c0 = batchMsub##NAME<V>(x(2,0), x(3,1), x(3,0), x(2,1));            \
+                    det = V::add(batchTerm3##NAME<V>(s0, c5, s1, c4, s2, c3),                     \
+                                 batchTerm3##NAME<V>(s3, c2, s4, c1, s5, c0));                    \
+                    b[0]  = batchTerm3##NAME<V>(x(1,1), c5, x(1,2), c4, x(1,3), c3);              \
+                    b[1]  = batchTerm3##NAME<V>(x(1,0), c5, x(1,2), c2, x(1,3), c1);              \
+                    b[2]  = batchTerm3##NAME<V>(x(1,0), c4, x(1,1), c2, x(1,3), c0);              \
+                    b[3]  = batchTerm3##NAME<V>(x(1,0), c3, x(1,1), c1, x(1,2), c0);              \
+                    b[4]  = batchTerm3##NAME<V>(x(0,1), c5, x(0,2), c4, x(0,3), c3);              \
+                    b[5]  = batchTerm3##NAME<V>(x(0,0), c5, x(0,2), c2, x(0,3), c1);              \
+                    b[6]  = batchTerm3##NAME<V>(x(0,0), c4, x(0,1), c2, x(0,3), c0);              \
+                    b[7]  = batchTerm3##NAME<V>(x(0,0), c3, x(0,1), c1, x(0,2), c0);              \
+                    b[8]  = batchTerm3##NAME<V>(x(3,1), s5, x(3,2), s4, x(3,3), s3);              \
+                    b[9]  = batchTerm3##NAME<V>(x(3,0), s5, x(3,2), s2, x(3,3), s1);              \
+                    b[10] = batchTerm3##NAME<V>(x(3,0), s4, x(3,1), s2, x(3,3), s0);              \
+                    b[11] = batchTerm3##NAME<V>(x(3,0), s3, x(3,1), s1, x(3,2), s0);              \
+                    b[12] = batchTerm3##NAME<V>(x(2,1), s5, x(2,2), s4, x(2,3), s3);              \
+                    b[13] = batchTerm3##NAME<V>(x(2,0), s5, x(2,2), s2, x(2,3), s1);              \
+                    b[14] = batchTerm3##NAME<V>(x(2,0), s4, x(2,1), s2, x(2,3), s0);              \
+                    b[15] = batchTerm3##NAME<V>(x(2,0), s3, x(2,1), s1, x(2,2), s0);              \
+                }                                                                                 \
+                value_type values[V::width];                                                      \
+                V::store(values, det);                                                            \
+                for(std::size_t j=0; (j<V::width) && (i + j < count); j++)                        \
+                    if(values[j] == static_cast<value_type>(0))                                   \
+                        throw Exeptions::SingularMatrix();                                        \
+                const reg inv = V::div(V::set1(static_cast<value_type>(1)), det);                 \
+                const reg negInv = V::sub(V::set1(static_cast<value_type>(0)), inv);              \
+                for(std::size_t line=0; line<N; line++)                                           \
+                    for(std::size_t col=0; col<N; col++)                                          \
+                    {                                                                             \
+                        const bool negative = (N != 3) && ((line + col)%2 == 1);                  \
+                        V::store(out + (line + col*N)*strideOut + i,                              \
+                                 V::mul(b[line + col*N], negative ? negInv : inv));               \
+                    }                                                                             \
+            }                                                                                     \
+        }
+
+        GEOMETRY_BATCH_KERNELS(Scalar, )
+#ifdef GEOMETRY_X86_SIMD
+        GEOMETRY_BATCH_KERNELS(Sse2, __attribute__((target("sse2"))))
+        GEOMETRY_BATCH_KERNELS(Avx2, __attribute__((target("avx2,fma"))))
+        GEOMETRY_BATCH_KERNELS(Avx512, __attribute__((target("avx512f"))))
+#endif
+#undef GEOMETRY_BATCH_KERNELS
+
+        // ------------------------------- DISPATCH ---------------------------
+        template<typename T, std::size_t R, std::size_t K, std::size_t C, bool FixedA, bool FixedB>
+        void batchMatmulSerial(const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+                               T* out, std::size_t strideOut, std::size_t first, std::size_t last)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return batchMatmulAvx512<SimdVector<Isa::Avx512, T>, R, K, C, FixedA, FixedB>(a, strideA, b, strideB, out, strideOut, first, last);
+                    case Isa::Avx2:   return batchMatmulAvx2<SimdVector<Isa::Avx2, T>, R, K, C, FixedA, FixedB>(a, strideA, b, strideB, out, strideOut, first, last);
+                    case Isa::Sse2:   return batchMatmulSse2<SimdVector<Isa::Sse2, T>, R, K, C, FixedA, FixedB>(a, strideA, b, strideB, out, strideOut, first, last);
+                    default: break;
+                }
+#endif
+            batchMatmulScalar<ScalarVector<T>, R, K, C, FixedA, FixedB>(a, strideA, b, strideB, out, strideOut, first, last);
+        }
+
+        template<typename T, std::size_t N>
+        void batchDeterminantSerial(const T* a, std::size_t stride, std::size_t first,
+                                    std::size_t last, std::size_t count, T* out)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return batchDeterminantAvx512<SimdVector<Isa::Avx512, T>, N>(a, stride, first, last, count, out);
+                    case Isa::Avx2:   return batchDeterminantAvx2<SimdVector<Isa::Avx2, T>, N>(a, stride, first, last, count, out);
+                    case Isa::Sse2:   return batchDeterminantSse2<SimdVector<Isa::Sse2, T>, N>(a, stride, first, last, count, out);
+                    default: break;
+                }
+#endif
+            batchDeterminantScalar<ScalarVector<T>, N>(a, stride, first, last, count, out);
+        }
+
+        template<typename T, std::size_t N>
+        void batchInverseSerial(const T* a, std::size_t strideA, T* out, std::size_t strideOut,
+                                std::size_t first, std::size_t last, std::size_t count)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return batchInverseAvx512<SimdVector<Isa::Avx512, T>, N>(a, strideA, out, strideOut, first, last, count);
+                    case Isa::Avx2:   return batchInverseAvx2<SimdVector<Isa::Avx2, T>, N>(a, strideA, out, strideOut, first, last, count);
+                    case Isa::Sse2:   return batchInverseSse2<SimdVector<Isa::Sse2, T>, N>(a, strideA, out, strideOut, first, last, count);
+                    default: break;
+                }
+#endif
+            batchInverseScalar<ScalarVector<T>, N>(a, strideA, out, strideOut, first, last, count);
+        }
+
+        // Cache lines of matrices, one range of them per thread.
+        template<std::size_t Lanes, class Body>
+        void batchFor(std::size_t size, std::size_t work, Body body)
+        {
+            parallelFor((size + Lanes - 1)/Lanes, work, [&](std::size_t first, std::size_t last){
+                body(first*Lanes, last*Lanes);
+            });
+        }
+
+    }
+
+    // ============================ FREE FUNCTIONS ============================
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    void matmul(const MatrixBatch<T, R, K>& A, const MatrixBatch<T, K, C>& B, MatrixBatch<T, R, C>& out)
+    {
+        if(A.size() != B.size())
+            throw Exeptions::SizeMismatch(A.size(), B.size());
+        out.resize(A.size());
+        utils::batchFor<MatrixBatch<T, R, C>::lanes>(A.size(), A.size()*R*K*C, [&](std::size_t first, std::size_t last){
+            utils::batchMatmulSerial<T, R, K, C, false, false>(A.data(), A.stride(), B.data(), B.stride(),
+                                                               out.data(), out.stride(), first, last);
+        });
+    }
+
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    void matmul(const FixedMatrix<T, R, K>& A, const MatrixBatch<T, K, C>& B, MatrixBatch<T, R, C>& out)
+    {
+        out.resize(B.size());
+        utils::batchFor<MatrixBatch<T, R, C>::lanes>(B.size(), B.size()*R*K*C, [&](std::size_t first, std::size_t last){
+            utils::batchMatmulSerial<T, R, K, C, true, false>(A.data(), 0, B.data(), B.stride(),
+                                                              out.data(), out.stride(), first, last);
+        });
+    }
+
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    void matmul(const MatrixBatch<T, R, K>& A, const FixedMatrix<T, K, C>& B, MatrixBatch<T, R, C>& out)
+    {
+        out.resize(A.size());
+        utils::batchFor<MatrixBatch<T, R, C>::lanes>(A.size(), A.size()*R*K*C, [&](std::size_t first, std::size_t last){
+            utils::batchMatmulSerial<T, R, K, C, false, true>(A.data(), A.stride(), B.data(), 0,
+                                                              out.data(), out.stride(), first, last);
+        });
+    }
+
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    MatrixBatch<T, R, C> matmul(const MatrixBatch<T, R, K>& A, const MatrixBatch<T, K, C>& B)
+    {
+        MatrixBatch<T, R, C> out;
+        matmul(A, B, out);
+        return out;
+    }
+
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    MatrixBatch<T, R, C> matmul(const FixedMatrix<T, R, K>& A, const MatrixBatch<T, K, C>& B)
+    {
+        MatrixBatch<T, R, C> out;
+        matmul(A, B, out);
+        return out;
+    }
+
+    template<class T, std::size_t R, std::size_t K, std::size_t C>
+    MatrixBatch<T, R, C> matmul(const MatrixBatch<T, R, K>& A, const FixedMatrix<T, K, C>& B)
+    {
+        MatrixBatch<T, R, C> out;
+        matmul(A, B, out);
+        return out;
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    void transpose(const MatrixBatch<T, R, C>& batch, MatrixBatch<T, C, R>& out)
+    {
+        // Whole entry arrays move, nothing to vectorize across lanes.
+        if constexpr (R == C)
+            if(&batch == &out)
+            {
+                for(std::size_t col=1; col<C; col++)
+                    for(std::size_t line=0; line<col; line++)
+                        std::swap_ranges(out.entry(line, col), out.entry(line, col) + out.size(),
+                                         out.entry(col, line));
+                return;
+            }
+        out.resize(batch.size());
+        utils::parallelFor(R*C, R*C*batch.size(), [&](std::size_t first, std::size_t last){
+            for(std::size_t e=first; e<last; e++)
+                std::copy_n(batch.entry(e%R, e/R), batch.size(), out.entry(e/R, e%R));
+        });
+    }
+
+    template<class T, std::size_t R, std::size_t C>
+    MatrixBatch<T, C, R> transpose(const MatrixBatch<T, R, C>& batch)
+    {
+        MatrixBatch<T, C, R> out;
+        transpose(batch, out);
+        return out;
+    }
+
+    template<class T, std::size_t N>
+    void determinant(const MatrixBatch<T, N, N>& batch, T* out)
+    {
+        static_assert(N <= 4, "batched determinant() has closed forms up to 4x4");
+        utils::batchFor<MatrixBatch<T, N, N>::lanes>(batch.size(), batch.size()*N*N*N, [&](std::size_t first, std::size_t last){
+            utils::batchDeterminantSerial<T, N>(batch.data(), batch.stride(), first, last, batch.size(), out);
+        });
+    }
+
+    template<class T, std::size_t N>
+    std::vector<T> determinant(const MatrixBatch<T, N, N>& batch)
+    {
+        std::vector<T> out(batch.size());
+        determinant(batch, out.data());
+        return out;
+    }
+
+    template<class T, std::size_t N>
+    void inverse(const MatrixBatch<T, N, N>& batch, MatrixBatch<T, N, N>& out)
+    {
+        static_assert(std::is_floating_point_v<T>, "inverse() needs a floating point matrix");
+        static_assert(N <= 4, "batched inverse() has closed forms up to 4x4");
+        out.resize(batch.size());
+        utils::batchFor<MatrixBatch<T, N, N>::lanes>(batch.size(), batch.size()*N*N*N, [&](std::size_t first, std::size_t last){
+            utils::batchInverseSerial<T, N>(batch.data(), batch.stride(), out.data(), out.stride(),
+                                            first, last, batch.size());
+        });
+    }
+
+    template<class T, std::size_t N>
+    MatrixBatch<T, N, N> inverse(const MatrixBatch<T, N, N>& batch)
+    {
+        MatrixBatch<T, N, N> out;
+        inverse(batch, out);
+        return out;
+    }
+
+}
+
+#endif
@@ -0,0 +1,483 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXEXPRESSIONS_DECL__GUARD__2610
+#define GEOMETRY__MATRIXEXPRESSIONS_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "exceptions.hpp"
+#include "matrixSimd.decl.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // Lazy matrix expressions.
+        // Every math operator returns a small node holding its operands by
+        // value. Nothing is computed until the tree is assigned to a Matrix,
+        // which then evaluates it in a single loop (one pass, no temporary,
+        // no virtual call and no bounds check per element).
+        //
+        // A node exposes:
+        //  - value_type                 -> type of one evaluated element
+        //  - isElementWise              -> element (i,j) only reads (i,j)
+        //  - nLines() / nColumns()
+        //  - operator()(line, col)      -> unchecked element evaluation
+        //  - references(first, last)    -> true if a leaf reads memory in
+        //                                  [first, last)
+        //  - broadcastTo(nLines, nCols) -> same node stretched to a bigger
+        //                                  shape (see BROADCASTING)
+
+        // ----------------------------- BROADCASTING -------------------------
+        // NumPy rules on two dimensions: the operands of a binary node must
+        // have equal dimensions, or a dimension of 1 that is repeated to the
+        // size of the other one. A column vector plus a matrix adds it to
+        // every column, a row vector to every line, a 1 x 1 matrix to every
+        // element. Nothing is expanded: a stretched leaf reads the same
+        // elements again through a stride of 0.
+        inline bool broadcastsTo(std::size_t from, std::size_t to)
+        {
+            return (from == to) || (from == 1);
+        }
+
+        // Shape of lhs op rhs.
+        // -> Exceptions::SizeMismatch()
+        template<class L, class R>
+        std::pair<std::size_t, std::size_t> broadcastShape(const L& lhs, const R& rhs);
+
+        // True if memory ranges [first1, last1) and [first2, last2) overlap.
+        inline bool overlaps(const void* first1, const void* last1,
+                             const void* first2, const void* last2)
+        {
+            const std::less<const void*> before{};
+            return before(first1, last2) && before(first2, last1);
+        }
+
+        // CRTP base, only used to recognise expressions in overloads.
+        template<class E>
+        class MatrixExpression
+        {
+        public:
+            const E& self() const {return static_cast<const E&>(*this);}
+        };
+
+        // ---------------------------- LEAF NODES ----------------------------
+        // Non-owning reference to a column-major buffer whose columns start
+        // every lead elements (lead == line when there is no padding).
+        // Broadcast, it repeats its single line (lineStride 0) or its single
+        // column (lead 0). Still element-wise: a stretched leaf is smaller
+        // than the destination, so it never is the destination matrix.
+        template<class T>
+        class MatrixOperand: public MatrixExpression<MatrixOperand<T>>
+        {
+        protected:
+            const T* mp_data{};
+            std::size_t m_nLines{};
+            std::size_t m_nColumns{};
+            std::size_t m_lead{};
+            std::size_t m_lineStride{1};
+
+        public:
+            using value_type = T;
+            static constexpr bool isElementWise = true;
+
+            MatrixOperand(const T* data, std::size_t line, std::size_t col):
+                MatrixOperand(data, line, col, line)
+                {}
+
+            MatrixOperand(const T* data, std::size_t line, std::size_t col, std::size_t lead,
+                          std::size_t lineStride = 1):
+                mp_data{data},
+                m_nLines{line},
+                m_nColumns{col},
+                m_lead{lead},
+                m_lineStride{lineStride}
+                {}
+
+            std::size_t nLines()   const {return m_nLines;}
+            std::size_t nColumns() const {return m_nColumns;}
+
+            T operator()(std::size_t line, std::size_t col) const {
+                return mp_data[line*m_lineStride + col*m_lead];
+            }
+            bool references(const void* first, const void* last) const {
+                if((m_nLines == 0) || (m_nColumns == 0))
+                    return false;
+                const T* end = mp_data + (m_nLines-1)*m_lineStride + (m_nColumns-1)*m_lead + 1;
+                return overlaps(mp_data, end, first, last);
+            }
+            MatrixOperand broadcastTo(std::size_t line, std::size_t col) const {
+                return {mp_data, line, col, (col == m_nColumns) ? m_lead : 0,
+                        (line == m_nLines) ? m_lineStride : 0};
+            }
+
+            const T* data() const {return mp_data;}
+            std::size_t lead() const {return m_lead;}
+            std::size_t lineStride() const {return m_lineStride;}
+            // A plain padded buffer, as the contiguous kernels expect.
+            bool isBroadcast() const {return (m_lineStride != 1) || (m_lead < m_nLines);}
+        };
+
+        // Non-owning reference to any strided buffer (views): element
+        // (line, col) lives at data[line*lineStride + col*columnStride].
+        // It may read its buffer at other coordinates than the destination
+        // (e.g. a transposed view of it), hence not element-wise.
+        template<class T>
+        class StridedOperand: public MatrixExpression<StridedOperand<T>>
+        {
+        protected:
+            const T* mp_data{};
+            std::size_t m_nLines{};
+            std::size_t m_nColumns{};
+            std::size_t m_lineStride{};
+            std::size_t m_columnStride{};
+
+        public:
+            using value_type = T;
+            static constexpr bool isElementWise = false;
+
+            StridedOperand(const T* data, std::size_t line, std::size_t col,
+                           std::size_t lineStride, std::size_t columnStride):
+                mp_data{data},
+                m_nLines{line},
+                m_nColumns{col},
+                m_lineStride{lineStride},
+                m_columnStride{columnStride}
+                {}
+
+            std::size_t nLines()   const {return m_nLines;}
+            std::size_t nColumns() const {return m_nColumns;}
+
+            T operator()(std::size_t line, std::size_t col) const {
+                return mp_data[line*m_lineStride + col*m_columnStride];
+            }
+            bool references(const void* first, const void* last) const {
+                if((m_nLines == 0) || (m_nColumns == 0))
+                    return false;
+                const T* end = mp_data + (m_nLines-1)*m_lineStride + (m_nColumns-1)*m_columnStride + 1;
+                return overlaps(mp_data, end, first, last);
+            }
+            StridedOperand broadcastTo(std::size_t line, std::size_t col) const {
+                return {mp_data, line, col, (line == m_nLines) ? m_lineStride : 0,
+                        (col == m_nColumns) ? m_columnStride : 0};
+            }
+
+            const T* data() const {return mp_data;}
+            std::size_t lineStride()   const {return m_lineStride;}
+            std::size_t columnStride() const {return m_columnStride;}
+        };
+
+        // Single value seen as a matrix of the same shape as the other operand.
+        template<class T>
+        class ScalarOperand: public MatrixExpression<ScalarOperand<T>>
+        {
+        protected:
+            T m_value{};
+            std::size_t m_nLines{};
+            std::size_t m_nColumns{};
+
+        public:
+            using value_type = T;
+            static constexpr bool isElementWise = true;
+
+            ScalarOperand(T value, std::size_t line, std::size_t col):
+                m_value{value},
+                m_nLines{line},
+                m_nColumns{col}
+                {}
+
+            std::size_t nLines()   const {return m_nLines;}
+            std::size_t nColumns() const {return m_nColumns;}
+
+            T operator()(std::size_t, std::size_t) const {return m_value;}
+            bool references(const void*, const void*) const {return false;}
+            ScalarOperand broadcastTo(std::size_t line, std::size_t col) const {
+                return {m_value, line, col};
+            }
+
+            T value() const {return m_value;}
+        };
+
+        // ---------------------------- INNER NODES ---------------------------
+        // Element-wise binary operation, Op being one of the std functors.
+        // Operands of different shapes are broadcast (see broadcastShape).
+        template<class Op, class L, class R>
+        class BinaryExpression: public MatrixExpression<BinaryExpression<Op, L, R>>
+        {
+        protected:
+            L m_lhs;
+            R m_rhs;
+
+        public:
+            using value_type = decltype(std::declval<Op>()(
+                std::declval<typename L::value_type>(),
+                std::declval<typename R::value_type>()));
+            static constexpr bool isElementWise = L::isElementWise && R::isElementWise;
+
+            // -> Exceptions::SizeMismatch()
+            BinaryExpression(const L& lhs, const R& rhs);
+
+            std::size_t nLines()   const {return m_lhs.nLines();}
+            std::size_t nColumns() const {return m_lhs.nColumns();}
+
+            value_type operator()(std::size_t line, std::size_t col) const {
+                return Op{}(m_lhs(line, col), m_rhs(line, col));
+            }
+            bool references(const void* first, const void* last) const {
+                return m_lhs.references(first, last) || m_rhs.references(first, last);
+            }
+            BinaryExpression broadcastTo(std::size_t line, std::size_t col) const {
+                return {m_lhs.broadcastTo(line, col), m_rhs.broadcastTo(line, col)};
+            }
+
+            const L& lhs() const {return m_lhs;}
+            const R& rhs() const {return m_rhs;}
+
+        private:
+            BinaryExpression(const L& lhs, const R& rhs, std::pair<std::size_t, std::size_t> shape);
+        };
+
+        // Swap lines and columns of the inner expression.
+        template<class E>
+        class TransposeExpression: public MatrixExpression<TransposeExpression<E>>
+        {
+        protected:
+            E m_expr;
+
+        public:
+            using value_type = typename E::value_type;
+            static constexpr bool isElementWise = false;
+
+            explicit TransposeExpression(const E& expr): m_expr{expr} {}
+
+            std::size_t nLines()   const {return m_expr.nColumns();}
+            std::size_t nColumns() const {return m_expr.nLines();}
+
+            value_type operator()(std::size_t line, std::size_t col) const {
+                return m_expr(col, line);
+            }
+            bool references(const void* first, const void* last) const {
+                return m_expr.references(first, last);
+            }
+            TransposeExpression broadcastTo(std::size_t line, std::size_t col) const {
+                return TransposeExpression(m_expr.broadcastTo(col, line));
+            }
+
+            const E& inner() const {return m_expr;}
+        };
+
+        // ----------------------------- TRANSPOSITION ------------------------
+        // transpose(expr) pushed down to the leaves: the transpose of a + b
+        // is transpose(a) + transpose(b) and the transpose of a transpose is
+        // the inner expression. Leaves that cannot absorb it (matrices) are
+        // wrapped in a TransposeExpression.
+        template<class E>
+        struct TransposedOperand
+        {
+            using type = TransposeExpression<E>;
+            static type make(const E& expr) {return type(expr);}
+        };
+
+        template<class E>
+        using transposed_t = typename TransposedOperand<E>::type;
+
+        template<class E>
+        transposed_t<E> transposed(const E& expr) {
+            return TransposedOperand<E>::make(expr);
+        }
+
+        template<class E>
+        struct TransposedOperand<TransposeExpression<E>>
+        {
+            using type = E;
+            static const E& make(const TransposeExpression<E>& expr) {return expr.inner();}
+        };
+
+        template<class Op, class L, class R>
+        struct TransposedOperand<BinaryExpression<Op, L, R>>
+        {
+            using type = BinaryExpression<Op, transposed_t<L>, transposed_t<R>>;
+            static type make(const BinaryExpression<Op, L, R>& expr) {
+                return type(transposed(expr.lhs()), transposed(expr.rhs()));
+            }
+        };
+
+        template<class T>
+        struct TransposedOperand<ScalarOperand<T>>
+        {
+            using type = ScalarOperand<T>;
+            static type make(const ScalarOperand<T>& expr) {
+                return type(expr.value(), expr.nColumns(), expr.nLines());
+            }
+        };
+
+        template<class T>
+        struct TransposedOperand<StridedOperand<T>>
+        {
+            using type = StridedOperand<T>;
+            static type make(const StridedOperand<T>& expr) {
+                return type(expr.data(), expr.nColumns(), expr.nLines(),
+                            expr.columnStride(), expr.lineStride());
+            }
+        };
+
+        // ------------------------- OPERAND SELECTION ------------------------
+        // How an expression is stored inside a parent node: nodes are copied
+        // as they are, matrices are replaced by a MatrixOperand leaf. A
+        // row-major matrix is the transpose of the column-major buffer it
+        // stores, so two row-major leaves under a row-major destination
+        // cancel out (see makeStorageOperand) into plain MatrixOperand.
+        template<class E>
+        struct ExpressionOperand
+        {
+            using type = E;
+            static const E& make(const MatrixExpression<E>& expr) {return expr.self();}
+        };
+
+        template<class T, class Alloc, Layout Order>
+        struct ExpressionOperand<Matrix<T, Alloc, Order>>
+        {
+            using type = std::conditional_t<Order == Layout::ColumnMajor,
+                                            MatrixOperand<T>,
+                                            TransposeExpression<MatrixOperand<T>>>;
+            static type make(const MatrixExpression<Matrix<T, Alloc, Order>>& expr);
+        };
+
+        template<class E>
+        using operand_t = typename ExpressionOperand<E>::type;
+
+        template<class E>
+        operand_t<E> makeOperand(const MatrixExpression<E>& expr) {
+            return ExpressionOperand<E>::make(expr);
+        }
+
+        // expr as read in the storage order of Order: itself for column-major
+        // buffers, its transpose for row-major ones, whose storage is then
+        // filled by the column-major kernels below.
+        template<Layout Order, class E>
+        using storage_operand_t = std::conditional_t<Order == Layout::ColumnMajor,
+                                                     operand_t<E>,
+                                                     transposed_t<operand_t<E>>>;
+
+        template<Layout Order, class E>
+        storage_operand_t<Order, E> makeStorageOperand(const MatrixExpression<E>& expr);
+
+        // ---------------------------- EVALUATION ----------------------------
+        // Plain assignment out = value, with conversion to the output type.
+        struct AssignOp
+        {
+            template<class T, class U>
+            void operator()(T& out, const U& value) const {out = static_cast<T>(value);}
+        };
+
+        // Run expr over a column-major nLines x nColumns buffer, calling
+        // assign(out[i], expr(line, col)) for every element. Big buffers are
+        // split across threads (see matrixParallel.decl.hpp).
+        template<class E, class T, class Assign>
+        void evaluate(const E& expr, T* out, Assign assign);
+
+        // Same when the columns of out start every lead elements (padded
+        // matrix, see Matrix::leadingDimension()).
+        template<class E, class T, class Assign>
+        void evaluate(const E& expr, T* out, std::size_t lead, Assign assign);
+
+        // Same over a strided buffer: element (line, col) of the output is
+        // out[line*lineStride + col*columnStride].
+        template<class E, class T, class Assign>
+        void evaluate(const E& expr, T* out, std::size_t lineStride,
+                      std::size_t columnStride, Assign assign);
+
+        // out = transpose(matrix): goes through the tiled transpose kernel
+        // (a broadcast matrix through the generic loop).
+        template<class T>
+        void evaluate(const TransposeExpression<MatrixOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp assign);
+
+        // out = a op b, a op value and value op b: one contiguous pass
+        // through the SIMD element-wise kernels (see matrixSimd.decl.hpp),
+        // one pass per column when a matrix is padded or broadcast.
+        template<class Op, class T>
+        void evaluate(const BinaryExpression<Op, MatrixOperand<T>, MatrixOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp assign);
+
+        template<class Op, class T>
+        void evaluate(const BinaryExpression<Op, MatrixOperand<T>, ScalarOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp assign);
+
+        template<class Op, class T>
+        void evaluate(const BinaryExpression<Op, ScalarOperand<T>, MatrixOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp assign);
+
+        // Kernel matching each std functor.
+        template<class Op> struct ElementOpOf;
+        template<> struct ElementOpOf<std::plus<>>       {static constexpr ElementOp value = ElementOp::Add;};
+        template<> struct ElementOpOf<std::minus<>>      {static constexpr ElementOp value = ElementOp::Sub;};
+        template<> struct ElementOpOf<std::multiplies<>> {static constexpr ElementOp value = ElementOp::Mul;};
+        template<> struct ElementOpOf<std::divides<>>    {static constexpr ElementOp value = ElementOp::Div;};
+
+        // ------------------------ OPERATORS OVERLOADING ---------------------
+        // Defined next to the nodes so that argument dependent lookup finds
+        // them for both Matrix and expression arguments.
+        template<class L, class R>
+        BinaryExpression<std::plus<>, operand_t<L>, operand_t<R>>
+        operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+
+        template<class L, class R>
+        BinaryExpression<std::minus<>, operand_t<L>, operand_t<R>>
+        operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+
+        template<class L, class R>
+        BinaryExpression<std::multiplies<>, operand_t<L>, operand_t<R>>
+        operator*(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+
+        template<class L, class R>
+        BinaryExpression<std::divides<>, operand_t<L>, operand_t<R>>
+        operator/(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+
+        // -> Math operations with single value (converted to the matrix type)
+        template<class E>
+        BinaryExpression<std::plus<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator+(const MatrixExpression<E>& lhs, const typename E::value_type& rhs);
+
+        template<class E>
+        BinaryExpression<std::minus<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator-(const MatrixExpression<E>& lhs, const typename E::value_type& rhs);
+
+        template<class E>
+        BinaryExpression<std::multiplies<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator*(const MatrixExpression<E>& lhs, const typename E::value_type& rhs);
+
+        template<class E>
+        BinaryExpression<std::divides<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator/(const MatrixExpression<E>& lhs, const typename E::value_type& rhs);
+
+        template<class E>
+        BinaryExpression<std::plus<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator+(const typename E::value_type& lhs, const MatrixExpression<E>& rhs);
+
+        template<class E>
+        BinaryExpression<std::minus<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator-(const typename E::value_type& lhs, const MatrixExpression<E>& rhs);
+
+        template<class E>
+        BinaryExpression<std::multiplies<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator*(const typename E::value_type& lhs, const MatrixExpression<E>& rhs);
+
+        template<class E>
+        BinaryExpression<std::divides<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator/(const typename E::value_type& lhs, const MatrixExpression<E>& rhs);
+
+    }
+}
+
+#endif
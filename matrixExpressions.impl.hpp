@@ -0,0 +1,258 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXEXPRESSIONS_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXEXPRESSIONS_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+// LOCAL INCLUDES
+#include "matrixExpressions.decl.hpp"
+#include "exceptions.hpp"
+#include "matrixTranspose.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // ----------------------------- BROADCASTING -------------------------
+        template<class L, class R>
+        std::pair<std::size_t, std::size_t> broadcastShape(const L& lhs, const R& rhs)
+        {
+            const std::size_t nLines = (lhs.nLines() == 1) ? rhs.nLines() : lhs.nLines();
+            const std::size_t nColumns = (lhs.nColumns() == 1) ? rhs.nColumns() : lhs.nColumns();
+            if(!broadcastsTo(lhs.nLines(), nLines) || !broadcastsTo(rhs.nLines(), nLines)
+               || !broadcastsTo(lhs.nColumns(), nColumns) || !broadcastsTo(rhs.nColumns(), nColumns))
+                throw Exeptions::SizeMismatch(lhs.nLines()*lhs.nColumns(),
+                                              rhs.nLines()*rhs.nColumns());
+            return {nLines, nColumns};
+        }
+
+        // ----------------------------- CONSTRUCTORS -------------------------
+        template<class Op, class L, class R>
+        BinaryExpression<Op, L, R>::BinaryExpression(const L& lhs, const R& rhs):
+            BinaryExpression(lhs, rhs, broadcastShape(lhs, rhs))
+            {}
+
+        template<class Op, class L, class R>
+        BinaryExpression<Op, L, R>::BinaryExpression(const L& lhs, const R& rhs,
+                                                     std::pair<std::size_t, std::size_t> shape):
+            m_lhs{lhs.broadcastTo(shape.first, shape.second)},
+            m_rhs{rhs.broadcastTo(shape.first, shape.second)}
+            {}
+
+        template<class T, class Alloc, Layout Order>
+        typename ExpressionOperand<Matrix<T, Alloc, Order>>::type
+        ExpressionOperand<Matrix<T, Alloc, Order>>::make(const MatrixExpression<Matrix<T, Alloc, Order>>& expr)
+        {
+            const Matrix<T, Alloc, Order>& mat = expr.self();
+            if constexpr (Order == Layout::ColumnMajor)
+                return type(mat.data(), mat.nLines(), mat.nColumns(), mat.leadingDimension());
+            else
+                return type(MatrixOperand<T>(mat.data(), mat.nColumns(), mat.nLines(),
+                                             mat.leadingDimension()));
+        }
+
+        template<Layout Order, class E>
+        storage_operand_t<Order, E> makeStorageOperand(const MatrixExpression<E>& expr)
+        {
+            if constexpr (Order == Layout::ColumnMajor)
+                return makeOperand(expr);
+            else
+                return transposed(makeOperand(expr));
+        }
+
+        // ------------------------------ EVALUATION --------------------------
+        template<class E, class T, class Assign>
+        void evaluate(const E& expr, T* out, Assign assign)
+        {
+            evaluate(expr, out, expr.nLines(), assign);
+        }
+
+        template<class E, class T, class Assign>
+        void evaluate(const E& expr, T* out, std::size_t lead, Assign assign)
+        {
+            const std::size_t nLines = expr.nLines();
+            if((lead != nLines) && (expr.nColumns() > 1))
+                return evaluate(expr, out, 1, lead, assign);
+            const std::size_t length = nLines*expr.nColumns();
+            // Threads get contiguous element ranges, which may start and end
+            // in the middle of a column.
+            parallelFor(length, length, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first/nLines; col*nLines<last; col++)
+                {
+                    T* column = out + col*nLines;
+                    const std::size_t begin = std::max(first, col*nLines) - col*nLines;
+                    const std::size_t end = std::min(last, (col+1)*nLines) - col*nLines;
+                    for(std::size_t line=begin; line<end; line++)
+                        assign(column[line], expr(line, col));
+                }
+            });
+        }
+
+        template<class E, class T, class Assign>
+        void evaluate(const E& expr, T* out, std::size_t lineStride,
+                      std::size_t columnStride, Assign assign)
+        {
+            const std::size_t nLines = expr.nLines();
+            const std::size_t nColumns = expr.nColumns();
+            parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                {
+                    T* column = out + col*columnStride;
+                    for(std::size_t line=0; line<nLines; line++)
+                        assign(column[line*lineStride], expr(line, col));
+                }
+            });
+        }
+
+        template<class T>
+        void evaluate(const TransposeExpression<MatrixOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp assign)
+        {
+            const MatrixOperand<T>& src = expr.inner();
+            if(src.isBroadcast())
+                return evaluate<TransposeExpression<MatrixOperand<T>>, T, AssignOp>(expr, out, lead, assign);
+            transpose(src.nLines(), src.nColumns(), src.data(), src.lead(), out, lead);
+        }
+
+        // A value is a 1 x 1 matrix broadcast with strides 0.
+        template<class Op, class T>
+        void evaluate(const BinaryExpression<Op, MatrixOperand<T>, MatrixOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp)
+        {
+            const MatrixOperand<T>& a = expr.lhs();
+            const MatrixOperand<T>& b = expr.rhs();
+            elementWise<ElementOpOf<Op>::value>(expr.nLines(), expr.nColumns(),
+                                               a.data(), a.lineStride(), a.lead(),
+                                               b.data(), b.lineStride(), b.lead(), out, lead);
+        }
+
+        template<class Op, class T>
+        void evaluate(const BinaryExpression<Op, MatrixOperand<T>, ScalarOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp)
+        {
+            const MatrixOperand<T>& a = expr.lhs();
+            const T value = expr.rhs().value();
+            elementWise<ElementOpOf<Op>::value>(expr.nLines(), expr.nColumns(),
+                                               a.data(), a.lineStride(), a.lead(),
+                                               &value, 0, 0, out, lead);
+        }
+
+        template<class Op, class T>
+        void evaluate(const BinaryExpression<Op, ScalarOperand<T>, MatrixOperand<T>>& expr, T* out,
+                      std::size_t lead, AssignOp)
+        {
+            const T value = expr.lhs().value();
+            const MatrixOperand<T>& b = expr.rhs();
+            elementWise<ElementOpOf<Op>::value>(expr.nLines(), expr.nColumns(), &value, 0, 0,
+                                               b.data(), b.lineStride(), b.lead(), out, lead);
+        }
+
+        // ------------------------ OPERATORS OVERLOADING ---------------------
+        template<class L, class R>
+        BinaryExpression<std::plus<>, operand_t<L>, operand_t<R>>
+        operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+        {
+            return {makeOperand(lhs), makeOperand(rhs)};
+        }
+
+        template<class L, class R>
+        BinaryExpression<std::minus<>, operand_t<L>, operand_t<R>>
+        operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+        {
+            return {makeOperand(lhs), makeOperand(rhs)};
+        }
+
+        template<class L, class R>
+        BinaryExpression<std::multiplies<>, operand_t<L>, operand_t<R>>
+        operator*(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+        {
+            return {makeOperand(lhs), makeOperand(rhs)};
+        }
+
+        template<class L, class R>
+        BinaryExpression<std::divides<>, operand_t<L>, operand_t<R>>
+        operator/(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+        {
+            return {makeOperand(lhs), makeOperand(rhs)};
+        }
+
+        // -> Math operations with single value
+        template<class E>
+        BinaryExpression<std::plus<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator+(const MatrixExpression<E>& lhs, const typename E::value_type& rhs)
+        {
+            auto mat = makeOperand(lhs);
+            return {mat, {rhs, mat.nLines(), mat.nColumns()}};
+        }
+
+        template<class E>
+        BinaryExpression<std::minus<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator-(const MatrixExpression<E>& lhs, const typename E::value_type& rhs)
+        {
+            auto mat = makeOperand(lhs);
+            return {mat, {rhs, mat.nLines(), mat.nColumns()}};
+        }
+
+        template<class E>
+        BinaryExpression<std::multiplies<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator*(const MatrixExpression<E>& lhs, const typename E::value_type& rhs)
+        {
+            auto mat = makeOperand(lhs);
+            return {mat, {rhs, mat.nLines(), mat.nColumns()}};
+        }
+
+        template<class E>
+        BinaryExpression<std::divides<>, operand_t<E>, ScalarOperand<typename E::value_type>>
+        operator/(const MatrixExpression<E>& lhs, const typename E::value_type& rhs)
+        {
+            auto mat = makeOperand(lhs);
+            return {mat, {rhs, mat.nLines(), mat.nColumns()}};
+        }
+
+        template<class E>
+        BinaryExpression<std::plus<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator+(const typename E::value_type& lhs, const MatrixExpression<E>& rhs)
+        {
+            auto mat = makeOperand(rhs);
+            return {{lhs, mat.nLines(), mat.nColumns()}, mat};
+        }
+
+        template<class E>
+        BinaryExpression<std::minus<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator-(const typename E::value_type& lhs, const MatrixExpression<E>& rhs)
+        {
+            auto mat = makeOperand(rhs);
+            return {{lhs, mat.nLines(), mat.nColumns()}, mat};
+        }
+
+        template<class E>
+        BinaryExpression<std::multiplies<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator*(const typename E::value_type& lhs, const MatrixExpression<E>& rhs)
+        {
+            auto mat = makeOperand(rhs);
+            return {{lhs, mat.nLines(), mat.nColumns()}, mat};
+        }
+
+        template<class E>
+        BinaryExpression<std::divides<>, ScalarOperand<typename E::value_type>, operand_t<E>>
+        operator/(const typename E::value_type& lhs, const MatrixExpression<E>& rhs)
+        {
+            auto mat = makeOperand(rhs);
+            return {{lhs, mat.nLines(), mat.nColumns()}, mat};
+        }
+
+    }
+}
+
+#endif
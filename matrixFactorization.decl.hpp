@@ -0,0 +1,179 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXFACTORIZATION_DECL__GUARD__2610
+#define GEOMETRY__MATRIXFACTORIZATION_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "matrix.decl.hpp"
+
+namespace geometry{
+
+    // Factorizations of dynamic matrices, computed once and reused for any
+    // number of right-hand sides. They work on a column-major copy of the
+    // input and go panel after panel (utils::factorizationBlock columns):
+    // the panel is factorized on its own, then the rest of the matrix is
+    // updated by utils::gemm, which runs the packed SIMD kernel across
+    // threads. Right-hand sides keep their type and layout.
+    //
+    // Singular factors are detected on exact zero pivots, as for the
+    // inverse of FixedMatrix.
+
+    // PA = LU with partial pivoting (square A). L has a unit diagonal and
+    // shares factors() with U.
+    // -> Exceptions::SizeMismatch() if A is not square
+    template<class T>
+    class LuFactorization
+    {
+    public: // attributes
+        Matrix<T> m_factors{};               // L below the diagonal, U on and above
+        std::vector<std::size_t> m_pivots{}; // line k was swapped with m_pivots[k]
+        bool m_singular{false};
+
+    public: // METHODS
+        template<class Alloc, Layout Order>
+        explicit LuFactorization(const Matrix<T, Alloc, Order>& A);
+
+        std::size_t size() const {return m_factors.nLines();}
+        const Matrix<T>& factors() const {return m_factors;}
+        const std::vector<std::size_t>& pivots() const {return m_pivots;}
+        bool isSingular() const {return m_singular;}
+
+        T determinant() const;
+
+        // X such that A.X = B.
+        // -> Exceptions::SingularMatrix()
+        // -> Exceptions::SizeMismatch() if B.nLines() != size()
+        template<class Alloc, Layout Order>
+        Matrix<T, Alloc, Order> solve(const Matrix<T, Alloc, Order>& B) const;
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template<class Alloc, Layout Order>
+        void solveInPlace(Matrix<T, Alloc, Order>& B) const;
+
+        // -> Exceptions::SingularMatrix()
+        Matrix<T> inverse() const;
+
+    protected:
+        // B (size() x nRhs) at B[i*rsB + j*csB], overwritten by X.
+        void solve(std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const;
+    };
+
+    // A = L.L^T for symmetric positive definite A, only the lower triangle
+    // of A is read.
+    // -> Exceptions::SizeMismatch() if A is not square
+    // -> Exceptions::NotPositiveDefinite()
+    template<class T>
+    class CholeskyFactorization
+    {
+    public: // attributes
+        Matrix<T> m_factors{}; // L on and below the diagonal
+
+    public: // METHODS
+        template<class Alloc, Layout Order>
+        explicit CholeskyFactorization(const Matrix<T, Alloc, Order>& A);
+
+        std::size_t size() const {return m_factors.nLines();}
+        Matrix<T> factor() const; // L, zeros above the diagonal
+
+        T determinant() const;
+
+        // -> Exceptions::SizeMismatch() if B.nLines() != size()
+        template<class Alloc, Layout Order>
+        Matrix<T, Alloc, Order> solve(const Matrix<T, Alloc, Order>& B) const;
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template<class Alloc, Layout Order>
+        void solveInPlace(Matrix<T, Alloc, Order>& B) const;
+
+        Matrix<T> inverse() const;
+
+    protected:
+        void solve(std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const;
+    };
+
+    // A = Q.R by Householder reflections (A is m x n, m >= n). The
+    // reflectors are kept in factors() below the diagonal and applied by
+    // blocks (I - V.T.V^T, compact WY form), Q is never formed to solve.
+    // -> Exceptions::SizeMismatch() if m < n
+    template<class T>
+    class QrFactorization
+    {
+    public: // attributes
+        Matrix<T> m_factors{}; // R on and above the diagonal, reflectors below
+        std::vector<T> m_tau{};
+        std::vector<T> m_blockT{}; // T of each panel, factorizationBlock values per column
+
+    public: // METHODS
+        template<class Alloc, Layout Order>
+        explicit QrFactorization(const Matrix<T, Alloc, Order>& A);
+
+        std::size_t nLines()   const {return m_factors.nLines();}
+        std::size_t nColumns() const {return m_factors.nColumns();}
+        const Matrix<T>& factors() const {return m_factors;}
+
+        Matrix<T> q() const; // m x n, orthonormal columns
+        Matrix<T> r() const; // n x n, upper triangular
+
+        // Least squares: X (n x k) minimizing ||A.X - B|| column by column,
+        // the exact solution for square A.
+        // -> Exceptions::SingularMatrix() if A does not have full rank
+        // -> Exceptions::SizeMismatch() if B.nLines() != nLines()
+        template<class Alloc, Layout Order>
+        Matrix<T, Alloc, Order> solve(const Matrix<T, Alloc, Order>& B) const;
+        std::vector<T> solve(const std::vector<T>& b) const;
+
+    protected:
+        // Q.B or Q^T.B in place, B being nLines() x nRhs.
+        void applyQ(bool transposeQ, std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const;
+        // X in the first nColumns() lines of B.
+        void solve(std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const;
+    };
+
+    // -> One-shot versions. solve() and inverse() go through LU, leastSquares()
+    // through QR.
+    // -> Exceptions::SingularMatrix()
+    // -> Exceptions::SizeMismatch()
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB>
+    Matrix<T, AllocB, OrderB> solve(const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B);
+    template<typename T, class Alloc, Layout Order>
+    std::vector<T> solve(const Matrix<T, Alloc, Order>& A, const std::vector<T>& b);
+
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB>
+    Matrix<T, AllocB, OrderB> leastSquares(const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B);
+    template<typename T, class Alloc, Layout Order>
+    std::vector<T> leastSquares(const Matrix<T, Alloc, Order>& A, const std::vector<T>& b);
+
+    template<typename T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> inverse(const Matrix<T, Alloc, Order>& A);
+
+    // -> Exceptions::SizeMismatch() if A is not square
+    template<typename T, class Alloc, Layout Order>
+    T determinant(const Matrix<T, Alloc, Order>& A);
+
+    namespace utils{
+
+        // Columns of a panel, the trailing updates being products of this depth.
+        constexpr std::size_t factorizationBlock = 64;
+
+        enum class Triangle {Lower, Upper};
+
+        // Solve A.X = B in place of B (n x nRhs) for triangular A (n x n).
+        // Element (i,j) of X lives at X[i*rsX + j*csX], so that transposed
+        // triangles and row-major right-hand sides need no copy. Blocks of
+        // factorizationBlock lines are solved one after the other, the rest
+        // of B being updated by gemm.
+        template<typename T>
+        void triangularSolve(Triangle triangle, bool unitDiagonal, std::size_t n, std::size_t nRhs,
+                             const T* A, std::size_t rsA, std::size_t csA,
+                             T* B, std::size_t rsB, std::size_t csB);
+
+    }
+}
+#endif
@@ -0,0 +1,13 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXFACTORIZATION__GUARD__2610
+#define GEOMETRY__MATRIXFACTORIZATION__GUARD__2610
+
+#include "matrixFactorization.decl.hpp"
+#include "matrixFactorization.impl.hpp"
+
+#endif
@@ -0,0 +1,650 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXFACTORIZATION_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXFACTORIZATION_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+// LOCAL INCLUDES
+#include "matrixFactorization.decl.hpp"
+#include "matrix.hpp"
+#include "matrixProduct.hpp"
+#include "matrixParallel.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // ------------------------------ TRIANGLES ---------------------------
+        // One diagonal block of triangularSolve, each right-hand side on its
+        // own (dot product form).
+        template<typename T>
+        void triangularBlockSolve(Triangle triangle, bool unitDiagonal, std::size_t n, std::size_t nRhs,
+                                  const T* A, std::size_t rsA, std::size_t csA,
+                                  T* B, std::size_t rsB, std::size_t csB)
+        {
+            parallelFor(nRhs, n*n*nRhs, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                {
+                    T* x = B + col*csB;
+                    for(std::size_t step=0; step<n; step++)
+                    {
+                        const std::size_t i = (triangle == Triangle::Lower) ? step : n - 1 - step;
+                        T sum = x[i*rsB];
+                        if(triangle == Triangle::Lower)
+                            for(std::size_t p=0; p<i; p++)
+                                sum -= A[i*rsA + p*csA]*x[p*rsB];
+                        else
+                            for(std::size_t p=i+1; p<n; p++)
+                                sum -= A[i*rsA + p*csA]*x[p*rsB];
+                        x[i*rsB] = unitDiagonal ? sum : sum/A[i*(rsA + csA)];
+                    }
+                }
+            });
+        }
+
+        template<typename T>
+        void triangularSolve(Triangle triangle, bool unitDiagonal, std::size_t n, std::size_t nRhs,
+                             const T* A, std::size_t rsA, std::size_t csA,
+                             T* B, std::size_t rsB, std::size_t csB)
+        {
+            const T minusOne = static_cast<T>(-1);
+            for(std::size_t done=0; done<n; done+=factorizationBlock)
+            {
+                const std::size_t kb = std::min(factorizationBlock, n - done);
+                if(triangle == Triangle::Lower)
+                {
+                    const std::size_t k = done;
+                    triangularBlockSolve(triangle, unitDiagonal, kb, nRhs, A + k*(rsA + csA), rsA, csA,
+                                         B + k*rsB, rsB, csB);
+                    gemm(n - k - kb, nRhs, kb, minusOne, A + (k + kb)*rsA + k*csA, rsA, csA,
+                         B + k*rsB, rsB, csB, static_cast<T>(1), B + (k + kb)*rsB, rsB, csB);
+                }
+                else
+                {
+                    const std::size_t k = n - done - kb;
+                    triangularBlockSolve(triangle, unitDiagonal, kb, nRhs, A + k*(rsA + csA), rsA, csA,
+                                         B + k*rsB, rsB, csB);
+                    gemm(k, nRhs, kb, minusOne, A + k*csA, rsA, csA,
+                         B + k*rsB, rsB, csB, static_cast<T>(1), B, rsB, csB);
+                }
+            }
+        }
+
+        // ---------------------------------- LU ------------------------------
+        // Right-looking: factorize the panel with partial pivoting, swap the
+        // same lines in the other columns, solve the block line of U and
+        // update the trailing matrix with one product. Returns true on a
+        // zero pivot (the factorization still completes).
+        template<typename T>
+        bool luFactorize(std::size_t n, T* A, std::size_t lda, std::size_t* pivots)
+        {
+            bool singular = false;
+            for(std::size_t j=0; j<n; j+=factorizationBlock)
+            {
+                const std::size_t jb = std::min(factorizationBlock, n - j);
+                for(std::size_t k=j; k<j+jb; k++)
+                {
+                    T* column = A + k*lda;
+                    std::size_t pivot = k;
+                    for(std::size_t i=k+1; i<n; i++)
+                        if(std::abs(column[i]) > std::abs(column[pivot]))
+                            pivot = i;
+                    pivots[k] = pivot;
+                    if(column[pivot] == static_cast<T>(0))
+                    {
+                        singular = true;
+                        continue;
+                    }
+                    if(pivot != k)
+                        for(std::size_t c=j; c<j+jb; c++)
+                            std::swap(A[k + c*lda], A[pivot + c*lda]);
+                    const T inv = static_cast<T>(1)/column[k];
+                    for(std::size_t i=k+1; i<n; i++)
+                        column[i] *= inv;
+                    for(std::size_t c=k+1; c<j+jb; c++)
+                    {
+                        T* target = A + c*lda;
+                        const T u = target[k];
+                        for(std::size_t i=k+1; i<n; i++)
+                            target[i] -= column[i]*u;
+                    }
+                }
+
+                parallelFor(n - jb, (n - jb)*jb, [&](std::size_t first, std::size_t last){
+                    for(std::size_t index=first; index<last; index++)
+                    {
+                        T* target = A + ((index < j) ? index : index + jb)*lda;
+                        for(std::size_t k=j; k<j+jb; k++)
+                            if(pivots[k] != k)
+                                std::swap(target[k], target[pivots[k]]);
+                    }
+                });
+
+                const std::size_t rest = n - j - jb;
+                if(rest == 0)
+                    continue;
+                triangularSolve(Triangle::Lower, true, jb, rest, A + j*(lda + 1), 1, lda,
+                                A + j + (j + jb)*lda, 1, lda);
+                gemm(rest, rest, jb, static_cast<T>(-1), A + (j + jb) + j*lda, 1, lda,
+                     A + j + (j + jb)*lda, 1, lda, static_cast<T>(1), A + (j + jb)*(lda + 1), 1, lda);
+            }
+            return singular;
+        }
+
+        // ------------------------------- CHOLESKY ---------------------------
+        // Right-looking on the lower triangle: diagonal block, then the
+        // block column under it (L21 = A21.L11^-T, solved as L11.L21^T =
+        // A21^T through the strides), then the lower part of the trailing
+        // matrix, one product per block column.
+        template<typename T>
+        void choleskyFactorize(std::size_t n, T* A, std::size_t lda)
+        {
+            for(std::size_t j=0; j<n; j+=factorizationBlock)
+            {
+                const std::size_t jb = std::min(factorizationBlock, n - j);
+                for(std::size_t k=j; k<j+jb; k++)
+                {
+                    T diagonal = A[k*(lda + 1)];
+                    for(std::size_t p=j; p<k; p++)
+                        diagonal -= A[k + p*lda]*A[k + p*lda];
+                    if(!(diagonal > static_cast<T>(0)))
+                        throw Exeptions::NotPositiveDefinite();
+                    diagonal = std::sqrt(diagonal);
+                    A[k*(lda + 1)] = diagonal;
+                    for(std::size_t i=k+1; i<j+jb; i++)
+                    {
+                        T sum = A[i + k*lda];
+                        for(std::size_t p=j; p<k; p++)
+                            sum -= A[i + p*lda]*A[k + p*lda];
+                        A[i + k*lda] = sum/diagonal;
+                    }
+                }
+
+                const std::size_t rest = n - j - jb;
+                if(rest == 0)
+                    continue;
+                triangularSolve(Triangle::Lower, false, jb, rest, A + j*(lda + 1), 1, lda,
+                                A + (j + jb) + j*lda, lda, 1);
+                for(std::size_t c=j+jb; c<n; c+=factorizationBlock)
+                {
+                    const std::size_t cw = std::min(factorizationBlock, n - c);
+                    gemm(n - c, cw, jb, static_cast<T>(-1), A + c + j*lda, 1, lda,
+                         A + c + j*lda, lda, 1, static_cast<T>(1), A + c*(lda + 1), 1, lda);
+                }
+            }
+        }
+
+        // ---------------------------------- QR ------------------------------
+        // Householder reflectors of the rows x jb panel P: H = I - tau.v.v^T
+        // with v[0] = 1 implicit, v[1:] stored under the diagonal and the
+        // diagonal of R on it. Each reflector is applied to the panel
+        // columns on its right.
+        template<typename T>
+        void householderPanel(std::size_t rows, std::size_t jb, T* P, std::size_t lda, T* tau)
+        {
+            for(std::size_t k=0; k<jb; k++)
+            {
+                T* x = P + k*(lda + 1);
+                const std::size_t length = rows - k;
+                T norm2 = static_cast<T>(0);
+                for(std::size_t i=1; i<length; i++)
+                    norm2 += x[i]*x[i];
+                if(norm2 == static_cast<T>(0))
+                {
+                    tau[k] = static_cast<T>(0);
+                    continue;
+                }
+                const T alpha = x[0];
+                const T beta = -std::copysign(std::sqrt(alpha*alpha + norm2), alpha);
+                tau[k] = (beta - alpha)/beta;
+                const T scale = static_cast<T>(1)/(alpha - beta);
+                for(std::size_t i=1; i<length; i++)
+                    x[i] *= scale;
+                x[0] = beta;
+                for(std::size_t c=k+1; c<jb; c++)
+                {
+                    T* y = P + k + c*lda;
+                    T w = y[0];
+                    for(std::size_t i=1; i<length; i++)
+                        w += x[i]*y[i];
+                    w *= tau[k];
+                    y[0] -= w;
+                    for(std::size_t i=1; i<length; i++)
+                        y[i] -= w*x[i];
+                }
+            }
+        }
+
+        // Upper triangular Tm (jb x jb, leading dimension jb) of the compact
+        // WY form H0.H1...H(jb-1) = I - V.Tm.V^T. V splits in V1, the unit
+        // lower jb x jb triangle, and V2 under it, read in place by gemm.
+        template<typename T>
+        void blockReflectorFactor(std::size_t rows, std::size_t jb, const T* P, std::size_t lda,
+                                  const T* tau, T* Tm)
+        {
+            // Gram matrix V^T.V in Tm first: V2 part by gemm, V1 part by hand.
+            gemm(jb, jb, rows - jb, static_cast<T>(1), P + jb, lda, 1, P + jb, 1, lda,
+                 static_cast<T>(0), Tm, 1, jb);
+            for(std::size_t i=0; i<jb; i++)
+                for(std::size_t p=0; p<i; p++)
+                {
+                    T sum = P[i + p*lda]; // V1(i,p).V1(i,i), V1(i,i) = 1
+                    for(std::size_t r=i+1; r<jb; r++)
+                        sum += P[r + p*lda]*P[r + i*lda];
+                    Tm[p + i*jb] += sum;
+                }
+            // Column i of Tm: -tau[i].Tm(0:i, 0:i).(V^T.v_i), the Gram
+            // column being overwritten from the top.
+            for(std::size_t i=0; i<jb; i++)
+            {
+                for(std::size_t a=0; a<i; a++)
+                {
+                    T sum = static_cast<T>(0);
+                    for(std::size_t b=a; b<i; b++)
+                        sum += Tm[a + b*jb]*Tm[b + i*jb];
+                    Tm[a + i*jb] = -tau[i]*sum;
+                }
+                Tm[i*(jb + 1)] = tau[i];
+                for(std::size_t a=i+1; a<jb; a++)
+                    Tm[a + i*jb] = static_cast<T>(0);
+            }
+        }
+
+        // C (rows x nc, strided) = (I - V.Tm.V^T).C, or its transpose
+        // applied (Q^T.C) with transposeQ.
+        template<typename T>
+        void applyBlockReflector(bool transposeQ, std::size_t rows, std::size_t jb, std::size_t nc,
+                                 const T* P, std::size_t lda, const T* Tm,
+                                 T* C, std::size_t rsC, std::size_t csC)
+        {
+            if(nc == 0)
+                return;
+            std::vector<T> W(jb*nc), W2(jb*nc);
+            // W = V^T.C = V1^T.C1 + V2^T.C2
+            parallelFor(nc, jb*jb*nc, [&](std::size_t first, std::size_t last){
+                for(std::size_t c=first; c<last; c++)
+                    for(std::size_t p=0; p<jb; p++)
+                    {
+                        T sum = C[p*rsC + c*csC];
+                        for(std::size_t r=p+1; r<jb; r++)
+                            sum += P[r + p*lda]*C[r*rsC + c*csC];
+                        W[p + c*jb] = sum;
+                    }
+            });
+            gemm(jb, nc, rows - jb, static_cast<T>(1), P + jb, lda, 1, C + jb*rsC, rsC, csC,
+                 static_cast<T>(1), W.data(), 1, jb);
+            // W2 = Tm^T.W for Q^T, Tm.W for Q
+            gemm(jb, nc, jb, static_cast<T>(1), Tm, transposeQ ? jb : 1, transposeQ ? 1 : jb,
+                 W.data(), 1, jb, static_cast<T>(0), W2.data(), 1, jb);
+            // C2 -= V2.W2, C1 -= V1.W2
+            gemm(rows - jb, nc, jb, static_cast<T>(-1), P + jb, 1, lda, W2.data(), 1, jb,
+                 static_cast<T>(1), C + jb*rsC, rsC, csC);
+            parallelFor(nc, jb*jb*nc, [&](std::size_t first, std::size_t last){
+                for(std::size_t c=first; c<last; c++)
+                    for(std::size_t r=0; r<jb; r++)
+                    {
+                        T sum = W2[r + c*jb];
+                        for(std::size_t p=0; p<r; p++)
+                            sum += P[r + p*lda]*W2[p + c*jb];
+                        C[r*rsC + c*csC] -= sum;
+                    }
+            });
+        }
+
+        // Panel after panel: reflectors of the panel, their Tm (kept in
+        // blockT, factorizationBlock values per column) and Q^T applied to
+        // the columns on the right.
+        template<typename T>
+        void qrFactorize(std::size_t m, std::size_t n, T* A, std::size_t lda, T* tau, T* blockT)
+        {
+            for(std::size_t j=0; j<n; j+=factorizationBlock)
+            {
+                const std::size_t jb = std::min(factorizationBlock, n - j);
+                T* panel = A + j*(lda + 1);
+                householderPanel(m - j, jb, panel, lda, tau + j);
+                blockReflectorFactor(m - j, jb, panel, lda, tau + j, blockT + j*factorizationBlock);
+                applyBlockReflector(true, m - j, jb, n - j - jb, panel, lda, blockT + j*factorizationBlock,
+                                    A + j + (j + jb)*lda, 1, lda);
+            }
+        }
+
+        // Strides of a matrix for the raw kernels above.
+        template<typename T, class Alloc, Layout Order>
+        std::array<std::size_t, 2> strides(const Matrix<T, Alloc, Order>& matrix)
+        {
+            if(Order == Layout::ColumnMajor)
+                return {1, matrix.leadingDimension()};
+            return {matrix.leadingDimension(), 1};
+        }
+
+        // Column-major copy of A with a padded leading dimension, so that
+        // the columns of the factors do not compete for the same cache sets.
+        template<typename T, class Alloc, Layout Order>
+        Matrix<T> factorizationCopy(const Matrix<T, Alloc, Order>& A)
+        {
+            Matrix<T> out;
+            out = A;
+            out.setLeadingDimension(paddedLeadingDimension<T>(out.nLines()));
+            return out;
+        }
+
+        template<typename T, class Alloc, Layout Order>
+        void setIdentity(Matrix<T, Alloc, Order>& matrix)
+        {
+            matrix.clear();
+            for(std::size_t i=0; i<std::min(matrix.nLines(), matrix.nColumns()); i++)
+                matrix.data()[i*(matrix.leadingDimension() + 1)] = static_cast<T>(1);
+        }
+
+    }
+
+    // =========================== LU FACTORIZATION ===========================
+    template<class T>
+    template<class Alloc, Layout Order>
+    LuFactorization<T>::LuFactorization(const Matrix<T, Alloc, Order>& A)
+    {
+        static_assert(std::is_floating_point_v<T>, "LuFactorization needs a floating point matrix");
+        if(A.nLines() != A.nColumns())
+            throw Exeptions::SizeMismatch(A.nLines(), A.nColumns());
+        m_factors = utils::factorizationCopy(A);
+        m_pivots.resize(A.nLines());
+        m_singular = utils::luFactorize(this->size(), m_factors.data(), m_factors.leadingDimension(),
+                                        m_pivots.data());
+    }
+
+    template<class T>
+    T LuFactorization<T>::determinant() const
+    {
+        T out = static_cast<T>(1);
+        for(std::size_t k=0; k<this->size(); k++)
+        {
+            out *= m_factors.data()[k*(m_factors.leadingDimension() + 1)];
+            if(m_pivots[k] != k)
+                out = -out;
+        }
+        return out;
+    }
+
+    template<class T>
+    void LuFactorization<T>::solve(std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const
+    {
+        if(m_singular)
+            throw Exeptions::SingularMatrix();
+        const std::size_t n = this->size();
+        utils::parallelFor(nRhs, n*nRhs, [&](std::size_t first, std::size_t last){
+            for(std::size_t col=first; col<last; col++)
+                for(std::size_t k=0; k<n; k++)
+                    if(m_pivots[k] != k)
+                        std::swap(B[k*rsB + col*csB], B[m_pivots[k]*rsB + col*csB]);
+        });
+        const std::size_t lda = m_factors.leadingDimension();
+        utils::triangularSolve(utils::Triangle::Lower, true, n, nRhs, m_factors.data(), 1, lda, B, rsB, csB);
+        utils::triangularSolve(utils::Triangle::Upper, false, n, nRhs, m_factors.data(), 1, lda, B, rsB, csB);
+    }
+
+    template<class T>
+    template<class Alloc, Layout Order>
+    void LuFactorization<T>::solveInPlace(Matrix<T, Alloc, Order>& B) const
+    {
+        if(B.nLines() != this->size())
+            throw Exeptions::SizeMismatch(B.nLines(), this->size());
+        const auto stride = utils::strides(B);
+        this->solve(B.nColumns(), B.data(), stride[0], stride[1]);
+    }
+
+    template<class T>
+    template<class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> LuFactorization<T>::solve(const Matrix<T, Alloc, Order>& B) const
+    {
+        Matrix<T, Alloc, Order> X(B);
+        this->solveInPlace(X);
+        return X;
+    }
+
+    template<class T>
+    std::vector<T> LuFactorization<T>::solve(const std::vector<T>& b) const
+    {
+        if(b.size() != this->size())
+            throw Exeptions::SizeMismatch(b.size(), this->size());
+        std::vector<T> x(b);
+        this->solve(1, x.data(), 1, x.size());
+        return x;
+    }
+
+    template<class T>
+    Matrix<T> LuFactorization<T>::inverse() const
+    {
+        Matrix<T> out(this->size(), this->size());
+        utils::setIdentity(out);
+        this->solveInPlace(out);
+        return out;
+    }
+
+    // ======================== CHOLESKY FACTORIZATION ========================
+    template<class T>
+    template<class Alloc, Layout Order>
+    CholeskyFactorization<T>::CholeskyFactorization(const Matrix<T, Alloc, Order>& A)
+    {
+        static_assert(std::is_floating_point_v<T>, "CholeskyFactorization needs a floating point matrix");
+        if(A.nLines() != A.nColumns())
+            throw Exeptions::SizeMismatch(A.nLines(), A.nColumns());
+        m_factors = utils::factorizationCopy(A);
+        utils::choleskyFactorize(this->size(), m_factors.data(), m_factors.leadingDimension());
+    }
+
+    template<class T>
+    Matrix<T> CholeskyFactorization<T>::factor() const
+    {
+        const std::size_t n = this->size();
+        const std::size_t lda = m_factors.leadingDimension();
+        Matrix<T> out(n, n);
+        for(std::size_t c=0; c<n; c++)
+            std::copy(m_factors.data() + c*(lda + 1), m_factors.data() + c*lda + n, out.data() + c*(n + 1));
+        return out;
+    }
+
+    template<class T>
+    T CholeskyFactorization<T>::determinant() const
+    {
+        T out = static_cast<T>(1);
+        for(std::size_t k=0; k<this->size(); k++)
+        {
+            const T diagonal = m_factors.data()[k*(m_factors.leadingDimension() + 1)];
+            out *= diagonal*diagonal;
+        }
+        return out;
+    }
+
+    // L.y = b, then L^T.x = y (L^T read through the strides).
+    template<class T>
+    void CholeskyFactorization<T>::solve(std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const
+    {
+        const std::size_t n = this->size();
+        const std::size_t lda = m_factors.leadingDimension();
+        utils::triangularSolve(utils::Triangle::Lower, false, n, nRhs, m_factors.data(), 1, lda, B, rsB, csB);
+        utils::triangularSolve(utils::Triangle::Upper, false, n, nRhs, m_factors.data(), lda, 1, B, rsB, csB);
+    }
+
+    template<class T>
+    template<class Alloc, Layout Order>
+    void CholeskyFactorization<T>::solveInPlace(Matrix<T, Alloc, Order>& B) const
+    {
+        if(B.nLines() != this->size())
+            throw Exeptions::SizeMismatch(B.nLines(), this->size());
+        const auto stride = utils::strides(B);
+        this->solve(B.nColumns(), B.data(), stride[0], stride[1]);
+    }
+
+    template<class T>
+    template<class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> CholeskyFactorization<T>::solve(const Matrix<T, Alloc, Order>& B) const
+    {
+        Matrix<T, Alloc, Order> X(B);
+        this->solveInPlace(X);
+        return X;
+    }
+
+    template<class T>
+    std::vector<T> CholeskyFactorization<T>::solve(const std::vector<T>& b) const
+    {
+        if(b.size() != this->size())
+            throw Exeptions::SizeMismatch(b.size(), this->size());
+        std::vector<T> x(b);
+        this->solve(1, x.data(), 1, x.size());
+        return x;
+    }
+
+    template<class T>
+    Matrix<T> CholeskyFactorization<T>::inverse() const
+    {
+        Matrix<T> out(this->size(), this->size());
+        utils::setIdentity(out);
+        this->solveInPlace(out);
+        return out;
+    }
+
+    // =========================== QR FACTORIZATION ===========================
+    template<class T>
+    template<class Alloc, Layout Order>
+    QrFactorization<T>::QrFactorization(const Matrix<T, Alloc, Order>& A)
+    {
+        static_assert(std::is_floating_point_v<T>, "QrFactorization needs a floating point matrix");
+        if(A.nLines() < A.nColumns())
+            throw Exeptions::SizeMismatch(A.nLines(), A.nColumns());
+        m_factors = utils::factorizationCopy(A);
+        m_tau.resize(A.nColumns());
+        m_blockT.resize(utils::factorizationBlock*A.nColumns());
+        utils::qrFactorize(this->nLines(), this->nColumns(), m_factors.data(), m_factors.leadingDimension(),
+                           m_tau.data(), m_blockT.data());
+    }
+
+    // Panels in reverse order.
+    template<class T>
+    void QrFactorization<T>::applyQ(bool transposeQ, std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const
+    {
+        const std::size_t m = this->nLines();
+        const std::size_t n = this->nColumns();
+        const std::size_t lda = m_factors.leadingDimension();
+        const std::size_t nPanels = (n + utils::factorizationBlock - 1)/utils::factorizationBlock;
+        for(std::size_t step=0; step<nPanels; step++)
+        {
+            const std::size_t j = (transposeQ ? step : nPanels - 1 - step)*utils::factorizationBlock;
+            const std::size_t jb = std::min(utils::factorizationBlock, n - j);
+            utils::applyBlockReflector(transposeQ, m - j, jb, nRhs, m_factors.data() + j*(lda + 1), lda,
+                                       m_blockT.data() + j*utils::factorizationBlock, B + j*rsB, rsB, csB);
+        }
+    }
+
+    template<class T>
+    Matrix<T> QrFactorization<T>::q() const
+    {
+        Matrix<T> out(this->nLines(), this->nColumns());
+        utils::setIdentity(out);
+        this->applyQ(false, out.nColumns(), out.data(), 1, out.leadingDimension());
+        return out;
+    }
+
+    template<class T>
+    Matrix<T> QrFactorization<T>::r() const
+    {
+        const std::size_t n = this->nColumns();
+        const std::size_t lda = m_factors.leadingDimension();
+        Matrix<T> out(n, n);
+        for(std::size_t c=0; c<n; c++)
+            std::copy(m_factors.data() + c*lda, m_factors.data() + c*(lda + 1) + 1, out.data() + c*n);
+        return out;
+    }
+
+    // Q^T.B, then R.X = (Q^T.B)[0:n].
+    template<class T>
+    void QrFactorization<T>::solve(std::size_t nRhs, T* B, std::size_t rsB, std::size_t csB) const
+    {
+        const std::size_t n = this->nColumns();
+        const std::size_t lda = m_factors.leadingDimension();
+        for(std::size_t k=0; k<n; k++)
+            if(m_factors.data()[k*(lda + 1)] == static_cast<T>(0))
+                throw Exeptions::SingularMatrix();
+        this->applyQ(true, nRhs, B, rsB, csB);
+        utils::triangularSolve(utils::Triangle::Upper, false, n, nRhs, m_factors.data(), 1, lda, B, rsB, csB);
+    }
+
+    template<class T>
+    template<class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> QrFactorization<T>::solve(const Matrix<T, Alloc, Order>& B) const
+    {
+        if(B.nLines() != this->nLines())
+            throw Exeptions::SizeMismatch(B.nLines(), this->nLines());
+        Matrix<T, Alloc, Order> work(B);
+        const auto stride = utils::strides(work);
+        this->solve(work.nColumns(), work.data(), stride[0], stride[1]);
+        if(this->nLines() == this->nColumns())
+            return work;
+        Matrix<T, Alloc, Order> X(this->nColumns(), B.nColumns(), B.get_allocator());
+        X = work.block(0, 0, this->nColumns(), B.nColumns());
+        return X;
+    }
+
+    template<class T>
+    std::vector<T> QrFactorization<T>::solve(const std::vector<T>& b) const
+    {
+        if(b.size() != this->nLines())
+            throw Exeptions::SizeMismatch(b.size(), this->nLines());
+        std::vector<T> x(b);
+        this->solve(1, x.data(), 1, x.size());
+        x.resize(this->nColumns());
+        return x;
+    }
+
+    // ============================== ONE-SHOT ================================
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB>
+    Matrix<T, AllocB, OrderB> solve(const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B)
+    {
+        return LuFactorization<T>(A).solve(B);
+    }
+
+    template<typename T, class Alloc, Layout Order>
+    std::vector<T> solve(const Matrix<T, Alloc, Order>& A, const std::vector<T>& b)
+    {
+        return LuFactorization<T>(A).solve(b);
+    }
+
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB>
+    Matrix<T, AllocB, OrderB> leastSquares(const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B)
+    {
+        return QrFactorization<T>(A).solve(B);
+    }
+
+    template<typename T, class Alloc, Layout Order>
+    std::vector<T> leastSquares(const Matrix<T, Alloc, Order>& A, const std::vector<T>& b)
+    {
+        return QrFactorization<T>(A).solve(b);
+    }
+
+    template<typename T, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> inverse(const Matrix<T, Alloc, Order>& A)
+    {
+        const LuFactorization<T> lu(A);
+        Matrix<T, Alloc, Order> out(A.nLines(), A.nColumns(), A.get_allocator());
+        utils::setIdentity(out);
+        lu.solveInPlace(out);
+        return out;
+    }
+
+    template<typename T, class Alloc, Layout Order>
+    T determinant(const Matrix<T, Alloc, Order>& A)
+    {
+        return LuFactorization<T>(A).determinant();
+    }
+
+}
+#endif
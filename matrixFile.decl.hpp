@@ -0,0 +1,194 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXFILE_DECL__GUARD__2610
+#define GEOMETRY__MATRIXFILE_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "matrixHalf.decl.hpp"
+#include "matrixView.decl.hpp"
+
+// Memory-mapped matrices need the POSIX mmap.
+#if defined(__unix__) || defined(__APPLE__)
+    #define GEOMETRY_MMAP 1
+#endif
+
+namespace geometry{
+
+    // ------------------------------- FORMAT ---------------------------------
+    // Binary matrix file: a 64-byte MatrixFileHeader, padding up to
+    // dataOffset, then the elements in storage order (column after column,
+    // line after line for row-major), lead elements apart. Values keep the
+    // byte order of the machine that wrote them: byteOrder tells, and a
+    // foreign file is refused rather than misread.
+    enum class DType: std::uint32_t {Unknown, Int8, UInt8, Int16, UInt16, Int32, UInt32,
+                                     Int64, UInt64, Float32, Float64, Float16, BFloat16};
+
+    struct MatrixFileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;   // utils::matrixFileByteOrder as written
+        std::uint32_t dtype;       // DType
+        std::uint32_t elementSize; // bytes
+        std::uint32_t layout;      // 0: column-major, 1: row-major
+        std::uint32_t alignment;   // dataOffset is a multiple of it
+        std::uint64_t nLines;
+        std::uint64_t nColumns;
+        std::uint64_t lead;        // elements between two columns (lines) in the file
+        std::uint64_t dataOffset;  // bytes from the start of the file
+    };
+    static_assert(sizeof(MatrixFileHeader) == 64, "the header is 64 bytes on disk");
+
+    namespace utils{
+
+        template<typename T>
+        constexpr DType dtypeOf();
+
+        constexpr char matrixFileMagic[8] = {'G', 'E', 'O', 'M', 'A', 'T', 'R', 'X'};
+        constexpr std::uint32_t matrixFileVersion = 1;
+        constexpr std::uint32_t matrixFileByteOrder = 0x01020304;
+        // Files are written with their elements one page in, so that a
+        // mapped file starts them on a page (and storageAlignment) boundary.
+        constexpr std::size_t matrixFileAlignment = 4096;
+        // Bytes per read / write call: large sequential requests.
+        constexpr std::size_t fileChunk = std::size_t(64) << 20;
+
+        // Header of a compact file (lead == storage lines).
+        MatrixFileHeader makeHeader(DType dtype, std::size_t elementSize, Layout layout,
+                                    std::size_t nLines, std::size_t nColumns);
+        Layout layoutOf(const MatrixFileHeader& header);
+        // Lines and columns of the storage seen as column-major.
+        std::size_t storageLines(const MatrixFileHeader& header);
+        std::size_t storageColumns(const MatrixFileHeader& header);
+        // Bytes from dataOffset to the end of the last element (unchecked,
+        // checkHeader() validates it for headers read from a file).
+        std::size_t dataBytes(const MatrixFileHeader& header);
+
+        // -> Exceptions::FileError() for a file that is not a matrix file of
+        //    this format, byte order, and element type, whose elements are
+        //    not aligned (dataOffset a multiple of elementSize), or whose
+        //    size arithmetic overflows or goes past fileBytes
+        void checkHeader(const MatrixFileHeader& header, const std::string& path,
+                         DType dtype, std::size_t elementSize, std::size_t fileBytes);
+
+        // std::FILE closed on destruction. Write errors surface at close().
+        class File
+        {
+        public:
+            // -> Exceptions::FileError()
+            File(const std::string& path, const char* mode);
+            ~File();
+
+            File(const File&) = delete;
+            File& operator=(const File&) = delete;
+
+            std::FILE* get() const {return mp_file;}
+            const std::string& path() const {return m_path;}
+
+            // -> Exceptions::FileError()
+            void read(void* out, std::size_t bytes);
+            void write(const void* in, std::size_t bytes);
+            void skip(std::size_t bytes);
+            std::size_t size(); // bytes, the position is kept
+            void close();
+
+        protected:
+            std::FILE* mp_file{nullptr};
+            std::string m_path;
+        };
+
+        // Header, then padding up to header.dataOffset.
+        void writeHeader(File& file, const MatrixFileHeader& header);
+        // Header checked against dtype, file positioned on the data.
+        MatrixFileHeader readHeader(File& file, DType dtype, std::size_t elementSize);
+
+        // nColumns storage columns of nLines elements, lead apart in memory
+        // (ld) and in the file (header lead). One request when both are
+        // compact, a column at a time otherwise.
+        template<typename T>
+        void writeStorage(File& file, const T* data, std::size_t nLines, std::size_t nColumns, std::size_t ld);
+        template<typename T>
+        void readStorage(File& file, T* data, std::size_t nLines, std::size_t nColumns,
+                         std::size_t ld, std::size_t fileLead);
+
+    }
+
+#ifdef GEOMETRY_MMAP
+    enum class MapMode {ReadOnly, ReadWrite};
+
+    // Matrix file mapped in memory: opening is O(1) whatever the size and
+    // pages are read from disk when first touched. Read-only mappings of a
+    // file share the page cache, so processes of the same host read one
+    // copy of it. ReadWrite mappings write back to the file (flush() forces
+    // it). The elements are reached through views, which take part in the
+    // expressions and products like any matrix:
+    //     MappedMatrix<double> a("a.mat");
+    //     Matrix<double> b = a.view()*2.0;
+    template<class T>
+    class MappedMatrix
+    {
+    public: // types
+        using value_type = T;
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        // -> Exceptions::FileError()
+        explicit MappedMatrix(const std::string& path, MapMode mode = MapMode::ReadOnly);
+        // New zero matrix file (sparse on disk), mapped ReadWrite.
+        // -> Exceptions::FileError()
+        static MappedMatrix<T> create(const std::string& path, std::size_t line, std::size_t col,
+                                      Layout layout = Layout::ColumnMajor);
+
+        MappedMatrix(MappedMatrix<T>&& other) noexcept;
+        MappedMatrix<T>& operator=(MappedMatrix<T>&& other) noexcept;
+        MappedMatrix(const MappedMatrix<T>&) = delete;
+        MappedMatrix<T>& operator=(const MappedMatrix<T>&) = delete;
+
+        // --------------------------- DESTRUCTORS ----------------------------
+        ~MappedMatrix();
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        std::size_t nLines()   const {return m_header.nLines;}
+        std::size_t nColumns() const {return m_header.nColumns;}
+        std::size_t length() const {return this->nLines()*this->nColumns();}
+        std::size_t leadingDimension() const {return m_header.lead;}
+        Layout layout() const {return utils::layoutOf(m_header);}
+        MapMode mode() const {return m_mode;}
+        const MatrixFileHeader& header() const {return m_header;}
+        const T* data() const {return mp_data;} // storage in layout()
+
+        ConstMatrixView<T> view() const;
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        // Writing through a ReadOnly mapping faults.
+        T* data() {return mp_data;}
+        MatrixView<T> view();
+        // -> Exceptions::FileError()
+        void flush();
+
+    // --------------------------- PROTECTED METHODS --------------------------
+    protected:
+        MappedMatrix() {}
+        void unmap();
+
+        MatrixFileHeader m_header{};
+        MapMode m_mode{MapMode::ReadOnly};
+        void* mp_mapping{nullptr};
+        std::size_t m_mappingBytes{0};
+        T* mp_data{nullptr};
+    };
+#endif
+
+}
+#endif
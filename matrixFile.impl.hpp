@@ -0,0 +1,367 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXFILE_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXFILE_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef GEOMETRY_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// LOCAL INCLUDES
+#include "matrixFile.decl.hpp"
+#include "matrixView.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // -------------------------------- FORMAT ----------------------------
+        template<typename T>
+        constexpr DType dtypeOf()
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return DType::Float32;
+            else if constexpr (std::is_same_v<T, double>)
+                return DType::Float64;
+            else if constexpr (std::is_same_v<T, Float16>)
+                return DType::Float16;
+            else if constexpr (std::is_same_v<T, BFloat16>)
+                return DType::BFloat16;
+            else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+            {
+                constexpr bool sign = std::is_signed_v<T>;
+                switch(sizeof(T))
+                {
+                    case 1: return sign ? DType::Int8 : DType::UInt8;
+                    case 2: return sign ? DType::Int16 : DType::UInt16;
+                    case 4: return sign ? DType::Int32 : DType::UInt32;
+                    case 8: return sign ? DType::Int64 : DType::UInt64;
+                    default: return DType::Unknown;
+                }
+            }
+            else
+                return DType::Unknown;
+        }
+
+        inline MatrixFileHeader makeHeader(DType dtype, std::size_t elementSize, Layout layout,
+                                           std::size_t nLines, std::size_t nColumns)
+        {
+            MatrixFileHeader header{};
+            std::copy(matrixFileMagic, matrixFileMagic + 8, header.magic);
+            header.version = matrixFileVersion;
+            header.byteOrder = matrixFileByteOrder;
+            header.dtype = static_cast<std::uint32_t>(dtype);
+            header.elementSize = static_cast<std::uint32_t>(elementSize);
+            header.layout = (layout == Layout::RowMajor) ? 1 : 0;
+            header.alignment = matrixFileAlignment;
+            header.nLines = nLines;
+            header.nColumns = nColumns;
+            header.lead = storageLines(header);
+            header.dataOffset = matrixFileAlignment;
+            return header;
+        }
+
+        inline Layout layoutOf(const MatrixFileHeader& header)
+        {
+            return (header.layout == 1) ? Layout::RowMajor : Layout::ColumnMajor;
+        }
+
+        inline std::size_t storageLines(const MatrixFileHeader& header)
+        {
+            return (layoutOf(header) == Layout::ColumnMajor) ? header.nLines : header.nColumns;
+        }
+
+        inline std::size_t storageColumns(const MatrixFileHeader& header)
+        {
+            return (layoutOf(header) == Layout::ColumnMajor) ? header.nColumns : header.nLines;
+        }
+
+        inline std::size_t dataBytes(const MatrixFileHeader& header)
+        {
+            const std::size_t columns = storageColumns(header);
+            if((columns == 0) || (storageLines(header) == 0))
+                return 0;
+            return ((columns - 1)*header.lead + storageLines(header))*header.elementSize;
+        }
+
+        inline void checkHeader(const MatrixFileHeader& header, const std::string& path,
+                                DType dtype, std::size_t elementSize, std::size_t fileBytes)
+        {
+            if(!std::equal(matrixFileMagic, matrixFileMagic + 8, header.magic))
+                throw Exeptions::FileError(path, "not a matrix file");
+            if(header.version > matrixFileVersion)
+                throw Exeptions::FileError(path, "format version " + std::to_string(header.version) + " is newer than this library");
+            if(header.byteOrder != matrixFileByteOrder)
+                throw Exeptions::FileError(path, "written with another byte order");
+            if((header.dtype != static_cast<std::uint32_t>(dtype)) || (header.elementSize != elementSize))
+                throw Exeptions::FileError(path, "element type " + std::to_string(header.dtype)
+                                                 + " where " + std::to_string(static_cast<std::uint32_t>(dtype))
+                                                 + " is expected");
+            if((header.layout > 1) || (header.dataOffset < sizeof(MatrixFileHeader))
+               || ((storageColumns(header) > 0) && (header.lead < storageLines(header))))
+                throw Exeptions::FileError(path, "corrupted header");
+            // elementSize is sizeof(T), a multiple of alignof(T): mappings
+            // start on a page, so this aligns the mapped elements too.
+            if(header.dataOffset % elementSize != 0)
+                throw Exeptions::FileError(path, "misaligned elements");
+            // dataBytes() step by step, each step checked for overflow,
+            // before anything is sized or mapped from it.
+            constexpr std::size_t maxBytes = std::numeric_limits<std::size_t>::max();
+            const std::size_t lines = storageLines(header);
+            const std::size_t columns = storageColumns(header);
+            std::size_t bytes = 0;
+            if((lines > 0) && (columns > 0))
+            {
+                const std::size_t steps = columns - 1;
+                if(((steps > 0) && (header.lead > maxBytes/steps))
+                   || (steps*header.lead > maxBytes - lines)
+                   || (steps*header.lead + lines > maxBytes/elementSize))
+                    throw Exeptions::FileError(path, "corrupted header: size overflows");
+                bytes = (steps*header.lead + lines)*elementSize;
+            }
+            if((header.dataOffset > fileBytes) || (bytes > fileBytes - header.dataOffset))
+                throw Exeptions::FileError(path, "file shorter than its header says");
+        }
+
+        // --------------------------------- FILE -----------------------------
+        inline File::File(const std::string& path, const char* mode):
+            mp_file{std::fopen(path.c_str(), mode)},
+            m_path{path}
+        {
+            if(!mp_file)
+                throw Exeptions::FileError(path, std::strerror(errno));
+        }
+
+        inline File::~File()
+        {
+            if(mp_file)
+                std::fclose(mp_file);
+        }
+
+        inline void File::read(void* out, std::size_t bytes)
+        {
+            char* cursor = static_cast<char*>(out);
+            while(bytes > 0)
+            {
+                const std::size_t request = std::min(bytes, fileChunk);
+                if(std::fread(cursor, 1, request, mp_file) != request)
+                    throw Exeptions::FileError(m_path, std::feof(mp_file) ? "unexpected end of file"
+                                                                          : std::strerror(errno));
+                cursor += request;
+                bytes -= request;
+            }
+        }
+
+        inline void File::write(const void* in, std::size_t bytes)
+        {
+            const char* cursor = static_cast<const char*>(in);
+            while(bytes > 0)
+            {
+                const std::size_t request = std::min(bytes, fileChunk);
+                if(std::fwrite(cursor, 1, request, mp_file) != request)
+                    throw Exeptions::FileError(m_path, std::strerror(errno));
+                cursor += request;
+                bytes -= request;
+            }
+        }
+
+        inline void File::skip(std::size_t bytes)
+        {
+            if((bytes > 0) && (std::fseek(mp_file, static_cast<long>(bytes), SEEK_CUR) != 0))
+                throw Exeptions::FileError(m_path, std::strerror(errno));
+        }
+
+        inline std::size_t File::size()
+        {
+            const long position = std::ftell(mp_file);
+            if((position < 0) || (std::fseek(mp_file, 0, SEEK_END) != 0))
+                throw Exeptions::FileError(m_path, std::strerror(errno));
+            const long end = std::ftell(mp_file);
+            if((end < 0) || (std::fseek(mp_file, position, SEEK_SET) != 0))
+                throw Exeptions::FileError(m_path, std::strerror(errno));
+            return static_cast<std::size_t>(end);
+        }
+
+        inline void File::close()
+        {
+            std::FILE* file = mp_file;
+            mp_file = nullptr;
+            if(std::fclose(file) != 0)
+                throw Exeptions::FileError(m_path, std::strerror(errno));
+        }
+
+        inline void writeHeader(File& file, const MatrixFileHeader& header)
+        {
+            file.write(&header, sizeof(header));
+            const std::vector<char> padding(header.dataOffset - sizeof(header), 0);
+            file.write(padding.data(), padding.size());
+        }
+
+        inline MatrixFileHeader readHeader(File& file, DType dtype, std::size_t elementSize)
+        {
+            MatrixFileHeader header{};
+            file.read(&header, sizeof(header));
+            checkHeader(header, file.path(), dtype, elementSize, file.size());
+            file.skip(header.dataOffset - sizeof(header));
+            return header;
+        }
+
+        template<typename T>
+        void writeStorage(File& file, const T* data, std::size_t nLines, std::size_t nColumns, std::size_t ld)
+        {
+            if((ld == nLines) || (nColumns <= 1))
+                return file.write(data, nLines*nColumns*sizeof(T));
+            for(std::size_t col=0; col<nColumns; col++)
+                file.write(data + col*ld, nLines*sizeof(T));
+        }
+
+        template<typename T>
+        void readStorage(File& file, T* data, std::size_t nLines, std::size_t nColumns,
+                         std::size_t ld, std::size_t fileLead)
+        {
+            if(((ld == nLines) && (fileLead == nLines)) || (nColumns <= 1))
+                return file.read(data, nLines*nColumns*sizeof(T));
+            for(std::size_t col=0; col<nColumns; col++)
+            {
+                file.read(data + col*ld, nLines*sizeof(T));
+                if(col + 1 < nColumns)
+                    file.skip((fileLead - nLines)*sizeof(T));
+            }
+        }
+
+    }
+
+#ifdef GEOMETRY_MMAP
+    // ============================ MAPPED MATRIX =============================
+    template<class T>
+    MappedMatrix<T>::MappedMatrix(const std::string& path, MapMode mode):
+        m_mode{mode}
+    {
+        const int fd = ::open(path.c_str(), (mode == MapMode::ReadOnly) ? O_RDONLY : O_RDWR);
+        if(fd < 0)
+            throw Exeptions::FileError(path, std::strerror(errno));
+        struct stat status{};
+        if((::fstat(fd, &status) != 0)
+           || (::pread(fd, &m_header, sizeof(m_header), 0) != static_cast<ssize_t>(sizeof(m_header))))
+        {
+            ::close(fd);
+            throw Exeptions::FileError(path, "cannot read the header");
+        }
+        try
+        {
+            utils::checkHeader(m_header, path, utils::dtypeOf<T>(), sizeof(T),
+                               static_cast<std::size_t>(status.st_size));
+        }
+        catch(...)
+        {
+            ::close(fd);
+            throw;
+        }
+        m_mappingBytes = m_header.dataOffset + utils::dataBytes(m_header);
+        const int protection = (mode == MapMode::ReadOnly) ? PROT_READ : (PROT_READ | PROT_WRITE);
+        void* mapping = ::mmap(nullptr, m_mappingBytes, protection, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd); // the mapping keeps the file
+        if(mapping == MAP_FAILED)
+            throw Exeptions::FileError(path, std::strerror(error));
+        mp_mapping = mapping;
+        mp_data = reinterpret_cast<T*>(static_cast<char*>(mapping) + m_header.dataOffset);
+    }
+
+    template<class T>
+    MappedMatrix<T> MappedMatrix<T>::create(const std::string& path, std::size_t line, std::size_t col,
+                                            Layout layout)
+    {
+        const MatrixFileHeader header = utils::makeHeader(utils::dtypeOf<T>(), sizeof(T), layout, line, col);
+        {
+            utils::File file(path, "wb");
+            file.write(&header, sizeof(header));
+            file.close();
+        }
+        if(::truncate(path.c_str(), header.dataOffset + utils::dataBytes(header)) != 0)
+            throw Exeptions::FileError(path, std::strerror(errno));
+        return MappedMatrix<T>(path, MapMode::ReadWrite);
+    }
+
+    template<class T>
+    MappedMatrix<T>::MappedMatrix(MappedMatrix<T>&& other) noexcept:
+        m_header{other.m_header},
+        m_mode{other.m_mode},
+        mp_mapping{std::exchange(other.mp_mapping, nullptr)},
+        m_mappingBytes{std::exchange(other.m_mappingBytes, 0)},
+        mp_data{std::exchange(other.mp_data, nullptr)}
+    {}
+
+    template<class T>
+    MappedMatrix<T>& MappedMatrix<T>::operator=(MappedMatrix<T>&& other) noexcept
+    {
+        if(this == &other)
+            return *this;
+        this->unmap();
+        m_header = other.m_header;
+        m_mode = other.m_mode;
+        mp_mapping = std::exchange(other.mp_mapping, nullptr);
+        m_mappingBytes = std::exchange(other.m_mappingBytes, 0);
+        mp_data = std::exchange(other.mp_data, nullptr);
+        return *this;
+    }
+
+    template<class T>
+    MappedMatrix<T>::~MappedMatrix()
+    {
+        this->unmap();
+    }
+
+    template<class T>
+    ConstMatrixView<T> MappedMatrix<T>::view() const
+    {
+        if(this->layout() == Layout::ColumnMajor)
+            return ConstMatrixView<T>(mp_data, this->nLines(), this->nColumns(), 1, m_header.lead);
+        return ConstMatrixView<T>(mp_data, this->nLines(), this->nColumns(), m_header.lead, 1);
+    }
+
+    template<class T>
+    MatrixView<T> MappedMatrix<T>::view()
+    {
+        if(this->layout() == Layout::ColumnMajor)
+            return MatrixView<T>(mp_data, this->nLines(), this->nColumns(), 1, m_header.lead);
+        return MatrixView<T>(mp_data, this->nLines(), this->nColumns(), m_header.lead, 1);
+    }
+
+    template<class T>
+    void MappedMatrix<T>::flush()
+    {
+        if(mp_mapping && (m_mode == MapMode::ReadWrite) && (::msync(mp_mapping, m_mappingBytes, MS_SYNC) != 0))
+            throw Exeptions::FileError("mapped matrix", std::strerror(errno));
+    }
+
+    template<class T>
+    void MappedMatrix<T>::unmap()
+    {
+        if(mp_mapping)
+            ::munmap(mp_mapping, m_mappingBytes);
+        mp_mapping = nullptr;
+        mp_data = nullptr;
+        m_mappingBytes = 0;
+    }
+#endif
+
+}
+#endif
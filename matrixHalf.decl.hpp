@@ -0,0 +1,148 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXHALF_DECL__GUARD__2610
+#define GEOMETRY__MATRIXHALF_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace geometry
+{
+    namespace utils{
+
+        // ----------------------------- ROUND TO ODD -------------------------
+        // value rounded toward zero to Narrow (float or double), the last
+        // mantissa bit set when that lost something. Rounding the result to
+        // nearest once more, into a format at least two bits narrower, gives
+        // the correctly rounded value: rounding double to float to nearest
+        // then to 16 bits would round twice (1 + 2^-11 + 2^-40 would give
+        // Float16 1 instead of 1 + 2^-10). Wide is a wider floating point
+        // type or an integer.
+        template<typename Narrow, typename Wide>
+        Narrow roundToOdd(Wide value);
+
+        // Every value of T is a float: going through float rounds once.
+        template<typename T>
+        constexpr bool exactInFloat = std::numeric_limits<T>::digits <= std::numeric_limits<float>::digits;
+
+        // ------------------------------ ENCODINGS ---------------------------
+        // 16-bit floating point formats, converted from float or double with
+        // rounding to nearest even (overflow goes to inf, NaN stays a quiet
+        // NaN) and back to float exactly.
+
+        // IEEE 754 binary16: 5 exponent bits, 10 mantissa bits. Largest value
+        // 65504, about 3 significant digits.
+        struct Binary16
+        {
+            static std::uint16_t fromFloat(float value);
+            static std::uint16_t fromDouble(double value);
+            static float toFloat(std::uint16_t bits);
+        };
+
+        // bfloat16: the upper half of a float. Same range as float, about 2
+        // significant digits.
+        struct BrainFloat16
+        {
+            static std::uint16_t fromFloat(float value);
+            static std::uint16_t fromDouble(double value);
+            static float toFloat(std::uint16_t bits);
+        };
+
+    }
+
+    // ------------------------------ REDUCED FLOAT ---------------------------
+    // A 16-bit storage type: half the bytes of float for memory-bound code.
+    // Every operation converts to float, computes there and rounds once, and
+    // the kernels (utils::elementWise, reduce, gemm) widen whole blocks to
+    // float the same way, so that sums and products accumulate in fp32 (see
+    // utils::accumulator_t). Converts implicitly from any arithmetic type,
+    // rounded once (see utils::roundToOdd), explicitly to them.
+    template<class Format>
+    class ReducedFloat
+    {
+    public: // METHODS
+        constexpr ReducedFloat() = default;
+        template<typename U, typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+        ReducedFloat(U value): m_bits{encode(value)} {}
+        // Between the two formats, through float.
+        template<class Other>
+        explicit ReducedFloat(ReducedFloat<Other> value): ReducedFloat(static_cast<float>(value)) {}
+
+        template<typename U, typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+        explicit operator U() const {return static_cast<U>(Format::toFloat(m_bits));}
+
+        // Raw encoding.
+        static constexpr ReducedFloat fromBits(std::uint16_t bits);
+        constexpr std::uint16_t bits() const {return m_bits;}
+
+        ReducedFloat& operator+=(ReducedFloat other);
+        ReducedFloat& operator-=(ReducedFloat other);
+        ReducedFloat& operator*=(ReducedFloat other);
+        ReducedFloat& operator/=(ReducedFloat other);
+
+        // Hidden friends: found for ReducedFloat operands only, the other one
+        // may be any arithmetic value.
+        friend ReducedFloat operator+(ReducedFloat a, ReducedFloat b) {return ReducedFloat(float(a) + float(b));}
+        friend ReducedFloat operator-(ReducedFloat a, ReducedFloat b) {return ReducedFloat(float(a) - float(b));}
+        friend ReducedFloat operator*(ReducedFloat a, ReducedFloat b) {return ReducedFloat(float(a) * float(b));}
+        friend ReducedFloat operator/(ReducedFloat a, ReducedFloat b) {return ReducedFloat(float(a) / float(b));}
+        friend ReducedFloat operator-(ReducedFloat a) {return fromBits(static_cast<std::uint16_t>(a.m_bits ^ 0x8000u));}
+
+        friend bool operator==(ReducedFloat a, ReducedFloat b) {return float(a) == float(b);}
+        friend bool operator!=(ReducedFloat a, ReducedFloat b) {return float(a) != float(b);}
+        friend bool operator<(ReducedFloat a, ReducedFloat b) {return float(a) < float(b);}
+        friend bool operator<=(ReducedFloat a, ReducedFloat b) {return float(a) <= float(b);}
+        friend bool operator>(ReducedFloat a, ReducedFloat b) {return float(a) > float(b);}
+        friend bool operator>=(ReducedFloat a, ReducedFloat b) {return float(a) >= float(b);}
+
+        friend std::ostream& operator<<(std::ostream& out, ReducedFloat value) {return out << float(value);}
+
+    private: // ATTRIBUTES
+        std::uint16_t m_bits{0};
+
+    private: // METHODS
+        template<typename U>
+        static std::uint16_t encode(U value);
+    };
+
+    using Float16 = ReducedFloat<utils::Binary16>;
+    using BFloat16 = ReducedFloat<utils::BrainFloat16>;
+
+    namespace utils{
+
+        template<typename T>
+        constexpr bool isReducedFloat = false;
+        template<class Format>
+        constexpr bool isReducedFloat<ReducedFloat<Format>> = true;
+
+        // Type sums and products of T accumulate in: float for the 16-bit
+        // types, 64 bits for integers (signed or not like T), T itself
+        // otherwise.
+        template<typename T, typename = void>
+        struct Accumulator {using type = T;};
+        template<typename T>
+        struct Accumulator<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+        {
+            using type = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+        };
+        template<class Format>
+        struct Accumulator<ReducedFloat<Format>> {using type = float;};
+
+        template<typename T>
+        using accumulator_t = typename Accumulator<T>::type;
+
+        // Type of means and norms: double when T accumulates in integers,
+        // accumulator_t<T> otherwise.
+        template<typename T>
+        using real_t = std::conditional_t<std::is_integral_v<accumulator_t<T>>, double, accumulator_t<T>>;
+
+    }
+}
+#endif
@@ -0,0 +1,211 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXHALF_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXHALF_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#ifdef __F16C__
+    #include <immintrin.h>
+#endif
+
+// LOCAL INCLUDES
+#include "matrixHalf.decl.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // ----------------------------- ROUND TO ODD -------------------------
+        template<typename Narrow, typename Wide>
+        Narrow roundToOdd(Wide value)
+        {
+            Narrow narrow;
+            if constexpr (std::is_integral_v<Wide>)
+            {
+                // Top digits of the magnitude, the ones shifted out or'ed in.
+                using Magnitude = std::make_unsigned_t<Wide>;
+                const bool negative = value < 0;
+                Magnitude magnitude = negative ? Magnitude(0) - static_cast<Magnitude>(value)
+                                               : static_cast<Magnitude>(value);
+                int shift = 0;
+                while((magnitude >> shift) >> std::numeric_limits<Narrow>::digits)
+                    shift++;
+                Magnitude kept = magnitude >> shift;
+                if((shift > 0) && ((kept << shift) != magnitude))
+                    kept |= 1;
+                narrow = std::ldexp(static_cast<Narrow>(kept), shift);
+                return negative ? -narrow : narrow;
+            }
+            else
+            {
+                narrow = static_cast<Narrow>(value);
+                if(value != value) // NaN
+                    return narrow;
+                if(std::fabs(narrow) > std::fabs(value))
+                    narrow = std::nextafter(narrow, Narrow(0));
+                if(narrow != value)
+                {
+                    std::conditional_t<sizeof(Narrow) == 4, std::uint32_t, std::uint64_t> bits;
+                    std::memcpy(&bits, &narrow, sizeof(bits));
+                    bits |= 1;
+                    std::memcpy(&narrow, &bits, sizeof(bits));
+                }
+                return narrow;
+            }
+        }
+
+        // ------------------------------ ENCODINGS ---------------------------
+        // Builds targeting F16C (-mf16c, -march=native...) convert single
+        // values with the instructions too, the same results.
+        inline std::uint16_t Binary16::fromFloat(float value)
+        {
+#ifdef __F16C__
+            return static_cast<std::uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+            const std::uint32_t magnitude = bits & 0x7FFFFFFFu;
+            if(magnitude >= 0x7F800000u) // inf, NaN (quiet, top of the payload kept)
+                return sign | 0x7C00u | ((magnitude > 0x7F800000u) ? (0x0200u | ((magnitude >> 13) & 0x03FFu)) : 0u);
+            if(magnitude >= 0x477FF000u) // 65520 and above round to inf
+                return sign | 0x7C00u;
+            if(magnitude < 0x33000000u)  // below 2^-25: rounds to 0
+                return sign;
+            std::uint32_t result, remainder, halfway;
+            if(magnitude < 0x38800000u)  // below 2^-14: subnormal, units of 2^-24
+            {
+                const std::uint32_t mantissa = (magnitude & 0x007FFFFFu) | 0x00800000u;
+                const std::uint32_t shift = 126 - (magnitude >> 23);
+                result = mantissa >> shift;
+                remainder = mantissa & ((1u << shift) - 1);
+                halfway = 1u << (shift - 1);
+            }
+            else // rebias the exponent from 127 to 15
+            {
+                result = (magnitude >> 13) - (112u << 10);
+                remainder = magnitude & 0x1FFFu;
+                halfway = 0x1000u;
+            }
+            // A carry out of the mantissa bumps the exponent, as it should.
+            if((remainder > halfway) || ((remainder == halfway) && (result & 1u)))
+                result++;
+            return static_cast<std::uint16_t>(sign | result);
+#endif
+        }
+
+        inline std::uint16_t Binary16::fromDouble(double value)
+        {
+            return fromFloat(roundToOdd<float>(value));
+        }
+
+        inline float Binary16::toFloat(std::uint16_t half)
+        {
+#ifdef __F16C__
+            return _cvtsh_ss(half);
+#else
+            const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+            std::uint32_t exponent = (half >> 10) & 0x1Fu;
+            std::uint32_t mantissa = half & 0x03FFu;
+            std::uint32_t bits;
+            if(exponent == 0x1Fu) // inf, NaN (made quiet like F16C does)
+                bits = sign | 0x7F800000u | (mantissa << 13) | ((mantissa != 0) ? 0x00400000u : 0u);
+            else if(exponent != 0)
+                bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+            else if(mantissa == 0)
+                bits = sign;
+            else // subnormal: normalized in float
+            {
+                exponent = 113;
+                while((mantissa & 0x0400u) == 0)
+                {
+                    mantissa <<= 1;
+                    exponent--;
+                }
+                bits = sign | (exponent << 23) | ((mantissa & 0x03FFu) << 13);
+            }
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+#endif
+        }
+
+        inline std::uint16_t BrainFloat16::fromFloat(float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            if((bits & 0x7FFFFFFFu) > 0x7F800000u) // NaN: truncated, kept quiet
+                return static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+            bits += 0x7FFFu + ((bits >> 16) & 1u);
+            return static_cast<std::uint16_t>(bits >> 16);
+        }
+
+        inline std::uint16_t BrainFloat16::fromDouble(double value)
+        {
+            return fromFloat(roundToOdd<float>(value));
+        }
+
+        inline float BrainFloat16::toFloat(std::uint16_t half)
+        {
+            const std::uint32_t bits = static_cast<std::uint32_t>(half) << 16;
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+    }
+
+    // ------------------------------ REDUCED FLOAT ---------------------------
+    template<class Format> template<typename U>
+    std::uint16_t ReducedFloat<Format>::encode(U value)
+    {
+        if constexpr (utils::exactInFloat<U>)
+            return Format::fromFloat(static_cast<float>(value));
+        else if constexpr (std::numeric_limits<U>::digits <= std::numeric_limits<double>::digits)
+            return Format::fromDouble(static_cast<double>(value));
+        else // 64-bit integers, long double
+            return Format::fromDouble(utils::roundToOdd<double>(value));
+    }
+
+    template<class Format>
+    constexpr ReducedFloat<Format> ReducedFloat<Format>::fromBits(std::uint16_t bits)
+    {
+        ReducedFloat value;
+        value.m_bits = bits;
+        return value;
+    }
+
+    template<class Format>
+    ReducedFloat<Format>& ReducedFloat<Format>::operator+=(ReducedFloat other)
+    {
+        return *this = *this + other;
+    }
+
+    template<class Format>
+    ReducedFloat<Format>& ReducedFloat<Format>::operator-=(ReducedFloat other)
+    {
+        return *this = *this - other;
+    }
+
+    template<class Format>
+    ReducedFloat<Format>& ReducedFloat<Format>::operator*=(ReducedFloat other)
+    {
+        return *this = *this * other;
+    }
+
+    template<class Format>
+    ReducedFloat<Format>& ReducedFloat<Format>::operator/=(ReducedFloat other)
+    {
+        return *this = *this / other;
+    }
+
+}
+#endif
@@ -0,0 +1,162 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXINSTRUMENTATION_DECL__GUARD__2610
+#define GEOMETRY__MATRIXINSTRUMENTATION_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Opt-in counters of what the matrices do: storage allocations and bytes,
+// deep copies, moves, and calls, time and shapes of the operations. Build
+// with -DGEOMETRY_INSTRUMENT (the whole program, the hooks live in
+// templates) to turn them on. Without it every hook below compiles to
+// nothing: its arguments only appear in sizeof, which keeps them used
+// (no -Wunused-parameter) without evaluating them, and the snapshot stays
+// empty.
+//     Matrix<double> c = a*b + a;
+//     geometry::utils::instrumentation().writeJson(std::cout);
+#ifdef GEOMETRY_INSTRUMENT
+    #define GEOMETRY_COUNT_ALLOCATION(bytes)   ::geometry::utils::instrumentation().allocation(bytes)
+    #define GEOMETRY_COUNT_DEALLOCATION(bytes) ::geometry::utils::instrumentation().deallocation(bytes)
+    #define GEOMETRY_COUNT_COPY(bytes)         ::geometry::utils::instrumentation().copy(bytes)
+    #define GEOMETRY_COUNT_MOVE()              ::geometry::utils::instrumentation().move()
+    // Times the rest of the enclosing scope as the operation name (a
+    // string literal) on a nLines x nColumns result.
+    #define GEOMETRY_TRACE(name, nLines, nColumns) \
+        const ::geometry::utils::TraceScope geometryTraceScope{name, nLines, nColumns}
+#else
+    #define GEOMETRY_COUNT_ALLOCATION(bytes)   ((void)sizeof(bytes))
+    #define GEOMETRY_COUNT_DEALLOCATION(bytes) ((void)sizeof(bytes))
+    #define GEOMETRY_COUNT_COPY(bytes)         ((void)sizeof(bytes))
+    #define GEOMETRY_COUNT_MOVE()              ((void)0)
+    #define GEOMETRY_TRACE(name, nLines, nColumns) \
+        ((void)sizeof(name), (void)sizeof(nLines), (void)sizeof(nColumns))
+#endif
+
+namespace geometry{
+
+    namespace utils{
+
+#ifdef GEOMETRY_INSTRUMENT
+        constexpr bool instrumentationEnabled = true;
+#else
+        constexpr bool instrumentationEnabled = false;
+#endif
+
+        struct OperationCounter
+        {
+            std::string name{};
+            std::uint64_t calls{0};
+            std::uint64_t nanoseconds{0}; // nested operations included
+            std::uint64_t elements{0};    // of the results
+        };
+
+        struct InstrumentationSnapshot
+        {
+            std::uint64_t allocations{0};
+            std::uint64_t deallocations{0};
+            std::uint64_t allocatedBytes{0};
+            std::uint64_t liveBytes{0};
+            std::uint64_t peakBytes{0};
+            std::uint64_t copies{0};
+            std::uint64_t copiedBytes{0};
+            std::uint64_t moves{0};
+            std::uint64_t droppedEvents{0}; // trace events past the capacity
+            std::vector<OperationCounter> operations{}; // most time first
+        };
+
+        // One timed operation, times in ns since the instrumentation started.
+        struct TraceEvent
+        {
+            const char* name;
+            std::uint64_t start;
+            std::uint64_t duration;
+            std::size_t nLines;
+            std::size_t nColumns;
+            std::uint32_t thread;
+        };
+
+        // Process-wide counters, safe from every thread. The counts are
+        // atomics, operations and trace events go under a mutex.
+        class Instrumentation
+        {
+        public: // METHODS
+            Instrumentation();
+
+            void allocation(std::size_t bytes);
+            void deallocation(std::size_t bytes);
+            void copy(std::size_t bytes);
+            void move();
+            void record(const char* name, std::uint64_t start, std::uint64_t duration,
+                        std::size_t nLines, std::size_t nColumns);
+
+            // ns since the instrumentation started.
+            std::uint64_t now() const;
+
+            InstrumentationSnapshot snapshot() const;
+            // Counters and events back to zero. Live bytes stay (the peak restarts
+            // from them) and times keep their origin.
+            void reset();
+            // Trace events kept (1M by default), later ones are only counted.
+            void setTraceCapacity(std::size_t events);
+
+            // The snapshot as a JSON object.
+            void writeJson(std::ostream& out) const;
+            // The trace events in the Chrome trace event format, which
+            // chrome://tracing and Perfetto open.
+            void writeChromeTrace(std::ostream& out) const;
+
+        protected:
+            std::atomic<std::uint64_t> m_allocations{0};
+            std::atomic<std::uint64_t> m_deallocations{0};
+            std::atomic<std::uint64_t> m_allocatedBytes{0};
+            std::atomic<std::uint64_t> m_liveBytes{0};
+            std::atomic<std::uint64_t> m_peakBytes{0};
+            std::atomic<std::uint64_t> m_copies{0};
+            std::atomic<std::uint64_t> m_copiedBytes{0};
+            std::atomic<std::uint64_t> m_moves{0};
+            std::atomic<std::uint64_t> m_droppedEvents{0};
+
+            mutable std::mutex m_mutex;
+            // Keyed by the name literal, merged by text in snapshot().
+            std::unordered_map<const char*, OperationCounter> m_operations{};
+            std::vector<TraceEvent> m_events{};
+            std::size_t m_traceCapacity{std::size_t{1} << 20};
+            std::chrono::steady_clock::time_point m_origin{};
+        };
+
+        Instrumentation& instrumentation();
+
+        // Small index of the calling thread, for the trace.
+        std::uint32_t traceThread();
+
+        class TraceScope
+        {
+        public:
+            TraceScope(const char* name, std::size_t nLines, std::size_t nColumns);
+            ~TraceScope();
+            TraceScope(const TraceScope&) = delete;
+            TraceScope& operator=(const TraceScope&) = delete;
+
+        protected:
+            const char* mp_name;
+            std::size_t m_nLines;
+            std::size_t m_nColumns;
+            std::uint64_t m_start;
+        };
+
+    }
+}
+#endif
@@ -0,0 +1,207 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXINSTRUMENTATION_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXINSTRUMENTATION_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <thread>
+
+// LOCAL INCLUDES
+#include "matrixInstrumentation.decl.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // ---------------------------- INSTRUMENTATION -----------------------
+        inline Instrumentation::Instrumentation():
+            m_origin{std::chrono::steady_clock::now()}
+            {}
+
+        inline void Instrumentation::allocation(std::size_t bytes)
+        {
+            m_allocations.fetch_add(1, std::memory_order_relaxed);
+            m_allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+            const std::uint64_t live = m_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            std::uint64_t peak = m_peakBytes.load(std::memory_order_relaxed);
+            while((live > peak) && !m_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+                {}
+        }
+
+        inline void Instrumentation::deallocation(std::size_t bytes)
+        {
+            m_deallocations.fetch_add(1, std::memory_order_relaxed);
+            m_liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        inline void Instrumentation::copy(std::size_t bytes)
+        {
+            m_copies.fetch_add(1, std::memory_order_relaxed);
+            m_copiedBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        inline void Instrumentation::move()
+        {
+            m_moves.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline void Instrumentation::record(const char* name, std::uint64_t start, std::uint64_t duration,
+                                            std::size_t nLines, std::size_t nColumns)
+        {
+            const std::uint32_t thread = traceThread();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            OperationCounter& counter = m_operations[name];
+            counter.calls++;
+            counter.nanoseconds += duration;
+            counter.elements += nLines*nColumns;
+            if(m_events.size() < m_traceCapacity)
+                m_events.push_back({name, start, duration, nLines, nColumns, thread});
+            else
+                m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline std::uint64_t Instrumentation::now() const
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_origin).count());
+        }
+
+        inline InstrumentationSnapshot Instrumentation::snapshot() const
+        {
+            InstrumentationSnapshot snapshot;
+            snapshot.allocations = m_allocations.load();
+            snapshot.deallocations = m_deallocations.load();
+            snapshot.allocatedBytes = m_allocatedBytes.load();
+            snapshot.liveBytes = m_liveBytes.load();
+            snapshot.peakBytes = m_peakBytes.load();
+            snapshot.copies = m_copies.load();
+            snapshot.copiedBytes = m_copiedBytes.load();
+            snapshot.moves = m_moves.load();
+            snapshot.droppedEvents = m_droppedEvents.load();
+
+            // The same literal may have one address per translation unit.
+            std::map<std::string, OperationCounter> operations;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for(const auto& [name, counter]: m_operations)
+                {
+                    OperationCounter& merged = operations[name];
+                    merged.calls += counter.calls;
+                    merged.nanoseconds += counter.nanoseconds;
+                    merged.elements += counter.elements;
+                }
+            }
+            for(auto& [name, counter]: operations)
+            {
+                counter.name = name;
+                snapshot.operations.push_back(std::move(counter));
+            }
+            std::stable_sort(snapshot.operations.begin(), snapshot.operations.end(),
+                             [](const OperationCounter& a, const OperationCounter& b){
+                                 return a.nanoseconds > b.nanoseconds;
+                             });
+            return snapshot;
+        }
+
+        inline void Instrumentation::reset()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(std::atomic<std::uint64_t>* counter: {&m_allocations, &m_deallocations, &m_allocatedBytes,
+                                                      &m_copies, &m_copiedBytes, &m_moves, &m_droppedEvents})
+                counter->store(0);
+            m_peakBytes.store(m_liveBytes.load()); // live storage is still there
+            m_operations.clear();
+            m_events.clear();
+        }
+
+        inline void Instrumentation::setTraceCapacity(std::size_t events)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_traceCapacity = events;
+        }
+
+        inline void Instrumentation::writeJson(std::ostream& out) const
+        {
+            const InstrumentationSnapshot snapshot = this->snapshot();
+            out << "{\"enabled\": " << (instrumentationEnabled ? "true" : "false")
+                << ", \"allocations\": " << snapshot.allocations
+                << ", \"deallocations\": " << snapshot.deallocations
+                << ", \"allocated_bytes\": " << snapshot.allocatedBytes
+                << ", \"live_bytes\": " << snapshot.liveBytes
+                << ", \"peak_bytes\": " << snapshot.peakBytes
+                << ", \"copies\": " << snapshot.copies
+                << ", \"copied_bytes\": " << snapshot.copiedBytes
+                << ", \"moves\": " << snapshot.moves
+                << ", \"dropped_events\": " << snapshot.droppedEvents
+                << ",\n \"operations\": [";
+            for(std::size_t i=0; i<snapshot.operations.size(); i++)
+            {
+                const OperationCounter& counter = snapshot.operations[i];
+                out << ((i == 0) ? "\n  " : ",\n  ")
+                    << "{\"name\": \"" << counter.name << "\", \"calls\": " << counter.calls
+                    << ", \"ns\": " << counter.nanoseconds << ", \"elements\": " << counter.elements << "}";
+            }
+            out << "]}\n";
+        }
+
+        inline void Instrumentation::writeChromeTrace(std::ostream& out) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // Complete events ("X"), times in microseconds with ns digits.
+            auto microseconds = [&out](std::uint64_t ns)
+            {
+                out << ns/1000 << '.' << (ns/100)%10 << (ns/10)%10 << ns%10;
+            };
+            out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+            for(std::size_t i=0; i<m_events.size(); i++)
+            {
+                const TraceEvent& event = m_events[i];
+                out << ((i == 0) ? "\n" : ",\n")
+                    << "{\"name\": \"" << event.name << "\", \"cat\": \"geometry\", \"ph\": \"X\", \"ts\": ";
+                microseconds(event.start);
+                out << ", \"dur\": ";
+                microseconds(event.duration);
+                out << ", \"pid\": 1, \"tid\": " << event.thread
+                    << ", \"args\": {\"lines\": " << event.nLines << ", \"columns\": " << event.nColumns << "}}";
+            }
+            out << "\n]}\n";
+        }
+
+        inline Instrumentation& instrumentation()
+        {
+            static Instrumentation counters;
+            return counters;
+        }
+
+        inline std::uint32_t traceThread()
+        {
+            static std::atomic<std::uint32_t> next{0};
+            thread_local const std::uint32_t thread = next.fetch_add(1);
+            return thread;
+        }
+
+        // ------------------------------- TRACE SCOPE ------------------------
+        inline TraceScope::TraceScope(const char* name, std::size_t nLines, std::size_t nColumns):
+            mp_name{name},
+            m_nLines{nLines},
+            m_nColumns{nColumns},
+            m_start{instrumentation().now()}
+            {}
+
+        inline TraceScope::~TraceScope()
+        {
+            Instrumentation& counters = instrumentation();
+            const std::uint64_t end = counters.now();
+            counters.record(mp_name, m_start, (end > m_start) ? end - m_start : 0, m_nLines, m_nColumns);
+        }
+
+    }
+}
+#endif
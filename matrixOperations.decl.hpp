@@ -10,13 +10,24 @@ Author: R. Tonneau (romain.tonneau@gmail.com)
 
 // STANDARD INCLUDES
 #include <iostream>
+#include <cstddef>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "matrixExpressions.decl.hpp"
 
 namespace geometry{
 
-    template<typename T> class Matrix; // Need to forward declare matrix.
+    // Lazy: evaluated when assigned to a Matrix (x = transpose(x) is safe).
+    template<class E>
+    utils::TransposeExpression<utils::operand_t<E>>
+    transpose(const utils::MatrixExpression<E>& obj);
 
-    template<typename T>
-    Matrix<T> transpose(const Matrix<T>& obj);
+    // Eager version writing into out (reshaped when needed), using the tiled
+    // SIMD kernel of matrixTranspose.decl.hpp. nThreads != 0 caps the
+    // threads it may use (0: see matrixParallel.decl.hpp).
+    template<typename T, class Alloc, Layout Order>
+    void transpose(const Matrix<T, Alloc, Order>& obj, Matrix<T, Alloc, Order>& out, std::size_t nThreads = 0);
 
 }
 #endif
\ No newline at end of file
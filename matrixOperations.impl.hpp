@@ -14,13 +14,31 @@ Author: R. Tonneau (romain.tonneau@gmail.com)
 #include "matrixOperations.decl.hpp"
 #include "matrix.decl.hpp"
 #include "matrixUtils.hpp"
+#include "matrixExpressions.hpp"
+#include "matrixTranspose.hpp"
+#include "matrixInstrumentation.hpp"
 
 
 namespace geometry{
 
-    template<typename T>
-    Matrix<T> transpose(const Matrix<T>& obj){
-        return Matrix<T>(utils::TransposeMCH<T>(&obj.getElements(), &obj.dimension()));
+    template<class E>
+    utils::TransposeExpression<utils::operand_t<E>>
+    transpose(const utils::MatrixExpression<E>& obj){
+        return utils::TransposeExpression<utils::operand_t<E>>(utils::makeOperand(obj));
+    }
+
+    template<typename T, class Alloc, Layout Order>
+    void transpose(const Matrix<T, Alloc, Order>& obj, Matrix<T, Alloc, Order>& out, std::size_t nThreads){
+        if(&obj == &out)
+        {
+            out.transposeInPlace();
+            return;
+        }
+        if((out.nLines() != obj.nColumns()) || (out.nColumns() != obj.nLines()))
+            out = Matrix<T, Alloc, Order>(obj.nColumns(), obj.nLines(), out.get_allocator());
+        GEOMETRY_TRACE("transpose", out.nLines(), out.nColumns());
+        utils::transpose(obj.storageLines(), obj.storageColumns(), obj.data(), obj.leadingDimension(),
+                         out.data(), out.leadingDimension(), nThreads);
     }
 
 }
@@ -0,0 +1,159 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXPARALLEL_DECL__GUARD__2610
+#define GEOMETRY__MATRIXPARALLEL_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geometry
+{
+    namespace utils{
+
+        // ------------------------------- BACKENDS ---------------------------
+        // Where the library runs its parallel loops. Big element-wise
+        // operations, expression evaluation, transpose and the product split
+        // their work into contiguous chunks and hand them to the current
+        // backend, which only has to run a batch of independent tasks.
+        class ExecutionBackend
+        {
+        public:
+            virtual ~ExecutionBackend() {}
+
+            // Threads that can run tasks at the same time, caller included.
+            virtual std::size_t concurrency() const = 0;
+
+            // Run task(i) for every i in [0, nTasks) and return once they are
+            // all done. An exception thrown by a task is rethrown here.
+            virtual void run(std::size_t nTasks, const std::function<void(std::size_t)>& task) = 0;
+        };
+
+        // Everything on the calling thread.
+        class SerialBackend: public ExecutionBackend
+        {
+        public:
+            std::size_t concurrency() const override {return 1;}
+            void run(std::size_t nTasks, const std::function<void(std::size_t)>& task) override;
+        };
+
+        // Work-stealing pool, the default backend. Each worker owns a task
+        // deque: it pops its own tasks from the back and steals from the
+        // front of the others when it runs dry. The calling thread steals
+        // too while it waits, so nested parallel loops cannot deadlock.
+        class ThreadPool: public ExecutionBackend
+        {
+        public:
+            // nWorkers threads on top of the callers.
+            explicit ThreadPool(std::size_t nWorkers);
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            std::size_t concurrency() const override {return m_threads.size() + 1;}
+            void run(std::size_t nTasks, const std::function<void(std::size_t)>& task) override;
+
+            // Shared pool with hardware_concurrency() - 1 workers, or
+            // GEOMETRY_NUM_THREADS - 1 when that variable is set.
+            static ThreadPool& global();
+
+        protected:
+            struct Batch;
+            struct Job
+            {
+                Batch* batch;
+                std::size_t index;
+            };
+            struct Queue
+            {
+                std::mutex mutex;
+                std::deque<Job> jobs;
+            };
+
+            std::vector<std::thread> m_threads;
+            std::vector<std::unique_ptr<Queue>> m_queues; // one per worker
+            std::atomic<std::size_t> m_queued{0}; // jobs in a queue, not yet taken
+            std::atomic<std::size_t> m_next{0};
+            std::mutex m_sleepMutex;
+            std::condition_variable m_wake;
+            bool m_stop{false};
+
+            void workerLoop(std::size_t self);
+            bool pop(std::size_t self, Job& job);
+            bool steal(std::size_t self, Job& job);
+            void execute(const Job& job);
+        };
+
+#ifdef GEOMETRY_STD_EXECUTION
+        // Adapter over the standard parallel algorithms (std::execution::par),
+        // built when GEOMETRY_STD_EXECUTION is defined (libstdc++ then needs
+        // -ltbb). An exception escaping a task calls std::terminate, as for
+        // any parallel algorithm.
+        class StdExecutionBackend: public ExecutionBackend
+        {
+        public:
+            std::size_t concurrency() const override;
+            void run(std::size_t nTasks, const std::function<void(std::size_t)>& task) override;
+        };
+#endif
+
+        // nullptr goes back to ThreadPool::global(). The backend must outlive
+        // every call made while it is installed.
+        void setExecutionBackend(ExecutionBackend* backend);
+        ExecutionBackend& executionBackend();
+
+        // ---------------------------- CONFIGURATION -------------------------
+        // Operations touching fewer elements stay on the calling thread.
+        void setParallelThreshold(std::size_t elements);
+        std::size_t parallelThreshold();
+
+        // Caps the chunks each call made from this thread splits into while
+        // it is alive, so that the library fits in an outer scheduler:
+        //     { ThreadLimit limit(4); a += b; }
+        // Limits nest, the innermost one wins. The cap is per call, not a
+        // budget: the tasks of a call run under the same cap on the workers,
+        // so a loop nested in a 4-chunk loop may split in 4 again, and up to
+        // 16 tasks (never more threads than the backend has) run at once.
+        // Inner calls under ThreadLimit(1) keep a whole computation within n.
+        class ThreadLimit
+        {
+        public:
+            explicit ThreadLimit(std::size_t nThreads);
+            ~ThreadLimit();
+
+            ThreadLimit(const ThreadLimit&) = delete;
+            ThreadLimit& operator=(const ThreadLimit&) = delete;
+
+        protected:
+            std::size_t m_previous;
+        };
+
+        // Chunks a call may split into from here: backend concurrency, capped
+        // by the current ThreadLimit.
+        std::size_t maxThreads();
+
+        // Threads an operation of this size gets: 1 under the threshold.
+        std::size_t parallelism(std::size_t work);
+
+        // ------------------------------ PARALLEL LOOP -----------------------
+        // Split [0, n) in one contiguous range per thread and call
+        // body(begin, end) on each. work is the number of elements the whole
+        // loop touches, compared with parallelThreshold().
+        template<class Body>
+        void parallelFor(std::size_t n, std::size_t work, Body body);
+
+    }
+}
+#endif
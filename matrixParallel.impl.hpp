@@ -0,0 +1,294 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXPARALLEL_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXPARALLEL_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <numeric>
+#include <utility>
+#ifdef GEOMETRY_STD_EXECUTION
+    #include <execution>
+#endif
+
+// LOCAL INCLUDES
+#include "matrixParallel.decl.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        std::size_t& threadLimitSlot(); // see CONFIGURATION
+
+        // ---------------------------- SERIAL BACKEND ------------------------
+        inline void SerialBackend::run(std::size_t nTasks, const std::function<void(std::size_t)>& task)
+        {
+            for(std::size_t i=0; i<nTasks; i++)
+                task(i);
+        }
+
+        // ------------------------------ THREAD POOL -------------------------
+        struct ThreadPool::Batch
+        {
+            const std::function<void(std::size_t)>* task;
+            std::size_t threadLimit; // of the caller, for the nested loops
+            std::size_t remaining;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+
+        inline ThreadPool::ThreadPool(std::size_t nWorkers)
+        {
+            for(std::size_t i=0; i<nWorkers; i++)
+                m_queues.push_back(std::make_unique<Queue>());
+            m_threads.reserve(nWorkers);
+            for(std::size_t i=0; i<nWorkers; i++)
+                m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+
+        inline ThreadPool::~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for(auto& thread: m_threads)
+                thread.join();
+        }
+
+        inline ThreadPool& ThreadPool::global()
+        {
+            static ThreadPool pool([]{
+                std::size_t nThreads = std::thread::hardware_concurrency();
+                if(const char* forced = std::getenv("GEOMETRY_NUM_THREADS"))
+                    if(const std::size_t value = std::strtoul(forced, nullptr, 10))
+                        nThreads = value;
+                return (nThreads > 1) ? nThreads - 1 : 0;
+            }());
+            return pool;
+        }
+
+        inline void ThreadPool::run(std::size_t nTasks, const std::function<void(std::size_t)>& task)
+        {
+            if(m_queues.empty() || (nTasks <= 1))
+            {
+                for(std::size_t i=0; i<nTasks; i++)
+                    task(i);
+                return;
+            }
+
+            Batch batch;
+            batch.task = &task;
+            batch.threadLimit = threadLimitSlot();
+            batch.remaining = nTasks;
+
+            // Round robin over the workers, starting where the last batch
+            // stopped so that concurrent callers spread their tasks.
+            const std::size_t first = m_next.fetch_add(nTasks);
+            for(std::size_t i=0; i<nTasks; i++)
+            {
+                Queue& queue = *m_queues[(first + i)%m_queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.jobs.push_back({&batch, i});
+                m_queued.fetch_add(1);
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_wake.notify_all();
+
+            // Help until nothing is left to steal, then wait for the rest.
+            Job job;
+            while(steal(m_queues.size(), job))
+                execute(job);
+            std::unique_lock<std::mutex> lock(batch.mutex);
+            batch.done.wait(lock, [&]{return batch.remaining == 0;});
+            if(batch.error)
+                std::rethrow_exception(batch.error);
+        }
+
+        inline void ThreadPool::workerLoop(std::size_t self)
+        {
+            while(true)
+            {
+                Job job;
+                if(pop(self, job) || steal(self, job))
+                {
+                    execute(job);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_sleepMutex);
+                // Only jobs still waiting in a queue: the running ones give
+                // a sleeping worker nothing to do.
+                m_wake.wait(lock, [&]{return m_stop || (m_queued.load() > 0);});
+                if(m_stop)
+                    return;
+            }
+        }
+
+        inline bool ThreadPool::pop(std::size_t self, Job& job)
+        {
+            Queue& queue = *m_queues[self];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(queue.jobs.empty())
+                return false;
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+            m_queued.fetch_sub(1);
+            return true;
+        }
+
+        // self == m_queues.size() for a calling thread: it owns no queue.
+        inline bool ThreadPool::steal(std::size_t self, Job& job)
+        {
+            const std::size_t n = m_queues.size();
+            for(std::size_t k=1; k<=n; k++)
+            {
+                Queue& queue = *m_queues[(self + k)%n];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if(queue.jobs.empty())
+                    continue;
+                job = queue.jobs.front();
+                queue.jobs.pop_front();
+                m_queued.fetch_sub(1);
+                return true;
+            }
+            return false;
+        }
+
+        inline void ThreadPool::execute(const Job& job)
+        {
+            Batch& batch = *job.batch;
+            std::exception_ptr error;
+            // The task runs under the ThreadLimit of the thread that
+            // submitted it, whichever thread picked it up.
+            const std::size_t previousLimit = std::exchange(threadLimitSlot(), batch.threadLimit);
+            try
+            {
+                (*batch.task)(job.index);
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+            threadLimitSlot() = previousLimit;
+            // Under the lock: the caller may destroy the batch as soon as
+            // it sees remaining == 0.
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            if(error && !batch.error)
+                batch.error = error;
+            if(--batch.remaining == 0)
+                batch.done.notify_all();
+        }
+
+#ifdef GEOMETRY_STD_EXECUTION
+        // -------------------------- STD::EXECUTION ADAPTER ------------------
+        inline std::size_t StdExecutionBackend::concurrency() const
+        {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        inline void StdExecutionBackend::run(std::size_t nTasks, const std::function<void(std::size_t)>& task)
+        {
+            std::vector<std::size_t> indices(nTasks);
+            std::iota(indices.begin(), indices.end(), std::size_t{0});
+            const std::size_t limit = threadLimitSlot();
+            std::for_each(std::execution::par, indices.begin(), indices.end(),
+                          [&](std::size_t i){
+                              const std::size_t previous = std::exchange(threadLimitSlot(), limit);
+                              task(i);
+                              threadLimitSlot() = previous;
+                          });
+        }
+#endif
+
+        // ----------------------------- CONFIGURATION ------------------------
+        inline std::atomic<ExecutionBackend*>& backendSlot()
+        {
+            static std::atomic<ExecutionBackend*> backend{nullptr};
+            return backend;
+        }
+
+        inline void setExecutionBackend(ExecutionBackend* backend)
+        {
+            backendSlot().store(backend);
+        }
+
+        inline ExecutionBackend& executionBackend()
+        {
+            ExecutionBackend* backend = backendSlot().load();
+            return backend ? *backend : ThreadPool::global();
+        }
+
+        inline std::atomic<std::size_t>& thresholdSlot()
+        {
+            static std::atomic<std::size_t> threshold{std::size_t{1} << 18};
+            return threshold;
+        }
+
+        inline void setParallelThreshold(std::size_t elements)
+        {
+            thresholdSlot().store(elements);
+        }
+
+        inline std::size_t parallelThreshold()
+        {
+            return thresholdSlot().load();
+        }
+
+        inline std::size_t& threadLimitSlot() // 0: no limit
+        {
+            static thread_local std::size_t limit = 0;
+            return limit;
+        }
+
+        inline ThreadLimit::ThreadLimit(std::size_t nThreads):
+            m_previous{threadLimitSlot()}
+        {
+            threadLimitSlot() = std::max<std::size_t>(nThreads, 1);
+        }
+
+        inline ThreadLimit::~ThreadLimit()
+        {
+            threadLimitSlot() = m_previous;
+        }
+
+        inline std::size_t maxThreads()
+        {
+            const std::size_t concurrency = executionBackend().concurrency();
+            const std::size_t limit = threadLimitSlot();
+            return (limit == 0) ? concurrency : std::min(limit, concurrency);
+        }
+
+        inline std::size_t parallelism(std::size_t work)
+        {
+            return (work < parallelThreshold()) ? 1 : maxThreads();
+        }
+
+        // ------------------------------ PARALLEL LOOP -----------------------
+        template<class Body>
+        void parallelFor(std::size_t n, std::size_t work, Body body)
+        {
+            const std::size_t nChunks = std::min(n, parallelism(work));
+            if(nChunks <= 1)
+            {
+                if(n > 0)
+                    body(std::size_t{0}, n);
+                return;
+            }
+            executionBackend().run(nChunks, [&](std::size_t i){
+                body(n*i/nChunks, n*(i+1)/nChunks);
+            });
+        }
+
+    }
+}
+#endif
@@ -0,0 +1,88 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXPRODUCT_DECL__GUARD__2610
+#define GEOMETRY__MATRIXPRODUCT_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "exceptions.hpp"
+#include "matrixUtils.decl.hpp"
+#include "matrixView.decl.hpp"
+
+namespace geometry{
+
+    // Linear algebra product (not the element-wise operator*). The result
+    // uses the allocator and the layout of A. Any mix of layouts runs the
+    // packed kernel without a transpose pass (packing reads any strides).
+    // -> Exceptions::SizeMismatch() if A.nColumns() != B.nLines()
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB>
+    Matrix<T, AllocA, OrderA> matmul(const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B);
+
+    // C = alpha * A.B + beta * C (BLAS convention, beta==0 ignores C content)
+    // -> Exceptions::SizeMismatch() if shapes do not agree
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB,
+             class AllocC, Layout OrderC>
+    void gemm(T alpha, const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B,
+              T beta, Matrix<T, AllocC, OrderC>& C);
+
+    // Same on views (sub-blocks, transposed views, ...), no copy of A or B.
+    // Mix with matrices through Matrix::view().
+    template<typename T>
+    Matrix<T> matmul(ConstMatrixView<T> A, ConstMatrixView<T> B);
+
+    template<typename T>
+    void gemm(T alpha, ConstMatrixView<T> A, ConstMatrixView<T> B, T beta, MatrixView<T> C);
+
+    namespace utils{
+
+        // Strided GEMM on raw buffers: element (i,j) of X lives at
+        // X[i*rsX + j*csX] (column-major => rsX=1, csX=nLines,
+        // row-major => rsX=nColumns, csX=1).
+        // C (m x n) = alpha * A (m x k) . B (k x n) + beta * C
+        // A row-major C is computed as C^T = B^T . A^T so that the
+        // micro-kernel still stores whole columns of registers.
+        // Big products split the lines of C across threads.
+        template<typename T>
+        void gemm(std::size_t m, std::size_t n, std::size_t k,
+                  T alpha,
+                  const T* A, std::size_t rsA, std::size_t csA,
+                  const T* B, std::size_t rsB, std::size_t csB,
+                  T beta,
+                  T* C, std::size_t rsC, std::size_t csC);
+
+        // Register-tiled micro-kernel and the cache blocking it is tuned for.
+        // fn computes an mr x nr tile of C (column-major, leading dimension
+        // ldc) from kc steps of packed A (mr values per step) and packed B
+        // (nr values per step): C = alpha * A.B + beta * C.
+        template<typename T>
+        struct GemmKernel
+        {
+            using Function = void (*)(std::size_t kc, const T* a, const T* b,
+                                      T* c, std::size_t ldc, T alpha, T beta);
+            Function fn{};
+            std::size_t mr{};
+            std::size_t nr{};
+            std::size_t kc{}; // depth of a packed panel (L1)
+            std::size_t mc{}; // lines of the packed A block (L2)
+            std::size_t nc{}; // columns of the packed B panel (L3)
+        };
+
+        // Best kernel for the running CPU (AVX-512, AVX2+FMA, or portable).
+        template<typename T>
+        const GemmKernel<T>& gemmKernel();
+
+        // Portable micro-kernel, used for every type without SIMD version.
+        template<typename T, std::size_t MR, std::size_t NR>
+        void gemmMicroKernel(std::size_t kc, const T* a, const T* b,
+                             T* c, std::size_t ldc, T alpha, T beta);
+
+    }
+}
+#endif
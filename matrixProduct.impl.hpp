@@ -0,0 +1,488 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXPRODUCT_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXPRODUCT_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrixProduct.decl.hpp"
+#include "matrix.decl.hpp"
+#include "exceptions.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+#include "matrixInstrumentation.hpp"
+
+namespace geometry{
+
+    // ============================ PUBLIC METHODS ============================
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB>
+    Matrix<T, AllocA, OrderA> matmul(const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B)
+    {
+        Matrix<T, AllocA, OrderA> C(A.nLines(), B.nColumns(), A.get_allocator());
+        gemm(static_cast<T>(1), A, B, static_cast<T>(0), C);
+        return C;
+    }
+
+    template<typename T, class AllocA, Layout OrderA, class AllocB, Layout OrderB,
+             class AllocC, Layout OrderC>
+    void gemm(T alpha, const Matrix<T, AllocA, OrderA>& A, const Matrix<T, AllocB, OrderB>& B,
+              T beta, Matrix<T, AllocC, OrderC>& C)
+    {
+        gemm(alpha, A.view(), B.view(), beta, C.view());
+    }
+
+    template<typename T>
+    Matrix<T> matmul(ConstMatrixView<T> A, ConstMatrixView<T> B)
+    {
+        Matrix<T> C(A.nLines(), B.nColumns());
+        gemm(static_cast<T>(1), A, B, static_cast<T>(0), C.view());
+        return C;
+    }
+
+    template<typename T>
+    void gemm(T alpha, ConstMatrixView<T> A, ConstMatrixView<T> B, T beta, MatrixView<T> C)
+    {
+        if(A.nColumns() != B.nLines())
+            throw Exeptions::SizeMismatch(A.nColumns(), B.nLines());
+        if((C.nLines() != A.nLines()) || (C.nColumns() != B.nColumns()))
+            throw Exeptions::SizeMismatch(C.length(), A.nLines()*B.nColumns());
+
+        // C is written while A and B are still read: work on a copy.
+        const T* first = C.data();
+        const T* last = first + ((C.length() == 0) ? 0 : (C.nLines()-1)*C.lineStride()
+                                                          + (C.nColumns()-1)*C.columnStride() + 1);
+        if(utils::makeOperand(A).references(first, last) || utils::makeOperand(B).references(first, last))
+        {
+            Matrix<T> result(C);
+            gemm(alpha, A, B, beta, result.view());
+            C = result;
+            return;
+        }
+
+        GEOMETRY_TRACE("gemm", C.nLines(), C.nColumns());
+        utils::gemm(A.nLines(), B.nColumns(), A.nColumns(),
+                    alpha,
+                    A.data(), A.lineStride(), A.columnStride(),
+                    B.data(), B.lineStride(), B.columnStride(),
+                    beta,
+                    C.data(), C.lineStride(), C.columnStride());
+    }
+
+    namespace utils{
+
+        // Below this many multiply-adds packing costs more than it saves.
+        constexpr std::size_t gemmSmallProduct = 48*48*48;
+        // Biggest mr x nr tile over all kernels (edge tiles go through it).
+        constexpr std::size_t gemmMaxTile = 32*16;
+
+        // --------------------------- MICRO-KERNELS --------------------------
+        template<typename T, std::size_t MR, std::size_t NR>
+        void gemmMicroKernel(std::size_t kc, const T* a, const T* b,
+                             T* c, std::size_t ldc, T alpha, T beta)
+        {
+            T acc[NR][MR]{};
+            for(std::size_t p=0; p<kc; p++, a+=MR, b+=NR)
+                for(std::size_t j=0; j<NR; j++)
+                    for(std::size_t i=0; i<MR; i++)
+                        acc[j][i] += a[i]*b[j];
+
+            for(std::size_t j=0; j<NR; j++)
+                for(std::size_t i=0; i<MR; i++)
+                    c[i + j*ldc] = (beta == static_cast<T>(0))
+                                 ? alpha*acc[j][i]
+                                 : alpha*acc[j][i] + beta*c[i + j*ldc];
+        }
+
+#ifdef GEOMETRY_X86_SIMD
+        using Avx2Double = SimdVector<Isa::Avx2, double>;
+        using Avx2Float = SimdVector<Isa::Avx2, float>;
+        using Avx512Double = SimdVector<Isa::Avx512, double>;
+        using Avx512Float = SimdVector<Isa::Avx512, float>;
+
+        // The two bodies only differ by their target attribute: GCC needs it
+        // on the function itself to inline the intrinsics above.
+        template<class V, std::size_t MR, std::size_t NR>
+        __attribute__((target("avx2,fma")))
+        void gemmMicroKernelAvx2(std::size_t kc,
+                                 const typename V::value_type* a,
+                                 const typename V::value_type* b,
+                                 typename V::value_type* c, std::size_t ldc,
+                                 typename V::value_type alpha,
+                                 typename V::value_type beta)
+        {
+            constexpr std::size_t NV = MR/V::width;
+            typename V::reg acc[NR][NV];
+            #pragma GCC unroll 32
+            for(std::size_t j=0; j<NR; j++)
+                #pragma GCC unroll 4
+                for(std::size_t v=0; v<NV; v++)
+                    acc[j][v] = V::zero();
+
+            for(std::size_t p=0; p<kc; p++, a+=MR, b+=NR)
+            {
+                typename V::reg av[NV];
+                #pragma GCC unroll 4
+                for(std::size_t v=0; v<NV; v++)
+                    av[v] = V::load(a + v*V::width);
+                #pragma GCC unroll 32
+                for(std::size_t j=0; j<NR; j++)
+                {
+                    const typename V::reg bj = V::broadcast(b + j);
+                    #pragma GCC unroll 4
+                    for(std::size_t v=0; v<NV; v++)
+                        acc[j][v] = V::fmadd(av[v], bj, acc[j][v]);
+                }
+            }
+
+            const typename V::reg valpha = V::set1(alpha);
+            const typename V::reg vbeta = V::set1(beta);
+            #pragma GCC unroll 32
+            for(std::size_t j=0; j<NR; j++)
+                #pragma GCC unroll 4
+                for(std::size_t v=0; v<NV; v++)
+                {
+                    typename V::value_type* dst = c + j*ldc + v*V::width;
+                    const typename V::reg ab = V::mul(valpha, acc[j][v]);
+                    V::store(dst, (beta == 0) ? ab : V::fmadd(vbeta, V::load(dst), ab));
+                }
+        }
+
+        template<class V, std::size_t MR, std::size_t NR>
+        __attribute__((target("avx512f")))
+        void gemmMicroKernelAvx512(std::size_t kc,
+                                   const typename V::value_type* a,
+                                   const typename V::value_type* b,
+                                   typename V::value_type* c, std::size_t ldc,
+                                   typename V::value_type alpha,
+                                   typename V::value_type beta)
+        {
+            constexpr std::size_t NV = MR/V::width;
+            typename V::reg acc[NR][NV];
+            #pragma GCC unroll 32
+            for(std::size_t j=0; j<NR; j++)
+                #pragma GCC unroll 4
+                for(std::size_t v=0; v<NV; v++)
+                    acc[j][v] = V::zero();
+
+            for(std::size_t p=0; p<kc; p++, a+=MR, b+=NR)
+            {
+                typename V::reg av[NV];
+                #pragma GCC unroll 4
+                for(std::size_t v=0; v<NV; v++)
+                    av[v] = V::load(a + v*V::width);
+                #pragma GCC unroll 32
+                for(std::size_t j=0; j<NR; j++)
+                {
+                    const typename V::reg bj = V::broadcast(b + j);
+                    #pragma GCC unroll 4
+                    for(std::size_t v=0; v<NV; v++)
+                        acc[j][v] = V::fmadd(av[v], bj, acc[j][v]);
+                }
+            }
+
+            const typename V::reg valpha = V::set1(alpha);
+            const typename V::reg vbeta = V::set1(beta);
+            #pragma GCC unroll 32
+            for(std::size_t j=0; j<NR; j++)
+                #pragma GCC unroll 4
+                for(std::size_t v=0; v<NV; v++)
+                {
+                    typename V::value_type* dst = c + j*ldc + v*V::width;
+                    const typename V::reg ab = V::mul(valpha, acc[j][v]);
+                    V::store(dst, (beta == 0) ? ab : V::fmadd(vbeta, V::load(dst), ab));
+                }
+        }
+#endif
+
+        // ------------------------- KERNEL SELECTION -------------------------
+        template<typename T>
+        GemmKernel<T> selectGemmKernel()
+        {
+            return {&gemmMicroKernel<T, 8, 4>, 8, 4, 256, 128, 4096};
+        }
+
+#ifdef GEOMETRY_X86_SIMD
+        template<>
+        inline GemmKernel<double> selectGemmKernel<double>()
+        {
+            if(activeIsa() == Isa::Avx512)
+                return {&gemmMicroKernelAvx512<Avx512Double, 16, 12>, 16, 12, 256, 240, 4080};
+            if(activeIsa() == Isa::Avx2)
+                return {&gemmMicroKernelAvx2<Avx2Double, 8, 6>, 8, 6, 256, 120, 4080};
+            return {&gemmMicroKernel<double, 8, 4>, 8, 4, 256, 128, 4096};
+        }
+
+        template<>
+        inline GemmKernel<float> selectGemmKernel<float>()
+        {
+            if(activeIsa() == Isa::Avx512)
+                return {&gemmMicroKernelAvx512<Avx512Float, 32, 12>, 32, 12, 256, 480, 4080};
+            if(activeIsa() == Isa::Avx2)
+                return {&gemmMicroKernelAvx2<Avx2Float, 16, 6>, 16, 6, 256, 240, 4080};
+            return {&gemmMicroKernel<float, 8, 4>, 8, 4, 256, 256, 4096};
+        }
+#endif
+
+        template<typename T>
+        const GemmKernel<T>& gemmKernel()
+        {
+            static const GemmKernel<T> kernel = selectGemmKernel<T>();
+            return kernel;
+        }
+
+        // ------------------------------ PACKING -----------------------------
+        // Per-thread packing buffers, 64-byte aligned, kept between calls.
+        template<typename T>
+        T* gemmBuffer(std::size_t slot, std::size_t size)
+        {
+            static thread_local std::vector<T> buffers[2];
+            constexpr std::size_t padding = 64/sizeof(T) + 1;
+            std::vector<T>& buffer = buffers[slot];
+            if(buffer.size() < size + padding)
+                buffer.resize(size + padding);
+            void* ptr = buffer.data();
+            std::size_t space = buffer.size()*sizeof(T);
+            return static_cast<T*>(std::align(64, size*sizeof(T), ptr, space));
+        }
+
+        // mc x kc block of A -> panels of mr lines, stored step by step.
+        template<typename T>
+        void gemmPackA(std::size_t mc, std::size_t kc,
+                       const T* A, std::size_t rsA, std::size_t csA,
+                       std::size_t mr, T* buffer)
+        {
+            for(std::size_t ir=0; ir<mc; ir+=mr)
+            {
+                const std::size_t lines = std::min(mr, mc-ir);
+                const T* panel = A + ir*rsA;
+                for(std::size_t p=0; p<kc; p++, buffer+=mr)
+                {
+                    const T* src = panel + p*csA;
+                    if(rsA == 1)
+                        std::copy(src, src+lines, buffer);
+                    else
+                        for(std::size_t i=0; i<lines; i++)
+                            buffer[i] = src[i*rsA];
+                    std::fill(buffer+lines, buffer+mr, static_cast<T>(0));
+                }
+            }
+        }
+
+        // kc x nc panel of B -> panels of nr columns, stored step by step.
+        template<typename T>
+        void gemmPackB(std::size_t kc, std::size_t nc,
+                       const T* B, std::size_t rsB, std::size_t csB,
+                       std::size_t nr, T* buffer)
+        {
+            for(std::size_t jr=0; jr<nc; jr+=nr)
+            {
+                const std::size_t columns = std::min(nr, nc-jr);
+                const T* panel = B + jr*csB;
+                for(std::size_t p=0; p<kc; p++, buffer+=nr)
+                {
+                    const T* src = panel + p*rsB;
+                    for(std::size_t j=0; j<columns; j++)
+                        buffer[j] = src[j*csB];
+                    std::fill(buffer+columns, buffer+nr, static_cast<T>(0));
+                }
+            }
+        }
+
+        // ------------------------------ DRIVERS -----------------------------
+        // Every (mr x nr) tile of an (mc x nc) block of C from packed data.
+        template<typename T>
+        void gemmMacroKernel(const GemmKernel<T>& kernel,
+                             std::size_t mc, std::size_t nc, std::size_t kc,
+                             T alpha, const T* packedA, const T* packedB,
+                             T beta, T* C, std::size_t rsC, std::size_t csC)
+        {
+            alignas(64) T tile[gemmMaxTile];
+            for(std::size_t jr=0; jr<nc; jr+=kernel.nr)
+            {
+                const std::size_t columns = std::min(kernel.nr, nc-jr);
+                for(std::size_t ir=0; ir<mc; ir+=kernel.mr)
+                {
+                    const std::size_t lines = std::min(kernel.mr, mc-ir);
+                    const T* a = packedA + ir*kc;
+                    const T* b = packedB + jr*kc;
+                    T* c = C + ir*rsC + jr*csC;
+
+                    if((lines == kernel.mr) && (columns == kernel.nr) && (rsC == 1))
+                    {
+                        kernel.fn(kc, a, b, c, csC, alpha, beta);
+                        continue;
+                    }
+                    // Edge or strided tile: compute aside then merge.
+                    kernel.fn(kc, a, b, tile, kernel.mr, alpha, static_cast<T>(0));
+                    for(std::size_t j=0; j<columns; j++)
+                        for(std::size_t i=0; i<lines; i++)
+                        {
+                            T& dst = c[i*rsC + j*csC];
+                            dst = (beta == static_cast<T>(0))
+                                ? tile[i + j*kernel.mr]
+                                : tile[i + j*kernel.mr] + beta*dst;
+                        }
+                }
+            }
+        }
+
+        // Unpacked loops for products too small to amortize packing.
+        template<typename T>
+        void gemmSmall(std::size_t m, std::size_t n, std::size_t k,
+                       T alpha,
+                       const T* A, std::size_t rsA, std::size_t csA,
+                       const T* B, std::size_t rsB, std::size_t csB,
+                       T beta,
+                       T* C, std::size_t rsC, std::size_t csC)
+        {
+            for(std::size_t j=0; j<n; j++)
+            {
+                T* c = C + j*csC;
+                for(std::size_t i=0; i<m; i++)
+                    c[i*rsC] = (beta == static_cast<T>(0)) ? static_cast<T>(0) : beta*c[i*rsC];
+                for(std::size_t p=0; p<k; p++)
+                {
+                    const T bpj = alpha*B[p*rsB + j*csB];
+                    const T* a = A + p*csA;
+                    if((rsA == 1) && (rsC == 1))
+                        for(std::size_t i=0; i<m; i++)
+                            c[i] += a[i]*bpj;
+                    else
+                        for(std::size_t i=0; i<m; i++)
+                            c[i*rsC] += a[i*rsA]*bpj;
+                }
+            }
+        }
+
+        // ---------------------------- 16-BIT FLOATS -------------------------
+        // Float copy of a rows x cols operand, keeping its contiguous
+        // direction: rs and cs become the strides of the copy.
+        template<typename T>
+        std::vector<float> gemmWiden(std::size_t rows, std::size_t cols, const T* X,
+                                     std::size_t& rs, std::size_t& cs)
+        {
+            std::vector<float> out(rows*cols);
+            if((rs != 1) && (cs == 1))
+            {
+                convert(cols, rows, X, rs, out.data(), cols);
+                rs = cols;
+            }
+            else if(rs == 1)
+            {
+                convert(rows, cols, X, cs, out.data(), rows);
+                cs = rows;
+            }
+            else
+            {
+                for(std::size_t j=0; j<cols; j++)
+                    for(std::size_t i=0; i<rows; i++)
+                        out[i + j*rows] = static_cast<float>(X[i*rs + j*cs]);
+                rs = 1;
+                cs = rows;
+            }
+            return out;
+        }
+
+        // Float16 and BFloat16 products run the float kernels on widened
+        // copies (float accumulation over the whole depth) and round C once.
+        template<typename T>
+        void gemmWidened(std::size_t m, std::size_t n, std::size_t k,
+                         T alpha,
+                         const T* A, std::size_t rsA, std::size_t csA,
+                         const T* B, std::size_t rsB, std::size_t csB,
+                         T beta,
+                         T* C, std::size_t rsC, std::size_t csC)
+        {
+            const std::vector<float> a = gemmWiden(m, k, A, rsA, csA);
+            const std::vector<float> b = gemmWiden(k, n, B, rsB, csB);
+            // C is not row-major here (see gemm): its copy is column-major.
+            std::size_t rsc = rsC, csc = csC;
+            std::vector<float> c = (beta == static_cast<T>(0)) ? std::vector<float>(m*n)
+                                                              : gemmWiden(m, n, static_cast<const T*>(C), rsc, csc);
+            gemm(m, n, k, static_cast<float>(alpha), a.data(), rsA, csA, b.data(), rsB, csB,
+                 static_cast<float>(beta), c.data(), std::size_t(1), m);
+            if(rsC == 1)
+                convert(m, n, c.data(), m, C, csC);
+            else
+                for(std::size_t j=0; j<n; j++)
+                    for(std::size_t i=0; i<m; i++)
+                        C[i*rsC + j*csC] = static_cast<T>(c[i + j*m]);
+        }
+
+        template<typename T>
+        void gemm(std::size_t m, std::size_t n, std::size_t k,
+                  T alpha,
+                  const T* A, std::size_t rsA, std::size_t csA,
+                  const T* B, std::size_t rsB, std::size_t csB,
+                  T beta,
+                  T* C, std::size_t rsC, std::size_t csC)
+        {
+            if((m == 0) || (n == 0))
+                return;
+            if((rsC != 1) && (csC == 1))
+                return gemm(n, m, k, alpha, B, csB, rsB, A, csA, rsA, beta, C, csC, rsC);
+            if constexpr (isReducedFloat<T>)
+                return gemmWidened(m, n, k, alpha, A, rsA, csA, B, rsB, csB, beta, C, rsC, csC);
+            if((k == 0) || (alpha == static_cast<T>(0)) || (m*n*k <= gemmSmallProduct))
+            {
+                gemmSmall(m, n, (alpha == static_cast<T>(0)) ? 0 : k,
+                          alpha, A, rsA, csA, B, rsB, csB, beta, C, rsC, csC);
+                return;
+            }
+
+            const GemmKernel<T>& kernel = gemmKernel<T>();
+            T* packedB = gemmBuffer<T>(1, kernel.kc*kernel.nc);
+
+            // Threads share the packed B panel and each packs its own blocks
+            // of A. With several threads the blocks shrink (down to mr lines)
+            // so that all of them get one.
+            const std::size_t work = m*n*(k/kernel.kc + 1);
+            const std::size_t nThreads = parallelism(work);
+            std::size_t mcStep = kernel.mc;
+            if(nThreads > 1)
+            {
+                const std::size_t share = (m + nThreads - 1)/nThreads;
+                mcStep = std::min(kernel.mc, (share + kernel.mr - 1)/kernel.mr*kernel.mr);
+            }
+            const std::size_t nBlocks = (m + mcStep - 1)/mcStep;
+
+            // BLIS loop ordering: B panel in L3, A block in L2, micro-panel
+            // of B in L1, mr x nr tile of C in registers.
+            for(std::size_t jc=0; jc<n; jc+=kernel.nc)
+            {
+                const std::size_t nc = std::min(kernel.nc, n-jc);
+                for(std::size_t pc=0; pc<k; pc+=kernel.kc)
+                {
+                    const std::size_t kc = std::min(kernel.kc, k-pc);
+                    // Only the first rank-kc update scales the previous C.
+                    const T betaBlock = (pc == 0) ? beta : static_cast<T>(1);
+                    gemmPackB(kc, nc, B + pc*rsB + jc*csB, rsB, csB, kernel.nr, packedB);
+                    const ThreadLimit limit(nThreads);
+                    parallelFor(nBlocks, work, [&](std::size_t first, std::size_t last){
+                        T* packedA = gemmBuffer<T>(0, kernel.mc*kernel.kc);
+                        for(std::size_t block=first; block<last; block++)
+                        {
+                            const std::size_t ic = block*mcStep;
+                            const std::size_t mc = std::min(mcStep, m-ic);
+                            gemmPackA(mc, kc, A + ic*rsA + pc*csA, rsA, csA, kernel.mr, packedA);
+                            gemmMacroKernel(kernel, mc, nc, kc, alpha, packedA, packedB,
+                                            betaBlock, C + ic*rsC + jc*csC, rsC, csC);
+                        }
+                    });
+                }
+            }
+        }
+
+    }
+}
+
+#endif
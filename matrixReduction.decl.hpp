@@ -0,0 +1,110 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXREDUCTION_DECL__GUARD__2610
+#define GEOMETRY__MATRIXREDUCTION_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+
+// LOCAL INCLUDES
+#include "matrixHalf.decl.hpp"
+#include "matrixUtils.decl.hpp"
+
+namespace geometry
+{
+    // Cartesian (L2), Manhattan (L1) and maximum (Linf) norms. On a matrix
+    // L2 is the Frobenius norm, L1 the largest column sum of |a_ij| and Linf
+    // the largest line sum: all three match the vector norms on N x 1.
+    enum class Norm {L1, L2, Linf};
+
+    namespace utils{
+
+        // ------------------------------ REDUCTIONS --------------------------
+        // Values folded into one: sum of a_i, of a_i^2 or of |a_i|, smallest,
+        // largest, largest |a_i|. Min and Max of NaNs are unspecified.
+        enum class ReduceOp {Sum, SumSquares, AbsSum, Min, Max, AbsMax};
+
+        // How Sum, SumSquares and AbsSum add floating point values. Integers
+        // add exactly in the 64 bits of accumulator_t<T>, and wrap around
+        // past them instead of overflowing:
+        //  - Fast: several SIMD accumulators, error growing with n;
+        //  - Pairwise: halves summed recursively down to pairwiseBlock
+        //    elements, summed the fast way, error growing with log(n);
+        //  - Kahan: compensated SIMD lanes, error independent of n, about
+        //    four times the operations of Fast.
+        // Compensation relies on strict IEEE arithmetic: -ffast-math turns
+        // it back into Fast.
+        enum class Summation {Fast, Pairwise, Kahan};
+
+        constexpr std::size_t pairwiseBlock = 1024;
+
+        // a_0 op ... op a_(n-1) over n contiguous elements. float and double
+        // use SSE2/AVX2/AVX-512 registers with four accumulators, other types
+        // a plain loop. Float16 and BFloat16 are widened to float by blocks
+        // and reduced as float, blocks added with compensation: the result
+        // is the float accumulator_t<T>, which neither overflows nor loses
+        // the small terms. Integers are summed widened to accumulator_t<T>.
+        // Above parallelThreshold() every function below
+        // splits the array across threads: same threads, same result. Min,
+        // Max and AbsMax of nothing are T().
+        template<ReduceOp Op, typename T>
+        accumulator_t<T> reduce(std::size_t n, const T* a, Summation summation = Summation::Fast);
+
+        // Same on a nLines x nColumns column-major block whose columns start
+        // every lda elements (see elementWise in matrixSimd.decl.hpp).
+        template<ReduceOp Op, typename T>
+        accumulator_t<T> reduce(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                                Summation summation = Summation::Fast);
+
+        // Sum of a_ij^2 in real_t<T>, for the L2 norms: integers are
+        // squared and added in double, where 64 bits overflow past a few
+        // squares of 32-bit values.
+        template<typename T>
+        real_t<T> sumSquares(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda);
+
+        // out[col] is the reduction of column col (nColumns values) and
+        // out[line] the one of line line (nLines values, the columns being
+        // folded in one SIMD pass each; Pairwise compensates like Kahan).
+        // out holds T or accumulator_t<T>: 16-bit floats are rounded to T
+        // once, from the float result, or kept in float, integer sums are
+        // truncated to T or kept in 64 bits.
+        template<ReduceOp Op, typename T, typename Out>
+        void reduceColumns(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                           Out* out, Summation summation = Summation::Fast);
+        template<ReduceOp Op, typename T, typename Out>
+        void reduceLines(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                         Out* out, Summation summation = Summation::Fast);
+
+        // {line, col} of the first smallest (largest) element, column after
+        // column. {0, 0} for an empty block.
+        template<typename T>
+        Coord argMin(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda);
+        template<typename T>
+        Coord argMax(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda);
+
+        // Whether predicate(a_ij) holds for any (every) element. Elements
+        // go by blocks of reductionBlock, branch-free inside a block, and
+        // every thread stops at the end of the block where one of them found
+        // the answer. predicate is called from several threads.
+        constexpr std::size_t reductionBlock = 4096;
+
+        template<typename T, class Predicate>
+        bool anyOf(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                   Predicate predicate);
+        template<typename T, class Predicate>
+        bool allOf(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                   Predicate predicate);
+
+        // allOf(x == 0), float and double blocks tested with the SIMD sum of
+        // their |a_ij|, integer ones with the or of their bits, 16-bit floats
+        // with the or of their bits but the sign.
+        template<typename T>
+        bool allZero(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda);
+
+    }
+}
+#endif
@@ -0,0 +1,620 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXREDUCTION_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXREDUCTION_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrixReduction.decl.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // --------------------------- SCALAR FALLBACK ------------------------
+        template<ReduceOp Op>
+        constexpr bool isSumOp = (Op == ReduceOp::Sum) || (Op == ReduceOp::SumSquares) || (Op == ReduceOp::AbsSum);
+
+        // Integers go through unsigned arithmetic (at least unsigned int,
+        // past the promotions): they wrap around where a signed type would
+        // overflow.
+        template<typename T, bool = std::is_integral_v<T> && !std::is_same_v<T, bool>>
+        struct Wrapping {using type = T;};
+        template<typename T>
+        struct Wrapping<T, true> {using type = std::common_type_t<std::make_unsigned_t<T>, unsigned>;};
+
+        template<typename T>
+        using WrappingType = typename Wrapping<T>::type;
+
+        // What each element contributes.
+        template<ReduceOp Op, typename T>
+        T reduceTerm(T x)
+        {
+            if constexpr ((Op == ReduceOp::SumSquares) && std::is_integral_v<T>)
+                return static_cast<T>(static_cast<WrappingType<T>>(x)*static_cast<WrappingType<T>>(x));
+            else if constexpr (Op == ReduceOp::SumSquares)
+                return static_cast<T>(x * x);
+            else if constexpr ((Op == ReduceOp::AbsSum) || (Op == ReduceOp::AbsMax))
+            {
+                if constexpr (std::is_unsigned_v<T>) return x;
+                else return (x < static_cast<T>(0)) ? static_cast<T>(-x) : x;
+            }
+            else
+                return x;
+        }
+
+        template<ReduceOp Op, typename T>
+        T reduceCombine(T a, T b)
+        {
+            if constexpr (isSumOp<Op> && std::is_integral_v<T>)
+                return static_cast<T>(static_cast<WrappingType<T>>(a) + static_cast<WrappingType<T>>(b));
+            else if constexpr (isSumOp<Op>)
+                return static_cast<T>(a + b);
+            else if constexpr (Op == ReduceOp::Min)
+                return std::min(a, b);
+            else
+                return std::max(a, b);
+        }
+
+        template<ReduceOp Op, typename T>
+        T reduceScalar(std::size_t n, const T* a)
+        {
+            if(n == 0)
+                return T{};
+            T result = reduceTerm<Op>(a[0]);
+            for(std::size_t i=1; i<n; i++)
+                result = reduceCombine<Op>(result, reduceTerm<Op>(a[i]));
+            return result;
+        }
+
+        // Kahan-Babuska (Neumaier) running sum of a few partial results: the
+        // rounding error of every addition goes in a second accumulator,
+        // whatever the magnitudes. Exact for integers.
+        template<typename T>
+        struct CompensatedSum
+        {
+            T sum{};
+            T compensation{};
+
+            void add(T value)
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    const T total = sum + value;
+                    if(std::abs(sum) >= std::abs(value))
+                        compensation += (sum - total) + value;
+                    else
+                        compensation += (value - total) + sum;
+                    sum = total;
+                }
+                else
+                    sum = reduceCombine<ReduceOp::Sum>(sum, value);
+            }
+
+            T result() const {return static_cast<T>(sum + compensation);}
+        };
+
+        // Plain Kahan over long runs: the compensation goes back in every
+        // addition and stays small, where the one of CompensatedSum would
+        // itself be a long naive sum.
+        template<ReduceOp Op, typename T>
+        T reduceKahanScalar(std::size_t n, const T* a)
+        {
+            T sum{}, compensation{};
+            for(std::size_t i=0; i<n; i++)
+            {
+                const T y = reduceTerm<Op>(a[i]) - compensation;
+                const T total = sum + y;
+                compensation = (total - sum) - y;
+                sum = total;
+            }
+            return sum;
+        }
+
+        // Partial results of chunks, in chunk order. Sums are compensated:
+        // a few additions more for as many chunks.
+        template<ReduceOp Op, typename T>
+        T combinePartials(std::size_t n, const T* partials)
+        {
+            if constexpr (isSumOp<Op>)
+            {
+                CompensatedSum<T> total;
+                for(std::size_t i=0; i<n; i++)
+                    total.add(partials[i]);
+                return total.result();
+            }
+            else
+            {
+                if(n == 0)
+                    return T{};
+                T result = partials[0];
+                for(std::size_t i=1; i<n; i++)
+                    result = reduceCombine<Op>(result, partials[i]);
+                return result;
+            }
+        }
+
+#ifdef GEOMETRY_X86_SIMD
+        // ---------------------------- KERNEL BODIES -------------------------
+        // Same bodies for every instruction set, only the target attribute
+        // changes (see matrixSimd.impl.hpp).
+#define GEOMETRY_REDUCE_KERNELS(NAME, TARGET)                                               \
+        template<ReduceOp Op, class V>                                                      \
+        __attribute__((target(TARGET)))                                                     \
+        typename V::reg reduceTerm##NAME(typename V::reg x)                                 \
+        {                                                                                   \
+            if constexpr (Op == ReduceOp::SumSquares)                                       \
+                return V::mul(x, x);                                                        \
+            else if constexpr ((Op == ReduceOp::AbsSum) || (Op == ReduceOp::AbsMax))        \
+                return V::abs(x);                                                           \
+            else                                                                            \
+                return x;                                                                   \
+        }                                                                                   \
+                                                                                            \
+        template<ReduceOp Op, class V>                                                      \
+        __attribute__((target(TARGET)))                                                     \
+        typename V::reg reduceCombine##NAME(typename V::reg a, typename V::reg b)           \
+        {                                                                                   \
+            if constexpr (isSumOp<Op>)          return V::add(a, b);                        \
+            else if constexpr (Op == ReduceOp::Min) return V::min(a, b);                    \
+            else                                return V::max(a, b);                        \
+        }                                                                                   \
+                                                                                            \
+        /* Four independent accumulators hide the latency of the adds. Min */               \
+        /* and max fold the last, overlapping register again instead of a  */               \
+        /* scalar tail.                                                    */               \
+        template<ReduceOp Op, class V>                                                      \
+        __attribute__((target(TARGET)))                                                     \
+        typename V::value_type reduce##NAME(std::size_t n, const typename V::value_type* a) \
+        {                                                                                   \
+            using T = typename V::value_type;                                               \
+            using reg = typename V::reg;                                                    \
+            constexpr std::size_t w = V::width;                                             \
+            if constexpr (isSumOp<Op>)                                                      \
+            {                                                                               \
+                reg acc0 = V::set1(T(0)), acc1 = acc0, acc2 = acc0, acc3 = acc0;            \
+                std::size_t i = 0;                                                          \
+                for(; i+4*w<=n; i+=4*w)                                                     \
+                {                                                                           \
+                    acc0 = V::add(acc0, reduceTerm##NAME<Op, V>(V::load(a + i)));           \
+                    acc1 = V::add(acc1, reduceTerm##NAME<Op, V>(V::load(a + i + w)));       \
+                    acc2 = V::add(acc2, reduceTerm##NAME<Op, V>(V::load(a + i + 2*w)));     \
+                    acc3 = V::add(acc3, reduceTerm##NAME<Op, V>(V::load(a + i + 3*w)));     \
+                }                                                                           \
+                for(; i+w<=n; i+=w)                                                         \
+                    acc0 = V::add(acc0, reduceTerm##NAME<Op, V>(V::load(a + i)));           \
+                T total = V::sum(V::add(V::add(acc0, acc1), V::add(acc2, acc3)));           \
+                for(; i<n; i++)                                                             \
+                    total += reduceTerm<Op>(a[i]);                                          \
+                return total;                                                               \
+            }                                                                               \
+            else                                                                            \
+            {                                                                               \
+                if(n < w)                                                                   \
+                    return reduceScalar<Op>(n, a);                                          \
+                reg acc0 = reduceTerm##NAME<Op, V>(V::load(a));                             \
+                reg acc1 = acc0, acc2 = acc0, acc3 = acc0;                                  \
+                std::size_t i = 0;                                                          \
+                for(; i+4*w<=n; i+=4*w)                                                     \
+                {                                                                           \
+                    acc0 = reduceCombine##NAME<Op, V>(acc0, reduceTerm##NAME<Op, V>(V::load(a + i)));       \
+                    acc1 = reduceCombine##NAME<Op, V>(acc1, reduceTerm##NAME<Op, V>(V::load(a + i + w)));   \
+                    acc2 = reduceCombine##NAME<Op, V>(acc2, reduceTerm##NAME<Op, V>(V::load(a + i + 2*w))); \
+                    acc3 = reduceCombine##NAME<Op, V>(acc3, reduceTerm##NAME<Op, V>(V::load(a + i + 3*w))); \
+                }                                                                           \
+                for(; i+w<=n; i+=w)                                                         \
+                    acc0 = reduceCombine##NAME<Op, V>(acc0, reduceTerm##NAME<Op, V>(V::load(a + i)));       \
+                if(i < n)                                                                   \
+                    acc0 = reduceCombine##NAME<Op, V>(acc0, reduceTerm##NAME<Op, V>(V::load(a + n - w)));   \
+                acc0 = reduceCombine##NAME<Op, V>(reduceCombine##NAME<Op, V>(acc0, acc1),   \
+                                                  reduceCombine##NAME<Op, V>(acc2, acc3));  \
+                T lanes[w];                                                                 \
+                V::store(lanes, acc0);                                                      \
+                return combinePartials<Op>(w, lanes);                                       \
+            }                                                                               \
+        }                                                                                   \
+                                                                                            \
+        /* Kahan summation lane by lane, the lanes and the tail then go */                  \
+        /* through a compensated scalar sum.                            */                  \
+        template<ReduceOp Op, class V>                                                      \
+        __attribute__((target(TARGET)))                                                     \
+        typename V::value_type reduceKahan##NAME(std::size_t n,                             \
+                                                 const typename V::value_type* a)           \
+        {                                                                                   \
+            using T = typename V::value_type;                                               \
+            using reg = typename V::reg;                                                    \
+            constexpr std::size_t w = V::width;                                             \
+            reg sum = V::set1(T(0)), compensation = sum;                                    \
+            std::size_t i = 0;                                                              \
+            for(; i+w<=n; i+=w)                                                             \
+            {                                                                               \
+                const reg y = V::sub(reduceTerm##NAME<Op, V>(V::load(a + i)), compensation); \
+                const reg total = V::add(sum, y);                                           \
+                compensation = V::sub(V::sub(total, sum), y);                               \
+                sum = total;                                                                \
+            }                                                                               \
+            T sums[w], compensations[w];                                                    \
+            V::store(sums, sum);                                                            \
+            V::store(compensations, compensation);                                          \
+            CompensatedSum<T> result;                                                       \
+            for(std::size_t l=0; l<w; l++)                                                  \
+            {                                                                               \
+                result.add(sums[l]);                                                        \
+                result.add(-compensations[l]);                                              \
+            }                                                                               \
+            for(; i<n; i++)                                                                 \
+                result.add(reduceTerm<Op>(a[i]));                                           \
+            return result.result();                                                         \
+        }                                                                                   \
+                                                                                            \
+        /* out[i] = out[i] op term(a[i]): one column folded into the */                     \
+        /* results of the lines.                                     */                     \
+        template<ReduceOp Op, class V>                                                      \
+        __attribute__((target(TARGET)))                                                     \
+        void accumulate##NAME(std::size_t n, const typename V::value_type* a,               \
+                              typename V::value_type* out)                                  \
+        {                                                                                   \
+            std::size_t i = 0;                                                              \
+            for(; i+V::width<=n; i+=V::width)                                               \
+                V::store(out + i, reduceCombine##NAME<Op, V>(V::load(out + i),              \
+                                  reduceTerm##NAME<Op, V>(V::load(a + i))));                \
+            for(; i<n; i++)                                                                 \
+                out[i] = reduceCombine<Op>(out[i], reduceTerm<Op>(a[i]));                   \
+        }
+
+        GEOMETRY_REDUCE_KERNELS(Sse2, "sse2")
+        GEOMETRY_REDUCE_KERNELS(Avx2, "avx2,fma")
+        GEOMETRY_REDUCE_KERNELS(Avx512, "avx512f")
+#undef GEOMETRY_REDUCE_KERNELS
+#endif
+
+        // ------------------------------- DISPATCH ---------------------------
+        // One contiguous run on the calling thread.
+        template<ReduceOp Op, typename T>
+        T reduceFastSerial(std::size_t n, const T* a)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return reduceAvx512<Op, SimdVector<Isa::Avx512, T>>(n, a);
+                    case Isa::Avx2:   return reduceAvx2<Op, SimdVector<Isa::Avx2, T>>(n, a);
+                    case Isa::Sse2:   return reduceSse2<Op, SimdVector<Isa::Sse2, T>>(n, a);
+                    default: break;
+                }
+#endif
+            return reduceScalar<Op>(n, a);
+        }
+
+        template<ReduceOp Op, typename T>
+        T reduceKahanSerial(std::size_t n, const T* a)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return reduceKahanAvx512<Op, SimdVector<Isa::Avx512, T>>(n, a);
+                    case Isa::Avx2:   return reduceKahanAvx2<Op, SimdVector<Isa::Avx2, T>>(n, a);
+                    case Isa::Sse2:   return reduceKahanSse2<Op, SimdVector<Isa::Sse2, T>>(n, a);
+                    default: break;
+                }
+#endif
+            return reduceKahanScalar<Op>(n, a);
+        }
+
+        template<ReduceOp Op, typename T>
+        accumulator_t<T> reduceSerial(std::size_t n, const T* a, Summation summation)
+        {
+            if constexpr (isReducedFloat<T>)
+            {
+                // Widened pairwiseBlock elements at a time, the blocks
+                // combined like chunks.
+                float buffer[pairwiseBlock];
+                CompensatedSum<float> total;
+                float result = 0;
+                for(std::size_t i=0; i<n; i+=pairwiseBlock)
+                {
+                    const std::size_t m = std::min(pairwiseBlock, n - i);
+                    convertSerial(m, a + i, buffer);
+                    const float block = reduceSerial<Op>(m, buffer, summation);
+                    if constexpr (isSumOp<Op>)
+                        total.add(block);
+                    else
+                        result = (i == 0) ? block : reduceCombine<Op>(result, block);
+                }
+                if constexpr (isSumOp<Op>)
+                    return total.result();
+                else
+                    return result;
+            }
+            else if constexpr (isSumOp<Op> && std::is_floating_point_v<T>)
+            {
+                if(summation == Summation::Kahan)
+                    return reduceKahanSerial<Op>(n, a);
+                if((summation == Summation::Pairwise) && (n > pairwiseBlock))
+                {
+                    const std::size_t half = n/2;
+                    return static_cast<T>(reduceSerial<Op>(half, a, summation)
+                                          + reduceSerial<Op>(n - half, a + half, summation));
+                }
+                return reduceFastSerial<Op>(n, a);
+            }
+            else if constexpr (isSumOp<Op> && std::is_integral_v<T>)
+            {
+                // Widened element by element: 8 to 32-bit integers add
+                // exactly.
+                using Accumulator = accumulator_t<T>;
+                Accumulator total{};
+                for(std::size_t i=0; i<n; i++)
+                    total = reduceCombine<Op>(total, reduceTerm<Op>(static_cast<Accumulator>(a[i])));
+                return total;
+            }
+            else
+                return reduceFastSerial<Op>(n, a);
+        }
+
+        // out[i] = out[i] op term(a[i]), out being T or wider.
+        template<ReduceOp Op, typename T, typename Out>
+        void accumulateSerial(std::size_t n, const T* a, Out* out)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T> && std::is_same_v<Out, T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return accumulateAvx512<Op, SimdVector<Isa::Avx512, T>>(n, a, out);
+                    case Isa::Avx2:   return accumulateAvx2<Op, SimdVector<Isa::Avx2, T>>(n, a, out);
+                    case Isa::Sse2:   return accumulateSse2<Op, SimdVector<Isa::Sse2, T>>(n, a, out);
+                    default: break;
+                }
+#endif
+            for(std::size_t i=0; i<n; i++)
+                out[i] = reduceCombine<Op>(out[i], reduceTerm<Op>(static_cast<Out>(a[i])));
+        }
+
+        // -------------------------------- PUBLIC ----------------------------
+        // One chunk of elements (of columns) per thread, each writes its own
+        // partial result, combined in chunk order once they are all done.
+        template<ReduceOp Op, typename T>
+        accumulator_t<T> reduce(std::size_t n, const T* a, Summation summation)
+        {
+            const std::size_t nChunks = std::max<std::size_t>(std::min(n, parallelism(n)), 1);
+            if(nChunks == 1)
+                return reduceSerial<Op>(n, a, summation);
+            std::vector<accumulator_t<T>> partials(nChunks);
+            parallelFor(nChunks, n, [&](std::size_t first, std::size_t last){
+                for(std::size_t chunk=first; chunk<last; chunk++)
+                {
+                    const std::size_t begin = n*chunk/nChunks;
+                    partials[chunk] = reduceSerial<Op>(n*(chunk+1)/nChunks - begin, a + begin, summation);
+                }
+            });
+            return combinePartials<Op>(nChunks, partials.data());
+        }
+
+        template<ReduceOp Op, typename T>
+        accumulator_t<T> reduce(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                                Summation summation)
+        {
+            if((lda == nLines) || (nColumns == 1))
+                return reduce<Op>(nLines*nColumns, a, summation);
+            if(nLines == 0)
+                return accumulator_t<T>{};
+            std::vector<accumulator_t<T>> columns(nColumns);
+            parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                    columns[col] = reduceSerial<Op>(nLines, a + col*lda, summation);
+            });
+            return combinePartials<Op>(nColumns, columns.data());
+        }
+
+        template<typename T>
+        real_t<T> sumSquares(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda)
+        {
+            if constexpr (!std::is_integral_v<accumulator_t<T>>)
+                return static_cast<real_t<T>>(reduce<ReduceOp::SumSquares>(nLines, nColumns, a, lda));
+            else
+            {
+                // Widened pairwiseBlock elements at a time, like the 16-bit
+                // floats, one compensated sum per column.
+                std::vector<double> columns(nColumns);
+                parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                    double buffer[pairwiseBlock];
+                    for(std::size_t col=first; col<last; col++)
+                    {
+                        CompensatedSum<double> total;
+                        for(std::size_t i=0; i<nLines; i+=pairwiseBlock)
+                        {
+                            const std::size_t m = std::min(pairwiseBlock, nLines - i);
+                            std::copy(a + col*lda + i, a + col*lda + i + m, buffer);
+                            total.add(reduceFastSerial<ReduceOp::SumSquares>(m, buffer));
+                        }
+                        columns[col] = total.result();
+                    }
+                });
+                return combinePartials<ReduceOp::Sum>(nColumns, columns.data());
+            }
+        }
+
+        template<ReduceOp Op, typename T, typename Out>
+        void reduceColumns(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                           Out* out, Summation summation)
+        {
+            static_assert(std::is_same_v<Out, T> || std::is_same_v<Out, accumulator_t<T>>);
+            parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                    out[col] = static_cast<Out>(reduceSerial<Op>(nLines, a + col*lda, summation));
+            });
+        }
+
+        // One range of lines per thread, folded column after column.
+        template<ReduceOp Op, typename T, typename Out>
+        void reduceLines(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                         Out* out, Summation summation)
+        {
+            static_assert(std::is_same_v<Out, T> || std::is_same_v<Out, accumulator_t<T>>);
+            if(nColumns == 0)
+                return std::fill(out, out + nLines, Out{});
+            using Accumulator = accumulator_t<T>;
+            const bool compensated = isSumOp<Op> && std::is_floating_point_v<Accumulator>
+                                     && (summation != Summation::Fast);
+            parallelFor(nLines, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                const std::size_t count = last - first;
+                if(compensated)
+                {
+                    std::vector<CompensatedSum<Accumulator>> totals(count);
+                    for(std::size_t col=0; col<nColumns; col++)
+                        for(std::size_t i=0; i<count; i++)
+                            totals[i].add(reduceTerm<Op>(static_cast<Accumulator>(a[first + i + col*lda])));
+                    for(std::size_t i=0; i<count; i++)
+                        out[first + i] = static_cast<Out>(totals[i].result());
+                    return;
+                }
+                if constexpr (isReducedFloat<T>)
+                {
+                    // Lines folded in float, each column widened first.
+                    std::vector<float> totals(count), column(count);
+                    convertSerial(count, a + first, totals.data());
+                    for(float& total: totals)
+                        total = reduceTerm<Op>(total);
+                    for(std::size_t col=1; col<nColumns; col++)
+                    {
+                        convertSerial(count, a + first + col*lda, column.data());
+                        accumulateSerial<Op>(count, column.data(), totals.data());
+                    }
+                    convertSerial(count, totals.data(), out + first);
+                }
+                else
+                {
+                    for(std::size_t i=0; i<count; i++)
+                        out[first + i] = reduceTerm<Op>(static_cast<Out>(a[first + i]));
+                    for(std::size_t col=1; col<nColumns; col++)
+                        accumulateSerial<Op>(count, a + first + col*lda, out + first);
+                }
+            });
+        }
+
+        // The value first, then its first position (early exit).
+        template<ReduceOp Op, typename T>
+        Coord argReduce(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda)
+        {
+            if(nLines*nColumns == 0)
+                return {0, 0};
+            const T value = static_cast<T>(reduce<Op>(nLines, nColumns, a, lda));
+            for(std::size_t col=0; col<nColumns; col++)
+            {
+                const T* column = a + col*lda;
+                const T* found = std::find(column, column + nLines, value);
+                if(found != column + nLines)
+                    return {static_cast<std::size_t>(found - column), col};
+            }
+            return {0, 0}; // NaNs
+        }
+
+        template<typename T>
+        Coord argMin(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda)
+        {
+            return argReduce<ReduceOp::Min>(nLines, nColumns, a, lda);
+        }
+
+        template<typename T>
+        Coord argMax(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda)
+        {
+            return argReduce<ReduceOp::Max>(nLines, nColumns, a, lda);
+        }
+
+        // Every column (the whole block when contiguous) is cut in blocks,
+        // the blocks are spread across threads and hit(first, length) tells
+        // whether one holds the answer.
+        template<typename T, class Hit>
+        bool anyBlock(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda, Hit hit)
+        {
+            const bool contiguous = (lda == nLines) || (nColumns == 1);
+            const std::size_t nRuns = contiguous ? 1 : nColumns;
+            const std::size_t runLength = contiguous ? nLines*nColumns : nLines;
+            const std::size_t blocksPerRun = (runLength + reductionBlock - 1)/reductionBlock;
+            std::atomic<bool> found{false};
+            parallelFor(nRuns*blocksPerRun, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t block=first; (block<last) && !found.load(std::memory_order_relaxed); block++)
+                {
+                    const T* run = a + (block/blocksPerRun)*lda;
+                    const std::size_t begin = (block%blocksPerRun)*reductionBlock;
+                    const std::size_t end = std::min(begin + reductionBlock, runLength);
+                    if(hit(run + begin, end - begin))
+                        found.store(true, std::memory_order_relaxed);
+                }
+            });
+            return found.load();
+        }
+
+        template<typename T, class Predicate>
+        bool anyOf(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                   Predicate predicate)
+        {
+            return anyBlock(nLines, nColumns, a, lda, [&predicate](const T* first, std::size_t length){
+                bool hit = false;
+                for(std::size_t i=0; i<length; i++)
+                    hit |= static_cast<bool>(predicate(first[i]));
+                return hit;
+            });
+        }
+
+        template<typename T, class Predicate>
+        bool allOf(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda,
+                   Predicate predicate)
+        {
+            return !anyOf(nLines, nColumns, a, lda, [&predicate](const T& x){ return !predicate(x); });
+        }
+
+        // A sum of |a_ij| is 0 only when they all are: it never rounds down
+        // to 0, and NaN and inf propagate. Integers or their bits together,
+        // 16-bit floats too but for their sign bits (-0 == 0).
+        template<typename T>
+        bool allZero(std::size_t nLines, std::size_t nColumns, const T* a, std::size_t lda)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                return !anyBlock(nLines, nColumns, a, lda, [](const T* first, std::size_t length){
+                    return reduceFastSerial<ReduceOp::AbsSum>(length, first) != T(0);
+                });
+            else if constexpr (std::is_integral_v<T> || isReducedFloat<T>)
+                return !anyBlock(nLines, nColumns, a, lda, [](const T* first, std::size_t length){
+                    constexpr std::uint64_t mask = isReducedFloat<T> ? 0x7FFF7FFF7FFF7FFFull : ~std::uint64_t(0);
+                    // 64-bit words, four at a time: GCC does not vectorize
+                    // an or reduction at -O2. Blocks start on an element, so
+                    // the tail bytes go back to their place in a word.
+                    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(first);
+                    const std::size_t size = length*sizeof(T);
+                    std::uint64_t bits[4] = {0, 0, 0, 0};
+                    std::size_t i = 0;
+                    for(; i+32<=size; i+=32)
+                        for(std::size_t w=0; w<4; w++)
+                        {
+                            std::uint64_t word;
+                            std::memcpy(&word, bytes + i + 8*w, 8);
+                            bits[w] |= word;
+                        }
+                    for(; i<size; i++)
+                        bits[0] |= std::uint64_t(bytes[i]) << (8*(i%8));
+                    return ((bits[0] | bits[1] | bits[2] | bits[3]) & mask) != 0;
+                });
+            else
+                return allOf(nLines, nColumns, a, lda, [](const T& x){ return x == T(0); });
+        }
+
+    }
+}
+#endif
@@ -0,0 +1,101 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXSIMD_DECL__GUARD__2610
+#define GEOMETRY__MATRIXSIMD_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+
+// LOCAL INCLUDES
+#include "matrixHalf.decl.hpp"
+#include "matrixUtils.decl.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // ------------------------------ CPU DISPATCH ------------------------
+        // Instruction sets the kernels are written for, from the weakest.
+        // Avx2 also requires FMA and F16C, Avx512 means AVX-512F.
+        enum class Isa {Scalar, Sse2, Avx2, Avx512};
+
+        // Best level the running CPU supports.
+        Isa detectIsa();
+
+        // Level every kernel (element-wise, gemm, transpose) runs with: the
+        // detected one, lowered by the GEOMETRY_ISA environment variable
+        // (scalar, sse2, avx2 or avx512) for A/B testing. The variable is read
+        // once, never raises the level above what the CPU supports and is
+        // ignored when it holds anything else.
+        Isa activeIsa();
+
+        const char* isaName(Isa isa);
+
+        // ------------------------- ELEMENT-WISE KERNELS ---------------------
+        enum class ElementOp {Add, Sub, Mul, Div};
+
+        // out[i] = a[i] op b[i] over n contiguous elements. out may be a or b.
+        // float and double use SSE2/AVX2/AVX-512 registers, Float16 and
+        // BFloat16 the float kernels on blocks widened to float, other types
+        // a plain loop. Above parallelThreshold() every function below splits
+        // the array across threads.
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t n, const T* a, const T* b, T* out);
+
+        // out[i] = a[i] op value. out may be a.
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t n, const T* a, T value, T* out);
+
+        // out[i] = value op b[i]. out may be b.
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t n, T value, const T* b, T* out);
+
+        // out[i] = value.
+        template<typename T>
+        void broadcast(std::size_t n, T value, T* out);
+
+        // out[i] = static_cast<To>(src[i]). Conversions between int, float
+        // and double, and between float and Float16 (F16C) or BFloat16, use
+        // the conversion instructions. The 16-bit types go through float to
+        // and from anything else, rounding once: doubles become floats
+        // rounded to odd first, wider integers a loop. Any other pair is a
+        // loop.
+        template<typename From, typename To>
+        void convert(std::size_t n, const From* src, To* out);
+
+        // Same on nLines x nColumns column-major blocks whose columns start
+        // every ld elements (leading dimension, >= nLines). The padding
+        // between columns is never read nor written.
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t nLines, std::size_t nColumns,
+                         const T* a, std::size_t lda, const T* b, std::size_t ldb,
+                         T* out, std::size_t ldOut);
+
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t nLines, std::size_t nColumns,
+                         const T* a, std::size_t lda, T value,
+                         T* out, std::size_t ldOut);
+
+        // Same with broadcast operands: element (line, col) of a is
+        // a[line*aStride + col*lda], aStride being 1, or 0 to repeat one line
+        // in every line, and lda 0 repeating one column in every column (b
+        // likewise). Nothing is expanded: columns with one repeated value go
+        // through the kernels taking a value, the others through a op b.
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t nLines, std::size_t nColumns,
+                         const T* a, std::size_t aStride, std::size_t lda,
+                         const T* b, std::size_t bStride, std::size_t ldb,
+                         T* out, std::size_t ldOut);
+
+        template<typename From, typename To>
+        void convert(std::size_t nLines, std::size_t nColumns,
+                     const From* src, std::size_t ldSrc,
+                     To* out, std::size_t ldOut);
+
+    }
+}
+#endif
@@ -0,0 +1,13 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXSIMD__GUARD__2610
+#define GEOMETRY__MATRIXSIMD__GUARD__2610
+
+#include "matrixSimd.decl.hpp"
+#include "matrixSimd.impl.hpp"
+
+#endif
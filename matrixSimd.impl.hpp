@@ -0,0 +1,939 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXSIMD_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXSIMD_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// LOCAL INCLUDES
+#include "matrixSimd.decl.hpp"
+#include "matrixHalf.hpp"
+#include "matrixParallel.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // ------------------------------ CPU DISPATCH ------------------------
+        inline Isa detectIsa()
+        {
+#ifdef GEOMETRY_X86_SIMD
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx512f"))
+                return Isa::Avx512;
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+               && __builtin_cpu_supports("f16c"))
+                return Isa::Avx2;
+            if(__builtin_cpu_supports("sse2"))
+                return Isa::Sse2;
+#endif
+            return Isa::Scalar;
+        }
+
+        inline const char* isaName(Isa isa)
+        {
+            switch(isa)
+            {
+                case Isa::Avx512: return "avx512";
+                case Isa::Avx2:   return "avx2";
+                case Isa::Sse2:   return "sse2";
+                default:          return "scalar";
+            }
+        }
+
+        inline Isa selectIsa()
+        {
+            const Isa detected = detectIsa();
+            const char* forced = std::getenv("GEOMETRY_ISA");
+            if(forced == nullptr)
+                return detected;
+            for(Isa isa: {Isa::Scalar, Isa::Sse2, Isa::Avx2, Isa::Avx512})
+                if(std::strcmp(forced, isaName(isa)) == 0)
+                    return std::min(isa, detected);
+            return detected;
+        }
+
+        inline Isa activeIsa()
+        {
+            static const Isa isa = selectIsa();
+            return isa;
+        }
+
+        // --------------------------- SCALAR FALLBACK ------------------------
+        template<ElementOp Op, typename T>
+        T applyElementOp(T a, T b)
+        {
+            if constexpr (Op == ElementOp::Add)
+                return static_cast<T>(a + b);
+            else if constexpr (Op == ElementOp::Sub)
+                return static_cast<T>(a - b);
+            else if constexpr (Op == ElementOp::Mul)
+                return static_cast<T>(a * b);
+            else
+                return static_cast<T>(a / b);
+        }
+
+        // One element seen as a one-lane register, for the kernels written
+        // once for every SimdVector (see matrixBatch).
+        template<typename T>
+        struct ScalarVector
+        {
+            using value_type = T;
+            using reg = T;
+            static constexpr std::size_t width = 1;
+            static reg set1(T v) {return v;}
+            static reg load(const T* p) {return *p;}
+            static void store(T* p, reg v) {*p = v;}
+            static reg add(reg a, reg b) {return static_cast<T>(a + b);}
+            static reg sub(reg a, reg b) {return static_cast<T>(a - b);}
+            static reg mul(reg a, reg b) {return static_cast<T>(a * b);}
+            static reg div(reg a, reg b) {return static_cast<T>(a / b);}
+            static reg max(reg a, reg b) {return std::max(a, b);}
+            static reg min(reg a, reg b) {return std::min(a, b);}
+            static reg sqrt(reg a) {return static_cast<T>(std::sqrt(a));}
+            static reg abs(reg a) {
+                if constexpr (std::is_unsigned_v<T>) return a;
+                else return (a < static_cast<T>(0)) ? static_cast<T>(-a) : a;
+            }
+            static reg fmadd(reg a, reg b, reg c) {return static_cast<T>(a * b + c);}
+            static reg gather(const T* base, const std::int32_t* index) {return base[*index];}
+            static T sum(reg a) {return a;}
+        };
+
+#ifdef GEOMETRY_X86_SIMD
+        // ---------------------------- REGISTER TYPES ------------------------
+        // Thin wrappers so that one kernel body serves float and double.
+        template<Isa I, typename T>
+        struct SimdVector; // no registers for this type
+
+        template<>
+        struct SimdVector<Isa::Sse2, double>
+        {
+            using value_type = double;
+            using reg = __m128d;
+            static constexpr std::size_t width = 2;
+            __attribute__((target("sse2"))) static reg set1(double v) {return _mm_set1_pd(v);}
+            __attribute__((target("sse2"))) static reg load(const double* p) {return _mm_loadu_pd(p);}
+            __attribute__((target("sse2"))) static void store(double* p, reg v) {_mm_storeu_pd(p, v);}
+            __attribute__((target("sse2"))) static reg add(reg a, reg b) {return _mm_add_pd(a, b);}
+            __attribute__((target("sse2"))) static reg sub(reg a, reg b) {return _mm_sub_pd(a, b);}
+            __attribute__((target("sse2"))) static reg mul(reg a, reg b) {return _mm_mul_pd(a, b);}
+            __attribute__((target("sse2"))) static reg div(reg a, reg b) {return _mm_div_pd(a, b);}
+            __attribute__((target("sse2"))) static reg max(reg a, reg b) {return _mm_max_pd(a, b);}
+            __attribute__((target("sse2"))) static reg min(reg a, reg b) {return _mm_min_pd(a, b);}
+            __attribute__((target("sse2"))) static reg sqrt(reg a) {return _mm_sqrt_pd(a);}
+            __attribute__((target("sse2"))) static reg abs(reg a) {return _mm_andnot_pd(_mm_set1_pd(-0.0), a);}
+            // No FMA with SSE2: separate multiply and add.
+            __attribute__((target("sse2"))) static reg fmadd(reg a, reg b, reg c) {return _mm_add_pd(_mm_mul_pd(a, b), c);}
+            // base[index[lane]] (no gather instruction before AVX2).
+            __attribute__((target("sse2"))) static reg gather(const double* base, const std::int32_t* index) {
+                return _mm_set_pd(base[index[1]], base[index[0]]);
+            }
+            // Horizontal sum of the lanes.
+            __attribute__((target("sse2"))) static double sum(reg a) {
+                return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+            }
+        };
+
+        template<>
+        struct SimdVector<Isa::Sse2, float>
+        {
+            using value_type = float;
+            using reg = __m128;
+            static constexpr std::size_t width = 4;
+            __attribute__((target("sse2"))) static reg set1(float v) {return _mm_set1_ps(v);}
+            __attribute__((target("sse2"))) static reg load(const float* p) {return _mm_loadu_ps(p);}
+            __attribute__((target("sse2"))) static void store(float* p, reg v) {_mm_storeu_ps(p, v);}
+            __attribute__((target("sse2"))) static reg add(reg a, reg b) {return _mm_add_ps(a, b);}
+            __attribute__((target("sse2"))) static reg sub(reg a, reg b) {return _mm_sub_ps(a, b);}
+            __attribute__((target("sse2"))) static reg mul(reg a, reg b) {return _mm_mul_ps(a, b);}
+            __attribute__((target("sse2"))) static reg div(reg a, reg b) {return _mm_div_ps(a, b);}
+            __attribute__((target("sse2"))) static reg max(reg a, reg b) {return _mm_max_ps(a, b);}
+            __attribute__((target("sse2"))) static reg min(reg a, reg b) {return _mm_min_ps(a, b);}
+            __attribute__((target("sse2"))) static reg sqrt(reg a) {return _mm_sqrt_ps(a);}
+            __attribute__((target("sse2"))) static reg abs(reg a) {return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);}
+            // No FMA with SSE2: separate multiply and add.
+            __attribute__((target("sse2"))) static reg fmadd(reg a, reg b, reg c) {return _mm_add_ps(_mm_mul_ps(a, b), c);}
+            __attribute__((target("sse2"))) static reg gather(const float* base, const std::int32_t* index) {
+                return _mm_set_ps(base[index[3]], base[index[2]], base[index[1]], base[index[0]]);
+            }
+            __attribute__((target("sse2"))) static float sum(reg a) {
+                const reg pairs = _mm_add_ps(a, _mm_movehl_ps(a, a));
+                return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+            }
+        };
+
+        template<>
+        struct SimdVector<Isa::Avx2, double>
+        {
+            using value_type = double;
+            using reg = __m256d;
+            static constexpr std::size_t width = 4;
+            __attribute__((target("avx2,fma"))) static reg zero() {return _mm256_setzero_pd();}
+            __attribute__((target("avx2,fma"))) static reg set1(double v) {return _mm256_set1_pd(v);}
+            __attribute__((target("avx2,fma"))) static reg load(const double* p) {return _mm256_loadu_pd(p);}
+            __attribute__((target("avx2,fma"))) static void store(double* p, reg v) {_mm256_storeu_pd(p, v);}
+            __attribute__((target("avx2,fma"))) static reg broadcast(const double* p) {return _mm256_broadcast_sd(p);}
+            __attribute__((target("avx2,fma"))) static reg add(reg a, reg b) {return _mm256_add_pd(a, b);}
+            __attribute__((target("avx2,fma"))) static reg sub(reg a, reg b) {return _mm256_sub_pd(a, b);}
+            __attribute__((target("avx2,fma"))) static reg mul(reg a, reg b) {return _mm256_mul_pd(a, b);}
+            __attribute__((target("avx2,fma"))) static reg div(reg a, reg b) {return _mm256_div_pd(a, b);}
+            __attribute__((target("avx2,fma"))) static reg max(reg a, reg b) {return _mm256_max_pd(a, b);}
+            __attribute__((target("avx2,fma"))) static reg min(reg a, reg b) {return _mm256_min_pd(a, b);}
+            __attribute__((target("avx2,fma"))) static reg sqrt(reg a) {return _mm256_sqrt_pd(a);}
+            __attribute__((target("avx2,fma"))) static reg abs(reg a) {return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);}
+            __attribute__((target("avx2,fma"))) static reg fmadd(reg a, reg b, reg c) {return _mm256_fmadd_pd(a, b, c);}
+            __attribute__((target("avx2,fma"))) static reg gather(const double* base, const std::int32_t* index) {
+                // Masked forms over a zero source throughout: the unmasked
+                // intrinsics start from an undefined register, which GCC
+                // reports as maybe-uninitialized.
+                return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base,
+                                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(index)),
+                                                _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+            }
+            __attribute__((target("avx2,fma"))) static double sum(reg a) {
+                const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+                return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+            }
+        };
+
+        template<>
+        struct SimdVector<Isa::Avx2, float>
+        {
+            using value_type = float;
+            using reg = __m256;
+            static constexpr std::size_t width = 8;
+            __attribute__((target("avx2,fma"))) static reg zero() {return _mm256_setzero_ps();}
+            __attribute__((target("avx2,fma"))) static reg set1(float v) {return _mm256_set1_ps(v);}
+            __attribute__((target("avx2,fma"))) static reg load(const float* p) {return _mm256_loadu_ps(p);}
+            __attribute__((target("avx2,fma"))) static void store(float* p, reg v) {_mm256_storeu_ps(p, v);}
+            __attribute__((target("avx2,fma"))) static reg broadcast(const float* p) {return _mm256_broadcast_ss(p);}
+            __attribute__((target("avx2,fma"))) static reg add(reg a, reg b) {return _mm256_add_ps(a, b);}
+            __attribute__((target("avx2,fma"))) static reg sub(reg a, reg b) {return _mm256_sub_ps(a, b);}
+            __attribute__((target("avx2,fma"))) static reg mul(reg a, reg b) {return _mm256_mul_ps(a, b);}
+            __attribute__((target("avx2,fma"))) static reg div(reg a, reg b) {return _mm256_div_ps(a, b);}
+            __attribute__((target("avx2,fma"))) static reg max(reg a, reg b) {return _mm256_max_ps(a, b);}
+            __attribute__((target("avx2,fma"))) static reg min(reg a, reg b) {return _mm256_min_ps(a, b);}
+            __attribute__((target("avx2,fma"))) static reg sqrt(reg a) {return _mm256_sqrt_ps(a);}
+            __attribute__((target("avx2,fma"))) static reg abs(reg a) {return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);}
+            __attribute__((target("avx2,fma"))) static reg fmadd(reg a, reg b, reg c) {return _mm256_fmadd_ps(a, b, c);}
+            __attribute__((target("avx2,fma"))) static reg gather(const float* base, const std::int32_t* index) {
+                return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base,
+                                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index)),
+                                                _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4);
+            }
+            __attribute__((target("avx2,fma"))) static float sum(reg a) {
+                const __m128 half = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+                const __m128 pairs = _mm_add_ps(half, _mm_movehl_ps(half, half));
+                return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+            }
+        };
+
+        template<>
+        struct SimdVector<Isa::Avx512, double>
+        {
+            using value_type = double;
+            using reg = __m512d;
+            static constexpr std::size_t width = 8;
+            __attribute__((target("avx512f"))) static reg zero() {return _mm512_setzero_pd();}
+            __attribute__((target("avx512f"))) static reg set1(double v) {return _mm512_set1_pd(v);}
+            __attribute__((target("avx512f"))) static reg load(const double* p) {return _mm512_loadu_pd(p);}
+            __attribute__((target("avx512f"))) static void store(double* p, reg v) {_mm512_storeu_pd(p, v);}
+            __attribute__((target("avx512f"))) static reg broadcast(const double* p) {return _mm512_set1_pd(*p);}
+            __attribute__((target("avx512f"))) static reg add(reg a, reg b) {return _mm512_add_pd(a, b);}
+            __attribute__((target("avx512f"))) static reg sub(reg a, reg b) {return _mm512_sub_pd(a, b);}
+            __attribute__((target("avx512f"))) static reg mul(reg a, reg b) {return _mm512_mul_pd(a, b);}
+            __attribute__((target("avx512f"))) static reg div(reg a, reg b) {return _mm512_div_pd(a, b);}
+            // Full-mask forms: the plain ones merge into an undefined register,
+            // which GCC 12 reports as maybe-uninitialized.
+            __attribute__((target("avx512f"))) static reg max(reg a, reg b) {return _mm512_mask_max_pd(a, __mmask8(-1), a, b);}
+            __attribute__((target("avx512f"))) static reg min(reg a, reg b) {return _mm512_mask_min_pd(a, __mmask8(-1), a, b);}
+            __attribute__((target("avx512f"))) static reg sqrt(reg a) {return _mm512_mask_sqrt_pd(a, __mmask8(-1), a);}
+            __attribute__((target("avx512f"))) static reg abs(reg a) {return _mm512_abs_pd(a);}
+            __attribute__((target("avx512f"))) static reg fmadd(reg a, reg b, reg c) {return _mm512_fmadd_pd(a, b, c);}
+            __attribute__((target("avx512f"))) static reg gather(const double* base, const std::int32_t* index) {
+                return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF,
+                                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index)), base, 8);
+            }
+            // Halves taken with full-mask extracts: _mm512_reduce_add_pd and
+            // the 512 to 256 casts have the same undefined register.
+            __attribute__((target("avx512f"))) static double sum(reg a) {
+                const __m256d quad = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xF, a, 0), _mm512_maskz_extractf64x4_pd(0xF, a, 1));
+                const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(quad), _mm256_extractf128_pd(quad, 1));
+                return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+            }
+        };
+
+        template<>
+        struct SimdVector<Isa::Avx512, float>
+        {
+            using value_type = float;
+            using reg = __m512;
+            static constexpr std::size_t width = 16;
+            __attribute__((target("avx512f"))) static reg zero() {return _mm512_setzero_ps();}
+            __attribute__((target("avx512f"))) static reg set1(float v) {return _mm512_set1_ps(v);}
+            __attribute__((target("avx512f"))) static reg load(const float* p) {return _mm512_loadu_ps(p);}
+            __attribute__((target("avx512f"))) static void store(float* p, reg v) {_mm512_storeu_ps(p, v);}
+            __attribute__((target("avx512f"))) static reg broadcast(const float* p) {return _mm512_set1_ps(*p);}
+            __attribute__((target("avx512f"))) static reg add(reg a, reg b) {return _mm512_add_ps(a, b);}
+            __attribute__((target("avx512f"))) static reg sub(reg a, reg b) {return _mm512_sub_ps(a, b);}
+            __attribute__((target("avx512f"))) static reg mul(reg a, reg b) {return _mm512_mul_ps(a, b);}
+            __attribute__((target("avx512f"))) static reg div(reg a, reg b) {return _mm512_div_ps(a, b);}
+            // Full-mask forms: the plain ones merge into an undefined register,
+            // which GCC 12 reports as maybe-uninitialized.
+            __attribute__((target("avx512f"))) static reg max(reg a, reg b) {return _mm512_mask_max_ps(a, __mmask16(-1), a, b);}
+            __attribute__((target("avx512f"))) static reg min(reg a, reg b) {return _mm512_mask_min_ps(a, __mmask16(-1), a, b);}
+            __attribute__((target("avx512f"))) static reg sqrt(reg a) {return _mm512_mask_sqrt_ps(a, __mmask16(-1), a);}
+            __attribute__((target("avx512f"))) static reg abs(reg a) {return _mm512_abs_ps(a);}
+            __attribute__((target("avx512f"))) static reg fmadd(reg a, reg b, reg c) {return _mm512_fmadd_ps(a, b, c);}
+            __attribute__((target("avx512f"))) static reg gather(const float* base, const std::int32_t* index) {
+                return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, _mm512_loadu_si512(index), base, 4);
+            }
+            __attribute__((target("avx512f"))) static float sum(reg a) {
+                const __m512d bits = _mm512_castps_pd(a);
+                const __m256 octet = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, bits, 0)),
+                                                   _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, bits, 1)));
+                const __m128 half = _mm_add_ps(_mm256_castps256_ps128(octet), _mm256_extractf128_ps(octet, 1));
+                const __m128 pairs = _mm_add_ps(half, _mm_movehl_ps(half, half));
+                return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+            }
+        };
+
+        template<typename T>
+        constexpr bool hasSimdVector = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        // ---------------------------- CONVERSIONS ---------------------------
+        // run() converts one block of elements. Only the pairs listed have
+        // an instruction, hasSimdConvert tells which.
+        template<Isa I>
+        struct SimdConvert;
+
+        template<>
+        struct SimdConvert<Isa::Sse2>
+        {
+            static constexpr std::size_t block = 4;
+            __attribute__((target("sse2"))) static void run(const float* s, double* d) {
+                const __m128 v = _mm_loadu_ps(s);
+                _mm_storeu_pd(d, _mm_cvtps_pd(v));
+                _mm_storeu_pd(d + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+            __attribute__((target("sse2"))) static void run(const double* s, float* d) {
+                _mm_storeu_ps(d, _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(s)),
+                                               _mm_cvtpd_ps(_mm_loadu_pd(s + 2))));
+            }
+            __attribute__((target("sse2"))) static void run(const int* s, float* d) {
+                _mm_storeu_ps(d, _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s))));
+            }
+            __attribute__((target("sse2"))) static void run(const float* s, int* d) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm_cvttps_epi32(_mm_loadu_ps(s)));
+            }
+            __attribute__((target("sse2"))) static void run(const int* s, double* d) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                _mm_storeu_pd(d, _mm_cvtepi32_pd(v));
+                _mm_storeu_pd(d + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, 0x0E)));
+            }
+            __attribute__((target("sse2"))) static void run(const double* s, int* d) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                                 _mm_unpacklo_epi64(_mm_cvttpd_epi32(_mm_loadu_pd(s)),
+                                                    _mm_cvttpd_epi32(_mm_loadu_pd(s + 2))));
+            }
+            __attribute__((target("sse2"))) static void run(const BFloat16* s, float* d) {
+                const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s));
+                _mm_storeu_ps(d, _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), v)));
+            }
+            // Rounded to nearest even on the upper halves (NaNs made quiet),
+            // packed through the signed saturation with a 0x8000 bias.
+            __attribute__((target("sse2"))) static void run(const float* s, BFloat16* d) {
+                const __m128 v = _mm_loadu_ps(s);
+                const __m128i bits = _mm_castps_si128(v);
+                const __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+                const __m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(odd, _mm_set1_epi32(0x7FFF)));
+                const __m128i nan = _mm_castps_si128(_mm_cmpunord_ps(v, v));
+                const __m128i quiet = _mm_or_si128(bits, _mm_set1_epi32(0x00400000));
+                const __m128i upper = _mm_srli_epi32(_mm_or_si128(_mm_and_si128(nan, quiet),
+                                                                  _mm_andnot_si128(nan, rounded)), 16);
+                const __m128i biased = _mm_sub_epi32(upper, _mm_set1_epi32(0x8000));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(d),
+                                 _mm_xor_si128(_mm_packs_epi32(biased, biased), _mm_set1_epi16(-0x8000)));
+            }
+
+            // double to float rounded to odd (see utils::roundToOdd): the
+            // nearest float, one step toward zero when it went away from it,
+            // last bit set when inexact.
+            __attribute__((target("sse2"))) static __m128 roundToOdd(__m128d v) {
+                const __m128d sign = _mm_set1_pd(-0.0);
+                const __m128 f = _mm_cvtpd_ps(v);
+                const __m128d back = _mm_cvtps_pd(f);
+                const __m128d away = _mm_cmpgt_pd(_mm_andnot_pd(sign, back), _mm_andnot_pd(sign, v));
+                const __m128d inexact = _mm_cmpneq_pd(back, v);
+                const __m128i bits = _mm_add_epi32(_mm_castps_si128(f), _mm_shuffle_epi32(_mm_castpd_si128(away), 0x08));
+                const __m128i odd = _mm_and_si128(_mm_shuffle_epi32(_mm_castpd_si128(inexact), 0x08), _mm_set1_epi32(1));
+                return _mm_castsi128_ps(_mm_or_si128(bits, odd));
+            }
+            __attribute__((target("sse2"))) static void roundToOdd(const double* s, float* d) {
+                _mm_storeu_ps(d, _mm_movelh_ps(roundToOdd(_mm_loadu_pd(s)), roundToOdd(_mm_loadu_pd(s + 2))));
+            }
+        };
+
+        template<>
+        struct SimdConvert<Isa::Avx2>
+        {
+            static constexpr std::size_t block = 8;
+            __attribute__((target("avx2,fma"))) static void run(const float* s, double* d) {
+                _mm256_storeu_pd(d, _mm256_cvtps_pd(_mm_loadu_ps(s)));
+                _mm256_storeu_pd(d + 4, _mm256_cvtps_pd(_mm_loadu_ps(s + 4)));
+            }
+            __attribute__((target("avx2,fma"))) static void run(const double* s, float* d) {
+                _mm_storeu_ps(d, _mm256_cvtpd_ps(_mm256_loadu_pd(s)));
+                _mm_storeu_ps(d + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(s + 4)));
+            }
+            __attribute__((target("avx2,fma"))) static void run(const int* s, float* d) {
+                _mm256_storeu_ps(d, _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s))));
+            }
+            __attribute__((target("avx2,fma"))) static void run(const float* s, int* d) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_cvttps_epi32(_mm256_loadu_ps(s)));
+            }
+            __attribute__((target("avx2,fma"))) static void run(const int* s, double* d) {
+                _mm256_storeu_pd(d, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s))));
+                _mm256_storeu_pd(d + 4, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4))));
+            }
+            __attribute__((target("avx2,fma"))) static void run(const double* s, int* d) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm256_cvttpd_epi32(_mm256_loadu_pd(s)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4), _mm256_cvttpd_epi32(_mm256_loadu_pd(s + 4)));
+            }
+            __attribute__((target("avx2,fma,f16c"))) static void run(const Float16* s, float* d) {
+                _mm256_storeu_ps(d, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s))));
+            }
+            __attribute__((target("avx2,fma,f16c"))) static void run(const float* s, Float16* d) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                                 _mm256_cvtps_ph(_mm256_loadu_ps(s), _MM_FROUND_TO_NEAREST_INT));
+            }
+            __attribute__((target("avx2,fma"))) static void run(const BFloat16* s, float* d) {
+                const __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+                _mm256_storeu_ps(d, _mm256_castsi256_ps(_mm256_slli_epi32(v, 16)));
+            }
+            __attribute__((target("avx2,fma"))) static void run(const float* s, BFloat16* d) {
+                const __m256 v = _mm256_loadu_ps(s);
+                const __m256i bits = _mm256_castps_si256(v);
+                const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+                const __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7FFF)));
+                const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+                const __m256i quiet = _mm256_or_si256(bits, _mm256_set1_epi32(0x00400000));
+                const __m256i upper = _mm256_srli_epi32(_mm256_blendv_epi8(rounded, quiet, nan), 16);
+                const __m256i packed = _mm256_packus_epi32(upper, upper); // per 128-bit lane
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                                 _mm256_castsi256_si128(_mm256_permute4x64_epi64(packed, 0x08)));
+            }
+
+            __attribute__((target("avx2,fma"))) static __m128 roundToOdd(__m256d v) {
+                const __m256d sign = _mm256_set1_pd(-0.0);
+                const __m128 f = _mm256_cvtpd_ps(v);
+                const __m256d back = _mm256_cvtps_pd(f);
+                const __m256d away = _mm256_cmp_pd(_mm256_andnot_pd(sign, back), _mm256_andnot_pd(sign, v), _CMP_GT_OQ);
+                const __m256d inexact = _mm256_cmp_pd(back, v, _CMP_NEQ_OQ);
+                const __m256i low = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6); // 64-bit masks to 32
+                const __m128i bits = _mm_add_epi32(_mm_castps_si128(f), _mm256_castsi256_si128(
+                    _mm256_permutevar8x32_epi32(_mm256_castpd_si256(away), low)));
+                const __m128i odd = _mm_and_si128(_mm256_castsi256_si128(
+                    _mm256_permutevar8x32_epi32(_mm256_castpd_si256(inexact), low)), _mm_set1_epi32(1));
+                return _mm_castsi128_ps(_mm_or_si128(bits, odd));
+            }
+            __attribute__((target("avx2,fma"))) static void roundToOdd(const double* s, float* d) {
+                _mm_storeu_ps(d, roundToOdd(_mm256_loadu_pd(s)));
+                _mm_storeu_ps(d + 4, roundToOdd(_mm256_loadu_pd(s + 4)));
+            }
+        };
+
+        // Full-mask maskz forms: same instructions, but GCC 12 headers warn
+        // about the undefined source register of the unmasked ones.
+        template<>
+        struct SimdConvert<Isa::Avx512>
+        {
+            static constexpr std::size_t block = 16;
+            __attribute__((target("avx512f"))) static void run(const float* s, double* d) {
+                _mm512_storeu_pd(d, _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(s)));
+                _mm512_storeu_pd(d + 8, _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(s + 8)));
+            }
+            __attribute__((target("avx512f"))) static void run(const double* s, float* d) {
+                _mm256_storeu_ps(d, _mm512_maskz_cvtpd_ps(0xFF, _mm512_loadu_pd(s)));
+                _mm256_storeu_ps(d + 8, _mm512_maskz_cvtpd_ps(0xFF, _mm512_loadu_pd(s + 8)));
+            }
+            __attribute__((target("avx512f"))) static void run(const int* s, float* d) {
+                _mm512_storeu_ps(d, _mm512_maskz_cvtepi32_ps(0xFFFF, _mm512_loadu_si512(s)));
+            }
+            __attribute__((target("avx512f"))) static void run(const float* s, int* d) {
+                _mm512_storeu_si512(d, _mm512_maskz_cvttps_epi32(0xFFFF, _mm512_loadu_ps(s)));
+            }
+            __attribute__((target("avx512f"))) static void run(const int* s, double* d) {
+                _mm512_storeu_pd(d, _mm512_maskz_cvtepi32_pd(0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s))));
+                _mm512_storeu_pd(d + 8, _mm512_maskz_cvtepi32_pd(0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 8))));
+            }
+            __attribute__((target("avx512f"))) static void run(const double* s, int* d) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm512_maskz_cvttpd_epi32(0xFF, _mm512_loadu_pd(s)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 8), _mm512_maskz_cvttpd_epi32(0xFF, _mm512_loadu_pd(s + 8)));
+            }
+            __attribute__((target("avx512f"))) static void run(const Float16* s, float* d) {
+                _mm512_storeu_ps(d, _mm512_maskz_cvtph_ps(0xFFFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s))));
+            }
+            __attribute__((target("avx512f"))) static void run(const float* s, Float16* d) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                                    _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(s), _MM_FROUND_TO_NEAREST_INT));
+            }
+            __attribute__((target("avx512f"))) static void run(const BFloat16* s, float* d) {
+                const __m512i v = _mm512_maskz_cvtepu16_epi32(0xFFFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+                _mm512_storeu_ps(d, _mm512_castsi512_ps(_mm512_maskz_slli_epi32(0xFFFF, v, 16)));
+            }
+            __attribute__((target("avx512f"))) static void run(const float* s, BFloat16* d) {
+                const __m512 v = _mm512_loadu_ps(s);
+                const __m512i bits = _mm512_castps_si512(v);
+                const __m512i odd = _mm512_and_si512(_mm512_maskz_srli_epi32(0xFFFF, bits, 16), _mm512_set1_epi32(1));
+                const __m512i rounded = _mm512_add_epi32(bits, _mm512_add_epi32(odd, _mm512_set1_epi32(0x7FFF)));
+                const __mmask16 nan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+                const __m512i result = _mm512_mask_or_epi32(rounded, nan, bits, _mm512_set1_epi32(0x00400000));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                                    _mm512_maskz_cvtepi32_epi16(0xFFFF, _mm512_maskz_srli_epi32(0xFFFF, result, 16)));
+            }
+
+            __attribute__((target("avx512f"))) static void roundToOdd(const double* s, float* d) {
+                const __m512d lo = _mm512_loadu_pd(s);
+                const __m512d hi = _mm512_loadu_pd(s + 8);
+                const __m256 flo = _mm512_maskz_cvtpd_ps(0xFF, lo);
+                const __m256 fhi = _mm512_maskz_cvtpd_ps(0xFF, hi);
+                const __m512d backLo = _mm512_maskz_cvtps_pd(0xFF, flo);
+                const __m512d backHi = _mm512_maskz_cvtps_pd(0xFF, fhi);
+                const __mmask16 away = static_cast<__mmask16>(
+                    _mm512_cmp_pd_mask(_mm512_abs_pd(backLo), _mm512_abs_pd(lo), _CMP_GT_OQ)
+                    | (_mm512_cmp_pd_mask(_mm512_abs_pd(backHi), _mm512_abs_pd(hi), _CMP_GT_OQ) << 8));
+                const __mmask16 inexact = static_cast<__mmask16>(
+                    _mm512_cmp_pd_mask(backLo, lo, _CMP_NEQ_OQ) | (_mm512_cmp_pd_mask(backHi, hi, _CMP_NEQ_OQ) << 8));
+                const __m512i one = _mm512_set1_epi32(1);
+                const __m512d low = _mm512_maskz_insertf64x4(0xFF, _mm512_setzero_pd(), _mm256_castps_pd(flo), 0);
+                __m512i bits = _mm512_castpd_si512(_mm512_maskz_insertf64x4(0xFF, low, _mm256_castps_pd(fhi), 1));
+                bits = _mm512_mask_sub_epi32(bits, away, bits, one);
+                bits = _mm512_mask_or_epi32(bits, inexact, bits, one);
+                _mm512_storeu_si512(d, bits);
+            }
+        };
+
+        template<Isa I, typename From, typename To, typename = void>
+        constexpr bool hasSimdConvert = false;
+
+        template<Isa I, typename From, typename To>
+        constexpr bool hasSimdConvert<I, From, To,
+            std::void_t<decltype(SimdConvert<I>::run(std::declval<const From*>(), std::declval<To*>()))>> = true;
+
+        // ---------------------------- KERNEL BODIES -------------------------
+        // Same bodies for every instruction set, only the target attribute
+        // changes: GCC needs it on the function itself to inline the
+        // intrinsics, and a shared inline body would pass registers across
+        // a non-AVX function boundary.
+#define GEOMETRY_SIMD_KERNELS(NAME, TARGET)                                                 \
+        template<ElementOp Op, class V>                                                     \
+        __attribute__((target(TARGET)))                                                     \
+        typename V::reg applyElementOp##NAME(typename V::reg a, typename V::reg b)          \
+        {                                                                                   \
+            if constexpr (Op == ElementOp::Add)      return V::add(a, b);                   \
+            else if constexpr (Op == ElementOp::Sub) return V::sub(a, b);                   \
+            else if constexpr (Op == ElementOp::Mul) return V::mul(a, b);                   \
+            else                                     return V::div(a, b);                   \
+        }                                                                                   \
+                                                                                            \
+        template<ElementOp Op, class V>                                                     \
+        __attribute__((target(TARGET)))                                                     \
+        void elementWise##NAME(std::size_t n, const typename V::value_type* a,              \
+                               const typename V::value_type* b,                             \
+                               typename V::value_type* out)                                 \
+        {                                                                                   \
+            std::size_t i = 0;                                                              \
+            for(; i+V::width<=n; i+=V::width)                                               \
+                V::store(out + i, applyElementOp##NAME<Op, V>(V::load(a + i),               \
+                                                              V::load(b + i)));             \
+            for(; i<n; i++)                                                                 \
+                out[i] = applyElementOp<Op>(a[i], b[i]);                                    \
+        }                                                                                   \
+                                                                                            \
+        template<ElementOp Op, class V>                                                     \
+        __attribute__((target(TARGET)))                                                     \
+        void elementWise##NAME(std::size_t n, const typename V::value_type* a,              \
+                               typename V::value_type value,                                \
+                               typename V::value_type* out)                                 \
+        {                                                                                   \
+            const typename V::reg v = V::set1(value);                                       \
+            std::size_t i = 0;                                                              \
+            for(; i+V::width<=n; i+=V::width)                                               \
+                V::store(out + i, applyElementOp##NAME<Op, V>(V::load(a + i), v));          \
+            for(; i<n; i++)                                                                 \
+                out[i] = applyElementOp<Op>(a[i], value);                                   \
+        }                                                                                   \
+                                                                                            \
+        template<ElementOp Op, class V>                                                     \
+        __attribute__((target(TARGET)))                                                     \
+        void elementWise##NAME(std::size_t n, typename V::value_type value,                 \
+                               const typename V::value_type* b,                             \
+                               typename V::value_type* out)                                 \
+        {                                                                                   \
+            const typename V::reg v = V::set1(value);                                       \
+            std::size_t i = 0;                                                              \
+            for(; i+V::width<=n; i+=V::width)                                               \
+                V::store(out + i, applyElementOp##NAME<Op, V>(v, V::load(b + i)));          \
+            for(; i<n; i++)                                                                 \
+                out[i] = applyElementOp<Op>(value, b[i]);                                   \
+        }                                                                                   \
+                                                                                            \
+        template<class V>                                                                   \
+        __attribute__((target(TARGET)))                                                     \
+        void broadcast##NAME(std::size_t n, typename V::value_type value,                   \
+                             typename V::value_type* out)                                   \
+        {                                                                                   \
+            const typename V::reg v = V::set1(value);                                       \
+            std::size_t i = 0;                                                              \
+            for(; i+V::width<=n; i+=V::width)                                               \
+                V::store(out + i, v);                                                       \
+            for(; i<n; i++)                                                                 \
+                out[i] = value;                                                             \
+        }                                                                                   \
+                                                                                            \
+        inline __attribute__((target(TARGET)))                                              \
+        void roundToOdd##NAME(std::size_t n, const double* src, float* out)                 \
+        {                                                                                   \
+            using C = SimdConvert<Isa::NAME>;                                               \
+            std::size_t i = 0;                                                              \
+            for(; i+C::block<=n; i+=C::block)                                               \
+                C::roundToOdd(src + i, out + i);                                            \
+            for(; i<n; i++)                                                                 \
+                out[i] = roundToOdd<float>(src[i]);                                         \
+        }                                                                                   \
+                                                                                            \
+        template<typename From, typename To>                                                \
+        __attribute__((target(TARGET)))                                                     \
+        void convert##NAME(std::size_t n, const From* src, To* out)                         \
+        {                                                                                   \
+            using C = SimdConvert<Isa::NAME>;                                               \
+            std::size_t i = 0;                                                              \
+            for(; i+C::block<=n; i+=C::block)                                               \
+                C::run(src + i, out + i);                                                   \
+            for(; i<n; i++)                                                                 \
+                out[i] = static_cast<To>(src[i]);                                           \
+        }
+
+        GEOMETRY_SIMD_KERNELS(Sse2, "sse2")
+        GEOMETRY_SIMD_KERNELS(Avx2, "avx2,fma,f16c")
+        GEOMETRY_SIMD_KERNELS(Avx512, "avx512f")
+#undef GEOMETRY_SIMD_KERNELS
+#endif
+
+        // ------------------------------- DISPATCH ---------------------------
+        // Float16 and BFloat16 go through float buffers of widenBlock
+        // elements on the stack: widened, computed in float, rounded back.
+        constexpr std::size_t widenBlock = 256;
+
+        template<typename From, typename To>
+        void convertSerial(std::size_t n, const From* src, To* out);
+
+        // One contiguous chunk on the calling thread.
+        template<ElementOp Op, typename T>
+        void elementWiseSerial(std::size_t n, const T* a, const T* b, T* out)
+        {
+            if constexpr (isReducedFloat<T>)
+            {
+                float x[widenBlock], y[widenBlock];
+                for(std::size_t i=0; i<n; i+=widenBlock)
+                {
+                    const std::size_t m = std::min(widenBlock, n - i);
+                    convertSerial(m, a + i, x);
+                    convertSerial(m, b + i, y);
+                    elementWiseSerial<Op>(m, x, y, x);
+                    convertSerial(m, x, out + i);
+                }
+                return;
+            }
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return elementWiseAvx512<Op, SimdVector<Isa::Avx512, T>>(n, a, b, out);
+                    case Isa::Avx2:   return elementWiseAvx2<Op, SimdVector<Isa::Avx2, T>>(n, a, b, out);
+                    case Isa::Sse2:   return elementWiseSse2<Op, SimdVector<Isa::Sse2, T>>(n, a, b, out);
+                    default: break;
+                }
+#endif
+            for(std::size_t i=0; i<n; i++)
+                out[i] = applyElementOp<Op>(a[i], b[i]);
+        }
+
+        template<ElementOp Op, typename T>
+        void elementWiseSerial(std::size_t n, const T* a, T value, T* out)
+        {
+            if constexpr (isReducedFloat<T>)
+            {
+                float x[widenBlock];
+                for(std::size_t i=0; i<n; i+=widenBlock)
+                {
+                    const std::size_t m = std::min(widenBlock, n - i);
+                    convertSerial(m, a + i, x);
+                    elementWiseSerial<Op>(m, x, static_cast<float>(value), x);
+                    convertSerial(m, x, out + i);
+                }
+                return;
+            }
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return elementWiseAvx512<Op, SimdVector<Isa::Avx512, T>>(n, a, value, out);
+                    case Isa::Avx2:   return elementWiseAvx2<Op, SimdVector<Isa::Avx2, T>>(n, a, value, out);
+                    case Isa::Sse2:   return elementWiseSse2<Op, SimdVector<Isa::Sse2, T>>(n, a, value, out);
+                    default: break;
+                }
+#endif
+            for(std::size_t i=0; i<n; i++)
+                out[i] = applyElementOp<Op>(a[i], value);
+        }
+
+        template<ElementOp Op, typename T>
+        void elementWiseSerial(std::size_t n, T value, const T* b, T* out)
+        {
+            if constexpr (isReducedFloat<T>)
+            {
+                float y[widenBlock];
+                for(std::size_t i=0; i<n; i+=widenBlock)
+                {
+                    const std::size_t m = std::min(widenBlock, n - i);
+                    convertSerial(m, b + i, y);
+                    elementWiseSerial<Op>(m, static_cast<float>(value), y, y);
+                    convertSerial(m, y, out + i);
+                }
+                return;
+            }
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return elementWiseAvx512<Op, SimdVector<Isa::Avx512, T>>(n, value, b, out);
+                    case Isa::Avx2:   return elementWiseAvx2<Op, SimdVector<Isa::Avx2, T>>(n, value, b, out);
+                    case Isa::Sse2:   return elementWiseSse2<Op, SimdVector<Isa::Sse2, T>>(n, value, b, out);
+                    default: break;
+                }
+#endif
+            for(std::size_t i=0; i<n; i++)
+                out[i] = applyElementOp<Op>(value, b[i]);
+        }
+
+        template<typename T>
+        void broadcastSerial(std::size_t n, T value, T* out)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return broadcastAvx512<SimdVector<Isa::Avx512, T>>(n, value, out);
+                    case Isa::Avx2:   return broadcastAvx2<SimdVector<Isa::Avx2, T>>(n, value, out);
+                    case Isa::Sse2:   return broadcastSse2<SimdVector<Isa::Sse2, T>>(n, value, out);
+                    default: break;
+                }
+#endif
+            std::fill(out, out + n, value);
+        }
+
+        // Doubles to float on their way to 16 bits, rounded to odd (see
+        // roundToOdd in matrixHalf.decl.hpp).
+        inline void roundToOddSerial(std::size_t n, const double* src, float* out)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            switch(activeIsa())
+            {
+                case Isa::Avx512: return roundToOddAvx512(n, src, out);
+                case Isa::Avx2:   return roundToOddAvx2(n, src, out);
+                case Isa::Sse2:   return roundToOddSse2(n, src, out);
+                default: break;
+            }
+#endif
+            for(std::size_t i=0; i<n; i++)
+                out[i] = roundToOdd<float>(src[i]);
+        }
+
+        template<typename From, typename To>
+        void convertSerial(std::size_t n, const From* src, To* out)
+        {
+            // Rounding to float to nearest then to 16 bits would round twice:
+            // doubles go through floats rounded to odd, wider integers
+            // through the ReducedFloat constructor.
+            if constexpr (isReducedFloat<To> && !exactInFloat<From>)
+            {
+                if constexpr (std::is_same_v<From, double>)
+                {
+                    float buffer[widenBlock];
+                    for(std::size_t i=0; i<n; i+=widenBlock)
+                    {
+                        const std::size_t m = std::min(widenBlock, n - i);
+                        roundToOddSerial(m, src + i, buffer);
+                        convertSerial(m, buffer, out + i);
+                    }
+                }
+                else
+                    for(std::size_t i=0; i<n; i++)
+                        out[i] = static_cast<To>(src[i]);
+                return;
+            }
+            if constexpr ((isReducedFloat<From> || isReducedFloat<To>) && !std::is_same_v<From, To>
+                          && !std::is_same_v<From, float> && !std::is_same_v<To, float>)
+            {
+                float buffer[widenBlock];
+                for(std::size_t i=0; i<n; i+=widenBlock)
+                {
+                    const std::size_t m = std::min(widenBlock, n - i);
+                    convertSerial(m, src + i, buffer);
+                    convertSerial(m, buffer, out + i);
+                }
+                return;
+            }
+#ifdef GEOMETRY_X86_SIMD
+            switch(activeIsa())
+            {
+                case Isa::Avx512:
+                    if constexpr (hasSimdConvert<Isa::Avx512, From, To>)
+                        return convertAvx512(n, src, out);
+                    break;
+                case Isa::Avx2:
+                    if constexpr (hasSimdConvert<Isa::Avx2, From, To>)
+                        return convertAvx2(n, src, out);
+                    break;
+                case Isa::Sse2:
+                    if constexpr (hasSimdConvert<Isa::Sse2, From, To>)
+                        return convertSse2(n, src, out);
+                    break;
+                default: break;
+            }
+#endif
+            for(std::size_t i=0; i<n; i++)
+                out[i] = static_cast<To>(src[i]);
+        }
+
+        // -------------------------------- PUBLIC ----------------------------
+        // Big arrays are cut in one chunk per thread (see matrixParallel).
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t n, const T* a, const T* b, T* out)
+        {
+            parallelFor(n, n, [&](std::size_t first, std::size_t last){
+                elementWiseSerial<Op>(last - first, a + first, b + first, out + first);
+            });
+        }
+
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t n, const T* a, T value, T* out)
+        {
+            parallelFor(n, n, [&](std::size_t first, std::size_t last){
+                elementWiseSerial<Op>(last - first, a + first, value, out + first);
+            });
+        }
+
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t n, T value, const T* b, T* out)
+        {
+            parallelFor(n, n, [&](std::size_t first, std::size_t last){
+                elementWiseSerial<Op>(last - first, value, b + first, out + first);
+            });
+        }
+
+        template<typename T>
+        void broadcast(std::size_t n, T value, T* out)
+        {
+            parallelFor(n, n, [&](std::size_t first, std::size_t last){
+                broadcastSerial(last - first, value, out + first);
+            });
+        }
+
+        template<typename From, typename To>
+        void convert(std::size_t n, const From* src, To* out)
+        {
+            parallelFor(n, n, [&](std::size_t first, std::size_t last){
+                convertSerial(last - first, src + first, out + first);
+            });
+        }
+
+        // Padded blocks go column by column, one range of columns per thread.
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t nLines, std::size_t nColumns,
+                         const T* a, std::size_t lda, const T* b, std::size_t ldb,
+                         T* out, std::size_t ldOut)
+        {
+            if(((lda == nLines) && (ldb == nLines) && (ldOut == nLines)) || (nColumns == 1))
+                return elementWise<Op>(nLines*nColumns, a, b, out);
+            parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                    elementWiseSerial<Op>(nLines, a + col*lda, b + col*ldb, out + col*ldOut);
+            });
+        }
+
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t nLines, std::size_t nColumns,
+                         const T* a, std::size_t lda, T value,
+                         T* out, std::size_t ldOut)
+        {
+            if(((lda == nLines) && (ldOut == nLines)) || (nColumns == 1))
+                return elementWise<Op>(nLines*nColumns, a, value, out);
+            parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                    elementWiseSerial<Op>(nLines, a + col*lda, value, out + col*ldOut);
+            });
+        }
+
+        template<ElementOp Op, typename T>
+        void elementWise(std::size_t nLines, std::size_t nColumns,
+                         const T* a, std::size_t aStride, std::size_t lda,
+                         const T* b, std::size_t bStride, std::size_t ldb,
+                         T* out, std::size_t ldOut)
+        {
+            if((nLines == 0) || (nColumns == 0))
+                return;
+            if((aStride != 0) && (bStride != 0))
+                return elementWise<Op>(nLines, nColumns, a, lda, b, ldb, out, ldOut);
+            if((aStride != 0) && (bStride == 0) && ((ldb == 0) || (nColumns == 1))) // a op value
+                return elementWise<Op>(nLines, nColumns, a, lda, *b, out, ldOut);
+            if((aStride == 0) && (bStride != 0) && ((lda == 0) || (nColumns == 1))
+               && (((ldb == nLines) && (ldOut == nLines)) || (nColumns == 1))) // value op b
+                return elementWise<Op>(nLines*nColumns, *a, b, out);
+            parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                {
+                    const T* x = a + col*lda;
+                    const T* y = b + col*ldb;
+                    T* z = out + col*ldOut;
+                    if(aStride != 0)
+                        elementWiseSerial<Op>(nLines, x, *y, z);
+                    else if(bStride != 0)
+                        elementWiseSerial<Op>(nLines, *x, y, z);
+                    else
+                        broadcastSerial(nLines, applyElementOp<Op>(*x, *y), z);
+                }
+            });
+        }
+
+        template<typename From, typename To>
+        void convert(std::size_t nLines, std::size_t nColumns,
+                     const From* src, std::size_t ldSrc,
+                     To* out, std::size_t ldOut)
+        {
+            if(((ldSrc == nLines) && (ldOut == nLines)) || (nColumns == 1))
+                return convert(nLines*nColumns, src, out);
+            parallelFor(nColumns, nLines*nColumns, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                    convertSerial(nLines, src + col*ldSrc, out + col*ldOut);
+            });
+        }
+
+    }
+}
+#endif
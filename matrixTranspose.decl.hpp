@@ -0,0 +1,61 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXTRANSPOSE_DECL__GUARD__2610
+#define GEOMETRY__MATRIXTRANSPOSE_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+#include <memory>
+
+// LOCAL INCLUDES
+#include "matrixUtils.decl.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // Out-of-place transpose of column-major buffers:
+        // dst (cols x rows, leading dimension ldDst) = src^T, where src is
+        // rows x cols with leading dimension ldSrc. The copy goes tile by
+        // tile (both tiles stay in L1) and full 8x8 / 4x4 sub-tiles are
+        // swapped in SIMD registers for 4 and 8 byte types.
+        // Above parallelThreshold() the column tiles of src are split across
+        // threads; nThreads != 0 caps their number like a ThreadLimit.
+        template<typename T>
+        void transpose(std::size_t rows, std::size_t cols,
+                       const T* src, std::size_t ldSrc,
+                       T* dst, std::size_t ldDst,
+                       std::size_t nThreads = 0);
+
+        // In-place transpose of a column-major rows x cols buffer, which then
+        // holds the cols x rows result. Square matrices swap tiles pairwise
+        // through one stack tile. Rectangular ones follow the rotation /
+        // row shuffle / column shuffle decomposition of Catanzaro et al.
+        // (PPoPP 2014): every pass reads whole lines or groups of up to 32
+        // columns through a scratch taken from alloc, at most
+        // transposeScratch(rows, cols) elements. A line longer than that
+        // (a 3 x N matrix) is permuted in place along its cycles with
+        // max(rows, cols) bits of scratch.
+        template<typename T, class Alloc = std::allocator<T>>
+        void transposeInPlace(std::size_t rows, std::size_t cols, T* data,
+                              const Alloc& alloc = Alloc());
+        // 1/16 of the matrix, at least 65536 elements.
+        std::size_t transposeScratch(std::size_t rows, std::size_t cols);
+
+        // Square n x n block with leading dimension ld.
+        template<typename T>
+        void transposeSquareInPlace(std::size_t n, T* data, std::size_t ld);
+
+        // Single cache tile, what every thread runs.
+        template<typename T>
+        void transposeTile(std::size_t rows, std::size_t cols,
+                           const T* src, std::size_t ldSrc,
+                           T* dst, std::size_t ldDst);
+
+    }
+}
+#endif
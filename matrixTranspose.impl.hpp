@@ -0,0 +1,517 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXTRANSPOSE_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXTRANSPOSE_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrixTranspose.decl.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+
+namespace geometry
+{
+    namespace utils{
+
+        // Edge of a cache tile: source and destination tiles fit in L1 with
+        // room to spare, bigger tiles measured slower (TLB pressure).
+        constexpr std::size_t transposeTileSize = 32;
+
+
+        // --------------------------- SCALAR KERNEL --------------------------
+        // Lines [l0, l1) of columns [c0, c1) of src.
+        template<typename T>
+        void transposeScalar(std::size_t l0, std::size_t l1,
+                             std::size_t c0, std::size_t c1,
+                             const T* src, std::size_t ldSrc,
+                             T* dst, std::size_t ldDst)
+        {
+            for(std::size_t col=c0; col<c1; col++)
+                for(std::size_t line=l0; line<l1; line++)
+                    dst[col + line*ldDst] = src[line + col*ldSrc];
+        }
+
+        // ---------------------------- SIMD KERNELS --------------------------
+        // rows and cols are multiples of the register tile. Data is only
+        // touched through intrinsics, so 32-bit integers go through the
+        // float versions (and 64-bit ones through double) bit for bit.
+#ifdef GEOMETRY_X86_SIMD
+        __attribute__((target("avx")))
+        inline void transposeTiles8x8Avx(std::size_t rows, std::size_t cols,
+                                         const float* src, std::size_t ldSrc,
+                                         float* dst, std::size_t ldDst)
+        {
+            for(std::size_t col=0; col<cols; col+=8)
+                for(std::size_t line=0; line<rows; line+=8)
+                {
+                    const float* s = src + line + col*ldSrc;
+                    float* d = dst + col + line*ldDst;
+                    const __m256 r0 = _mm256_loadu_ps(s);
+                    const __m256 r1 = _mm256_loadu_ps(s + ldSrc);
+                    const __m256 r2 = _mm256_loadu_ps(s + 2*ldSrc);
+                    const __m256 r3 = _mm256_loadu_ps(s + 3*ldSrc);
+                    const __m256 r4 = _mm256_loadu_ps(s + 4*ldSrc);
+                    const __m256 r5 = _mm256_loadu_ps(s + 5*ldSrc);
+                    const __m256 r6 = _mm256_loadu_ps(s + 6*ldSrc);
+                    const __m256 r7 = _mm256_loadu_ps(s + 7*ldSrc);
+
+                    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+                    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+                    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+                    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+                    const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+                    const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+                    const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+                    const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+                    const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+                    const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+                    const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+                    const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+                    const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1,0,1,0));
+                    const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3,2,3,2));
+                    const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1,0,1,0));
+                    const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3,2,3,2));
+
+                    _mm256_storeu_ps(d,           _mm256_permute2f128_ps(u0, u4, 0x20));
+                    _mm256_storeu_ps(d + ldDst,   _mm256_permute2f128_ps(u1, u5, 0x20));
+                    _mm256_storeu_ps(d + 2*ldDst, _mm256_permute2f128_ps(u2, u6, 0x20));
+                    _mm256_storeu_ps(d + 3*ldDst, _mm256_permute2f128_ps(u3, u7, 0x20));
+                    _mm256_storeu_ps(d + 4*ldDst, _mm256_permute2f128_ps(u0, u4, 0x31));
+                    _mm256_storeu_ps(d + 5*ldDst, _mm256_permute2f128_ps(u1, u5, 0x31));
+                    _mm256_storeu_ps(d + 6*ldDst, _mm256_permute2f128_ps(u2, u6, 0x31));
+                    _mm256_storeu_ps(d + 7*ldDst, _mm256_permute2f128_ps(u3, u7, 0x31));
+                }
+        }
+
+        __attribute__((target("avx")))
+        inline void transposeTiles4x4Avx(std::size_t rows, std::size_t cols,
+                                         const double* src, std::size_t ldSrc,
+                                         double* dst, std::size_t ldDst)
+        {
+            for(std::size_t col=0; col<cols; col+=4)
+                for(std::size_t line=0; line<rows; line+=4)
+                {
+                    const double* s = src + line + col*ldSrc;
+                    double* d = dst + col + line*ldDst;
+                    const __m256d r0 = _mm256_loadu_pd(s);
+                    const __m256d r1 = _mm256_loadu_pd(s + ldSrc);
+                    const __m256d r2 = _mm256_loadu_pd(s + 2*ldSrc);
+                    const __m256d r3 = _mm256_loadu_pd(s + 3*ldSrc);
+
+                    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+                    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+                    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+                    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+                    _mm256_storeu_pd(d,           _mm256_permute2f128_pd(t0, t2, 0x20));
+                    _mm256_storeu_pd(d + ldDst,   _mm256_permute2f128_pd(t1, t3, 0x20));
+                    _mm256_storeu_pd(d + 2*ldDst, _mm256_permute2f128_pd(t0, t2, 0x31));
+                    _mm256_storeu_pd(d + 3*ldDst, _mm256_permute2f128_pd(t1, t3, 0x31));
+                }
+        }
+
+        __attribute__((target("sse2")))
+        inline void transposeTiles4x4Sse(std::size_t rows, std::size_t cols,
+                                         const float* src, std::size_t ldSrc,
+                                         float* dst, std::size_t ldDst)
+        {
+            for(std::size_t col=0; col<cols; col+=4)
+                for(std::size_t line=0; line<rows; line+=4)
+                {
+                    const float* s = src + line + col*ldSrc;
+                    float* d = dst + col + line*ldDst;
+                    __m128 r0 = _mm_loadu_ps(s);
+                    __m128 r1 = _mm_loadu_ps(s + ldSrc);
+                    __m128 r2 = _mm_loadu_ps(s + 2*ldSrc);
+                    __m128 r3 = _mm_loadu_ps(s + 3*ldSrc);
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    _mm_storeu_ps(d,           r0);
+                    _mm_storeu_ps(d + ldDst,   r1);
+                    _mm_storeu_ps(d + 2*ldDst, r2);
+                    _mm_storeu_ps(d + 3*ldDst, r3);
+                }
+        }
+
+        // 16-bit elements (Float16, BFloat16, short): pairs, then quads,
+        // then halves of registers interleaved.
+        __attribute__((target("sse2")))
+        inline void transposeTiles8x8Sse(std::size_t rows, std::size_t cols,
+                                         const std::uint16_t* src, std::size_t ldSrc,
+                                         std::uint16_t* dst, std::size_t ldDst)
+        {
+            for(std::size_t col=0; col<cols; col+=8)
+                for(std::size_t line=0; line<rows; line+=8)
+                {
+                    const std::uint16_t* s = src + line + col*ldSrc;
+                    std::uint16_t* d = dst + col + line*ldDst;
+                    __m128i r[8];
+                    for(std::size_t i=0; i<8; i++)
+                        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i*ldSrc));
+
+                    __m128i t[8];
+                    for(std::size_t i=0; i<8; i+=2)
+                    {
+                        t[i]     = _mm_unpacklo_epi16(r[i], r[i+1]);
+                        t[i + 1] = _mm_unpackhi_epi16(r[i], r[i+1]);
+                    }
+                    const __m128i u0 = _mm_unpacklo_epi32(t[0], t[2]);
+                    const __m128i u1 = _mm_unpackhi_epi32(t[0], t[2]);
+                    const __m128i u2 = _mm_unpacklo_epi32(t[1], t[3]);
+                    const __m128i u3 = _mm_unpackhi_epi32(t[1], t[3]);
+                    const __m128i u4 = _mm_unpacklo_epi32(t[4], t[6]);
+                    const __m128i u5 = _mm_unpackhi_epi32(t[4], t[6]);
+                    const __m128i u6 = _mm_unpacklo_epi32(t[5], t[7]);
+                    const __m128i u7 = _mm_unpackhi_epi32(t[5], t[7]);
+
+                    const __m128i out[8] = {_mm_unpacklo_epi64(u0, u4), _mm_unpackhi_epi64(u0, u4),
+                                            _mm_unpacklo_epi64(u1, u5), _mm_unpackhi_epi64(u1, u5),
+                                            _mm_unpacklo_epi64(u2, u6), _mm_unpackhi_epi64(u2, u6),
+                                            _mm_unpacklo_epi64(u3, u7), _mm_unpackhi_epi64(u3, u7)};
+                    for(std::size_t i=0; i<8; i++)
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i*ldDst), out[i]);
+                }
+        }
+#endif
+
+        // ----------------------------- TILE LEVEL ---------------------------
+        template<typename T>
+        void transposeTile(std::size_t rows, std::size_t cols,
+                           const T* src, std::size_t ldSrc,
+                           T* dst, std::size_t ldDst)
+        {
+            std::size_t rowsV = 0;
+            std::size_t colsV = 0;
+#ifdef GEOMETRY_X86_SIMD
+            const Isa isa = activeIsa();
+            if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) == 4))
+            {
+                if(isa >= Isa::Sse2)
+                {
+                    const bool avx = (isa >= Isa::Avx2);
+                    const std::size_t width = avx ? 8 : 4;
+                    rowsV = rows - rows%width;
+                    colsV = cols - cols%width;
+                    const float* s = reinterpret_cast<const float*>(src);
+                    float* d = reinterpret_cast<float*>(dst);
+                    if(avx)
+                        transposeTiles8x8Avx(rowsV, colsV, s, ldSrc, d, ldDst);
+                    else
+                        transposeTiles4x4Sse(rowsV, colsV, s, ldSrc, d, ldDst);
+                }
+            }
+            else if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) == 2))
+            {
+                if(isa >= Isa::Sse2)
+                {
+                    rowsV = rows - rows%8;
+                    colsV = cols - cols%8;
+                    transposeTiles8x8Sse(rowsV, colsV,
+                                         reinterpret_cast<const std::uint16_t*>(src), ldSrc,
+                                         reinterpret_cast<std::uint16_t*>(dst), ldDst);
+                }
+            }
+            else if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) == 8))
+            {
+                if(isa >= Isa::Avx2)
+                {
+                    rowsV = rows - rows%4;
+                    colsV = cols - cols%4;
+                    transposeTiles4x4Avx(rowsV, colsV,
+                                         reinterpret_cast<const double*>(src), ldSrc,
+                                         reinterpret_cast<double*>(dst), ldDst);
+                }
+            }
+#endif
+            // What the registers did not cover: bottom band then right band.
+            transposeScalar(rowsV, rows, 0, cols, src, ldSrc, dst, ldDst);
+            transposeScalar(std::size_t{0}, rowsV, colsV, cols, src, ldSrc, dst, ldDst);
+        }
+
+        // ----------------------------- FULL MATRIX --------------------------
+        // Columns [c0, c1) of src, tile by tile. Tiles are walked along the
+        // lines of src so that each destination column is written in order.
+        template<typename T>
+        void transposeColumns(std::size_t rows, std::size_t c0, std::size_t c1,
+                              const T* src, std::size_t ldSrc,
+                              T* dst, std::size_t ldDst)
+        {
+            constexpr std::size_t tile = transposeTileSize;
+            for(std::size_t line=0; line<rows; line+=tile)
+                for(std::size_t col=c0; col<c1; col+=tile)
+                    transposeTile(std::min(tile, rows-line), std::min(tile, c1-col),
+                                  src + line + col*ldSrc, ldSrc,
+                                  dst + col + line*ldDst, ldDst);
+        }
+
+        template<typename T>
+        void transpose(std::size_t rows, std::size_t cols,
+                       const T* src, std::size_t ldSrc,
+                       T* dst, std::size_t ldDst,
+                       std::size_t nThreads)
+        {
+            // Whole column tiles per thread.
+            constexpr std::size_t tile = transposeTileSize;
+            const std::size_t nTiles = (cols + tile - 1)/tile;
+            const auto columns = [&](std::size_t first, std::size_t last){
+                transposeColumns(rows, first*tile, std::min(cols, last*tile),
+                                 src, ldSrc, dst, ldDst);
+            };
+            if(nThreads == 0)
+                parallelFor(nTiles, rows*cols, columns);
+            else
+            {
+                const ThreadLimit limit(nThreads);
+                parallelFor(nTiles, rows*cols, columns);
+            }
+        }
+
+        // ------------------------------ IN PLACE ----------------------------
+        template<typename T>
+        void transposeSquareInPlace(std::size_t n, T* data, std::size_t ld)
+        {
+            constexpr std::size_t tile = transposeTileSize;
+            const std::size_t nTiles = (n + tile - 1)/tile;
+            // Band I swaps nTiles - I/tile tile pairs: bands are dealt long,
+            // short, long, ... so that every thread gets about as much work.
+            parallelFor(nTiles, n*n, [&](std::size_t first, std::size_t last){
+                alignas(64) T buffer[tile*tile];
+                for(std::size_t t=first; t<last; t++)
+                {
+                    const std::size_t I = ((t%2 == 0) ? t/2 : nTiles - 1 - t/2)*tile;
+                    const std::size_t bi = std::min(tile, n-I);
+                    T* diagonal = data + I + I*ld;
+                    transposeTile(bi, bi, diagonal, ld, buffer, tile);
+                    for(std::size_t col=0; col<bi; col++)
+                        std::copy(buffer + col*tile, buffer + col*tile + bi, diagonal + col*ld);
+
+                    // Tiles (I,J) and (J,I) swap places, both transposed.
+                    for(std::size_t J=I+tile; J<n; J+=tile)
+                    {
+                        const std::size_t bj = std::min(tile, n-J);
+                        T* upper = data + I + J*ld;
+                        T* lower = data + J + I*ld;
+                        transposeTile(bi, bj, upper, ld, buffer, tile);
+                        transposeTile(bj, bi, lower, ld, upper, ld);
+                        for(std::size_t col=0; col<bi; col++)
+                            std::copy(buffer + col*tile, buffer + col*tile + bj, lower + col*ld);
+                    }
+                }
+            });
+        }
+
+        // x such that a*x = 1 (mod b), a and b being coprime.
+        inline std::size_t modularInverse(std::size_t a, std::size_t b)
+        {
+            if(b == 1)
+                return 0;
+            long long r0 = static_cast<long long>(b), r1 = static_cast<long long>(a % b);
+            long long x0 = 0, x1 = 1;
+            while(r1 != 0)
+            {
+                const long long q = r0/r1;
+                r0 -= q*r1; std::swap(r0, r1);
+                x0 -= q*x1; std::swap(x0, x1);
+            }
+            return static_cast<std::size_t>((x0 % static_cast<long long>(b) + static_cast<long long>(b))
+                                            % static_cast<long long>(b));
+        }
+
+        inline std::size_t transposeScratch(std::size_t rows, std::size_t cols)
+        {
+            return std::max<std::size_t>(std::size_t{1} << 16, rows*cols/16);
+        }
+
+        // Moves element p of a line of length elements, stride apart, to
+        // target(p), cycle after cycle: visited (length bits) is the only
+        // scratch. Lines longer than the scratch go through here.
+        template<typename T, class Target, class Bits>
+        void permuteInPlace(std::size_t length, T* first, std::size_t stride, Target target, Bits& visited)
+        {
+            std::fill(visited.begin(), visited.begin() + static_cast<std::ptrdiff_t>(length), false);
+            for(std::size_t start=0; start<length; start++)
+            {
+                if(visited[start])
+                    continue;
+                T carried = first[start*stride];
+                std::size_t p = start;
+                do
+                {
+                    p = target(p);
+                    visited[p] = true;
+                    std::swap(carried, first[p*stride]);
+                }
+                while(p != start);
+            }
+        }
+
+        template<typename T, class Alloc>
+        void transposeInPlace(std::size_t rows, std::size_t cols, T* data, const Alloc& alloc)
+        {
+            if((rows <= 1) || (cols <= 1)) // Vectors: same storage both ways.
+                return;
+            if(rows == cols)
+            {
+                transposeSquareInPlace(rows, data, rows);
+                return;
+            }
+
+            // Seen as row-major, data is an m x n matrix (element (i,j) at
+            // i*n + j) with m = cols and n = rows, and the goal is its
+            // row-major transpose: (i,j) has to end at flat index j*m + i.
+            // With c = gcd(m,n), m = a*c, n = b*c, this splits into:
+            //  1. rotate column j down by j/b       (only when c > 1)
+            //  2. inside each row, move column j to (j*m + i) mod n
+            //  3. inside each column, move row i to (j*m + i) / n
+            // where (i,j) are the original coordinates of the element.
+            const std::size_t m = cols;
+            const std::size_t n = rows;
+            const std::size_t c = std::gcd(m, n);
+            const std::size_t b = n/c;
+            const std::size_t aInverse = modularInverse(m/c, b);
+
+            // Column passes work on a group of neighbouring columns at once
+            // so that each row is read by whole cache lines, as many as the
+            // scratch holds up to 32. Indices are updated incrementally, a
+            // division per element costs more than the memory traffic.
+            // Columns (rows) longer than the scratch are permuted in place
+            // instead, one at a time (short-wide and tall-thin matrices).
+            constexpr std::size_t group = 32;
+            const std::size_t scratch = transposeScratch(rows, cols);
+            const std::size_t columnGroup = std::min({group, n, scratch/m});
+            const bool rowBuffer = (n <= scratch);
+            std::vector<T, Alloc> buffer(std::max(m*columnGroup, rowBuffer ? n : 0), alloc);
+            using BitAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<bool>;
+            std::vector<bool, BitAlloc> visited(((columnGroup == 0) || !rowBuffer) ? std::max(m, n) : 0,
+                                                BitAlloc(alloc));
+            std::size_t state[3][group];
+
+            // 1. Column rotation.
+            if((c > 1) && (columnGroup == 0))
+                for(std::size_t j=0; j<n; j++)
+                {
+                    const std::size_t shift = (j/b) % m;
+                    permuteInPlace(m, data + j, n, [&](std::size_t i){
+                        return (i + shift >= m) ? i + shift - m : i + shift;
+                    }, visited);
+                }
+            else if(c > 1)
+                for(std::size_t j0=0; j0<n; j0+=columnGroup)
+                {
+                    const std::size_t g = std::min(columnGroup, n-j0);
+                    std::size_t* shift = state[0];
+                    for(std::size_t jj=0; jj<g; jj++)
+                        shift[jj] = ((j0+jj)/b) % m;
+                    for(std::size_t i=0; i<m; i++)
+                        for(std::size_t jj=0; jj<g; jj++)
+                        {
+                            const std::size_t row = (i + shift[jj] >= m) ? i + shift[jj] - m : i + shift[jj];
+                            buffer[row*g + jj] = data[i*n + j0 + jj];
+                        }
+                    for(std::size_t i=0; i<m; i++)
+                        std::copy(&buffer[i*g], &buffer[i*g] + g, data + i*n + j0);
+                }
+
+            // 2. Row shuffle, (i,j) being now at row (i + j/b) mod m. Along a
+            //    row, j/b is constant by runs of b and the target column
+            //    starts at i mod n (q*b*m is a multiple of n) then moves by m.
+            const std::size_t mModN = m % n;
+            const std::size_t a = m/c;
+            for(std::size_t row=0; (row<m) && !rowBuffer; row++)
+            {
+                // j = q*b + t goes to (i + t*m) mod n, t*m mod n = c*(t*a mod b).
+                permuteInPlace(n, data + row*n, 1, [&](std::size_t j){
+                    const std::size_t q = j/b, t = j % b;
+                    const std::size_t i = (row >= q) ? row - q : row + m - q;
+                    return (i % n + c*((t*(a % b)) % b)) % n;
+                }, visited);
+            }
+            for(std::size_t row=0; (row<m) && rowBuffer; row++)
+            {
+                T* line = data + row*n;
+                for(std::size_t q=0, j=0; q<c; q++)
+                {
+                    const std::size_t i = (row >= q) ? row - q : row + m - q;
+                    std::size_t s = i % n;
+                    for(std::size_t t=0; t<b; t++, j++)
+                    {
+                        buffer[s] = line[j];
+                        s += mModN;
+                        if(s >= n)
+                            s -= n;
+                    }
+                }
+                std::copy(&buffer[0], &buffer[0] + n, line);
+            }
+
+            // 3. Column shuffle. The element at (row, s) is the original
+            //    (i, j = q*b + t) with q = (row - s) mod c, i = (row - q) mod m
+            //    and t*a = (s - i)/c (mod b). It goes to row r = (j*m + i)/n.
+            //    Going down a column q grows by one (so r by a) and when it
+            //    wraps, i moves by c and t by -1/a (+1 if i wrapped too).
+            const std::size_t tStep = b - aInverse;
+            for(std::size_t s=0; (s<n) && (columnGroup == 0); s++)
+                permuteInPlace(m, data + s, n, [&](std::size_t row){
+                    const std::size_t q = (row % c + c - s % c) % c;
+                    const std::size_t i = (row >= q) ? row - q : row + m - q;
+                    const std::size_t t = ((((s + n - i % n) % n)/c)*aInverse) % b;
+                    return ((q*b + t)*m + i)/n;
+                }, visited);
+            for(std::size_t s0=0; (s0<n) && (columnGroup > 0); s0+=columnGroup)
+            {
+                const std::size_t g = std::min(columnGroup, n-s0);
+                std::size_t* qs = state[0];
+                std::size_t* is = state[1];
+                std::size_t* ts = state[2];
+                std::size_t rs[group];
+                for(std::size_t ss=0; ss<g; ss++)
+                {
+                    const std::size_t s = s0 + ss;
+                    qs[ss] = (c - s % c) % c;
+                    is[ss] = (m - qs[ss]) % m;
+                    ts[ss] = ((((s + n - is[ss] % n) % n)/c)*aInverse) % b;
+                    rs[ss] = ((qs[ss]*b + ts[ss])*m + is[ss])/n;
+                }
+                for(std::size_t row=0; row<m; row++)
+                    for(std::size_t ss=0; ss<g; ss++)
+                    {
+                        buffer[rs[ss]*g + ss] = data[row*n + s0 + ss];
+                        if(++qs[ss] < c)
+                        {
+                            rs[ss] += a;
+                            continue;
+                        }
+                        qs[ss] = 0;
+                        is[ss] += c;
+                        ts[ss] += tStep;
+                        if(ts[ss] >= b)
+                            ts[ss] -= b;
+                        if(is[ss] >= m)
+                        {
+                            is[ss] -= m;
+                            if(++ts[ss] == b)
+                                ts[ss] = 0;
+                        }
+                        rs[ss] = (ts[ss]*m + is[ss])/n;
+                    }
+                for(std::size_t row=0; row<m; row++)
+                    std::copy(&buffer[row*g], &buffer[row*g] + g, data + row*n + s0);
+            }
+        }
+
+    }
+}
+
+#endif
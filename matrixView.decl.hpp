@@ -0,0 +1,254 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXVIEW_DECL__GUARD__2610
+#define GEOMETRY__MATRIXVIEW_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "matrixExpressions.decl.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    // Forward iterator over a strided buffer, column after column like the
+    // storage of Matrix. T is const for read-only views.
+    template<class T>
+    class StridedIterator
+    {
+    public: // types
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+    protected: // attributes
+        T* mp_data{};
+        std::size_t m_nLines{};
+        std::size_t m_lineStride{};
+        std::size_t m_columnStride{};
+        std::size_t m_line{};
+        std::size_t m_col{};
+
+    public: // METHODS
+        StridedIterator() {}
+        StridedIterator(T* data, std::size_t nLines,
+                        std::size_t lineStride, std::size_t columnStride,
+                        std::size_t line, std::size_t col):
+            mp_data{data},
+            m_nLines{nLines},
+            m_lineStride{lineStride},
+            m_columnStride{columnStride},
+            m_line{line},
+            m_col{col}
+            {}
+
+        reference operator*() const {return mp_data[m_line*m_lineStride + m_col*m_columnStride];}
+        pointer operator->() const {return &(**this);}
+
+        StridedIterator& operator++() {
+            if(++m_line == m_nLines)
+            {
+                m_line = 0;
+                m_col++;
+            }
+            return *this;
+        }
+        StridedIterator operator++(int) {StridedIterator tmp{*this}; ++(*this); return tmp;}
+
+        bool operator==(const StridedIterator& other) const {
+            return (m_line == other.m_line) && (m_col == other.m_col);
+        }
+        bool operator!=(const StridedIterator& other) const {return !(*this == other);}
+    };
+
+    // Non-owning, read-only window on a matrix (or any buffer): element
+    // (line, col) is data[line*lineStride + col*columnStride]. A whole
+    // matrix has strides (1, nLines); row, column, block and transposed
+    // views only change the offset, the shape and the strides, so they cost
+    // nothing and never copy. Views are MatrixExpressions: they go in every
+    // math operator and evaluate into a Matrix like any other expression.
+    // The viewed memory must outlive the view.
+    template<class T>
+    class ConstMatrixView: public utils::MatrixExpression<ConstMatrixView<T>>
+    {
+    public: // types
+        using value_type = T;
+        using const_iterator = StridedIterator<const T>;
+
+    protected: // attributes
+        const T* mp_data{};
+        std::size_t m_nLines{};
+        std::size_t m_nColumns{};
+        std::size_t m_lineStride{1};
+        std::size_t m_columnStride{};
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        ConstMatrixView() {} // --> (0,0) view on nothing.
+
+        ConstMatrixView(const T* data, std::size_t nLines, std::size_t nColumns,
+                        std::size_t lineStride, std::size_t columnStride):
+            mp_data{data},
+            m_nLines{nLines},
+            m_nColumns{nColumns},
+            m_lineStride{lineStride},
+            m_columnStride{columnStride}
+            {}
+
+        // Whole matrix.
+        template<class Alloc, Layout Order>
+        ConstMatrixView(const Matrix<T, Alloc, Order>& matrix);
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        T operator()(std::size_t line, std::size_t col) const {
+            GEOMETRY_CHECK_INDEX(line, m_nLines);
+            GEOMETRY_CHECK_INDEX(col, m_nColumns);
+            return mp_data[line*m_lineStride + col*m_columnStride];
+        }
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        std::size_t nLines()   const {return m_nLines;}
+        std::size_t nColumns() const {return m_nColumns;}
+        std::size_t length() const {return m_nLines*m_nColumns;}
+        std::size_t lineStride()   const {return m_lineStride;}
+        std::size_t columnStride() const {return m_columnStride;}
+        const T* data() const {return mp_data;}
+        // Same layout as a Matrix: a single column-major block.
+        bool isContiguous() const {
+            return (m_lineStride == 1) && ((m_columnStride == m_nLines) || (m_nColumns <= 1));
+        }
+
+        void print() const;
+
+        // ---------------------------- SUB-VIEWS -----------------------------
+        // -> Exceptions::SizeMismatch() if they do not fit in this view
+        ConstMatrixView row(std::size_t line) const;
+        ConstMatrixView column(std::size_t col) const;
+        ConstMatrixView block(std::size_t line, std::size_t col,
+                              std::size_t nLines, std::size_t nColumns) const;
+        ConstMatrixView transposed() const {
+            return {mp_data, m_nColumns, m_nLines, m_columnStride, m_lineStride};
+        }
+
+        // ----------------------------- ITERATORS ----------------------------
+        const_iterator begin() const {return {mp_data, m_nLines, m_lineStride, m_columnStride, 0, 0};}
+        const_iterator end()   const {return {mp_data, m_nLines, m_lineStride, m_columnStride, 0, endColumn()};}
+
+    protected:
+        std::size_t endColumn() const {return (m_nLines == 0) ? 0 : m_nColumns;}
+
+        // -> Exceptions::SizeMismatch()
+        void checkBlock(std::size_t line, std::size_t col,
+                        std::size_t nLines, std::size_t nColumns) const;
+    };
+
+    // Writable view. Copying a view copies the window, assigning to it
+    // writes the elements (shapes must match):
+    //     m.row(0) = m.row(1);  m.block(0, 0, 2, 2) += 1;
+    // Constness is the one of the viewed data, not of the view itself.
+    template<class T>
+    class MatrixView: public ConstMatrixView<T>
+    {
+    public: // types
+        using iterator = StridedIterator<T>;
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        MatrixView() {}
+
+        MatrixView(T* data, std::size_t nLines, std::size_t nColumns,
+                   std::size_t lineStride, std::size_t columnStride):
+            ConstMatrixView<T>(data, nLines, nColumns, lineStride, columnStride)
+            {}
+
+        // Whole matrix.
+        template<class Alloc, Layout Order>
+        MatrixView(Matrix<T, Alloc, Order>& matrix);
+
+        MatrixView(const MatrixView& other) = default;
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        T& operator()(std::size_t line, std::size_t col) const {
+            GEOMETRY_CHECK_INDEX(line, this->m_nLines);
+            GEOMETRY_CHECK_INDEX(col, this->m_nColumns);
+            return data()[line*this->m_lineStride + col*this->m_columnStride];
+        }
+
+        // -> Assignement (element by element)
+        // -> Exceptions::SizeMismatch()
+        MatrixView& operator=(const MatrixView& other);
+        template<class E>
+        MatrixView& operator=(const utils::MatrixExpression<E>& expr);
+        MatrixView& operator=(T value);
+
+        // -> Math operations in place
+        MatrixView& operator*=(T value);
+        MatrixView& operator+=(T value);
+        MatrixView& operator/=(T value);
+        MatrixView& operator-=(T value);
+
+        template<class E>
+        MatrixView& operator*=(const utils::MatrixExpression<E>& value);
+        template<class E>
+        MatrixView& operator+=(const utils::MatrixExpression<E>& value);
+        template<class E>
+        MatrixView& operator/=(const utils::MatrixExpression<E>& value);
+        template<class E>
+        MatrixView& operator-=(const utils::MatrixExpression<E>& value);
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        T* data() const {return const_cast<T*>(this->mp_data);}
+
+        // ---------------------------- SUB-VIEWS -----------------------------
+        // -> Exceptions::SizeMismatch() if they do not fit in this view
+        MatrixView row(std::size_t line) const;
+        MatrixView column(std::size_t col) const;
+        MatrixView block(std::size_t line, std::size_t col,
+                         std::size_t nLines, std::size_t nColumns) const;
+        MatrixView transposed() const {
+            return {data(), this->m_nColumns, this->m_nLines, this->m_columnStride, this->m_lineStride};
+        }
+
+        // ----------------------------- ITERATORS ----------------------------
+        iterator begin() const {return {data(), this->m_nLines, this->m_lineStride, this->m_columnStride, 0, 0};}
+        iterator end()   const {return {data(), this->m_nLines, this->m_lineStride, this->m_columnStride, 0, this->endColumn()};}
+
+    protected:
+        // Evaluate expr, broadcast to the shape of the view (v = row fills
+        // every line), into the viewed elements with assign(element, value).
+        // When expr reads the viewed memory through another layout (e.g.
+        // v = v.transposed()) it is first evaluated into a temporary.
+        // -> Exceptions::SizeMismatch()
+        template<class E, class Assign>
+        void evaluate(const utils::MatrixExpression<E>& expr, Assign assign);
+    };
+
+    namespace utils{
+
+        // Inside expressions a view is a strided leaf.
+        template<class T>
+        struct ExpressionOperand<ConstMatrixView<T>>
+        {
+            using type = StridedOperand<T>;
+            static type make(const MatrixExpression<ConstMatrixView<T>>& expr) {
+                const ConstMatrixView<T>& view = expr.self();
+                return type(view.data(), view.nLines(), view.nColumns(),
+                            view.lineStride(), view.columnStride());
+            }
+        };
+
+    }
+}
+#endif
@@ -0,0 +1,234 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__MATRIXVIEW_IMPL__GUARD__2610
+#define GEOMETRY__MATRIXVIEW_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+
+// LOCAL INCLUDES
+#include "matrixView.decl.hpp"
+#include "matrix.decl.hpp"
+#include "matrixExpressions.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    // ============================ CONSTMATRIXVIEW ===========================
+    // ----------------------------- CONSTRUCTORS -----------------------------
+    template<class T> template<class Alloc, Layout Order>
+    ConstMatrixView<T>::ConstMatrixView(const Matrix<T, Alloc, Order>& matrix):
+        ConstMatrixView(matrix.data(), matrix.nLines(), matrix.nColumns(),
+                        (Order == Layout::ColumnMajor) ? 1 : matrix.leadingDimension(),
+                        (Order == Layout::ColumnMajor) ? matrix.leadingDimension() : 1)
+        {}
+
+    // --------------------- ASK INFO MEMBERS (-> const) ----------------------
+    template<class T>
+    void ConstMatrixView<T>::print() const
+    {
+        std::cout << m_nLines
+                  << " X "
+                  << m_nColumns
+                  << " matrix:\n";
+        for(std::size_t line=0; line<m_nLines; line++)
+        {
+            for(std::size_t col=0; col<m_nColumns; col++)
+                std::cout << (*this)(line, col) << " ";
+            std::cout << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    // ------------------------------- SUB-VIEWS ------------------------------
+    template<class T>
+    ConstMatrixView<T> ConstMatrixView<T>::row(std::size_t line) const
+    {
+        return this->block(line, 0, 1, m_nColumns);
+    }
+
+    template<class T>
+    ConstMatrixView<T> ConstMatrixView<T>::column(std::size_t col) const
+    {
+        return this->block(0, col, m_nLines, 1);
+    }
+
+    template<class T>
+    ConstMatrixView<T> ConstMatrixView<T>::block(std::size_t line, std::size_t col,
+                                                 std::size_t nLines, std::size_t nColumns) const
+    {
+        this->checkBlock(line, col, nLines, nColumns);
+        return {mp_data + line*m_lineStride + col*m_columnStride,
+                nLines, nColumns, m_lineStride, m_columnStride};
+    }
+
+    template<class T>
+    void ConstMatrixView<T>::checkBlock(std::size_t line, std::size_t col,
+                                        std::size_t nLines, std::size_t nColumns) const
+    {
+        if((line + nLines > m_nLines) || (col + nColumns > m_nColumns))
+            throw Exeptions::SizeMismatch(this->length(),
+                                          (line + nLines)*(col + nColumns));
+    }
+
+    // =============================== MATRIXVIEW =============================
+    // ----------------------------- CONSTRUCTORS -----------------------------
+    template<class T> template<class Alloc, Layout Order>
+    MatrixView<T>::MatrixView(Matrix<T, Alloc, Order>& matrix):
+        MatrixView(matrix.data(), matrix.nLines(), matrix.nColumns(),
+                   (Order == Layout::ColumnMajor) ? 1 : matrix.leadingDimension(),
+                   (Order == Layout::ColumnMajor) ? matrix.leadingDimension() : 1)
+        {}
+
+    // ------------------------ OPERATORS OVERLOADING -------------------------
+    // -> Assignement
+    template<class T>
+    MatrixView<T>& MatrixView<T>::operator=(const MatrixView& other)
+    {
+        this->evaluate(static_cast<const ConstMatrixView<T>&>(other), utils::AssignOp{});
+        return *this;
+    }
+
+    template<class T> template<class E>
+    MatrixView<T>& MatrixView<T>::operator=(const utils::MatrixExpression<E>& expr)
+    {
+        this->evaluate(expr, utils::AssignOp{});
+        return *this;
+    }
+
+    template<class T>
+    MatrixView<T>& MatrixView<T>::operator=(T value)
+    {
+        if(this->isContiguous())
+            utils::broadcast(this->length(), value, data());
+        else
+            std::fill(begin(), end(), value);
+        return *this;
+    }
+
+    // -> Math operations with single value
+    template<class T>
+    MatrixView<T>& MatrixView<T>::operator*=(T value)
+    {
+        this->evaluate(utils::ScalarOperand<T>(value, this->m_nLines, this->m_nColumns),
+                       [](T& elt, const T& v){ elt *= v; });
+        return *this;
+    }
+
+    template<class T>
+    MatrixView<T>& MatrixView<T>::operator+=(T value)
+    {
+        this->evaluate(utils::ScalarOperand<T>(value, this->m_nLines, this->m_nColumns),
+                       [](T& elt, const T& v){ elt += v; });
+        return *this;
+    }
+
+    template<class T>
+    MatrixView<T>& MatrixView<T>::operator/=(T value)
+    {
+        this->evaluate(utils::ScalarOperand<T>(value, this->m_nLines, this->m_nColumns),
+                       [](T& elt, const T& v){ elt /= v; });
+        return *this;
+    }
+
+    template<class T>
+    MatrixView<T>& MatrixView<T>::operator-=(T value)
+    {
+        this->evaluate(utils::ScalarOperand<T>(value, this->m_nLines, this->m_nColumns),
+                       [](T& elt, const T& v){ elt -= v; });
+        return *this;
+    }
+
+    // -> Math operations with other Matrices (or expressions)
+    template<class T> template<class E>
+    MatrixView<T>& MatrixView<T>::operator*=(const utils::MatrixExpression<E>& value)
+    {
+        this->evaluate(value, [](T& elt, const auto& v){ elt *= v; });
+        return *this;
+    }
+
+    template<class T> template<class E>
+    MatrixView<T>& MatrixView<T>::operator+=(const utils::MatrixExpression<E>& value)
+    {
+        this->evaluate(value, [](T& elt, const auto& v){ elt += v; });
+        return *this;
+    }
+
+    template<class T> template<class E>
+    MatrixView<T>& MatrixView<T>::operator/=(const utils::MatrixExpression<E>& value)
+    {
+        this->evaluate(value, [](T& elt, const auto& v){ elt /= v; });
+        return *this;
+    }
+
+    template<class T> template<class E>
+    MatrixView<T>& MatrixView<T>::operator-=(const utils::MatrixExpression<E>& value)
+    {
+        this->evaluate(value, [](T& elt, const auto& v){ elt -= v; });
+        return *this;
+    }
+
+    // ------------------------------- SUB-VIEWS ------------------------------
+    template<class T>
+    MatrixView<T> MatrixView<T>::row(std::size_t line) const
+    {
+        return this->block(line, 0, 1, this->m_nColumns);
+    }
+
+    template<class T>
+    MatrixView<T> MatrixView<T>::column(std::size_t col) const
+    {
+        return this->block(0, col, this->m_nLines, 1);
+    }
+
+    template<class T>
+    MatrixView<T> MatrixView<T>::block(std::size_t line, std::size_t col,
+                                       std::size_t nLines, std::size_t nColumns) const
+    {
+        this->checkBlock(line, col, nLines, nColumns);
+        return {data() + line*this->m_lineStride + col*this->m_columnStride,
+                nLines, nColumns, this->m_lineStride, this->m_columnStride};
+    }
+
+    // =========================== PROTECTED METHODS ==========================
+    template<class T> template<class E, class Assign>
+    void MatrixView<T>::evaluate(const utils::MatrixExpression<E>& expr, Assign assign)
+    {
+        const auto& node = expr.self();
+        if(!utils::broadcastsTo(node.nLines(), this->m_nLines)
+           || !utils::broadcastsTo(node.nColumns(), this->m_nColumns))
+            throw Exeptions::SizeMismatch(this->length(), node.nLines()*node.nColumns());
+        if(this->length() == 0)
+            return;
+
+        auto operand = utils::makeOperand(expr).broadcastTo(this->m_nLines, this->m_nColumns);
+        const T* first = data();
+        const T* last = first + (this->m_nLines-1)*this->m_lineStride
+                              + (this->m_nColumns-1)*this->m_columnStride + 1;
+        // Element-wise leaves only read the viewed memory at the element
+        // being written if the view has the layout of a whole matrix.
+        const bool safe = decltype(operand)::isElementWise && this->isContiguous();
+        if(!safe && operand.references(first, last))
+        {
+            const Matrix<T> copy(utils::makeOperand(expr));
+            utils::evaluate(utils::makeOperand(copy).broadcastTo(this->m_nLines, this->m_nColumns), data(),
+                            this->m_lineStride, this->m_columnStride, assign);
+            return;
+        }
+        if(this->m_lineStride == 1) // whole columns: contiguous kernels
+            utils::evaluate(operand, data(), this->m_columnStride, assign);
+        else if(this->m_columnStride == 1) // whole lines (row-major matrix)
+            utils::evaluate(utils::transposed(operand), data(), this->m_lineStride, assign);
+        else
+            utils::evaluate(operand, data(), this->m_lineStride, this->m_columnStride, assign);
+    }
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__SPARSEMATRIX_DECL__GUARD__2610
+#define GEOMETRY__SPARSEMATRIX_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "matrixAllocator.decl.hpp"
+
+namespace geometry{
+
+    // Compressed storage: Csr keeps the non-zeros line after line (CSR,
+    // compressed sparse rows), Csc column after column.
+    enum class SparseFormat {Csr, Csc};
+
+    template<class T, SparseFormat Format> class SparseMatrix;
+
+    // Coordinate list (COO) used to assemble a sparse matrix: entries come
+    // in any order and the duplicates are summed when it is compressed.
+    // Coordinates are 32-bit, the dimensions must stay below 2^31.
+    template<class T>
+    class CooMatrix
+    {
+    public: // types
+        using value_type = T;
+
+    public: // attributes
+        std::array<std::size_t, 2> m_size{0, 0}; // {lines, columns}
+        std::vector<std::int32_t> m_lines{};
+        std::vector<std::int32_t> m_columns{};
+        std::vector<T> m_values{};
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        CooMatrix() {}
+        // -> Exceptions::SizeMismatch() for dimensions above 2^31 - 1
+        CooMatrix(std::size_t line, std::size_t col);
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        std::size_t nLines()   const {return m_size[0];}
+        std::size_t nColumns() const {return m_size[1];}
+        const std::array<std::size_t, 2>& dimension() const {return m_size;}
+        std::size_t nonZeros() const {return m_values.size();} // duplicates included
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        // -> Exceptions::SizeMismatch() for coordinates out of the matrix
+        void add(std::size_t line, std::size_t col, T value);
+        void reserve(std::size_t nonZeros);
+        void clear() {m_lines.clear(); m_columns.clear(); m_values.clear();}
+    };
+
+    // Sparse matrix in a compressed format: for every outer index (line of
+    // Csr, column of Csc) m_offsets gives the range of its entries in
+    // m_indices (inner index, ascending) and m_values. The memory is
+    // proportional to the non-zeros plus the outer dimension.
+    //
+    // Products with dense operands split the non-zeros, not the lines,
+    // across threads, so that a few long lines do not serialise the call.
+    // The Csr kernels gather x with SIMD registers, the Csc ones scatter
+    // into y and stay scalar. Indices are 32-bit (dimensions below 2^31)
+    // which keeps them gather operands and halves their footprint.
+    template<class T, SparseFormat Format = SparseFormat::Csr>
+    class SparseMatrix
+    {
+    public: // types
+        using value_type = T;
+        static constexpr SparseFormat format = Format;
+        static constexpr SparseFormat otherFormat =
+            (Format == SparseFormat::Csr) ? SparseFormat::Csc : SparseFormat::Csr;
+
+    public: // attributes
+        std::array<std::size_t, 2> m_size{0, 0}; // {lines, columns}
+        std::vector<std::size_t> m_offsets{0};     // outer dimension + 1
+        std::vector<std::int32_t> m_indices{};     // one per non-zero
+        std::vector<T, utils::AlignedAllocator<T>> m_values{};
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        SparseMatrix() {}
+        // Zero matrix, no entries.
+        // -> Exceptions::SizeMismatch() for dimensions above 2^31 - 1
+        SparseMatrix(std::size_t line, std::size_t col);
+
+        // Compress a coordinate list (duplicates summed, explicit zeros kept).
+        explicit SparseMatrix(const CooMatrix<T>& coo);
+
+        // Non-zero elements of a dense matrix.
+        // -> Exceptions::SizeMismatch() for dimensions above 2^31 - 1
+        template<class Alloc, Layout Order>
+        explicit SparseMatrix(const Matrix<T, Alloc, Order>& dense);
+
+        // Csr <-> Csc, one counting sort over the non-zeros.
+        template<SparseFormat F, class = std::enable_if_t<F != Format>>
+        explicit SparseMatrix(const SparseMatrix<T, F>& other);
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        SparseMatrix<T, Format>& operator*=(T value);
+        SparseMatrix<T, Format>& operator/=(T value);
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        std::size_t nLines()   const {return m_size[0];}
+        std::size_t nColumns() const {return m_size[1];}
+        const std::array<std::size_t, 2>& dimension() const {return m_size;}
+        std::size_t nonZeros() const {return m_values.size();}
+        // Bytes held by the object and its arrays.
+        std::size_t memoryUsage() const;
+
+        // Element (line, col), zero when it is not stored (binary search).
+        // -> Exceptions::SizeMismatch() for coordinates out of the matrix
+        T at(std::size_t line, std::size_t col) const;
+
+        const std::vector<std::size_t>& offsets() const {return m_offsets;}
+        const std::vector<std::int32_t>& indices() const {return m_indices;}
+        const std::vector<T, utils::AlignedAllocator<T>>& values() const {return m_values;}
+
+        template<class Alloc = utils::AlignedAllocator<T>, Layout Order = Layout::ColumnMajor>
+        Matrix<T, Alloc, Order> toDense() const;
+
+        // The transpose reads the same arrays in the other format: a copy
+        // of the arrays, no sort (moved out of an rvalue).
+        SparseMatrix<T, otherFormat> transposed() const &;
+        SparseMatrix<T, otherFormat> transposed() &&;
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        // Values can change in place, the pattern cannot.
+        std::vector<T, utils::AlignedAllocator<T>>& values() {return m_values;}
+        void swap(SparseMatrix<T, Format>& other) noexcept;
+
+    // --------------------------- PROTECTED METHODS --------------------------
+    protected:
+        std::size_t nOuter() const {return (Format == SparseFormat::Csr) ? m_size[0] : m_size[1];}
+        std::size_t nInner() const {return (Format == SparseFormat::Csr) ? m_size[1] : m_size[0];}
+    };
+
+    template<class T> using CsrMatrix = SparseMatrix<T, SparseFormat::Csr>;
+    template<class T> using CscMatrix = SparseMatrix<T, SparseFormat::Csc>;
+
+    // y = alpha * A.x + beta * y on raw arrays of A.nColumns() and
+    // A.nLines() elements (beta==0 ignores y content). x and y must not
+    // overlap.
+    template<typename T, SparseFormat Format>
+    void spmv(T alpha, const SparseMatrix<T, Format>& A, const T* x, T beta, T* y);
+
+    // -> Exceptions::SizeMismatch() if A.nColumns() != x.size()
+    template<typename T, SparseFormat Format>
+    std::vector<T> matmul(const SparseMatrix<T, Format>& A, const std::vector<T>& x);
+
+    // Sparse-dense product. The result uses the allocator and the layout
+    // of B.
+    // -> Exceptions::SizeMismatch() if A.nColumns() != B.nLines()
+    template<typename T, SparseFormat Format, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> matmul(const SparseMatrix<T, Format>& A, const Matrix<T, Alloc, Order>& B);
+
+    // C = alpha * A.B + beta * C (BLAS convention, beta==0 ignores C content)
+    // -> Exceptions::SizeMismatch() if shapes do not agree
+    template<typename T, SparseFormat Format, class AllocB, Layout OrderB, class AllocC, Layout OrderC>
+    void gemm(T alpha, const SparseMatrix<T, Format>& A, const Matrix<T, AllocB, OrderB>& B,
+              T beta, Matrix<T, AllocC, OrderC>& C);
+
+    namespace utils{
+
+        // Outer indices whose entries start in [first, last) of the
+        // non-zeros, the trailing empty ones going with the last range:
+        // how a parallelFor over the non-zeros hands out lines (columns).
+        std::array<std::size_t, 2> outerRange(const std::vector<std::size_t>& offsets,
+                                              std::size_t first, std::size_t last);
+
+        // Counting sort of a compressed matrix by inner index: the same
+        // matrix in the other format, indices ascending. out* are resized.
+        template<typename T, class AllocIn, class AllocOut>
+        void compressTranspose(std::size_t nOuter, std::size_t nInner,
+                               const std::vector<std::size_t>& offsets,
+                               const std::vector<std::int32_t>& indices,
+                               const std::vector<T, AllocIn>& values,
+                               std::vector<std::size_t>& outOffsets,
+                               std::vector<std::int32_t>& outIndices,
+                               std::vector<T, AllocOut>& outValues);
+
+    }
+}
+#endif
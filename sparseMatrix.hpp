@@ -0,0 +1,13 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__SPARSEMATRIX__GUARD__2610
+#define GEOMETRY__SPARSEMATRIX__GUARD__2610
+
+#include "sparseMatrix.decl.hpp"
+#include "sparseMatrix.impl.hpp"
+
+#endif
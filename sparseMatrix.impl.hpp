@@ -0,0 +1,562 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__SPARSEMATRIX_IMPL__GUARD__2610
+#define GEOMETRY__SPARSEMATRIX_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+// LOCAL INCLUDES
+#include "sparseMatrix.decl.hpp"
+#include "matrix.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // -> Exceptions::SizeMismatch() above the 32-bit indices
+        inline void checkSparseDimension(std::size_t size)
+        {
+            constexpr std::size_t maxSize = std::numeric_limits<std::int32_t>::max();
+            if(size > maxSize)
+                throw Exeptions::SizeMismatch(maxSize, size);
+        }
+
+        inline std::array<std::size_t, 2> outerRange(const std::vector<std::size_t>& offsets,
+                                                     std::size_t first, std::size_t last)
+        {
+            const std::size_t nOuter = offsets.size() - 1;
+            const auto begin = offsets.begin();
+            const auto end = offsets.begin() + nOuter;
+            return {static_cast<std::size_t>(std::lower_bound(begin, end, first) - begin),
+                    (last >= offsets.back()) ? nOuter
+                                             : static_cast<std::size_t>(std::lower_bound(begin, end, last) - begin)};
+        }
+
+        template<typename T, class AllocIn, class AllocOut>
+        void compressTranspose(std::size_t nOuter, std::size_t nInner,
+                               const std::vector<std::size_t>& offsets,
+                               const std::vector<std::int32_t>& indices,
+                               const std::vector<T, AllocIn>& values,
+                               std::vector<std::size_t>& outOffsets,
+                               std::vector<std::int32_t>& outIndices,
+                               std::vector<T, AllocOut>& outValues)
+        {
+            outOffsets.assign(nInner + 1, 0);
+            for(const std::int32_t index: indices)
+                outOffsets[index + 1]++;
+            std::partial_sum(outOffsets.begin(), outOffsets.end(), outOffsets.begin());
+
+            outIndices.resize(indices.size());
+            outValues.resize(values.size());
+            std::vector<std::size_t> next(outOffsets.begin(), outOffsets.end() - 1);
+            for(std::size_t outer=0; outer<nOuter; outer++)
+                for(std::size_t k=offsets[outer]; k<offsets[outer+1]; k++)
+                {
+                    const std::size_t position = next[indices[k]]++;
+                    outIndices[position] = static_cast<std::int32_t>(outer);
+                    outValues[position] = values[k];
+                }
+        }
+
+        // ---------------------------- SPARSE KERNELS ------------------------
+        // Csr lines against a dense vector x of unit stride: the entries of a
+        // line are read V::width at a time and x is gathered at their column
+        // indices. The line results go to y[line*incY].
+#define GEOMETRY_SPARSE_KERNELS(NAME, ATTRIBUTE)                                                  \
+        template<class V>                                                                         \
+        ATTRIBUTE typename V::value_type sparseDot##NAME(std::size_t n,                           \
+                                                         const typename V::value_type* values,    \
+                                                         const std::int32_t* indices,             \
+                                                         const typename V::value_type* x)         \
+        {                                                                                         \
+            using value_type = typename V::value_type;                                            \
+            typename V::reg acc = V::set1(static_cast<value_type>(0));                            \
+            std::size_t i = 0;                                                                    \
+            for(; i + V::width <= n; i += V::width)                                               \
+                acc = V::fmadd(V::load(values + i), V::gather(x, indices + i), acc);              \
+            value_type out = V::sum(acc);                                                         \
+            for(; i<n; i++)                                                                       \
+                out += values[i]*x[indices[i]];                                                   \
+            return out;                                                                           \
+        }                                                                                         \
+                                                                                                  \
+        /* y[line] = alpha*(A.x)[line] + beta*y[line] for lines in [first, last). */              \
+        template<class V>                                                                         \
+        ATTRIBUTE void csrLines##NAME(const std::size_t* offsets, const std::int32_t* indices,    \
+                                      const typename V::value_type* values,                       \
+                                      const typename V::value_type* x,                            \
+                                      typename V::value_type alpha, typename V::value_type beta,  \
+                                      typename V::value_type* y, std::size_t incY,                \
+                                      std::size_t first, std::size_t last)                        \
+        {                                                                                         \
+            using value_type = typename V::value_type;                                            \
+            for(std::size_t line=first; line<last; line++)                                        \
+            {                                                                                     \
+                const std::size_t begin = offsets[line];                                          \
+                const value_type dot = sparseDot##NAME<V>(offsets[line+1] - begin, values + begin,\
+                                                          indices + begin, x);                    \
+                value_type& out = y[line*incY];                                                   \
+                out = (beta == static_cast<value_type>(0)) ? alpha*dot : alpha*dot + beta*out;    \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        /* y[i] += a*x[i] over n contiguous elements. */                                          \
+        template<class V>                                                                         \
+        ATTRIBUTE void sparseAxpy##NAME(std::size_t n, typename V::value_type a,                  \
+                                        const typename V::value_type* x,                          \
+                                        typename V::value_type* y)                                \
+        {                                                                                         \
+            const typename V::reg scale = V::set1(a);                                             \
+            std::size_t i = 0;                                                                    \
+            for(; i + V::width <= n; i += V::width)                                               \
+                V::store(y + i, V::fmadd(scale, V::load(x + i), V::load(y + i)));                 \
+            for(; i<n; i++)                                                                       \
+                y[i] += a*x[i];                                                                   \
+        }
+
+        GEOMETRY_SPARSE_KERNELS(Scalar, )
+#ifdef GEOMETRY_X86_SIMD
+        GEOMETRY_SPARSE_KERNELS(Sse2, __attribute__((target("sse2"))))
+        GEOMETRY_SPARSE_KERNELS(Avx2, __attribute__((target("avx2,fma"))))
+        GEOMETRY_SPARSE_KERNELS(Avx512, __attribute__((target("avx512f"))))
+#endif
+#undef GEOMETRY_SPARSE_KERNELS
+
+        // ------------------------------- DISPATCH ---------------------------
+        template<typename T>
+        void csrLinesSerial(const std::size_t* offsets, const std::int32_t* indices, const T* values,
+                            const T* x, T alpha, T beta, T* y, std::size_t incY,
+                            std::size_t first, std::size_t last)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return csrLinesAvx512<SimdVector<Isa::Avx512, T>>(offsets, indices, values, x, alpha, beta, y, incY, first, last);
+                    case Isa::Avx2:   return csrLinesAvx2<SimdVector<Isa::Avx2, T>>(offsets, indices, values, x, alpha, beta, y, incY, first, last);
+                    case Isa::Sse2:   return csrLinesSse2<SimdVector<Isa::Sse2, T>>(offsets, indices, values, x, alpha, beta, y, incY, first, last);
+                    default: break;
+                }
+#endif
+            csrLinesScalar<ScalarVector<T>>(offsets, indices, values, x, alpha, beta, y, incY, first, last);
+        }
+
+        template<typename T>
+        void sparseAxpySerial(std::size_t n, T a, const T* x, T* y)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return sparseAxpyAvx512<SimdVector<Isa::Avx512, T>>(n, a, x, y);
+                    case Isa::Avx2:   return sparseAxpyAvx2<SimdVector<Isa::Avx2, T>>(n, a, x, y);
+                    case Isa::Sse2:   return sparseAxpySse2<SimdVector<Isa::Sse2, T>>(n, a, x, y);
+                    default: break;
+                }
+#endif
+            sparseAxpyScalar<ScalarVector<T>>(n, a, x, y);
+        }
+
+        // y[line*incY] += alpha * sum over the columns c in [first, last) of
+        // A(line, c)*x[c*incX]. The lines of a column are distinct but there
+        // is no scatter before AVX-512: a plain loop.
+        template<typename T>
+        void cscScatter(const SparseMatrix<T, SparseFormat::Csc>& A, T alpha, const T* x, std::size_t incX,
+                        T* y, std::size_t incY, std::size_t first, std::size_t last)
+        {
+            for(std::size_t col=first; col<last; col++)
+            {
+                const T scale = alpha*x[col*incX];
+                for(std::size_t k=A.m_offsets[col]; k<A.m_offsets[col+1]; k++)
+                    y[A.m_indices[k]*incY] += scale*A.m_values[k];
+            }
+        }
+
+        // y = beta*y over n contiguous elements, y content ignored for beta==0.
+        template<typename T>
+        void scaleSerial(std::size_t n, T beta, T* y)
+        {
+            if(beta == static_cast<T>(0))
+                broadcastSerial(n, static_cast<T>(0), y);
+            else if(beta != static_cast<T>(1))
+                elementWiseSerial<ElementOp::Mul>(n, y, beta, y);
+        }
+
+        // Csr times the dense matrix B (rsB, csB strides) into C, column by
+        // column when the columns of B are contiguous (gather dot products),
+        // line by line otherwise (one SIMD axpy per non-zero over a line of
+        // B, into the line of C or a buffer when it is strided).
+        template<typename T>
+        void csrGemm(T alpha, const SparseMatrix<T, SparseFormat::Csr>& A,
+                     const T* B, std::size_t rsB, std::size_t csB, std::size_t nCols,
+                     T beta, T* C, std::size_t rsC, std::size_t csC)
+        {
+            const std::size_t nnz = A.nonZeros();
+            parallelFor(std::max<std::size_t>(nnz, 1), (nnz + A.nLines())*nCols, [&](std::size_t first, std::size_t last){
+                const auto lines = outerRange(A.m_offsets, first, last);
+                if(rsB == 1)
+                {
+                    for(std::size_t col=0; col<nCols; col++)
+                        csrLinesSerial(A.m_offsets.data(), A.m_indices.data(), A.m_values.data(),
+                                       B + col*csB, alpha, beta, C + col*csC, rsC, lines[0], lines[1]);
+                    return;
+                }
+                std::vector<T> buffer((csC == 1) ? 0 : nCols);
+                for(std::size_t line=lines[0]; line<lines[1]; line++)
+                {
+                    T* out = (csC == 1) ? C + line*rsC : buffer.data();
+                    scaleSerial(nCols, (csC == 1) ? beta : static_cast<T>(0), out);
+                    for(std::size_t k=A.m_offsets[line]; k<A.m_offsets[line+1]; k++)
+                        sparseAxpySerial(nCols, alpha*A.m_values[k], B + A.m_indices[k]*rsB, out);
+                    if(csC == 1)
+                        continue;
+                    for(std::size_t col=0; col<nCols; col++)
+                    {
+                        T& element = C[line*rsC + col*csC];
+                        element = (beta == static_cast<T>(0)) ? buffer[col] : buffer[col] + beta*element;
+                    }
+                }
+            });
+        }
+
+    }
+
+    // ============================== COO MATRIX ==============================
+    template<class T>
+    CooMatrix<T>::CooMatrix(std::size_t line, std::size_t col):
+        m_size{line, col}
+    {
+        utils::checkSparseDimension(line);
+        utils::checkSparseDimension(col);
+    }
+
+    template<class T>
+    void CooMatrix<T>::add(std::size_t line, std::size_t col, T value)
+    {
+        if(line >= this->nLines())
+            throw Exeptions::SizeMismatch(line, this->nLines());
+        if(col >= this->nColumns())
+            throw Exeptions::SizeMismatch(col, this->nColumns());
+        m_lines.push_back(static_cast<std::int32_t>(line));
+        m_columns.push_back(static_cast<std::int32_t>(col));
+        m_values.push_back(value);
+    }
+
+    template<class T>
+    void CooMatrix<T>::reserve(std::size_t nonZeros)
+    {
+        m_lines.reserve(nonZeros);
+        m_columns.reserve(nonZeros);
+        m_values.reserve(nonZeros);
+    }
+
+    // ============================ PUBLIC METHODS ============================
+    // ---------------------------- CONSTRUCTORS ------------------------------
+    template<class T, SparseFormat Format>
+    SparseMatrix<T, Format>::SparseMatrix(std::size_t line, std::size_t col):
+        m_size{line, col}
+    {
+        utils::checkSparseDimension(line);
+        utils::checkSparseDimension(col);
+        m_offsets.assign(this->nOuter() + 1, 0);
+    }
+
+    // Entries bucketed by inner index first: the counting sort by outer
+    // index that follows leaves every outer range sorted, the duplicates
+    // are then next to each other.
+    template<class T, SparseFormat Format>
+    SparseMatrix<T, Format>::SparseMatrix(const CooMatrix<T>& coo):
+        m_size{coo.m_size}
+    {
+        const bool csr = (Format == SparseFormat::Csr);
+        const std::vector<std::int32_t>& outer = csr ? coo.m_lines : coo.m_columns;
+        const std::vector<std::int32_t>& inner = csr ? coo.m_columns : coo.m_lines;
+        const std::size_t nnz = coo.nonZeros();
+
+        std::vector<std::size_t> byInner(this->nInner() + 1, 0);
+        for(const std::int32_t index: inner)
+            byInner[index + 1]++;
+        std::partial_sum(byInner.begin(), byInner.end(), byInner.begin());
+        std::vector<std::int32_t> outerIndices(nnz);
+        std::vector<T> values(nnz);
+        std::vector<std::size_t> next(byInner.begin(), byInner.end() - 1);
+        for(std::size_t k=0; k<nnz; k++)
+        {
+            const std::size_t position = next[inner[k]]++;
+            outerIndices[position] = outer[k];
+            values[position] = coo.m_values[k];
+        }
+        utils::compressTranspose(this->nInner(), this->nOuter(), byInner, outerIndices, values,
+                                 m_offsets, m_indices, m_values);
+
+        std::size_t write = 0;
+        for(std::size_t o=0; o<this->nOuter(); o++)
+        {
+            const std::size_t begin = m_offsets[o];
+            const std::size_t end = m_offsets[o+1];
+            m_offsets[o] = write;
+            for(std::size_t k=begin; k<end; k++)
+                if((write > m_offsets[o]) && (m_indices[write-1] == m_indices[k]))
+                    m_values[write-1] += m_values[k];
+                else
+                {
+                    m_indices[write] = m_indices[k];
+                    m_values[write] = m_values[k];
+                    write++;
+                }
+        }
+        m_offsets.back() = write;
+        if(write < nnz)
+        {
+            m_indices.resize(write);
+            m_values.resize(write);
+            m_indices.shrink_to_fit();
+            m_values.shrink_to_fit();
+        }
+    }
+
+    // Storage order of dense is walked twice (count, then fill): whichever
+    // index is the outer one, the inner indices come out ascending.
+    template<class T, SparseFormat Format>
+    template<class Alloc, Layout Order>
+    SparseMatrix<T, Format>::SparseMatrix(const Matrix<T, Alloc, Order>& dense):
+        m_size{dense.dimension()}
+    {
+        utils::checkSparseDimension(this->nLines());
+        utils::checkSparseDimension(this->nColumns());
+        const bool sameOrder = ((Format == SparseFormat::Csr) == (Order == Layout::RowMajor));
+        const T* data = dense.data();
+        const std::size_t lead = dense.leadingDimension();
+        const std::size_t nStorageColumns = dense.storageColumns();
+        const std::size_t nStorageLines = dense.storageLines();
+
+        m_offsets.assign(this->nOuter() + 1, 0);
+        for(std::size_t s=0; s<nStorageColumns; s++)
+            for(std::size_t i=0; i<nStorageLines; i++)
+                if(data[s*lead + i] != static_cast<T>(0))
+                    m_offsets[(sameOrder ? s : i) + 1]++;
+        std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+        m_indices.resize(m_offsets.back());
+        m_values.resize(m_offsets.back());
+        std::vector<std::size_t> next(m_offsets.begin(), m_offsets.end() - 1);
+        for(std::size_t s=0; s<nStorageColumns; s++)
+            for(std::size_t i=0; i<nStorageLines; i++)
+                if(data[s*lead + i] != static_cast<T>(0))
+                {
+                    const std::size_t position = next[sameOrder ? s : i]++;
+                    m_indices[position] = static_cast<std::int32_t>(sameOrder ? i : s);
+                    m_values[position] = data[s*lead + i];
+                }
+    }
+
+    template<class T, SparseFormat Format>
+    template<SparseFormat F, class>
+    SparseMatrix<T, Format>::SparseMatrix(const SparseMatrix<T, F>& other):
+        m_size{other.m_size}
+    {
+        utils::compressTranspose(this->nInner(), this->nOuter(), other.m_offsets, other.m_indices,
+                                 other.m_values, m_offsets, m_indices, m_values);
+    }
+
+    // ----------------------- OPERATORS OVERLOADING --------------------------
+    template<class T, SparseFormat Format>
+    SparseMatrix<T, Format>& SparseMatrix<T, Format>::operator*=(T value)
+    {
+        utils::elementWise<utils::ElementOp::Mul>(m_values.size(), m_values.data(), value, m_values.data());
+        return *this;
+    }
+
+    template<class T, SparseFormat Format>
+    SparseMatrix<T, Format>& SparseMatrix<T, Format>::operator/=(T value)
+    {
+        utils::elementWise<utils::ElementOp::Div>(m_values.size(), m_values.data(), value, m_values.data());
+        return *this;
+    }
+
+    // -------------------- ASK INFO MEMBERS (-> const) -----------------------
+    template<class T, SparseFormat Format>
+    std::size_t SparseMatrix<T, Format>::memoryUsage() const
+    {
+        return sizeof(*this) + m_offsets.capacity()*sizeof(std::size_t)
+             + m_indices.capacity()*sizeof(std::int32_t) + m_values.capacity()*sizeof(T);
+    }
+
+    template<class T, SparseFormat Format>
+    T SparseMatrix<T, Format>::at(std::size_t line, std::size_t col) const
+    {
+        if(line >= this->nLines())
+            throw Exeptions::SizeMismatch(line, this->nLines());
+        if(col >= this->nColumns())
+            throw Exeptions::SizeMismatch(col, this->nColumns());
+        const bool csr = (Format == SparseFormat::Csr);
+        const std::size_t outer = csr ? line : col;
+        const auto inner = static_cast<std::int32_t>(csr ? col : line);
+        const auto begin = m_indices.begin() + m_offsets[outer];
+        const auto end = m_indices.begin() + m_offsets[outer+1];
+        const auto found = std::lower_bound(begin, end, inner);
+        if((found == end) || (*found != inner))
+            return static_cast<T>(0);
+        return m_values[found - m_indices.begin()];
+    }
+
+    template<class T, SparseFormat Format>
+    template<class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> SparseMatrix<T, Format>::toDense() const
+    {
+        Matrix<T, Alloc, Order> out(this->nLines(), this->nColumns());
+        const bool sameOrder = ((Format == SparseFormat::Csr) == (Order == Layout::RowMajor));
+        const std::size_t lead = out.leadingDimension();
+        T* data = out.data();
+        utils::parallelFor(this->nOuter(), this->nonZeros() + out.length(), [&](std::size_t first, std::size_t last){
+            for(std::size_t o=first; o<last; o++)
+                for(std::size_t k=m_offsets[o]; k<m_offsets[o+1]; k++)
+                {
+                    const std::size_t inner = m_indices[k];
+                    data[sameOrder ? o*lead + inner : inner*lead + o] = m_values[k];
+                }
+        });
+        return out;
+    }
+
+    template<class T, SparseFormat Format>
+    SparseMatrix<T, SparseMatrix<T, Format>::otherFormat> SparseMatrix<T, Format>::transposed() const &
+    {
+        SparseMatrix<T, otherFormat> out;
+        out.m_size = {m_size[1], m_size[0]};
+        out.m_offsets = m_offsets;
+        out.m_indices = m_indices;
+        out.m_values = m_values;
+        return out;
+    }
+
+    template<class T, SparseFormat Format>
+    SparseMatrix<T, SparseMatrix<T, Format>::otherFormat> SparseMatrix<T, Format>::transposed() &&
+    {
+        SparseMatrix<T, otherFormat> out;
+        out.m_size = {m_size[1], m_size[0]};
+        out.m_offsets = std::move(m_offsets);
+        out.m_indices = std::move(m_indices);
+        out.m_values = std::move(m_values);
+        m_size = {0, 0};
+        m_offsets.assign(1, 0);
+        return out;
+    }
+
+    // ------------------------ DATA MODIFIER MEMBERS -------------------------
+    template<class T, SparseFormat Format>
+    void SparseMatrix<T, Format>::swap(SparseMatrix<T, Format>& other) noexcept
+    {
+        std::swap(m_size, other.m_size);
+        m_offsets.swap(other.m_offsets);
+        m_indices.swap(other.m_indices);
+        m_values.swap(other.m_values);
+    }
+
+    // =============================== PRODUCTS ===============================
+    // Csr: one range of lines per thread, balanced on the non-zeros. Csc:
+    // one range of columns per thread scattering into its own copy of y,
+    // the copies are summed into y under a lock.
+    template<typename T, SparseFormat Format>
+    void spmv(T alpha, const SparseMatrix<T, Format>& A, const T* x, T beta, T* y)
+    {
+        const std::size_t nnz = A.nonZeros();
+        if constexpr (Format == SparseFormat::Csr)
+        {
+            utils::parallelFor(std::max<std::size_t>(nnz, 1), nnz + A.nLines(), [&](std::size_t first, std::size_t last){
+                const auto lines = utils::outerRange(A.m_offsets, first, last);
+                utils::csrLinesSerial(A.m_offsets.data(), A.m_indices.data(), A.m_values.data(),
+                                      x, alpha, beta, y, 1, lines[0], lines[1]);
+            });
+        }
+        else
+        {
+            const std::size_t nLines = A.nLines();
+            utils::scaleSerial(nLines, beta, y);
+            std::mutex mutex;
+            utils::parallelFor(std::max<std::size_t>(nnz, 1), nnz + A.nColumns(), [&](std::size_t first, std::size_t last){
+                const auto cols = utils::outerRange(A.m_offsets, first, last);
+                if(cols[0] == cols[1])
+                    return;
+                if((cols[0] == 0) && (cols[1] == A.nColumns())) // the only busy chunk
+                    return utils::cscScatter(A, alpha, x, 1, y, 1, cols[0], cols[1]);
+                std::vector<T> partial(nLines, static_cast<T>(0));
+                utils::cscScatter(A, alpha, x, 1, partial.data(), 1, cols[0], cols[1]);
+                std::lock_guard<std::mutex> lock(mutex);
+                utils::elementWiseSerial<utils::ElementOp::Add>(nLines, y, partial.data(), y);
+            });
+        }
+    }
+
+    template<typename T, SparseFormat Format>
+    std::vector<T> matmul(const SparseMatrix<T, Format>& A, const std::vector<T>& x)
+    {
+        if(A.nColumns() != x.size())
+            throw Exeptions::SizeMismatch(A.nColumns(), x.size());
+        std::vector<T> y(A.nLines());
+        spmv(static_cast<T>(1), A, x.data(), static_cast<T>(0), y.data());
+        return y;
+    }
+
+    template<typename T, SparseFormat Format, class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> matmul(const SparseMatrix<T, Format>& A, const Matrix<T, Alloc, Order>& B)
+    {
+        Matrix<T, Alloc, Order> C(A.nLines(), B.nColumns(), B.get_allocator());
+        gemm(static_cast<T>(1), A, B, static_cast<T>(0), C);
+        return C;
+    }
+
+    // Csc with several columns: one range of columns of B per thread.
+    template<typename T, SparseFormat Format, class AllocB, Layout OrderB, class AllocC, Layout OrderC>
+    void gemm(T alpha, const SparseMatrix<T, Format>& A, const Matrix<T, AllocB, OrderB>& B,
+              T beta, Matrix<T, AllocC, OrderC>& C)
+    {
+        if(A.nColumns() != B.nLines())
+            throw Exeptions::SizeMismatch(A.nColumns(), B.nLines());
+        if((C.nLines() != A.nLines()) || (C.nColumns() != B.nColumns()))
+            throw Exeptions::SizeMismatch(C.length(), A.nLines()*B.nColumns());
+
+        const bool columnB = (OrderB == Layout::ColumnMajor);
+        const bool columnC = (OrderC == Layout::ColumnMajor);
+        const std::size_t rsB = columnB ? 1 : B.leadingDimension();
+        const std::size_t csB = columnB ? B.leadingDimension() : 1;
+        const std::size_t rsC = columnC ? 1 : C.leadingDimension();
+        const std::size_t csC = columnC ? C.leadingDimension() : 1;
+        const std::size_t nCols = B.nColumns();
+        if((nCols == 1) && (rsB == 1) && (rsC == 1))
+            return spmv(alpha, A, B.data(), beta, C.data());
+
+        if constexpr (Format == SparseFormat::Csr)
+            utils::csrGemm(alpha, A, B.data(), rsB, csB, nCols, beta, C.data(), rsC, csC);
+        else
+        {
+            const std::size_t nLines = A.nLines();
+            utils::parallelFor(nCols, (A.nonZeros() + nLines)*nCols, [&](std::size_t first, std::size_t last){
+                for(std::size_t col=first; col<last; col++)
+                {
+                    T* out = C.data() + col*csC;
+                    if(rsC == 1)
+                        utils::scaleSerial(nLines, beta, out);
+                    else
+                        for(std::size_t line=0; line<nLines; line++)
+                            out[line*rsC] = (beta == static_cast<T>(0)) ? static_cast<T>(0) : beta*out[line*rsC];
+                    utils::cscScatter(A, alpha, B.data() + col*csB, rsB, out, rsC, 0, A.nColumns());
+                }
+            });
+        }
+    }
+
+}
+#endif
@@ -0,0 +1,364 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__TENSOR_DECL__GUARD__2610
+#define GEOMETRY__TENSOR_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "matrixAllocator.decl.hpp"
+#include "matrixExpressions.decl.hpp"
+#include "matrixView.decl.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // Position (or shape) in a Rank-dimensional array.
+        template<std::size_t Rank>
+        using Index = std::array<std::size_t, Rank>;
+
+        // Strides of a dense array, first index fastest like Matrix:
+        // strides[0] = 1, strides[d] = strides[d-1]*shape[d-1].
+        template<std::size_t Rank>
+        constexpr Index<Rank> denseStrides(const Index<Rank>& shape);
+
+        // Number of elements of shape.
+        template<std::size_t Rank>
+        constexpr std::size_t product(const Index<Rank>& shape);
+
+        // sum(index[d]*strides[d]).
+        template<std::size_t Rank>
+        constexpr std::size_t flatIndex(const Index<Rank>& index, const Index<Rank>& strides);
+
+        // Inverse of flatIndex for the dense strides of shape.
+        template<std::size_t Rank>
+        constexpr Index<Rank> unravel(std::size_t flat, const Index<Rank>& shape);
+
+        // body(offsetA, offsetB) for every line along dimension 0 of shape
+        // (shape[0] elements each), offsets being the flat positions of its
+        // first element with stridesA and stridesB. Lines are split across
+        // threads (see matrixParallel.decl.hpp).
+        template<std::size_t Rank, class Body>
+        void forEachLine(const Index<Rank>& shape, const Index<Rank>& stridesA,
+                         const Index<Rank>& stridesB, Body body);
+
+    }
+
+    template<class T, std::size_t Rank, class Alloc = utils::AlignedAllocator<T>> class Tensor;
+
+    // Non-owning strided window on Rank-dimensional data: element index
+    // lives at data()[sum(index[d]*stride(d))]. Shape and strides are held
+    // inline, slicing and sub-blocks are O(1).
+    template<class T, std::size_t Rank>
+    class ConstTensorView
+    {
+        static_assert(Rank >= 1, "a tensor has at least one dimension");
+
+    public: // types
+        using value_type = T;
+        using index_type = utils::Index<Rank>;
+        static constexpr std::size_t rank = Rank;
+
+    protected: // attributes
+        const T* mp_data{nullptr};
+        index_type m_shape{};
+        index_type m_strides{};
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        ConstTensorView() {} // --> empty view on nothing.
+
+        ConstTensorView(const T* data, const index_type& shape, const index_type& strides):
+            mp_data{data},
+            m_shape(shape),
+            m_strides(strides)
+            {}
+
+        // Whole tensor.
+        template<class Alloc>
+        ConstTensorView(const Tensor<T, Rank, Alloc>& tensor);
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        template<class... I, class = std::enable_if_t<sizeof...(I) == Rank>>
+        const T& operator()(I... index) const {
+            return (*this)[index_type{static_cast<std::size_t>(index)...}];
+        }
+        const T& operator[](const index_type& index) const {
+            GEOMETRY_CHECK_INDEX(index, m_shape);
+            return mp_data[utils::flatIndex(index, m_strides)];
+        }
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        const index_type& shape()   const {return m_shape;}
+        const index_type& strides() const {return m_strides;}
+        std::size_t extent(std::size_t dim) const {return m_shape[dim];}
+        std::size_t stride(std::size_t dim) const {return m_strides[dim];}
+        std::size_t size() const {return utils::product(m_shape);}
+        bool empty() const {return this->size() == 0;}
+        const T* data() const {return mp_data;}
+        // Same layout as a Tensor: one dense block.
+        bool isContiguous() const;
+        // True if the span of the view (first to last element) overlaps
+        // [first, last), as utils::MatrixOperand::references.
+        bool references(const void* first, const void* last) const;
+
+        // ---------------------------- SUB-VIEWS -----------------------------
+        // Hyperplane index of dimension dim (one rank less).
+        // -> Exceptions::SizeMismatch() if index is out of the view
+        ConstTensorView<T, Rank-1> slice(std::size_t dim, std::size_t index) const;
+
+        // extents elements from first along every dimension.
+        // -> Exceptions::SizeMismatch() if they do not fit in this view
+        ConstTensorView block(const index_type& first, const index_type& extents) const;
+
+        // Rank 2 only: the same elements as a matrix view (dimension 0 gives
+        // the lines), to run the matrix operations on a plane of a grid.
+        ConstMatrixView<T> asMatrix() const;
+
+    protected:
+        const T* spanEnd() const; // one past the last element, mp_data if empty
+        void checkSlice(std::size_t dim, std::size_t index) const;
+        void checkBlock(const index_type& first, const index_type& extents) const;
+    };
+
+    // Writable view: copying a view copies the window, assigning to it writes
+    // the elements, like MatrixView:
+    //     grid.slice(2, 0) = grid.slice(2, 1);  grid.block({0, 0, 0}, {8, 8, 8}) *= 2;
+    template<class T, std::size_t Rank>
+    class TensorView: public ConstTensorView<T, Rank>
+    {
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        TensorView() {}
+
+        TensorView(T* data, const utils::Index<Rank>& shape, const utils::Index<Rank>& strides):
+            ConstTensorView<T, Rank>(data, shape, strides)
+            {}
+
+        template<class Alloc>
+        TensorView(Tensor<T, Rank, Alloc>& tensor);
+
+        TensorView(const TensorView& other) = default;
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        template<class... I, class = std::enable_if_t<sizeof...(I) == Rank>>
+        T& operator()(I... index) const {
+            return (*this)[utils::Index<Rank>{static_cast<std::size_t>(index)...}];
+        }
+        T& operator[](const utils::Index<Rank>& index) const {
+            GEOMETRY_CHECK_INDEX(index, this->m_shape);
+            return data()[utils::flatIndex(index, this->m_strides)];
+        }
+
+        // -> Assignement (element by element). A source overlapping the view
+        //    in any other way than being the same view is copied first.
+        // -> Exceptions::SizeMismatch() if the shapes differ
+        TensorView& operator=(const TensorView& other);
+        TensorView& operator=(const ConstTensorView<T, Rank>& other);
+        TensorView& operator=(T value);
+
+        // -> Math operations in place, element-wise
+        // -> Exceptions::SizeMismatch() if the shapes differ
+        TensorView& operator+=(const ConstTensorView<T, Rank>& other);
+        TensorView& operator-=(const ConstTensorView<T, Rank>& other);
+        TensorView& operator*=(const ConstTensorView<T, Rank>& other);
+        TensorView& operator/=(const ConstTensorView<T, Rank>& other);
+
+        TensorView& operator+=(T value);
+        TensorView& operator-=(T value);
+        TensorView& operator*=(T value);
+        TensorView& operator/=(T value);
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        T* data() const {return const_cast<T*>(this->mp_data);}
+
+        // ---------------------------- SUB-VIEWS -----------------------------
+        // -> Exceptions::SizeMismatch() if they do not fit in this view
+        TensorView<T, Rank-1> slice(std::size_t dim, std::size_t index) const;
+        TensorView block(const utils::Index<Rank>& first, const utils::Index<Rank>& extents) const;
+        MatrixView<T> asMatrix() const;
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        // this[i] = this[i] op other[i] (what the compound operators run),
+        // through the SIMD kernel on every line contiguous on both sides.
+        // other overlapping the view is copied first, as for assignment.
+        // -> Exceptions::SizeMismatch() if the shapes differ
+        template<utils::ElementOp Op>
+        void apply(const ConstTensorView<T, Rank>& other);
+        template<utils::ElementOp Op>
+        void apply(T value);
+    };
+
+    // Dense Rank-dimensional array (volumetric grids, stacks of images...).
+    // Storage is 64-byte aligned and first-index-fastest, the N-D extension
+    // of the column-major Matrix: element (i0, i1, ..., iN) lives at
+    // data()[i0 + i1*stride(1) + ... + iN*stride(N)]. Shape and strides are
+    // std::array members, so no rank needs a heap allocation besides the
+    // elements. Whole-tensor operations run the flat SIMD element-wise
+    // kernels (and their threads) of matrixSimd.decl.hpp.
+    template<class T, std::size_t Rank, class Alloc>
+    class Tensor
+    {
+        static_assert(Rank >= 1, "a tensor has at least one dimension");
+
+    public: // types
+        using value_type = T;
+        using allocator_type = Alloc;
+        using index_type = utils::Index<Rank>;
+        using const_view_type = ConstTensorView<T, Rank>;
+        static constexpr std::size_t rank = Rank;
+
+    protected: // attributes
+        std::vector<T, Alloc> m_data{};
+        index_type m_shape{};
+        index_type m_strides{};
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        Tensor() {} // --> empty tensor, every extent 0.
+        explicit Tensor(const index_type& shape, const Alloc& alloc = Alloc()); // --> zeros
+        Tensor(const index_type& shape, T value, const Alloc& alloc = Alloc());
+
+        // Elements in storage order (first index fastest).
+        // -> Exceptions::SizeMismatch()
+        Tensor(const index_type& shape, std::initializer_list<T> list, const Alloc& alloc = Alloc());
+
+        // Copy of the viewed elements.
+        explicit Tensor(const ConstTensorView<T, Rank>& view, const Alloc& alloc = Alloc());
+
+        // Type (or allocator) conversion.
+        template<class U, class A>
+        explicit Tensor(const Tensor<U, Rank, A>& other);
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        template<class... I, class = std::enable_if_t<sizeof...(I) == Rank>>
+        T operator()(I... index) const {
+            return (*this)[index_type{static_cast<std::size_t>(index)...}];
+        }
+        template<class... I, class = std::enable_if_t<sizeof...(I) == Rank>>
+        T& operator()(I... index) {
+            return (*this)[index_type{static_cast<std::size_t>(index)...}];
+        }
+        T operator[](const index_type& index) const {
+            GEOMETRY_CHECK_INDEX(index, m_shape);
+            return m_data[utils::flatIndex(index, m_strides)];
+        }
+        T& operator[](const index_type& index) {
+            GEOMETRY_CHECK_INDEX(index, m_shape);
+            return m_data[utils::flatIndex(index, m_strides)];
+        }
+
+        // -> Assignement
+        Tensor& operator=(T value);
+
+        // -> Math operations in place, element-wise. A dense operand goes
+        //    through one flat SIMD pass.
+        // -> Exceptions::SizeMismatch() if the shapes differ
+        Tensor& operator+=(const ConstTensorView<T, Rank>& other);
+        Tensor& operator-=(const ConstTensorView<T, Rank>& other);
+        Tensor& operator*=(const ConstTensorView<T, Rank>& other);
+        Tensor& operator/=(const ConstTensorView<T, Rank>& other);
+
+        Tensor& operator+=(T value);
+        Tensor& operator-=(T value);
+        Tensor& operator*=(T value);
+        Tensor& operator/=(T value);
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        const index_type& shape()   const {return m_shape;}
+        const index_type& strides() const {return m_strides;}
+        std::size_t extent(std::size_t dim) const {return m_shape[dim];}
+        std::size_t stride(std::size_t dim) const {return m_strides[dim];}
+        std::size_t size() const {return m_data.size();}
+        bool empty() const {return m_data.empty();}
+        const T* data() const {return m_data.data();}
+        Alloc get_allocator() const {return m_data.get_allocator();}
+
+        // ------------------------------ VIEWS -------------------------------
+        // O(1), no copy. Invalidated when the storage is reallocated.
+        // -> Exceptions::SizeMismatch() for indices out of the tensor
+        TensorView<T, Rank> view() {return TensorView<T, Rank>(*this);}
+        ConstTensorView<T, Rank> view() const {return ConstTensorView<T, Rank>(*this);}
+        TensorView<T, Rank-1> slice(std::size_t dim, std::size_t index) {
+            return this->view().slice(dim, index);
+        }
+        ConstTensorView<T, Rank-1> slice(std::size_t dim, std::size_t index) const {
+            return this->view().slice(dim, index);
+        }
+        TensorView<T, Rank> block(const index_type& first, const index_type& extents) {
+            return this->view().block(first, extents);
+        }
+        ConstTensorView<T, Rank> block(const index_type& first, const index_type& extents) const {
+            return this->view().block(first, extents);
+        }
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        T* data() {return m_data.data();}
+        // Same elements under another shape of the same size.
+        // -> Exceptions::SizeMismatch()
+        void reshape(const index_type& shape);
+        void swap(Tensor& other) noexcept;
+
+        // this[i] = this[i] op other[i], one flat SIMD pass when other is
+        // dense (see TensorView::apply otherwise).
+        // -> Exceptions::SizeMismatch() if the shapes differ
+        template<utils::ElementOp Op>
+        void apply(const ConstTensorView<T, Rank>& other);
+        template<utils::ElementOp Op>
+        void apply(T value);
+    };
+
+    // -> Element-wise math, one pass into a new tensor. An expiring left
+    //    operand is reused as the result.
+    // -> Exceptions::SizeMismatch()
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator+(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator-(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator*(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator/(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator+(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator-(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator*(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator/(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs);
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator+(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator-(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator*(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs);
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator/(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs);
+
+}
+#endif
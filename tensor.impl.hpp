@@ -0,0 +1,641 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__TENSOR_IMPL__GUARD__2610
+#define GEOMETRY__TENSOR_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <utility>
+
+// LOCAL INCLUDES
+#include "tensor.decl.hpp"
+#include "matrixAllocator.hpp"
+#include "matrixView.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // ------------------------------ INDEXING ----------------------------
+        template<std::size_t Rank>
+        constexpr Index<Rank> denseStrides(const Index<Rank>& shape)
+        {
+            Index<Rank> strides{};
+            std::size_t stride = 1;
+            for(std::size_t d=0; d<Rank; d++)
+            {
+                strides[d] = stride;
+                stride *= shape[d];
+            }
+            return strides;
+        }
+
+        template<std::size_t Rank>
+        constexpr std::size_t product(const Index<Rank>& shape)
+        {
+            std::size_t out = 1;
+            for(std::size_t d=0; d<Rank; d++)
+                out *= shape[d];
+            return out;
+        }
+
+        template<std::size_t Rank>
+        constexpr std::size_t flatIndex(const Index<Rank>& index, const Index<Rank>& strides)
+        {
+            std::size_t out = 0;
+            for(std::size_t d=0; d<Rank; d++)
+                out += index[d]*strides[d];
+            return out;
+        }
+
+        template<std::size_t Rank>
+        constexpr Index<Rank> unravel(std::size_t flat, const Index<Rank>& shape)
+        {
+            Index<Rank> index{};
+            for(std::size_t d=0; d<Rank; d++)
+            {
+                if(shape[d] == 0)
+                    return Index<Rank>{};
+                index[d] = flat % shape[d];
+                flat /= shape[d];
+            }
+            return index;
+        }
+
+        template<std::size_t Rank, class Body>
+        void forEachLine(const Index<Rank>& shape, const Index<Rank>& stridesA,
+                         const Index<Rank>& stridesB, Body body)
+        {
+            const std::size_t nLines = (shape[0] == 0) ? 0 : product(shape)/shape[0];
+            parallelFor(nLines, nLines*shape[0], [&](std::size_t first, std::size_t last){
+                if(first == last)
+                    return;
+                // Odometer over dimensions 1..Rank-1, started at line first.
+                Index<Rank> index{};
+                std::size_t rest = first;
+                for(std::size_t d=1; d<Rank; d++)
+                {
+                    index[d] = rest % shape[d];
+                    rest /= shape[d];
+                }
+                std::size_t offsetA = flatIndex(index, stridesA);
+                std::size_t offsetB = flatIndex(index, stridesB);
+                for(std::size_t line=first; line<last; line++)
+                {
+                    body(offsetA, offsetB);
+                    for(std::size_t d=1; d<Rank; d++)
+                    {
+                        offsetA += stridesA[d];
+                        offsetB += stridesB[d];
+                        if(++index[d] < shape[d])
+                            break;
+                        offsetA -= shape[d]*stridesA[d];
+                        offsetB -= shape[d]*stridesB[d];
+                        index[d] = 0;
+                    }
+                }
+            });
+        }
+
+    }
+
+    // ============================ CONSTTENSORVIEW ===========================
+    // ----------------------------- CONSTRUCTORS -----------------------------
+    template<class T, std::size_t Rank> template<class Alloc>
+    ConstTensorView<T, Rank>::ConstTensorView(const Tensor<T, Rank, Alloc>& tensor):
+        ConstTensorView(tensor.data(), tensor.shape(), tensor.strides())
+        {}
+
+    // --------------------- ASK INFO MEMBERS (-> const) ----------------------
+    template<class T, std::size_t Rank>
+    bool ConstTensorView<T, Rank>::isContiguous() const
+    {
+        // Strides of dimensions of extent 1 never matter.
+        std::size_t stride = 1;
+        for(std::size_t d=0; d<Rank; d++)
+        {
+            if((m_shape[d] != 1) && (m_strides[d] != stride))
+                return false;
+            stride *= m_shape[d];
+        }
+        return true;
+    }
+
+    template<class T, std::size_t Rank>
+    bool ConstTensorView<T, Rank>::references(const void* first, const void* last) const
+    {
+        return !this->empty() && utils::overlaps(mp_data, this->spanEnd(), first, last);
+    }
+
+    // ------------------------------- SUB-VIEWS ------------------------------
+    template<class T, std::size_t Rank>
+    ConstTensorView<T, Rank-1> ConstTensorView<T, Rank>::slice(std::size_t dim, std::size_t index) const
+    {
+        this->checkSlice(dim, index);
+        utils::Index<Rank-1> shape{}, strides{};
+        for(std::size_t d=0, e=0; d<Rank; d++)
+            if(d != dim)
+            {
+                shape[e] = m_shape[d];
+                strides[e++] = m_strides[d];
+            }
+        return {mp_data + index*m_strides[dim], shape, strides};
+    }
+
+    template<class T, std::size_t Rank>
+    ConstTensorView<T, Rank> ConstTensorView<T, Rank>::block(const index_type& first,
+                                                             const index_type& extents) const
+    {
+        this->checkBlock(first, extents);
+        return {mp_data + utils::flatIndex(first, m_strides), extents, m_strides};
+    }
+
+    template<class T, std::size_t Rank>
+    ConstMatrixView<T> ConstTensorView<T, Rank>::asMatrix() const
+    {
+        static_assert(Rank == 2, "only rank 2 tensors are matrices");
+        return {mp_data, m_shape[0], m_shape[1], m_strides[0], m_strides[1]};
+    }
+
+    template<class T, std::size_t Rank>
+    const T* ConstTensorView<T, Rank>::spanEnd() const
+    {
+        if(this->empty())
+            return mp_data;
+        std::size_t last = 0;
+        for(std::size_t d=0; d<Rank; d++)
+            last += (m_shape[d] - 1)*m_strides[d];
+        return mp_data + last + 1;
+    }
+
+    template<class T, std::size_t Rank>
+    void ConstTensorView<T, Rank>::checkSlice(std::size_t dim, std::size_t index) const
+    {
+        static_assert(Rank >= 2, "slicing a rank 1 tensor gives a single value");
+        if(dim >= Rank)
+            throw Exeptions::SizeMismatch(Rank, dim + 1);
+        if(index >= m_shape[dim])
+            throw Exeptions::SizeMismatch(m_shape[dim], index + 1);
+    }
+
+    template<class T, std::size_t Rank>
+    void ConstTensorView<T, Rank>::checkBlock(const index_type& first, const index_type& extents) const
+    {
+        for(std::size_t d=0; d<Rank; d++)
+            if(first[d] + extents[d] > m_shape[d])
+                throw Exeptions::SizeMismatch(m_shape[d], first[d] + extents[d]);
+    }
+
+    // ============================== TENSORVIEW ==============================
+    // ----------------------------- CONSTRUCTORS -----------------------------
+    template<class T, std::size_t Rank> template<class Alloc>
+    TensorView<T, Rank>::TensorView(Tensor<T, Rank, Alloc>& tensor):
+        TensorView(tensor.data(), tensor.shape(), tensor.strides())
+        {}
+
+    // ------------------------ OPERATORS OVERLOADING -------------------------
+    // -> Assignement
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator=(const TensorView& other)
+    {
+        return *this = static_cast<const ConstTensorView<T, Rank>&>(other);
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator=(const ConstTensorView<T, Rank>& other)
+    {
+        if(other.shape() != this->m_shape)
+            throw Exeptions::SizeMismatch(this->size(), other.size());
+        if(other.data() == this->mp_data && other.strides() == this->m_strides)
+            return *this;
+        // Written while still read (e.g. a block shifted by one): copy it.
+        if(other.references(this->mp_data, this->spanEnd()))
+        {
+            const Tensor<T, Rank> copy(other);
+            return *this = copy.view();
+        }
+        T* out = data();
+        const T* in = other.data();
+        const std::size_t n = this->m_shape[0];
+        const std::size_t strideOut = this->m_strides[0];
+        const std::size_t strideIn = other.stride(0);
+        utils::forEachLine(this->m_shape, this->m_strides, other.strides(),
+                           [&](std::size_t offsetOut, std::size_t offsetIn){
+            if((strideOut == 1) && (strideIn == 1))
+                std::copy_n(in + offsetIn, n, out + offsetOut);
+            else
+                for(std::size_t i=0; i<n; i++)
+                    out[offsetOut + i*strideOut] = in[offsetIn + i*strideIn];
+        });
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator=(T value)
+    {
+        T* out = data();
+        const std::size_t n = this->m_shape[0];
+        const std::size_t stride = this->m_strides[0];
+        utils::forEachLine(this->m_shape, this->m_strides, this->m_strides,
+                           [&](std::size_t offset, std::size_t){
+            if(stride == 1)
+                utils::broadcast(n, value, out + offset);
+            else
+                for(std::size_t i=0; i<n; i++)
+                    out[offset + i*stride] = value;
+        });
+        return *this;
+    }
+
+    // -> Math operations in place
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator+=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Add>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator-=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Sub>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator*=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Mul>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator/=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Div>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator+=(T value)
+    {
+        this->template apply<utils::ElementOp::Add>(value);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator-=(T value)
+    {
+        this->template apply<utils::ElementOp::Sub>(value);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator*=(T value)
+    {
+        this->template apply<utils::ElementOp::Mul>(value);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank>& TensorView<T, Rank>::operator/=(T value)
+    {
+        this->template apply<utils::ElementOp::Div>(value);
+        return *this;
+    }
+
+    // ------------------------------- SUB-VIEWS ------------------------------
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank-1> TensorView<T, Rank>::slice(std::size_t dim, std::size_t index) const
+    {
+        const ConstTensorView<T, Rank-1> out = ConstTensorView<T, Rank>::slice(dim, index);
+        return {const_cast<T*>(out.data()), out.shape(), out.strides()};
+    }
+
+    template<class T, std::size_t Rank>
+    TensorView<T, Rank> TensorView<T, Rank>::block(const utils::Index<Rank>& first,
+                                                   const utils::Index<Rank>& extents) const
+    {
+        this->checkBlock(first, extents);
+        return {data() + utils::flatIndex(first, this->m_strides), extents, this->m_strides};
+    }
+
+    template<class T, std::size_t Rank>
+    MatrixView<T> TensorView<T, Rank>::asMatrix() const
+    {
+        static_assert(Rank == 2, "only rank 2 tensors are matrices");
+        return {data(), this->m_shape[0], this->m_shape[1], this->m_strides[0], this->m_strides[1]};
+    }
+
+    // ------------------------ DATA MODIFIER MEMBERS -------------------------
+    template<class T, std::size_t Rank> template<utils::ElementOp Op>
+    void TensorView<T, Rank>::apply(const ConstTensorView<T, Rank>& other)
+    {
+        if(other.shape() != this->m_shape)
+            throw Exeptions::SizeMismatch(this->size(), other.size());
+        // The same view reads each element where it writes it: no copy.
+        if(!((other.data() == this->mp_data) && (other.strides() == this->m_strides))
+           && other.references(this->mp_data, this->spanEnd()))
+        {
+            const Tensor<T, Rank> copy(other);
+            return this->template apply<Op>(copy.view());
+        }
+        T* out = data();
+        const T* in = other.data();
+        const std::size_t n = this->m_shape[0];
+        const std::size_t strideOut = this->m_strides[0];
+        const std::size_t strideIn = other.stride(0);
+        utils::forEachLine(this->m_shape, this->m_strides, other.strides(),
+                           [&](std::size_t offsetOut, std::size_t offsetIn){
+            if((strideOut == 1) && (strideIn == 1))
+                utils::elementWise<Op>(n, out + offsetOut, in + offsetIn, out + offsetOut);
+            else
+                for(std::size_t i=0; i<n; i++)
+                {
+                    T& elt = out[offsetOut + i*strideOut];
+                    elt = utils::applyElementOp<Op>(elt, in[offsetIn + i*strideIn]);
+                }
+        });
+    }
+
+    template<class T, std::size_t Rank> template<utils::ElementOp Op>
+    void TensorView<T, Rank>::apply(T value)
+    {
+        T* out = data();
+        const std::size_t n = this->m_shape[0];
+        const std::size_t stride = this->m_strides[0];
+        utils::forEachLine(this->m_shape, this->m_strides, this->m_strides,
+                           [&](std::size_t offset, std::size_t){
+            if(stride == 1)
+                utils::elementWise<Op>(n, out + offset, value, out + offset);
+            else
+                for(std::size_t i=0; i<n; i++)
+                {
+                    T& elt = out[offset + i*stride];
+                    elt = utils::applyElementOp<Op>(elt, value);
+                }
+        });
+    }
+
+    // ================================ TENSOR ================================
+    // ----------------------------- CONSTRUCTORS -----------------------------
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>::Tensor(const index_type& shape, const Alloc& alloc):
+        m_data(utils::product(shape), static_cast<T>(0), alloc),
+        m_shape(shape),
+        m_strides(utils::denseStrides(shape))
+        {}
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>::Tensor(const index_type& shape, T value, const Alloc& alloc):
+        m_data(utils::product(shape), value, alloc),
+        m_shape(shape),
+        m_strides(utils::denseStrides(shape))
+        {}
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>::Tensor(const index_type& shape, std::initializer_list<T> list, const Alloc& alloc):
+        m_data(list, alloc),
+        m_shape(shape),
+        m_strides(utils::denseStrides(shape))
+    {
+        if(list.size() != utils::product(shape))
+            throw Exeptions::SizeMismatch(utils::product(shape), list.size());
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>::Tensor(const ConstTensorView<T, Rank>& view, const Alloc& alloc):
+        Tensor(view.shape(), alloc)
+    {
+        this->view() = view;
+    }
+
+    template<class T, std::size_t Rank, class Alloc> template<class U, class A>
+    Tensor<T, Rank, Alloc>::Tensor(const Tensor<U, Rank, A>& other):
+        m_data(other.size()),
+        m_shape(other.shape()),
+        m_strides(other.strides())
+    {
+        utils::convert(other.size(), other.data(), m_data.data());
+    }
+
+    // ------------------------ OPERATORS OVERLOADING -------------------------
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator=(T value)
+    {
+        utils::broadcast(m_data.size(), value, m_data.data());
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator+=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Add>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator-=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Sub>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator*=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Mul>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator/=(const ConstTensorView<T, Rank>& other)
+    {
+        this->template apply<utils::ElementOp::Div>(other);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator+=(T value)
+    {
+        this->template apply<utils::ElementOp::Add>(value);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator-=(T value)
+    {
+        this->template apply<utils::ElementOp::Sub>(value);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator*=(T value)
+    {
+        this->template apply<utils::ElementOp::Mul>(value);
+        return *this;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc>& Tensor<T, Rank, Alloc>::operator/=(T value)
+    {
+        this->template apply<utils::ElementOp::Div>(value);
+        return *this;
+    }
+
+    // ------------------------ DATA MODIFIER MEMBERS -------------------------
+    template<class T, std::size_t Rank, class Alloc>
+    void Tensor<T, Rank, Alloc>::reshape(const index_type& shape)
+    {
+        if(utils::product(shape) != m_data.size())
+            throw Exeptions::SizeMismatch(m_data.size(), utils::product(shape));
+        m_shape = shape;
+        m_strides = utils::denseStrides(shape);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    void Tensor<T, Rank, Alloc>::swap(Tensor& other) noexcept
+    {
+        m_data.swap(other.m_data);
+        std::swap(m_shape, other.m_shape);
+        std::swap(m_strides, other.m_strides);
+    }
+
+    template<class T, std::size_t Rank, class Alloc> template<utils::ElementOp Op>
+    void Tensor<T, Rank, Alloc>::apply(const ConstTensorView<T, Rank>& other)
+    {
+        if(other.shape() != m_shape)
+            throw Exeptions::SizeMismatch(this->size(), other.size());
+        if(other.isContiguous())
+            utils::elementWise<Op>(m_data.size(), m_data.data(), other.data(), m_data.data());
+        else
+            this->view().template apply<Op>(other);
+    }
+
+    template<class T, std::size_t Rank, class Alloc> template<utils::ElementOp Op>
+    void Tensor<T, Rank, Alloc>::apply(T value)
+    {
+        utils::elementWise<Op>(m_data.size(), m_data.data(), value, m_data.data());
+    }
+
+    // ============================ FREE FUNCTIONS ============================
+    namespace utils{
+
+        // One pass lhs op rhs into a new tensor (no copy of lhs first).
+        template<ElementOp Op, class T, std::size_t Rank, class Alloc>
+        Tensor<T, Rank, Alloc> tensorElementWise(const Tensor<T, Rank, Alloc>& lhs,
+                                                 const ConstTensorView<T, Rank>& rhs)
+        {
+            if(!rhs.isContiguous())
+            {
+                Tensor<T, Rank, Alloc> out(lhs);
+                out.view().template apply<Op>(rhs);
+                return out;
+            }
+            if(rhs.shape() != lhs.shape())
+                throw Exeptions::SizeMismatch(lhs.size(), rhs.size());
+            Tensor<T, Rank, Alloc> out(lhs.shape(), lhs.get_allocator());
+            elementWise<Op>(lhs.size(), lhs.data(), rhs.data(), out.data());
+            return out;
+        }
+
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator+(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        return utils::tensorElementWise<utils::ElementOp::Add>(lhs, rhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator-(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        return utils::tensorElementWise<utils::ElementOp::Sub>(lhs, rhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator*(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        return utils::tensorElementWise<utils::ElementOp::Mul>(lhs, rhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator/(const Tensor<T, Rank, Alloc>& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        return utils::tensorElementWise<utils::ElementOp::Div>(lhs, rhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator+(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator-(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator*(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator/(Tensor<T, Rank, Alloc>&& lhs,
+                                     const typename Tensor<T, Rank, Alloc>::const_view_type& rhs)
+    {
+        lhs /= rhs;
+        return std::move(lhs);
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator+(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs)
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator-(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs)
+    {
+        lhs -= rhs;
+        return lhs;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator*(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs)
+    {
+        lhs *= rhs;
+        return lhs;
+    }
+
+    template<class T, std::size_t Rank, class Alloc>
+    Tensor<T, Rank, Alloc> operator/(Tensor<T, Rank, Alloc> lhs, const typename Tensor<T, Rank, Alloc>::value_type& rhs)
+    {
+        lhs /= rhs;
+        return lhs;
+    }
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Minimal harness shared by the tests/check*.cpp programs: each program runs
+its cases against a naive reference, prints one line per failure and the
+totals, and exits with 1 when anything failed. `make check` builds every
+program and runs it once per instruction set (GEOMETRY_ISA), so the
+scalar fallback and each SIMD kernel are compared with the same reference.
+*/
+
+#ifndef GEOMETRY__CHECK__GUARD__2610
+#define GEOMETRY__CHECK__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+// LOCAL INCLUDES
+#include "matrixSimd.hpp"
+
+namespace check{
+
+    inline std::size_t& failures() {static std::size_t count = 0; return count;}
+    inline std::size_t& checks()   {static std::size_t count = 0; return count;}
+
+    // Records one check, reports it when it fails.
+    inline bool expect(bool ok, const std::string& what)
+    {
+        checks()++;
+        if(!ok)
+        {
+            failures()++;
+            std::printf("FAILED: %s\n", what.c_str());
+        }
+        return ok;
+    }
+
+    // |value - reference| <= tolerance*(1 + |reference|), NaN never close.
+    inline bool close(double value, double reference, double tolerance)
+    {
+        return std::abs(value - reference) <= tolerance*(1.0 + std::abs(reference));
+    }
+
+    // Deterministic values in [-1, 1) (no dependency on <random> engines
+    // whose sequences differ between standard libraries).
+    inline double value(std::size_t seed)
+    {
+        seed = seed*6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>((seed >> 33) % 2001)/1000.0 - 1.0;
+    }
+
+    // -> exit status of the program
+    inline int report(const char* name)
+    {
+        std::printf("%s [%s]: %zu checks, %zu failed\n", name,
+                    geometry::utils::isaName(geometry::utils::activeIsa()), checks(), failures());
+        return (failures() == 0) ? 0 : 1;
+    }
+
+}
+
+#endif
@@ -0,0 +1,239 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Broadcasting against element-by-element loops: column vectors, row vectors
+and 1 x 1 matrices on either side of the four operators, both broadcast at
+once (outer sums), stride-0 views, broadcasts under a transpose, compound
+operators and view assignments taking a broadcast operand, expiring
+operands too small for the result, and the shapes that must be refused.
+*/
+
+// STANDARD INCLUDES
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixOperations.hpp"
+#include "matrixView.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    template<typename T>
+    double tolerance()
+    {
+        return std::is_integral_v<T> ? 0.0 : std::is_same_v<T, float> ? 1e-5 : 1e-13;
+    }
+
+    // Column-major values, never zero (divisors).
+    template<typename T>
+    Matrix<T> filled(std::size_t line, std::size_t col, std::size_t seed)
+    {
+        std::vector<T> values(line*col);
+        for(std::size_t k=0; k<values.size(); k++)
+        {
+            const double v = check::value(seed + k)*(std::is_integral_v<T> ? 50 : 4);
+            values[k] = static_cast<T>((v < 0) ? v - 1 : v + 1);
+        }
+        Matrix<T> out(line, col);
+        out.setValues(values);
+        return out;
+    }
+
+    // Element (i, j) of m, broadcast: a dimension of 1 repeats.
+    template<typename T>
+    T element(const Matrix<T>& m, std::size_t line, std::size_t col)
+    {
+        const std::size_t i = (m.nLines() == 1) ? 0 : line;
+        const std::size_t j = (m.nColumns() == 1) ? 0 : col;
+        return m.at(i + j*m.nLines());
+    }
+
+    template<class V, class Reference>
+    bool matches(const V& view, std::size_t line, std::size_t col, Reference reference)
+    {
+        using T = std::decay_t<decltype(view(0, 0))>;
+        if((view.nLines() != line) || (view.nColumns() != col))
+            return false;
+        for(std::size_t j=0; j<col; j++)
+            for(std::size_t i=0; i<line; i++)
+                if(!check::close(static_cast<double>(view(i, j)), static_cast<double>(reference(i, j)),
+                                 tolerance<T>()))
+                    return false;
+        return true;
+    }
+
+    template<typename T, class Reference>
+    bool matches(const Matrix<T>& m, std::size_t line, std::size_t col, Reference reference)
+    {
+        return matches(m.view(), line, col, reference);
+    }
+
+    // fn() throws Exeptions::SizeMismatch.
+    bool mismatch(const std::function<void()>& fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    // x (line x col) against every operand shape that broadcasts to it.
+    template<typename T>
+    void checkOperators(std::size_t line, std::size_t col)
+    {
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col);
+        const Matrix<T> x = filled<T>(line, col, 1);
+        const Matrix<T> column = filled<T>(line, 1, 2), row = filled<T>(1, col, 3), single = filled<T>(1, 1, 4);
+
+        for(const Matrix<T>* b: {&column, &row, &single})
+        {
+            const std::string name = shape + " with " + std::to_string(b->nLines()) + "x"
+                                     + std::to_string(b->nColumns());
+            const auto ref = [&](std::size_t i, std::size_t j, auto op){
+                return op(element(x, i, j), element(*b, i, j));
+            };
+            check::expect(matches(Matrix<T>(x + *b), line, col, [&](std::size_t i, std::size_t j){
+                return ref(i, j, [](T u, T v){return T(u + v);});
+            }) && matches(Matrix<T>(*b + x), line, col, [&](std::size_t i, std::size_t j){
+                return ref(i, j, [](T u, T v){return T(v + u);});
+            }), "x + b and b + x " + name);
+            check::expect(matches(Matrix<T>(x - *b), line, col, [&](std::size_t i, std::size_t j){
+                return ref(i, j, [](T u, T v){return T(u - v);});
+            }) && matches(Matrix<T>(*b - x), line, col, [&](std::size_t i, std::size_t j){
+                return ref(i, j, [](T u, T v){return T(v - u);});
+            }), "x - b and b - x " + name);
+            check::expect(matches(Matrix<T>(x*(*b)), line, col, [&](std::size_t i, std::size_t j){
+                return ref(i, j, [](T u, T v){return T(u*v);});
+            }), "x*b " + name);
+            check::expect(matches(Matrix<T>(x/(*b)), line, col, [&](std::size_t i, std::size_t j){
+                return ref(i, j, [](T u, T v){return T(u/v);});
+            }) && matches(Matrix<T>(*b/x), line, col, [&](std::size_t i, std::size_t j){
+                return ref(i, j, [](T u, T v){return T(v/u);});
+            }), "x/b and b/x " + name);
+            check::expect(matches(Matrix<T>(x*T(2) + *b*T(3) - T(1)), line, col, [&](std::size_t i, std::size_t j){
+                return T(T(T(element(x, i, j)*T(2)) + T(element(*b, i, j)*T(3))) - T(1));
+            }), "chain with values " + name);
+
+            // Compound operators broadcast into the destination.
+            Matrix<T> y = x;
+            y += *b;
+            y *= *b;
+            y -= *b*T(2);
+            check::expect(matches(y, line, col, [&](std::size_t i, std::size_t j){
+                const T v = element(*b, i, j);
+                return T(T(T(element(x, i, j) + v)*v) - T(v*T(2)));
+            }), "compound operators " + name);
+            y /= *b;
+            check::expect(matches(y, line, col, [&](std::size_t i, std::size_t j){
+                const T v = element(*b, i, j);
+                return T(T(T(T(element(x, i, j) + v)*v) - T(v*T(2)))/v);
+            }), "y /= b " + name);
+
+            // A view filled from a smaller operand.
+            Matrix<T> z = x;
+            z.view() = *b;
+            check::expect(matches(z, line, col, [&](std::size_t i, std::size_t j){return element(*b, i, j);}),
+                          "view = b " + name);
+
+            // Expiring operands: the recycled buffer is too small when it
+            // is the one broadcast.
+            Matrix<T> small = *b;
+            const Matrix<T> grown = std::move(small) + x;
+            check::expect(matches(grown, line, col, [&](std::size_t i, std::size_t j){
+                return T(element(*b, i, j) + element(x, i, j));
+            }), "Matrix&& + x " + name);
+            Matrix<T> big = x;
+            const T* buffer = big.data();
+            const Matrix<T> kept = std::move(big) - *b;
+            check::expect((kept.data() == buffer) && matches(kept, line, col, [&](std::size_t i, std::size_t j){
+                return T(element(x, i, j) - element(*b, i, j));
+            }), "x&& - b keeps the buffer " + name);
+        }
+
+        // Both operands broadcast: an outer sum and an outer product.
+        check::expect(matches(Matrix<T>(column + row), line, col, [&](std::size_t i, std::size_t j){
+            return T(element(column, i, j) + element(row, i, j));
+        }) && matches(Matrix<T>(row*column), line, col, [&](std::size_t i, std::size_t j){
+            return T(element(row, i, j)*element(column, i, j));
+        }), "column + row and row*column " + shape);
+
+        // Transposes: a column turned into a row and a broadcast expression
+        // transposed whole.
+        const Matrix<T> columnOfRow = filled<T>(col, 1, 5);
+        check::expect(matches(Matrix<T>(x + transpose(columnOfRow)), line, col, [&](std::size_t i, std::size_t j){
+            return T(element(x, i, j) + element(columnOfRow, j, i));
+        }), "x + transpose(column) " + shape);
+        check::expect(matches(Matrix<T>(transpose(x - column)), col, line, [&](std::size_t i, std::size_t j){
+            return T(element(x, j, i) - element(column, j, i));
+        }), "transpose(x - column) " + shape);
+
+        // Stride-0 views built by hand repeat the same elements.
+        const ConstMatrixView<T> repeatedRow(row.data(), line, col, 0, 1);
+        const ConstMatrixView<T> repeatedColumn(column.data(), line, col, 1, 0);
+        check::expect(matches(Matrix<T>(x*repeatedRow - repeatedColumn), line, col, [&](std::size_t i, std::size_t j){
+            return T(T(element(x, i, j)*element(row, i, j)) - element(column, i, j));
+        }), "stride-0 views " + shape);
+        Matrix<T> w = x;
+        w += repeatedRow;
+        check::expect(matches(w, line, col, [&](std::size_t i, std::size_t j){
+            return T(element(x, i, j) + element(row, i, j));
+        }), "w += stride-0 view " + shape);
+        check::expect(matches(Matrix<T>(x + row.view()), line, col, [&](std::size_t i, std::size_t j){
+            return T(element(x, i, j) + element(row, i, j));
+        }), "x + row view " + shape);
+
+        // A column of x broadcast back onto x.
+        Matrix<T> self = x;
+        self -= Matrix<T>(self.column(0));
+        check::expect(matches(self, line, col, [&](std::size_t i, std::size_t j){
+            return T(element(x, i, j) - element(x, i, 0));
+        }), "x -= column of x " + shape);
+    }
+
+    template<typename T>
+    void checkErrors()
+    {
+        const Matrix<T> x = filled<T>(4, 5, 6), y = filled<T>(4, 3, 7), column = filled<T>(4, 1, 8);
+        const Matrix<T> wrongColumn = filled<T>(3, 1, 9), wrongRow = filled<T>(1, 4, 10);
+        check::expect(mismatch([&]{Matrix<T> r = x + y;}), "4x5 + 4x3");
+        check::expect(mismatch([&]{Matrix<T> r = x - wrongColumn;}), "4x5 - 3x1");
+        check::expect(mismatch([&]{Matrix<T> r = wrongRow*x;}), "1x4 * 4x5");
+        check::expect(mismatch([&]{Matrix<T> r = column + transpose(column) + x;}), "4x4 + 4x5");
+
+        // The destination of a compound operator or a view never grows.
+        Matrix<T> c = column;
+        check::expect(mismatch([&]{c += x;}) && (c.nLines() == 4) && (c.nColumns() == 1), "column += matrix");
+        check::expect(mismatch([&]{c.view() = x;}), "column view = matrix");
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t line: {1, 2, 5, 17, 64})
+            for(std::size_t col: {1, 3, 8, 33})
+                checkOperators<T>(line, col);
+        checkErrors<T>();
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<int>();
+    return check::report("broadcast");
+}
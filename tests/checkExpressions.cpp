@@ -0,0 +1,181 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Lazy expressions against element-by-element loops: chains of the four
+operators with matrices and single values on either side, transposes of
+matrices and of whole expressions, compound operators taking expressions,
+mixed element types, the aliasing cases (x = x*x, x = transpose(x),
+s += transpose(s)) and shape mismatches.
+*/
+
+// STANDARD INCLUDES
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixOperations.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    template<typename T>
+    double tolerance()
+    {
+        return std::is_integral_v<T> ? 0.0 : std::is_same_v<T, float> ? 1e-5 : 1e-13;
+    }
+
+    // Column-major values, never zero when nonZero is set (divisors).
+    template<typename T>
+    Matrix<T> filled(std::size_t line, std::size_t col, std::size_t seed, bool nonZero = false)
+    {
+        std::vector<T> values(line*col);
+        for(std::size_t k=0; k<values.size(); k++)
+        {
+            const double v = check::value(seed + k)*(std::is_integral_v<T> ? 50 : 4);
+            values[k] = static_cast<T>(nonZero ? ((v < 0) ? v - 1 : v + 1) : v);
+        }
+        Matrix<T> out(line, col);
+        out.setValues(values);
+        return out;
+    }
+
+    template<typename T>
+    T element(const Matrix<T>& m, std::size_t line, std::size_t col)
+    {
+        return m.at(line + col*m.nLines());
+    }
+
+    // m is line x col and m(i, j) == reference(i, j) for every element.
+    template<typename T, class Reference>
+    bool matches(const Matrix<T>& m, std::size_t line, std::size_t col, Reference reference)
+    {
+        if((m.nLines() != line) || (m.nColumns() != col))
+            return false;
+        for(std::size_t j=0; j<col; j++)
+            for(std::size_t i=0; i<line; i++)
+                if(!check::close(static_cast<double>(element(m, i, j)),
+                                 static_cast<double>(reference(i, j)), tolerance<T>()))
+                    return false;
+        return true;
+    }
+
+    template<typename T>
+    void checkShape(std::size_t line, std::size_t col)
+    {
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col);
+        const Matrix<T> a = filled<T>(line, col, 1), b = filled<T>(line, col, 2);
+        const Matrix<T> c = filled<T>(line, col, 3), d = filled<T>(line, col, 4, true);
+
+        const Matrix<T> chain = (a*b + c)/d - T(1);
+        check::expect(matches(chain, line, col, [&](std::size_t i, std::size_t j){
+            return T(T(T(T(element(a, i, j)*element(b, i, j)) + element(c, i, j))/element(d, i, j)) - T(1));
+        }), "(a*b + c)/d - 1 " + shape);
+
+        const Matrix<T> scalars = T(3) - a*T(2) + T(7)/d;
+        check::expect(matches(scalars, line, col, [&](std::size_t i, std::size_t j){
+            return T(T(T(3) - T(element(a, i, j)*T(2))) + T(T(7)/element(d, i, j)));
+        }), "3 - a*2 + 7/d " + shape);
+
+        const Matrix<T> t = transpose(a);
+        check::expect(matches(t, col, line, [&](std::size_t i, std::size_t j){return element(a, j, i);}),
+                      "transpose " + shape);
+        const Matrix<T> te = transpose(a - b)*T(2);
+        check::expect(matches(te, col, line, [&](std::size_t i, std::size_t j){
+            return T(T(element(a, j, i) - element(b, j, i))*T(2));
+        }), "transpose(a - b)*2 " + shape);
+
+        // Compound operators evaluate the whole expression in their pass.
+        Matrix<T> r = c;
+        r += a*b;
+        r -= d;
+        r *= a + T(1);
+        r /= d;
+        check::expect(matches(r, line, col, [&](std::size_t i, std::size_t j){
+            T value = element(c, i, j);
+            value += element(a, i, j)*element(b, i, j);
+            value -= element(d, i, j);
+            value *= element(a, i, j) + T(1);
+            value /= element(d, i, j);
+            return value;
+        }), "compound operators " + shape);
+
+        // Aliasing: the destination is also an operand.
+        Matrix<T> x = a;
+        x = x*x;
+        check::expect(matches(x, line, col, [&](std::size_t i, std::size_t j){
+            return T(element(a, i, j)*element(a, i, j));
+        }), "x = x*x " + shape);
+        x = a;
+        x = transpose(x);
+        check::expect(matches(x, col, line, [&](std::size_t i, std::size_t j){return element(a, j, i);}),
+                      "x = transpose(x) " + shape);
+        x = transpose(x) + b;
+        check::expect(matches(x, line, col, [&](std::size_t i, std::size_t j){
+            return T(element(a, i, j) + element(b, i, j));
+        }), "x = transpose(x) + b " + shape);
+
+        bool thrown = false;
+        try
+        {
+            const Matrix<T> wrong = a + Matrix<T>(line + 2, col + 2);
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            thrown = true;
+        }
+        // Unless a is 1 x 1, which broadcasts to any shape.
+        check::expect(thrown == ((line != 1) || (col != 1)), "shape mismatch " + shape);
+    }
+
+    // s op= transpose(s) reads elements the pass has already written.
+    template<typename T>
+    void checkSquare(std::size_t n)
+    {
+        const std::string shape = std::to_string(n) + "x" + std::to_string(n);
+        const Matrix<T> a = filled<T>(n, n, 5);
+        Matrix<T> s = a;
+        s += transpose(s);
+        check::expect(matches(s, n, n, [&](std::size_t i, std::size_t j){
+            return T(element(a, i, j) + element(a, j, i));
+        }), "s += transpose(s) " + shape);
+        s = a;
+        s = transpose(s) - s*T(2);
+        check::expect(matches(s, n, n, [&](std::size_t i, std::size_t j){
+            return T(element(a, j, i) - T(element(a, i, j)*T(2)));
+        }), "s = transpose(s) - s*2 " + shape);
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t line: {1, 2, 3, 17, 64})
+            for(std::size_t col: {1, 4, 5, 33})
+                checkShape<T>(line, col);
+        for(std::size_t n: {1, 2, 7, 16, 65})
+            checkSquare<T>(n);
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<int>();
+
+    // Mixed element types evaluate in the common type.
+    const Matrix<int> i = filled<int>(5, 3, 9);
+    const Matrix<double> d = filled<double>(5, 3, 10);
+    const Matrix<double> mixed = i*d + i;
+    check::expect(matches(mixed, 5, 3, [&](std::size_t l, std::size_t c){
+        return element(i, l, c)*element(d, l, c) + element(i, l, c);
+    }), "int*double + int");
+
+    return check::report("expressions");
+}
@@ -0,0 +1,297 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+LU, Cholesky and QR against their definitions, computed in double:
+P.A = L.U, A = L.L^T, A = Q.R with orthonormal Q, residuals of the
+solves (matrix and vector right-hand sides, both layouts), inverses,
+determinants, least squares through the normal equations, and the
+singular / not positive definite errors. Sizes straddle the panel width
+(utils::factorizationBlock) so the blocked updates run.
+*/
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixFactorization.hpp"
+#include "matrixParallel.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    template<typename T>
+    double tolerance()
+    {
+        return std::is_same_v<T, float> ? 2e-4 : 1e-11;
+    }
+
+    template<typename T, Layout Order = Layout::ColumnMajor>
+    Matrix<T, utils::AlignedAllocator<T, 64>, Order> random(std::size_t line, std::size_t col,
+                                                          std::size_t seed, double diagonal = 0)
+    {
+        Matrix<T, utils::AlignedAllocator<T, 64>, Order> out(line, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                out(i, j) = static_cast<T>(check::value(seed + i*col + j) + ((i == j) ? diagonal : 0));
+        return out;
+    }
+
+    // Largest |(X.Y)_ij - Z_ij| over max(1, max |Z_ij|), in double.
+    template<class X, class Y, class Z>
+    double productError(const X& x, const Y& y, const Z& z)
+    {
+        double error = 0, scale = 1;
+        for(std::size_t i=0; i<x.nLines(); i++)
+            for(std::size_t j=0; j<y.nColumns(); j++)
+            {
+                double sum = 0;
+                for(std::size_t p=0; p<x.nColumns(); p++)
+                    sum += static_cast<double>(x(i, p))*static_cast<double>(y(p, j));
+                error = std::max(error, std::abs(sum - static_cast<double>(z(i, j))));
+                scale = std::max(scale, std::abs(static_cast<double>(z(i, j))));
+            }
+        return error/scale;
+    }
+
+    template<typename T>
+    Matrix<T> identity(std::size_t n)
+    {
+        Matrix<T> out(n, n);
+        for(std::size_t i=0; i<n; i++)
+            out(i, i) = T(1);
+        return out;
+    }
+
+    template<typename T, class A, class B, class X>
+    void checkSolution(const A& a, const B& b, const X& x, const std::string& name)
+    {
+        const double error = productError(a, x, b);
+        check::expect(error <= tolerance<T>()*static_cast<double>(a.nLines()),
+                      name + ": residual " + std::to_string(error));
+    }
+
+    template<typename T, Layout Order>
+    void checkLu(std::size_t n)
+    {
+        const std::string name = "lu " + std::to_string(n) + " layout " + std::to_string(int(Order));
+        const auto a = random<T, Order>(n, n, n, 2.0);
+        const LuFactorization<T> lu(a);
+
+        // P.A = L.U: apply the recorded swaps to the lines of A.
+        Matrix<T> pa(n, n), l(n, n), u(n, n);
+        for(std::size_t i=0; i<n; i++)
+            for(std::size_t j=0; j<n; j++)
+                pa(i, j) = a(i, j);
+        for(std::size_t k=0; k<n; k++)
+            for(std::size_t j=0; j<n; j++)
+                std::swap(pa(k, j), pa(lu.pivots()[k], j));
+        for(std::size_t i=0; i<n; i++)
+            for(std::size_t j=0; j<n; j++)
+            {
+                l(i, j) = (i > j) ? lu.factors()(i, j) : (i == j) ? T(1) : T(0);
+                u(i, j) = (i <= j) ? lu.factors()(i, j) : T(0);
+            }
+        check::expect(!lu.isSingular() && (productError(l, u, pa) <= tolerance<T>()*n), name + ": P.A = L.U");
+
+        const auto b = random<T, Order>(n, 3, 7*n);
+        checkSolution<T>(a, b, lu.solve(b), name + " solve");
+        auto inPlace = b;
+        lu.solveInPlace(inPlace);
+        checkSolution<T>(a, b, inPlace, name + " solveInPlace");
+        checkSolution<T>(a, b, solve(a, b), name + " one-shot solve");
+        std::vector<T> v(n);
+        for(std::size_t i=0; i<n; i++)
+            v[i] = b(i, 0);
+        const std::vector<T> xv = lu.solve(v);
+        Matrix<T> xm(n, 1), vm(n, 1);
+        for(std::size_t i=0; i<n; i++)
+        {
+            xm(i, 0) = xv[i];
+            vm(i, 0) = v[i];
+        }
+        checkSolution<T>(a, vm, xm, name + " vector solve");
+        check::expect(productError(a, lu.inverse(), identity<T>(n)) <= tolerance<T>()*n, name + ": A.inverse");
+    }
+
+    template<typename T, Layout Order>
+    void checkCholesky(std::size_t n)
+    {
+        const std::string name = "cholesky " + std::to_string(n) + " layout " + std::to_string(int(Order));
+        // M.M^T + n.I is symmetric positive definite.
+        const auto m = random<T>(n, n, 3*n);
+        Matrix<T, utils::AlignedAllocator<T, 64>, Order> a(n, n);
+        for(std::size_t i=0; i<n; i++)
+            for(std::size_t j=0; j<n; j++)
+            {
+                double sum = (i == j) ? static_cast<double>(n) : 0.0;
+                for(std::size_t p=0; p<n; p++)
+                    sum += static_cast<double>(m(i, p))*static_cast<double>(m(j, p));
+                a(i, j) = static_cast<T>(sum);
+            }
+        const CholeskyFactorization<T> cholesky(a);
+        const Matrix<T> l = cholesky.factor();
+        Matrix<T> lt(n, n);
+        for(std::size_t i=0; i<n; i++)
+            for(std::size_t j=0; j<n; j++)
+                lt(i, j) = l(j, i);
+        check::expect(productError(l, lt, a) <= tolerance<T>()*n, name + ": A = L.L^T");
+
+        const auto b = random<T, Order>(n, 4, 5*n);
+        checkSolution<T>(a, b, cholesky.solve(b), name + " solve");
+        check::expect(productError(a, cholesky.inverse(), identity<T>(n)) <= tolerance<T>()*n, name + ": A.inverse");
+
+        // det A = prod(L_ii)^2, compared in log scale (it is large) while
+        // it fits in T.
+        double logDeterminant = 0;
+        for(std::size_t i=0; i<n; i++)
+            logDeterminant += 2*std::log(static_cast<double>(l(i, i)));
+        if(logDeterminant < 0.9*std::log(static_cast<double>(std::numeric_limits<T>::max())))
+        {
+            const double viaLu = static_cast<double>(LuFactorization<T>(a).determinant());
+            const double viaCholesky = static_cast<double>(cholesky.determinant());
+            check::expect(check::close(std::log(viaCholesky), logDeterminant, tolerance<T>()*n)
+                          && check::close(std::log(viaLu), logDeterminant, tolerance<T>()*n),
+                          name + ": determinant");
+        }
+
+        // A negative diagonal entry on an otherwise zero line and column.
+        bool thrown = false;
+        for(std::size_t j=0; j<n; j++)
+            a(n/2, j) = a(j, n/2) = static_cast<T>((j == n/2) ? -1 : 0);
+        try
+        {
+            const CholeskyFactorization<T> indefinite(a);
+        }
+        catch(const Exeptions::NotPositiveDefinite&)
+        {
+            thrown = true;
+        }
+        check::expect(thrown, name + ": not positive definite");
+    }
+
+    template<typename T, Layout Order>
+    void checkQr(std::size_t m, std::size_t n)
+    {
+        const std::string name = "qr " + std::to_string(m) + "x" + std::to_string(n)
+                                 + " layout " + std::to_string(int(Order));
+        const auto a = random<T, Order>(m, n, m + 17*n, 1.0);
+        const QrFactorization<T> qr(a);
+        const Matrix<T> q = qr.q(), r = qr.r();
+        Matrix<T> qt(n, m);
+        for(std::size_t i=0; i<m; i++)
+            for(std::size_t j=0; j<n; j++)
+                qt(j, i) = q(i, j);
+        bool upper = true;
+        for(std::size_t i=0; i<n; i++)
+            for(std::size_t j=0; j<i; j++)
+                upper &= (r(i, j) == T(0));
+        check::expect(upper && (productError(q, r, a) <= tolerance<T>()*m), name + ": A = Q.R");
+        check::expect(productError(qt, q, identity<T>(n)) <= tolerance<T>()*m, name + ": Q^T.Q = I");
+
+        // Least squares: A^T.(A.X - B) = 0.
+        const auto b = random<T, Order>(m, 2, 11*m);
+        const auto x = qr.solve(b);
+        Matrix<T> residual(m, 2), at(n, m);
+        for(std::size_t i=0; i<m; i++)
+        {
+            for(std::size_t j=0; j<n; j++)
+                at(j, i) = a(i, j);
+            for(std::size_t k=0; k<2; k++)
+            {
+                double sum = -static_cast<double>(b(i, k));
+                for(std::size_t j=0; j<n; j++)
+                    sum += static_cast<double>(a(i, j))*static_cast<double>(x(j, k));
+                residual(i, k) = static_cast<T>(sum);
+            }
+        }
+        check::expect(productError(at, residual, Matrix<T>(n, 2)) <= tolerance<T>()*m*m,
+                      name + ": normal equations");
+        const auto oneShot = leastSquares(a, b);
+        bool same = true;
+        for(std::size_t i=0; i<n; i++)
+            for(std::size_t k=0; k<2; k++)
+                same &= check::close(static_cast<double>(oneShot(i, k)), static_cast<double>(x(i, k)),
+                                     tolerance<T>()*m);
+        check::expect(same, name + ": one-shot least squares");
+    }
+
+    template<typename T>
+    void checkSingular()
+    {
+        // A zero column: the updates keep it exactly zero (singular factors
+        // are detected on exact zero pivots).
+        Matrix<T> a = random<T>(70, 70, 1);
+        for(std::size_t i=0; i<70; i++)
+            a(i, 3) = T(0);
+        const LuFactorization<T> lu(a);
+        bool thrown = false;
+        try
+        {
+            lu.solve(Matrix<T>(70, 1));
+        }
+        catch(const Exeptions::SingularMatrix&)
+        {
+            thrown = true;
+        }
+        check::expect(lu.isSingular() && thrown && (lu.determinant() == T(0)), "lu singular");
+
+        bool mismatch = false;
+        try
+        {
+            const LuFactorization<T> notSquare(Matrix<T>(3, 4));
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            mismatch = true;
+        }
+        check::expect(mismatch, "lu not square");
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t n: {1, 2, 5, 17, 63, 64, 65, 130})
+        {
+            checkLu<T, Layout::ColumnMajor>(n);
+            checkLu<T, Layout::RowMajor>(n);
+            checkCholesky<T, Layout::ColumnMajor>(n + 1);
+            checkCholesky<T, Layout::RowMajor>(n + 1);
+        }
+        for(std::size_t m: {1, 3, 40, 64, 65, 150})
+            for(std::size_t n: {1, 2, 33, 64, 65, 130})
+                if(n <= m)
+                {
+                    checkQr<T, Layout::ColumnMajor>(m, n);
+                    checkQr<T, Layout::RowMajor>(m, n);
+                }
+        checkSingular<T>();
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+
+    // Trailing updates split across a pool.
+    utils::ThreadPool pool(3);
+    utils::setExecutionBackend(&pool);
+    utils::setParallelThreshold(1);
+    checkLu<double, Layout::ColumnMajor>(130);
+    checkCholesky<double, Layout::ColumnMajor>(131);
+    checkQr<double, Layout::ColumnMajor>(150, 130);
+    utils::setExecutionBackend(nullptr);
+
+    return check::report("factorization");
+}
@@ -0,0 +1,283 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Matrix files: save / load round trips for several element types, both
+layouts (loaded into either), padded matrices and hand-written files with
+padding between the columns, the size of what is written, mapped files
+(read-only, created, written back), and every header or file the reader
+must refuse: wrong magic, version, byte order, element type, layout,
+leading dimension or data offset, misaligned elements, sizes that overflow
+or go past the end of the file, and truncated data.
+*/
+
+// STANDARD INCLUDES
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixFile.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    std::string path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("geometry_check_" + name + ".mat")).string();
+    }
+
+    template<typename T>
+    T element(std::size_t i, std::size_t j)
+    {
+        return static_cast<T>(i*131 + j*7 + 1);
+    }
+
+    template<typename T, Layout Order>
+    using M = Matrix<T, utils::AlignedAllocator<T>, Order>;
+
+    template<typename T, Layout Order>
+    M<T, Order> reference(std::size_t line, std::size_t col, bool padded)
+    {
+        M<T, Order> out = padded ? M<T, Order>::padded(line, col) : M<T, Order>(line, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                out.view()(i, j) = element<T>(i, j);
+        return out;
+    }
+
+    template<typename T, class V>
+    bool matches(const V& view, std::size_t line, std::size_t col)
+    {
+        if((view.nLines() != line) || (view.nColumns() != col))
+            return false;
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                if(!(view(i, j) == element<T>(i, j)))
+                    return false;
+        return true;
+    }
+
+    // Rewrites the header of an existing file.
+    void patch(const std::string& file, const std::function<void(MatrixFileHeader&)>& change)
+    {
+        MatrixFileHeader header{};
+        std::FILE* f = std::fopen(file.c_str(), "r+b");
+        const bool read = f && (std::fread(&header, sizeof(header), 1, f) == 1);
+        change(header);
+        const bool written = read && (std::fseek(f, 0, SEEK_SET) == 0)
+                             && (std::fwrite(&header, sizeof(header), 1, f) == 1);
+        if(f)
+            std::fclose(f);
+        check::expect(written, "patching " + file);
+    }
+
+    // open() throws Exeptions::FileError.
+    bool refused(const std::function<void()>& open)
+    {
+        try
+        {
+            open();
+        }
+        catch(const Exeptions::FileError&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    template<typename T, Layout Order>
+    void checkRoundTrip(std::size_t line, std::size_t col, bool padded)
+    {
+        constexpr Layout Other = (Order == Layout::ColumnMajor) ? Layout::RowMajor : Layout::ColumnMajor;
+        const std::string name = std::to_string(line) + "x" + std::to_string(col) + " layout "
+                                 + std::to_string(int(Order)) + (padded ? " padded" : "")
+                                 + " size " + std::to_string(sizeof(T));
+        const std::string file = path("roundtrip");
+        reference<T, Order>(line, col, padded).save(file);
+
+        // Padding dropped, elements one page in.
+        check::expect(std::filesystem::file_size(file) == utils::matrixFileAlignment + line*col*sizeof(T),
+                      "file size " + name);
+        check::expect(matches<T>(M<T, Order>::load(file).view(), line, col), "load " + name);
+        check::expect(matches<T>(M<T, Other>::load(file).view(), line, col), "load into the other layout " + name);
+
+#ifdef GEOMETRY_MMAP
+        const MappedMatrix<T> mapped(file);
+        check::expect((mapped.layout() == Order) && matches<T>(mapped.view(), line, col), "mapped " + name);
+        const M<T, Layout::ColumnMajor> twice = mapped.view()*T(2);
+        bool ok = (twice.nLines() == line) && (twice.nColumns() == col);
+        for(std::size_t i=0; ok && (i<line); i++)
+            for(std::size_t j=0; j<col; j++)
+                ok &= (twice.view()(i, j) == T(element<T>(i, j)*T(2)));
+        check::expect(ok, "mapped view in an expression " + name);
+#endif
+        std::filesystem::remove(file);
+    }
+
+    // A file with lead - lines padding elements after every column, as
+    // another writer may produce.
+    template<typename T, Layout Order>
+    void checkPaddedFile(std::size_t line, std::size_t col, std::size_t pad)
+    {
+        const std::string name = std::to_string(line) + "x" + std::to_string(col) + " layout "
+                                 + std::to_string(int(Order)) + " pad " + std::to_string(pad);
+        MatrixFileHeader header = utils::makeHeader(utils::dtypeOf<T>(), sizeof(T), Order, line, col);
+        const std::size_t lines = utils::storageLines(header), columns = utils::storageColumns(header);
+        header.lead = lines + pad;
+        std::vector<T> data(header.lead*columns, T(-1));
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                data[(Order == Layout::ColumnMajor) ? i + j*header.lead : i*header.lead + j] = element<T>(i, j);
+        const std::string file = path("padded");
+        {
+            utils::File out(file, "wb");
+            utils::writeHeader(out, header);
+            out.write(data.data(), data.size()*sizeof(T));
+            out.close();
+        }
+        check::expect(matches<T>(M<T, Layout::ColumnMajor>::load(file).view(), line, col)
+                      && matches<T>(M<T, Layout::RowMajor>::load(file).view(), line, col),
+                      "load a padded file " + name);
+#ifdef GEOMETRY_MMAP
+        const MappedMatrix<T> mapped(file);
+        check::expect((mapped.leadingDimension() == header.lead) && matches<T>(mapped.view(), line, col),
+                      "map a padded file " + name);
+#endif
+        std::filesystem::remove(file);
+    }
+
+#ifdef GEOMETRY_MMAP
+    template<typename T>
+    void checkCreate(std::size_t line, std::size_t col, Layout layout)
+    {
+        const std::string name = std::to_string(line) + "x" + std::to_string(col) + " layout "
+                                 + std::to_string(int(layout));
+        const std::string file = path("created");
+        {
+            MappedMatrix<T> created = MappedMatrix<T>::create(file, line, col, layout);
+            bool zero = (created.mode() == MapMode::ReadWrite);
+            for(std::size_t i=0; i<line; i++)
+                for(std::size_t j=0; j<col; j++)
+                {
+                    zero &= (created.view()(i, j) == T(0));
+                    created.view()(i, j) = element<T>(i, j);
+                }
+            created.flush();
+            check::expect(zero, "created file starts at zero " + name);
+        }
+        check::expect(matches<T>(Matrix<T>::load(file).view(), line, col), "created file written back " + name);
+
+        {
+            MappedMatrix<T> writable(file, MapMode::ReadWrite);
+            writable.view()(0, 0) = T(5);
+        }
+        check::expect(Matrix<T>::load(file).view()(0, 0) == T(5), "ReadWrite mapping written back " + name);
+        std::filesystem::remove(file);
+    }
+#endif
+
+    template<typename T>
+    void checkRefused(const std::string& what, const std::function<void(const std::string&)>& damage)
+    {
+        const std::string file = path("refused");
+        reference<T, Layout::ColumnMajor>(5, 3, false).save(file);
+        damage(file);
+        check::expect(refused([&]{Matrix<T>::load(file);}), "load refuses " + what);
+#ifdef GEOMETRY_MMAP
+        check::expect(refused([&]{MappedMatrix<T> mapped(file);}), "map refuses " + what);
+#endif
+        std::filesystem::remove(file);
+    }
+
+    template<typename T>
+    void checkErrors()
+    {
+        checkRefused<T>("a wrong magic", [](const std::string& f){patch(f, [](MatrixFileHeader& h){h.magic[0] = 'X';});});
+        checkRefused<T>("a newer version", [](const std::string& f){patch(f, [](MatrixFileHeader& h){h.version = 99;});});
+        checkRefused<T>("another byte order", [](const std::string& f){
+            patch(f, [](MatrixFileHeader& h){h.byteOrder = 0x04030201;});
+        });
+        checkRefused<T>("another element type", [](const std::string& f){
+            patch(f, [](MatrixFileHeader& h){
+                const bool isDouble = (utils::dtypeOf<T>() == DType::Float64);
+                h.dtype = static_cast<std::uint32_t>(isDouble ? DType::Float32 : DType::Float64);
+                h.elementSize = isDouble ? 4 : 8;
+            });
+        });
+        checkRefused<T>("another element size", [](const std::string& f){
+            patch(f, [](MatrixFileHeader& h){h.elementSize = 3;});
+        });
+        checkRefused<T>("an unknown layout", [](const std::string& f){patch(f, [](MatrixFileHeader& h){h.layout = 2;});});
+        checkRefused<T>("a lead smaller than the lines", [](const std::string& f){
+            patch(f, [](MatrixFileHeader& h){h.lead = h.nLines - 1;});
+        });
+        checkRefused<T>("a data offset inside the header", [](const std::string& f){
+            patch(f, [](MatrixFileHeader& h){h.dataOffset = 8;});
+        });
+        if(sizeof(T) > 1)
+            checkRefused<T>("misaligned elements", [](const std::string& f){
+                patch(f, [](MatrixFileHeader& h){h.dataOffset += 1;});
+            });
+        // ((columns - 1)*lead + lines)*elementSize wraps to a few bytes.
+        checkRefused<T>("a size that overflows", [](const std::string& f){
+            patch(f, [](MatrixFileHeader& h){
+                h.lead = (std::uint64_t{1} << 61) + 1;
+                h.nColumns = 9;
+            });
+        });
+        checkRefused<T>("a lead past the end of the file", [](const std::string& f){
+            patch(f, [](MatrixFileHeader& h){h.lead = h.nLines + 64;});
+        });
+        checkRefused<T>("truncated data", [](const std::string& f){
+            std::filesystem::resize_file(f, std::filesystem::file_size(f) - sizeof(T));
+        });
+        checkRefused<T>("a truncated header", [](const std::string& f){std::filesystem::resize_file(f, 40);});
+
+        const std::string file = path("missing");
+        std::filesystem::remove(file);
+        check::expect(refused([&]{Matrix<T>::load(file);}), "load refuses a missing file");
+
+        // The element type must match, no conversion on load.
+        reference<T, Layout::ColumnMajor>(2, 2, false).save(file);
+        check::expect(refused([&]{Matrix<std::int16_t>::load(file);}), "load refuses another type");
+        std::filesystem::remove(file);
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t line: {1, 3, 17, 64})
+            for(std::size_t col: {1, 5, 33})
+                for(bool padded: {false, true})
+                {
+                    checkRoundTrip<T, Layout::ColumnMajor>(line, col, padded);
+                    checkRoundTrip<T, Layout::RowMajor>(line, col, padded);
+                }
+        checkPaddedFile<T, Layout::ColumnMajor>(13, 7, 3);
+        checkPaddedFile<T, Layout::RowMajor>(13, 7, 5);
+#ifdef GEOMETRY_MMAP
+        checkCreate<T>(9, 4, Layout::ColumnMajor);
+        checkCreate<T>(9, 4, Layout::RowMajor);
+#endif
+        checkErrors<T>();
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<std::int32_t>();
+    checkType<std::uint8_t>();
+    checkType<std::int64_t>();
+    return check::report("file");
+}
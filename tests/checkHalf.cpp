@@ -0,0 +1,268 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Float16 and BFloat16 against a reference that knows nothing of the
+library: every bit pattern decoded by hand, and values rounded to the
+nearest pattern (ties to even) by a search over all of them. Scalar
+constructors from float, double and 64-bit integers, the SIMD convert
+loops (odd lengths for the tails), including the values just past a
+half-way point that rounding twice gets wrong, then the matrix paths:
+sums that would overflow 16 bits, element-wise operations and gemm.
+*/
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixHalf.hpp"
+#include "matrixProduct.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    // Layout of a 16-bit format: exponent bias and mantissa bits.
+    struct Format
+    {
+        int mantissaBits;
+        int bias;
+        std::uint16_t infinity; // first pattern past the largest finite value
+    };
+    constexpr Format binary16{10, 15, 0x7c00};
+    constexpr Format bfloat16{7, 127, 0x7f80};
+
+    template<class T>
+    constexpr Format formatOf() {return std::is_same_v<T, Float16> ? binary16 : bfloat16;}
+
+    // Value of a pattern, infinity read as the largest value plus one ulp.
+    double decode(const Format& format, std::uint16_t bits)
+    {
+        const int exponentMask = (0x7fff >> format.mantissaBits);
+        const int exponent = (bits >> format.mantissaBits) & exponentMask;
+        const int mantissa = bits & ((1 << format.mantissaBits) - 1);
+        const double sign = (bits & 0x8000) ? -1.0 : 1.0;
+        if(exponent == 0)
+            return sign*std::ldexp(mantissa, 1 - format.bias - format.mantissaBits);
+        if((exponent == exponentMask) && (mantissa != 0))
+            return std::numeric_limits<double>::quiet_NaN();
+        return sign*std::ldexp(mantissa + (1 << format.mantissaBits), exponent - format.bias - format.mantissaBits);
+    }
+
+    // Nearest pattern, ties to the even one; overflow to infinity.
+    std::uint16_t encode(const Format& format, long double value)
+    {
+        if(std::isnan(value))
+            return static_cast<std::uint16_t>(format.infinity | 0x200 >> (10 - format.mantissaBits));
+        const std::uint16_t sign = std::signbit(value) ? 0x8000 : 0;
+        const long double magnitude = std::abs(value);
+        // Positive patterns grow with their value: binary search.
+        std::uint16_t low = 0, high = format.infinity;
+        if(magnitude >= decode(format, high))
+            return static_cast<std::uint16_t>(sign | high);
+        while(high - low > 1)
+        {
+            const std::uint16_t middle = static_cast<std::uint16_t>((low + high)/2);
+            ((decode(format, middle) <= magnitude) ? low : high) = middle;
+        }
+        const long double below = magnitude - decode(format, low), above = decode(format, high) - magnitude;
+        const std::uint16_t nearest = (below < above) ? low : (above < below) ? high : ((low & 1) ? high : low);
+        return static_cast<std::uint16_t>(sign | nearest);
+    }
+
+    template<class T>
+    bool sameBits(T value, std::uint16_t expected)
+    {
+        if((expected & 0x7fff) > formatOf<T>().infinity) // NaN: any NaN
+            return std::isnan(static_cast<float>(value));
+        return value.bits() == expected;
+    }
+
+    // Values around every half-way point of a range of patterns, nudged by
+    // amounts float cannot hold, plus integers and extremes.
+    template<class T>
+    std::vector<double> hardValues()
+    {
+        const Format format = formatOf<T>();
+        std::vector<double> out = {0.0, -0.0, 1e-300, -1e300, std::numeric_limits<double>::infinity(),
+                                   std::numeric_limits<double>::quiet_NaN(), 65504.0, 65519.99, 65520.0,
+                                   3.3895313892515355e38, 3.40e38};
+        for(std::uint32_t bits=0; bits<format.infinity; bits+=7)
+        {
+            const double low = decode(format, static_cast<std::uint16_t>(bits));
+            const double high = decode(format, static_cast<std::uint16_t>(bits + 1));
+            const double middle = (low + high)/2;
+            const double ulp = high - low;
+            for(double nudge: {0.0, std::ldexp(ulp, -30), -std::ldexp(ulp, -30), std::ldexp(ulp, -3)})
+            {
+                out.push_back(middle + nudge);
+                out.push_back(-(middle + nudge));
+            }
+        }
+        return out;
+    }
+
+    template<class T>
+    void checkScalar(const std::string& name)
+    {
+        const Format format = formatOf<T>();
+        bool decoded = true, roundTrip = true;
+        for(std::uint32_t bits=0; bits<=0xffff; bits++)
+        {
+            const float value = static_cast<float>(T::fromBits(static_cast<std::uint16_t>(bits)));
+            const double expected = decode(format, static_cast<std::uint16_t>(bits));
+            if((bits & 0x7fff) == format.infinity)
+                decoded &= std::isinf(value) && ((value < 0) == ((bits & 0x8000) != 0));
+            else if(std::isnan(expected))
+                decoded &= std::isnan(value);
+            else
+            {
+                decoded &= (static_cast<double>(value) == expected);
+                roundTrip &= (T(value).bits() == bits);
+            }
+        }
+        check::expect(decoded, name + " decoding of every pattern");
+        check::expect(roundTrip, name + " round trip of every finite pattern");
+
+        std::size_t wrongFloat = 0, wrongDouble = 0;
+        for(double value: hardValues<T>())
+        {
+            wrongDouble += !sameBits(T(value), encode(format, value));
+            const float single = static_cast<float>(value);
+            wrongFloat += !sameBits(T(single), encode(format, single));
+        }
+        check::expect(wrongFloat == 0, name + " from float: " + std::to_string(wrongFloat) + " wrong");
+        check::expect(wrongDouble == 0, name + " from double: " + std::to_string(wrongDouble) + " wrong");
+
+        // 64-bit integers rounded once: 2^k + 2^(k-m-1) + 1 sits just above
+        // a half-way point.
+        std::size_t wrongInteger = 0;
+        for(int k=format.mantissaBits + 2; k<63; k++)
+            for(std::int64_t offset: {std::int64_t{0}, std::int64_t{1}, std::int64_t{-1}})
+            {
+                const std::int64_t value = (std::int64_t{1} << k) + (std::int64_t{1} << (k - format.mantissaBits - 1))
+                                           + offset;
+                wrongInteger += !sameBits(T(value), encode(format, static_cast<long double>(value)));
+                wrongInteger += !sameBits(T(-value), encode(format, -static_cast<long double>(value)));
+                const std::uint64_t unsignedValue = std::uint64_t(value) << 1;
+                wrongInteger += !sameBits(T(unsignedValue), encode(format, static_cast<long double>(unsignedValue)));
+            }
+        check::expect(wrongInteger == 0, name + " from 64-bit integers: " + std::to_string(wrongInteger) + " wrong");
+    }
+
+    template<class T, typename From>
+    void checkConvert(const std::string& name, const std::vector<From>& values)
+    {
+        const Format format = formatOf<T>();
+        for(std::size_t n: {values.size(), values.size() - 7, std::size_t{3}})
+        {
+            std::vector<T> out(n);
+            utils::convert(n, values.data(), out.data());
+            std::size_t wrong = 0;
+            for(std::size_t i=0; i<n; i++)
+                wrong += !sameBits(out[i], encode(format, static_cast<long double>(values[i])));
+            check::expect(wrong == 0, name + " convert " + std::to_string(n) + ": " + std::to_string(wrong) + " wrong");
+        }
+        std::vector<T> encoded(values.size());
+        utils::convert(values.size(), values.data(), encoded.data());
+        std::vector<float> back(values.size());
+        utils::convert(values.size(), encoded.data(), back.data());
+        bool exact = true;
+        for(std::size_t i=0; i<values.size(); i++)
+            exact &= (back[i] == static_cast<float>(encoded[i])) || std::isnan(back[i]);
+        check::expect(exact, name + " convert back to float");
+    }
+
+    template<class T>
+    void checkMatrix(const std::string& name)
+    {
+        // A million ones: 16 bits would stop at 2048 (Float16) or 256
+        // (BFloat16), or overflow.
+        Matrix<T> ones(1000, 1000);
+        ones.setValues(std::vector<T>(1000000, T(1)));
+        check::expect(ones.sum() == 1e6f, name + " sum of ones");
+        check::expect(ones.sum(utils::Summation::Kahan) == 1e6f, name + " compensated sum of ones");
+        check::expect(ones.mean() == 1.0f, name + " mean of ones");
+        check::expect(ones.norm() == 1000.0f, name + " L2 norm of ones");
+        check::expect((ones.norm(Norm::L1) == 1000.0f) && (ones.norm(Norm::Linf) == 1000.0f),
+                      name + " L1 / Linf norms of ones");
+
+        // Element-wise: computed in float, rounded once.
+        const std::size_t line = 37, col = 29;
+        Matrix<T> a(line, col), b(line, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+            {
+                a(i, j) = T(check::value(i*col + j)*4);
+                b(i, j) = T(check::value(i*col + j + 5000) + 1.5);
+            }
+        const Matrix<T> sum = a + b, quotient = a / b;
+        bool elementWise = true;
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                elementWise &= (sum(i, j).bits() == T(float(a(i, j)) + float(b(i, j))).bits())
+                               && (quotient(i, j).bits() == T(float(a(i, j)) / float(b(i, j))).bits());
+        check::expect(elementWise, name + " element-wise operations");
+
+        // gemm accumulates in float: within one rounding of the exact value.
+        const std::size_t k = 300;
+        Matrix<T> x(line, k), y(k, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t p=0; p<k; p++)
+                x(i, p) = T(check::value(i*k + p));
+        for(std::size_t p=0; p<k; p++)
+            for(std::size_t j=0; j<col; j++)
+                y(p, j) = T(check::value(p*col + j + 77));
+        const Matrix<T> product = matmul(x, y);
+        const double unit = std::ldexp(1.0, -formatOf<T>().mantissaBits);
+        bool close = true;
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+            {
+                double exact = 0;
+                for(std::size_t p=0; p<k; p++)
+                    exact += static_cast<double>(float(x(i, p)))*static_cast<double>(float(y(p, j)));
+                close &= (std::abs(static_cast<double>(float(product(i, j))) - exact)
+                          <= unit*std::abs(exact) + 1e-4*k);
+            }
+        check::expect(close, name + " gemm");
+    }
+
+    template<class T>
+    void checkType(const std::string& name)
+    {
+        checkScalar<T>(name);
+        const std::vector<double> doubles = hardValues<T>();
+        std::vector<float> floats(doubles.size());
+        std::transform(doubles.begin(), doubles.end(), floats.begin(), [](double v){return static_cast<float>(v);});
+        std::vector<std::int32_t> ints(1001);
+        std::vector<std::int64_t> longs(1001);
+        for(std::size_t i=0; i<ints.size(); i++)
+        {
+            ints[i] = static_cast<std::int32_t>(check::value(i)*2e9);
+            longs[i] = static_cast<std::int64_t>(check::value(i + 7)*9e18);
+        }
+        checkConvert<T>(name + " double", doubles);
+        checkConvert<T>(name + " float", floats);
+        checkConvert<T>(name + " int32", ints);
+        checkConvert<T>(name + " int64", longs);
+        checkMatrix<T>(name);
+    }
+
+}
+
+int main()
+{
+    checkType<Float16>("Float16");
+    checkType<BFloat16>("BFloat16");
+    return check::report("half");
+}
@@ -0,0 +1,188 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Row-major matrices against the same values in a column-major one: brace
+initializers, at(), setValues() and the iterators in storage order,
+explicit conversions both ways (padded or not, shapes around the transpose
+tiles), expressions and compound operators mixing layouts, the aliasing
+cases, views and getLine() / getColumn(), padding and transposeInPlace.
+*/
+
+// STANDARD INCLUDES
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixOperations.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    template<typename T>
+    T element(std::size_t i, std::size_t j)
+    {
+        return static_cast<T>(i*131 + j*7 + 1);
+    }
+
+    template<typename T, Layout Order>
+    using M = Matrix<T, utils::AlignedAllocator<T>, Order>;
+
+    template<typename T, Layout Order>
+    M<T, Order> reference(std::size_t line, std::size_t col, bool padded = false)
+    {
+        M<T, Order> out = padded ? M<T, Order>::padded(line, col) : M<T, Order>(line, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                out.view()(i, j) = element<T>(i, j);
+        return out;
+    }
+
+    template<class Mat, class Expected>
+    bool matches(const Mat& m, std::size_t line, std::size_t col, Expected expected)
+    {
+        if((m.nLines() != line) || (m.nColumns() != col))
+            return false;
+        const auto view = m.view();
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                if(!(view(i, j) == expected(i, j)))
+                    return false;
+        return true;
+    }
+
+    template<typename T>
+    auto same() {return [](std::size_t i, std::size_t j){return element<T>(i, j);};}
+
+    template<typename T>
+    void checkStorageOrder()
+    {
+        const RowMatrix<T> r(2, 3, {1, 2, 3,
+                                    4, 5, 6});
+        const Matrix<T> c(2, 3, {1, 4,
+                                 2, 5,
+                                 3, 6});
+        const auto values = [](std::size_t i, std::size_t j){return T(1 + 3*i + j);};
+        check::expect(matches(r, 2, 3, values) && matches(c, 2, 3, values), "brace initializers");
+
+        bool ok = true;
+        for(std::size_t k=0; k<6; k++)
+            ok &= (r.at(k) == T(k + 1));
+        std::vector<T> iterated(r.cbegin(), r.cend());
+        ok &= (iterated == std::vector<T>{1, 2, 3, 4, 5, 6});
+        RowMatrix<T> s(2, 3);
+        s.setValues({1, 2, 3, 4, 5, 6});
+        ok &= matches(s, 2, 3, values);
+        ok &= (r.getLine(1) == std::vector<T>{4, 5, 6}) && (r.getColumn(2) == std::vector<T>{3, 6});
+        check::expect(ok, "at, iterators, setValues, getLine and getColumn in storage order");
+
+        static_assert(!std::is_convertible_v<Matrix<T>, RowMatrix<T>>, "layout conversions are explicit");
+        static_assert(!std::is_convertible_v<RowMatrix<T>, Matrix<T>>, "layout conversions are explicit");
+    }
+
+    template<typename T>
+    void checkShape(std::size_t line, std::size_t col)
+    {
+        constexpr Layout Col = Layout::ColumnMajor, Row = Layout::RowMajor;
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col);
+        const M<T, Col> c = reference<T, Col>(line, col);
+        const M<T, Row> r = reference<T, Row>(line, col);
+
+        // Explicit conversions, padded or not on either side.
+        const M<T, Row> toRow(c);
+        const M<T, Col> toCol(r);
+        const M<T, Row> fromPadded(reference<T, Col>(line, col, true));
+        M<T, Col> intoPadded = M<T, Col>::padded(line, col);
+        intoPadded = M<T, Col>(reference<T, Row>(line, col, true));
+        check::expect(matches(toRow, line, col, same<T>()) && matches(toCol, line, col, same<T>())
+                      && matches(fromPadded, line, col, same<T>()) && matches(intoPadded, line, col, same<T>()),
+                      "conversions " + shape);
+
+        // Expressions mixing layouts, evaluated into either layout.
+        const auto sum = [](std::size_t i, std::size_t j){return T(element<T>(i, j)*T(3));};
+        const M<T, Row> rowSum = r + c*T(2);
+        const M<T, Col> colSum = r*T(2) + c;
+        check::expect(matches(rowSum, line, col, sum) && matches(colSum, line, col, sum),
+                      "mixed expressions " + shape);
+        const M<T, Row> rowT = transpose(c) - transpose(r);
+        check::expect(matches(rowT, col, line, [](std::size_t, std::size_t){return T(0);}),
+                      "transposes of both layouts " + shape);
+
+        M<T, Row> compound = r;
+        compound += c;
+        compound *= T(2);
+        compound -= r;
+        check::expect(matches(compound, line, col, sum), "compound operators " + shape);
+        M<T, Row> padded = reference<T, Row>(line, col, true);
+        padded += c;
+        padded += r;
+        padded -= reference<T, Row>(line, col, true)*T(0);
+        check::expect(matches(padded, line, col, sum), "compound operators on a padded matrix " + shape);
+
+        // Aliasing with a row-major destination.
+        M<T, Row> x = r;
+        x = transpose(x);
+        check::expect(matches(x, col, line, [](std::size_t i, std::size_t j){return element<T>(j, i);}),
+                      "x = transpose(x) " + shape);
+        x = r;
+        x = x*x - r*r;
+        check::expect(matches(x, line, col, [](std::size_t, std::size_t){return T(0);}), "x = x*x " + shape);
+        if(line == col)
+        {
+            x = r;
+            x += transpose(x);
+            check::expect(matches(x, line, col, [](std::size_t i, std::size_t j){
+                return T(element<T>(i, j) + element<T>(j, i));
+            }), "x += transpose(x) " + shape);
+        }
+
+        // Views of a row-major matrix are (lead, 1)-strided.
+        M<T, Row> w = reference<T, Row>(line, col, true);
+        w.row(line - 1) = r.row(0);
+        w.column(0) += c.column(col - 1);
+        check::expect(matches(w, line, col, [&](std::size_t i, std::size_t j){
+            const T value = (i == line - 1) ? element<T>(0, j) : element<T>(i, j);
+            return (j == 0) ? T(value + element<T>(i, col - 1)) : value;
+        }), "writes through views " + shape);
+
+        M<T, Row> t = reference<T, Row>(line, col);
+        t.transposeInPlace();
+        M<T, Row> tp = reference<T, Row>(line, col, true);
+        tp.transposeInPlace();
+        check::expect(matches(t, col, line, [](std::size_t i, std::size_t j){return element<T>(j, i);})
+                      && matches(tp, col, line, [](std::size_t i, std::size_t j){return element<T>(j, i);}),
+                      "transposeInPlace " + shape);
+
+        M<T, Row> lead = reference<T, Row>(line, col);
+        lead.setLeadingDimension(col + 5);
+        const bool padding = (lead.leadingDimension() == col + 5);
+        lead.setLeadingDimension(col);
+        check::expect(padding && lead.isContiguous() && matches(lead, line, col, same<T>()),
+                      "setLeadingDimension " + shape);
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        checkStorageOrder<T>();
+        for(std::size_t line: {1, 2, 7, 8, 9, 33})
+            for(std::size_t col: {1, 3, 8, 17, 64})
+                checkShape<T>(line, col);
+        checkShape<T>(40, 40);
+        checkShape<T>(257, 129);
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<int>();
+    return check::report("layout");
+}
@@ -0,0 +1,238 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Moves and buffer recycling, watched through the global operator new:
+moves steal the buffer and leave a (0,0) matrix, copy assignment keeps the
+capacity, the operators on expiring matrices write into the buffer of the
+expiring operand (also when the other operand reads it through a
+transpose), and a steady-state arithmetic loop allocates nothing.
+*/
+
+// STANDARD INCLUDES
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixOperations.hpp"
+
+using namespace geometry;
+
+// Every allocation of the program goes through these. Not inlined: GCC
+// would then pair malloc() with operator delete, or operator new with free().
+std::atomic<std::size_t> allocations{0};
+
+__attribute__((noinline)) void* operator new(std::size_t size)
+{
+    allocations++;
+    if(void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations++;
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if(void* p = std::aligned_alloc(align, (size + align - 1)/align*align))
+        return p;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {std::free(p);}
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept {std::free(p);}
+__attribute__((noinline)) void operator delete(void* p, std::align_val_t) noexcept {std::free(p);}
+__attribute__((noinline)) void operator delete(void* p, std::size_t, std::align_val_t) noexcept {std::free(p);}
+
+namespace {
+
+    template<typename T>
+    Matrix<T> filled(std::size_t line, std::size_t col, std::size_t seed)
+    {
+        std::vector<T> values(line*col);
+        for(std::size_t k=0; k<values.size(); k++)
+            values[k] = static_cast<T>(check::value(seed + k)*8);
+        Matrix<T> out(line, col);
+        out.setValues(values);
+        return out;
+    }
+
+    template<typename T>
+    T at(const Matrix<T>& m, std::size_t line, std::size_t col)
+    {
+        return m.at(line + col*m.nLines());
+    }
+
+    template<typename T, class Reference>
+    bool matches(const Matrix<T>& m, std::size_t line, std::size_t col, Reference reference)
+    {
+        if((m.nLines() != line) || (m.nColumns() != col))
+            return false;
+        for(std::size_t j=0; j<col; j++)
+            for(std::size_t i=0; i<line; i++)
+                if(!check::close(static_cast<double>(at(m, i, j)), static_cast<double>(reference(i, j)), 1e-6))
+                    return false;
+        return true;
+    }
+
+    template<typename T>
+    void checkMoves(std::size_t line, std::size_t col)
+    {
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col);
+        const Matrix<T> ref = filled<T>(line, col, 1);
+        auto same = [&](std::size_t i, std::size_t j){return at(ref, i, j);};
+
+        Matrix<T> a = ref;
+        const T* buffer = a.data();
+        std::size_t before = allocations;
+        Matrix<T> b(std::move(a));
+        bool none = (allocations == before); // before the message is built
+        check::expect(none && (b.data() == buffer) && matches(b, line, col, same)
+                      && (a.nLines() == 0) && (a.nColumns() == 0) && (a.length() == 0),
+                      "move constructor " + shape);
+
+        Matrix<T> c(1, 1);
+        before = allocations;
+        c = std::move(b);
+        none = (allocations == before);
+        check::expect(none && (c.data() == buffer) && matches(c, line, col, same),
+                      "move assignment " + shape);
+
+        // A moved-from matrix is usable again.
+        a = ref;
+        check::expect(matches(a, line, col, same), "assignment to a moved-from matrix " + shape);
+
+        Matrix<T> d = filled<T>(line, col, 2);
+        buffer = d.data();
+        before = allocations;
+        d = ref;
+        none = (allocations == before);
+        check::expect(none && (d.data() == buffer) && matches(d, line, col, same),
+                      "copy assignment keeps the buffer " + shape);
+
+        Matrix<T> e(ref);
+        check::expect((e.data() != ref.data()) && matches(e, line, col, same), "copy constructor " + shape);
+    }
+
+    template<typename T>
+    void checkRecycling(std::size_t line, std::size_t col)
+    {
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col);
+        const Matrix<T> x = filled<T>(line, col, 3), y = filled<T>(line, col, 4);
+
+        Matrix<T> a = x;
+        const T* buffer = a.data();
+        Matrix<T> r = std::move(a) + y*T(2);
+        check::expect((r.data() == buffer) && matches(r, line, col, [&](std::size_t i, std::size_t j){
+            return T(at(x, i, j) + T(at(y, i, j)*T(2)));
+        }), "Matrix&& + expression " + shape);
+
+        Matrix<T> b = y;
+        buffer = b.data();
+        r = x*T(3) - std::move(b);
+        check::expect((r.data() == buffer) && matches(r, line, col, [&](std::size_t i, std::size_t j){
+            return T(T(at(x, i, j)*T(3)) - at(y, i, j));
+        }), "expression - Matrix&& " + shape);
+
+        a = x;
+        b = y;
+        buffer = a.data();
+        r = std::move(a)*std::move(b);
+        check::expect((r.data() == buffer) && matches(r, line, col, [&](std::size_t i, std::size_t j){
+            return T(at(x, i, j)*at(y, i, j));
+        }), "Matrix&& * Matrix&& " + shape);
+
+        a = x;
+        buffer = a.data();
+        r = T(1) - std::move(a)*T(2);
+        check::expect((r.data() == buffer) && matches(r, line, col, [&](std::size_t i, std::size_t j){
+            return T(T(1) - T(at(x, i, j)*T(2)));
+        }), "1 - Matrix&& * 2 " + shape);
+
+        // The recycled buffer is also read at other coordinates.
+        if(line == col)
+        {
+            a = x;
+            a = std::move(a) + transpose(a);
+            check::expect(matches(a, line, col, [&](std::size_t i, std::size_t j){
+                return T(at(x, i, j) + at(x, j, i));
+            }), "a = Matrix&& + transpose(a) " + shape);
+            b = y;
+            b = transpose(b) - std::move(b);
+            check::expect(matches(b, line, col, [&](std::size_t i, std::size_t j){
+                return T(at(y, j, i) - at(y, i, j));
+            }), "b = transpose(b) - Matrix&& " + shape);
+        }
+    }
+
+    // z = x + y*2; z += x; x = std::move(x) + y; y = z; once warm, nothing
+    // allocates.
+    template<typename T>
+    void checkSteadyState(std::size_t line, std::size_t col)
+    {
+        Matrix<T> x = filled<T>(line, col, 5), y = filled<T>(line, col, 6), z;
+        const Matrix<T> x0 = x, y0 = y;
+        std::size_t during = 0;
+        for(std::size_t step=0; step<10; step++)
+        {
+            const std::size_t before = allocations;
+            z = x + y*T(2);
+            z += x;
+            x = std::move(x) + y;
+            y = z;
+            x *= T(0.5);
+            if(step > 0)
+                during += allocations - before;
+        }
+        check::expect(during == 0, "steady-state loop " + std::to_string(line) + "x" + std::to_string(col)
+                                   + ": " + std::to_string(during) + " allocations");
+
+        // Same loop on plain values.
+        std::vector<double> xs(line*col), ys(line*col);
+        for(std::size_t k=0; k<xs.size(); k++)
+        {
+            xs[k] = static_cast<double>(x0.at(k));
+            ys[k] = static_cast<double>(y0.at(k));
+        }
+        for(std::size_t step=0; step<10; step++)
+            for(std::size_t k=0; k<xs.size(); k++)
+            {
+                const double zk = xs[k] + ys[k]*2 + xs[k];
+                xs[k] = (xs[k] + ys[k])*0.5;
+                ys[k] = zk;
+            }
+        bool ok = true;
+        for(std::size_t k=0; k<xs.size(); k++)
+            ok &= check::close(static_cast<double>(x.at(k)), xs[k], 1e-6)
+                  && check::close(static_cast<double>(y.at(k)), ys[k], 1e-6);
+        check::expect(ok, "steady-state loop values");
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t line: {1, 3, 17, 64})
+            for(std::size_t col: {1, 3, 40})
+            {
+                checkMoves<T>(line, col);
+                checkRecycling<T>(line, col);
+            }
+        checkRecycling<T>(17, 17);
+        checkSteadyState<T>(33, 65);
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    return check::report("move");
+}
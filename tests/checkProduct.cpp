@@ -0,0 +1,187 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+matmul and gemm against a naive triple loop: odd shapes around the
+micro-kernel tiles and the cache blocks, every mix of layouts, padded
+matrices, strided views, alpha / beta, for int, float and double, on the
+calling thread and on a thread pool.
+*/
+
+// STANDARD INCLUDES
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixParallel.hpp"
+#include "matrixProduct.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    template<typename T>
+    double tolerance()
+    {
+        return std::is_integral_v<T> ? 0.0 : std::is_same_v<T, float> ? 1e-4 : 1e-12;
+    }
+
+    template<typename T, Layout Order>
+    Matrix<T, utils::AlignedAllocator<T, 64>, Order> filled(std::size_t line, std::size_t col,
+                                                          std::size_t seed, bool padded = false)
+    {
+        using M = Matrix<T, utils::AlignedAllocator<T, 64>, Order>;
+        M out = padded ? M::padded(line, col) : M(line, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                out(i, j) = std::is_integral_v<T> ? static_cast<T>(check::value(seed + i*col + j)*8)
+                                                  : static_cast<T>(check::value(seed + i*col + j));
+        return out;
+    }
+
+    // alpha*A.B + beta*C in double.
+    template<class A, class B, class C>
+    std::vector<double> reference(double alpha, const A& a, const B& b, double beta, const C& c)
+    {
+        std::vector<double> out(a.nLines()*b.nColumns());
+        for(std::size_t i=0; i<a.nLines(); i++)
+            for(std::size_t j=0; j<b.nColumns(); j++)
+            {
+                double sum = 0;
+                for(std::size_t p=0; p<a.nColumns(); p++)
+                    sum += static_cast<double>(a(i, p))*static_cast<double>(b(p, j));
+                out[i + j*a.nLines()] = alpha*sum + ((beta == 0) ? 0.0 : beta*static_cast<double>(c(i, j)));
+            }
+        return out;
+    }
+
+    template<typename T, class C>
+    bool matches(const C& c, const std::vector<double>& expected, double scale)
+    {
+        for(std::size_t i=0; i<c.nLines(); i++)
+            for(std::size_t j=0; j<c.nColumns(); j++)
+                if(!check::close(static_cast<double>(c(i, j)), expected[i + j*c.nLines()], tolerance<T>()*scale))
+                    return false;
+        return true;
+    }
+
+    template<typename T, Layout OrderA, Layout OrderB, Layout OrderC>
+    void checkShape(std::size_t m, std::size_t n, std::size_t k, bool padded)
+    {
+        const std::string shape = std::to_string(m) + "x" + std::to_string(n) + "x" + std::to_string(k)
+                                  + " layouts " + std::to_string(int(OrderA)) + std::to_string(int(OrderB))
+                                  + std::to_string(int(OrderC)) + (padded ? " padded" : "");
+        const auto a = filled<T, OrderA>(m, k, 1, padded);
+        const auto b = filled<T, OrderB>(k, n, 2, padded);
+        const double scale = static_cast<double>(k + 1);
+
+        const auto product = matmul(a, b);
+        check::expect((product.nLines() == m) && (product.nColumns() == n)
+                      && matches<T>(product, reference(1, a, b, 0, product), scale), "matmul " + shape);
+
+        // beta == 0 ignores C, even NaN.
+        auto c = filled<T, OrderC>(m, n, 3, padded);
+        if constexpr (std::is_floating_point_v<T>)
+            if(m*n > 0)
+                c(0, 0) = std::numeric_limits<T>::quiet_NaN();
+        gemm(T(2), a, b, T(0), c);
+        check::expect(matches<T>(c, reference(2, a, b, 0, c), scale), "gemm beta=0 " + shape);
+
+        auto d = filled<T, OrderC>(m, n, 4, padded);
+        const std::vector<double> expected = reference(-1, a, b, 3, d);
+        gemm(T(-1), a, b, T(3), d);
+        check::expect(matches<T>(d, expected, scale), "gemm beta=3 " + shape);
+    }
+
+    template<typename T>
+    void checkLayouts(std::size_t m, std::size_t n, std::size_t k)
+    {
+        constexpr Layout Col = Layout::ColumnMajor, Row = Layout::RowMajor;
+        checkShape<T, Col, Col, Col>(m, n, k, false);
+        checkShape<T, Col, Row, Col>(m, n, k, false);
+        checkShape<T, Row, Col, Col>(m, n, k, false);
+        checkShape<T, Row, Row, Col>(m, n, k, false);
+        checkShape<T, Col, Col, Row>(m, n, k, false);
+        checkShape<T, Col, Row, Row>(m, n, k, false);
+        checkShape<T, Row, Col, Row>(m, n, k, false);
+        checkShape<T, Row, Row, Row>(m, n, k, false);
+        checkShape<T, Col, Col, Col>(m, n, k, true);
+        checkShape<T, Row, Row, Row>(m, n, k, true);
+    }
+
+    // Sub-blocks and transposed views: strides the packing has to follow.
+    template<typename T>
+    void checkViews()
+    {
+        const auto a = filled<T, Layout::ColumnMajor>(41, 37, 5);
+        const auto b = filled<T, Layout::RowMajor>(39, 43, 6);
+        const ConstMatrixView<T> av = a.block(3, 2, 33, 27).transposed(); // 27 x 33
+        const ConstMatrixView<T> bv = b.block(1, 5, 33, 31);              // 33 x 31
+        auto c = filled<T, Layout::ColumnMajor>(40, 40, 7);
+        const MatrixView<T> cv = c.block(4, 6, 27, 31);
+        std::vector<double> expected = reference(2, av, bv, -1, cv);
+        const auto outside = c;
+        gemm(T(2), av, bv, T(-1), cv);
+        check::expect(matches<T>(cv, expected, 33), "gemm on views");
+        bool untouched = true;
+        for(std::size_t i=0; i<40; i++)
+            for(std::size_t j=0; j<40; j++)
+                if(((i < 4) || (i >= 31) || (j < 6) || (j >= 37)) && !(c(i, j) == outside(i, j)))
+                    untouched = false;
+        check::expect(untouched, "gemm on views writes outside the block");
+
+        const Matrix<T> product = matmul(av, bv);
+        check::expect(matches<T>(product, reference(1, av, bv, 0, product), 33), "matmul on views");
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        // Around the register tiles (up to 16 x 14) and past one cache block.
+        for(std::size_t m: {1, 2, 7, 15, 16, 17, 33})
+            for(std::size_t n: {1, 3, 13, 14, 29})
+                for(std::size_t k: {1, 5, 64})
+                    checkLayouts<T>(m, n, k);
+        checkLayouts<T>(0, 5, 3);
+        checkLayouts<T>(4, 6, 0);
+        checkLayouts<T>(131, 97, 301);
+        checkLayouts<T>(257, 41, 517);
+        checkViews<T>();
+
+        bool thrown = false;
+        try
+        {
+            Matrix<T> c(3, 3);
+            gemm(T(1), Matrix<T>(3, 4), Matrix<T>(5, 3), T(0), c);
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            thrown = true;
+        }
+        check::expect(thrown, "gemm shape mismatch");
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<int>();
+
+    // The same through a pool: the lines of C split across threads.
+    utils::ThreadPool pool(3);
+    utils::setExecutionBackend(&pool);
+    utils::setParallelThreshold(1);
+    checkLayouts<double>(131, 97, 301);
+    checkLayouts<float>(257, 41, 517);
+    checkLayouts<int>(67, 45, 33);
+    utils::setExecutionBackend(nullptr);
+
+    return check::report("product");
+}
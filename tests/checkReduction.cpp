@@ -0,0 +1,202 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Reductions against loops in long double: sums in every summation mode,
+means, min / max and their positions, the three norms, per-line and
+per-column reductions, any / all / isZero, on padded and row-major matrices
+and across a thread pool. Integer matrices sum in 64 bits and give their
+means and norms in double: no truncation, no overflow of the element type.
+*/
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixParallel.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    // Rounding errors of a sum of n terms grow like sqrt(n): felt in float.
+    template<typename T>
+    double tolerance(std::size_t n)
+    {
+        return std::is_integral_v<T> ? 1e-15 : std::is_same_v<T, float> ? 1e-4*std::max(1.0, std::sqrt(n*1e-4))
+                                                                        : 1e-12;
+    }
+
+    template<typename T>
+    T element(std::size_t i, std::size_t j)
+    {
+        return static_cast<T>(check::value(i*7919 + j*104729)*(std::is_integral_v<T> ? 100 : 8));
+    }
+
+    template<typename T, Layout Order>
+    using M = Matrix<T, utils::AlignedAllocator<T>, Order>;
+
+    template<typename T, Layout Order>
+    M<T, Order> reference(std::size_t line, std::size_t col, bool padded)
+    {
+        M<T, Order> out = padded ? M<T, Order>::padded(line, col) : M<T, Order>(line, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                out(i, j) = element<T>(i, j);
+        return out;
+    }
+
+    template<typename T, Layout Order>
+    void checkShape(std::size_t line, std::size_t col, bool padded)
+    {
+        const std::string name = std::to_string(line) + "x" + std::to_string(col) + " layout "
+                                 + std::to_string(int(Order)) + (padded ? " padded" : "");
+        const M<T, Order> m = reference<T, Order>(line, col, padded);
+
+        long double sum = 0, magnitude = 0, squares = 0, l1 = 0, linf = 0;
+        T low = element<T>(0, 0), high = low;
+        for(std::size_t i=0; i<line; i++)
+        {
+            long double lineSum = 0;
+            for(std::size_t j=0; j<col; j++)
+            {
+                const long double v = element<T>(i, j);
+                sum += v;
+                magnitude += std::abs(v);
+                squares += v*v;
+                lineSum += std::abs(v);
+                low = std::min(low, element<T>(i, j));
+                high = std::max(high, element<T>(i, j));
+            }
+            linf = std::max(linf, lineSum);
+        }
+        for(std::size_t j=0; j<col; j++)
+        {
+            long double columnSum = 0;
+            for(std::size_t i=0; i<line; i++)
+                columnSum += std::abs(static_cast<long double>(element<T>(i, j)));
+            l1 = std::max(l1, columnSum);
+        }
+
+        // Sums of signed terms are off by a fraction of the sum of their
+        // magnitudes, not of the sum itself.
+        const double tol = tolerance<T>(line*col);
+        const double sumTol = tol*(1 + static_cast<double>(magnitude))/(1 + std::abs(static_cast<double>(sum)));
+        const double meanTol = tol*(1 + static_cast<double>(magnitude/(line*col)))
+                               /(1 + std::abs(static_cast<double>(sum/(line*col))));
+        bool sums = true;
+        for(utils::Summation s: {utils::Summation::Fast, utils::Summation::Pairwise, utils::Summation::Kahan})
+            sums &= check::close(static_cast<double>(m.sum(s)), static_cast<double>(sum), sumTol)
+                    && check::close(static_cast<double>(m.mean(s)), static_cast<double>(sum/(line*col)), meanTol);
+        check::expect(sums, "sum and mean " + name);
+        check::expect((m.min() == low) && (m.max() == high), "min and max " + name);
+        const Coord lowAt = m.argMin(), highAt = m.argMax();
+        check::expect((m(lowAt[0], lowAt[1]) == low) && (m(highAt[0], highAt[1]) == high), "argMin and argMax " + name);
+        check::expect(check::close(static_cast<double>(m.norm()), std::sqrt(static_cast<double>(squares)), tol)
+                      && check::close(static_cast<double>(m.norm(Norm::L1)), static_cast<double>(l1), tol)
+                      && check::close(static_cast<double>(m.norm(Norm::Linf)), static_cast<double>(linf), tol),
+                      "norms " + name);
+
+        const M<T, Order> lines = m.template reduceLines<utils::ReduceOp::Max>();
+        const M<T, Order> columns = m.template reduceColumns<utils::ReduceOp::Sum>();
+        bool ok = (lines.nLines() == line) && (lines.nColumns() == 1)
+                  && (columns.nLines() == 1) && (columns.nColumns() == col);
+        for(std::size_t i=0; ok && (i<line); i++)
+        {
+            T value = element<T>(i, 0);
+            for(std::size_t j=1; j<col; j++)
+                value = std::max(value, element<T>(i, j));
+            ok &= (lines(i, 0) == value);
+        }
+        for(std::size_t j=0; ok && (j<col); j++)
+        {
+            long double value = 0, size = 0;
+            for(std::size_t i=0; i<line; i++)
+            {
+                value += element<T>(i, j);
+                size += std::abs(static_cast<long double>(element<T>(i, j)));
+            }
+            ok &= check::close(static_cast<double>(columns(0, j)), static_cast<double>(value),
+                               tol*(1 + static_cast<double>(size))/(1 + std::abs(static_cast<double>(value))));
+        }
+        check::expect(ok, "reduceLines and reduceColumns " + name);
+
+        check::expect(m.any([&](T v){return v == high;}) && !m.any([&](T v){return v > high;})
+                      && m.all([&](T v){return v >= low;}) && !m.isZero()
+                      && M<T, Order>(line, col).isZero(), "any, all and isZero " + name);
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t line: {1, 3, 17, 64, 301})
+            for(std::size_t col: {1, 5, 33})
+                for(bool padded: {false, true})
+                {
+                    checkShape<T, Layout::ColumnMajor>(line, col, padded);
+                    checkShape<T, Layout::RowMajor>(line, col, padded);
+                }
+        checkShape<T, Layout::ColumnMajor>(1500, 700, false);
+    }
+
+    // Integer reductions do not come back in the element type.
+    void checkIntegers()
+    {
+        const Matrix<int> small(1, 2, {1, 2});
+        static_assert(std::is_same_v<decltype(small.mean()), double>, "integer means are double");
+        static_assert(std::is_same_v<decltype(small.norm()), double>, "integer norms are double");
+        static_assert(std::is_same_v<decltype(small.sum()), std::int64_t>, "integer sums are 64 bits");
+        check::expect(small.mean() == 1.5, "mean of {1, 2}: " + std::to_string(small.mean()));
+        check::expect(check::close(small.norm(), std::sqrt(5.0), 1e-15), "norm of {1, 2}: " + std::to_string(small.norm()));
+
+        Matrix<unsigned char> bytes(20, 20);
+        bytes.view() = static_cast<unsigned char>(200);
+        check::expect(bytes.sum() == 80000u, "sum of 400 bytes of 200: " + std::to_string(bytes.sum()));
+        check::expect(bytes.norm() == 4000.0, "norm of 400 bytes of 200: " + std::to_string(bytes.norm()));
+        check::expect((bytes.norm(Norm::L1) == 4000.0) && (bytes.norm(Norm::Linf) == 4000.0),
+                      "L1 and Linf norms of 400 bytes of 200");
+        check::expect(bytes.mean() == 200.0, "mean of 400 bytes of 200");
+
+        // 2e9 is close to the int limit: a sum in int would overflow.
+        Matrix<int> large(300, 70);
+        large.view() = 2000000000;
+        const std::int64_t expected = std::int64_t{2000000000}*300*70;
+        check::expect(large.sum() == expected, "sum of 21000 ints of 2e9: " + std::to_string(large.sum()));
+        check::expect(large.mean() == 2e9, "mean of 21000 ints of 2e9");
+        check::expect(check::close(large.norm(), 2e9*std::sqrt(21000.0), 1e-12), "norm of 21000 ints of 2e9");
+        check::expect(large.norm(Norm::L1) == 2e9*300, "L1 norm of 21000 ints of 2e9");
+
+        Matrix<std::int16_t> negative(40, 40);
+        negative.view() = std::int16_t{-30000};
+        check::expect((negative.sum() == -30000*1600) && (negative.mean() == -30000.0)
+                      && (negative.norm(Norm::Linf) == 30000.0*40), "int16 sums and norms");
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<int>();
+    checkIntegers();
+
+    // Chunks and columns split across a pool.
+    utils::ThreadPool pool(3);
+    utils::setExecutionBackend(&pool);
+    utils::setParallelThreshold(1);
+    checkType<double>();
+    checkType<int>();
+    checkIntegers();
+    utils::setExecutionBackend(nullptr);
+
+    return check::report("reduction");
+}
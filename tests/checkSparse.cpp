@@ -0,0 +1,231 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Sparse matrices against the dense matrix they stand for: assembly from a
+coordinate list with duplicates, Csr <-> Csc conversion and transposes,
+spmv and the sparse-dense products in both layouts, with patterns that
+have empty lines and one dense line, on the calling thread and on a pool.
+*/
+
+// STANDARD INCLUDES
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixParallel.hpp"
+#include "sparseMatrix.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    template<typename T>
+    double tolerance()
+    {
+        return std::is_integral_v<T> ? 0.0 : std::is_same_v<T, float> ? 1e-5 : 1e-13;
+    }
+
+    template<typename T>
+    T entry(std::size_t seed)
+    {
+        return std::is_integral_v<T> ? static_cast<T>(check::value(seed)*16)
+                                     : static_cast<T>(check::value(seed));
+    }
+
+    // Coordinate list of about density*line*col entries (some repeated),
+    // line 1 dense, every third line empty, and the dense sum it stands for.
+    template<typename T>
+    CooMatrix<T> pattern(std::size_t line, std::size_t col, double density, Matrix<double>& dense)
+    {
+        CooMatrix<T> coo(line, col);
+        dense = Matrix<double>(line, col);
+        std::size_t seed = line*1000 + col;
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+            {
+                const bool kept = (i == 1) || (check::value(seed++) + 1 < 2*density);
+                if(!kept || ((i % 3 == 2) && (i != 1)))
+                    continue;
+                const std::size_t repeats = (check::value(seed++) > 0.8) ? 2 : 1;
+                for(std::size_t r=0; r<repeats; r++)
+                {
+                    const T value = entry<T>(seed++);
+                    coo.add(i, j, value);
+                    dense(i, j) += static_cast<double>(value);
+                }
+            }
+        return coo;
+    }
+
+    template<class M>
+    bool equalsDense(const M& m, const Matrix<double>& dense, double tolerance)
+    {
+        if((m.nLines() != dense.nLines()) || (m.nColumns() != dense.nColumns()))
+            return false;
+        for(std::size_t i=0; i<m.nLines(); i++)
+            for(std::size_t j=0; j<m.nColumns(); j++)
+                if(!check::close(static_cast<double>(m(i, j)), dense(i, j), tolerance))
+                    return false;
+        return true;
+    }
+
+    template<typename T, SparseFormat Format>
+    void checkProducts(const SparseMatrix<T, Format>& a, const Matrix<double>& dense, const std::string& name)
+    {
+        const std::size_t line = a.nLines(), col = a.nColumns();
+        const double scale = static_cast<double>(col + 1);
+
+        // spmv, beta == 0 ignores y even if it holds NaN.
+        std::vector<T> x(col), y(line), z(line);
+        for(std::size_t j=0; j<col; j++)
+            x[j] = entry<T>(7*j + 1);
+        for(std::size_t i=0; i<line; i++)
+        {
+            z[i] = entry<T>(5*i + 3);
+            if constexpr (std::is_floating_point_v<T>)
+                y[i] = std::numeric_limits<T>::quiet_NaN();
+        }
+        std::vector<double> ax(line);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                ax[i] += dense(i, j)*static_cast<double>(x[j]);
+        spmv(T(2), a, x.data(), T(0), y.data());
+        const std::vector<T> z0 = z;
+        spmv(T(-1), a, x.data(), T(3), z.data());
+        const std::vector<T> product = matmul(a, x);
+        bool ok = (product.size() == line);
+        for(std::size_t i=0; ok && (i<line); i++)
+            ok = check::close(static_cast<double>(y[i]), 2*ax[i], tolerance<T>()*scale)
+                 && check::close(static_cast<double>(z[i]), -ax[i] + 3*static_cast<double>(z0[i]), tolerance<T>()*scale)
+                 && check::close(static_cast<double>(product[i]), ax[i], tolerance<T>()*scale);
+        check::expect(ok, "spmv " + name);
+
+        // Sparse-dense products, B and C in both layouts.
+        const std::size_t n = 11;
+        Matrix<T> b(col, n);
+        RowMatrix<T> rb(col, n);
+        for(std::size_t p=0; p<col; p++)
+            for(std::size_t j=0; j<n; j++)
+                rb(p, j) = b(p, j) = entry<T>(p*n + j + 11);
+        Matrix<double> ab(line, n);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<n; j++)
+                for(std::size_t p=0; p<col; p++)
+                    ab(i, j) += dense(i, p)*static_cast<double>(b(p, j));
+        check::expect(equalsDense(matmul(a, b), ab, tolerance<T>()*scale), "matmul column-major " + name);
+        check::expect(equalsDense(matmul(a, rb), ab, tolerance<T>()*scale), "matmul row-major " + name);
+
+        Matrix<T> c(line, n);
+        RowMatrix<T> rc(line, n);
+        Matrix<double> expected(line, n);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<n; j++)
+            {
+                rc(i, j) = c(i, j) = entry<T>(i*n + j + 13);
+                expected(i, j) = 2*ab(i, j) - static_cast<double>(c(i, j));
+            }
+        gemm(T(2), a, b, T(-1), c);
+        gemm(T(2), a, rb, T(-1), rc);
+        check::expect(equalsDense(c, expected, tolerance<T>()*scale), "gemm column-major " + name);
+        check::expect(equalsDense(rc, expected, tolerance<T>()*scale), "gemm row-major " + name);
+    }
+
+    template<typename T>
+    void checkShape(std::size_t line, std::size_t col, double density)
+    {
+        const std::string name = std::to_string(line) + "x" + std::to_string(col)
+                                  + " density " + std::to_string(density);
+        Matrix<double> dense;
+        const CooMatrix<T> coo = pattern<T>(line, col, density, dense);
+        const CsrMatrix<T> csr(coo);
+        const CscMatrix<T> csc(csr);
+        const CsrMatrix<T> back(csc);
+
+        bool ok = (csr.offsets().size() == line + 1) && (csc.offsets().size() == col + 1)
+                  && (csr.nonZeros() == csc.nonZeros()) && (back.indices() == csr.indices());
+        for(std::size_t i=0; ok && (i<line); i++)
+            for(std::size_t k=csr.offsets()[i]; k+1<csr.offsets()[i+1]; k++)
+                ok = (csr.indices()[k] < csr.indices()[k+1]); // ascending, duplicates summed
+        check::expect(ok, "compressed arrays " + name);
+
+        bool at = true;
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                at &= check::close(static_cast<double>(csr.at(i, j)), dense(i, j), tolerance<T>())
+                      && check::close(static_cast<double>(csc.at(i, j)), dense(i, j), tolerance<T>());
+        check::expect(at, "at " + name);
+        check::expect(equalsDense(csr.toDense(), dense, tolerance<T>())
+                      && equalsDense(csc.template toDense<utils::AlignedAllocator<T>, Layout::RowMajor>(), dense,
+                                     tolerance<T>()), "toDense " + name);
+
+        Matrix<double> denseT(col, line);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                denseT(j, i) = dense(i, j);
+        check::expect(equalsDense(csr.transposed().toDense(), denseT, tolerance<T>())
+                      && equalsDense(CscMatrix<T>(csc).transposed().toDense(), denseT, tolerance<T>()),
+                      "transposed " + name);
+
+        checkProducts(csr, dense, "csr " + name);
+        checkProducts(csc, dense, "csc " + name);
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t line: {1, 2, 5, 17, 64})
+            for(std::size_t col: {1, 3, 16, 33})
+                for(double density: {0.0, 0.1, 0.5, 1.0})
+                    checkShape<T>(line, col, density);
+        checkShape<T>(300, 211, 0.05);
+
+        // Dense matrices round-trip through the sparse formats.
+        Matrix<T> dense(9, 7);
+        for(std::size_t i=0; i<9; i++)
+            for(std::size_t j=0; j<7; j++)
+                dense(i, j) = ((i + j) % 3 == 0) ? entry<T>(i*7 + j) : T(0);
+        const CscMatrix<T> fromDense(dense);
+        bool ok = true;
+        for(std::size_t i=0; i<9; i++)
+            for(std::size_t j=0; j<7; j++)
+                ok &= (fromDense.at(i, j) == dense(i, j));
+        check::expect(ok, "from dense");
+
+        bool thrown = false;
+        try
+        {
+            const CsrMatrix<T> a(3, 4);
+            matmul(a, std::vector<T>(5));
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            thrown = true;
+        }
+        check::expect(thrown, "spmv shape mismatch");
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<int>();
+
+    // Non-zeros split across a pool.
+    utils::ThreadPool pool(3);
+    utils::setExecutionBackend(&pool);
+    utils::setParallelThreshold(1);
+    checkShape<double>(300, 211, 0.05);
+    checkShape<float>(64, 33, 0.5);
+    checkShape<int>(17, 16, 1.0);
+    utils::setExecutionBackend(nullptr);
+
+    return check::report("sparse");
+}
@@ -0,0 +1,201 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Out-of-core matrices against the same values in memory: conversions both
+ways (row-major sources, edge tiles), element-wise operators with a matrix
+or a value, reductions, transpose and matmul, save / load through the
+matrix file format, tile size mismatches, and every operation again with a
+budget below one pipeline step.
+*/
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "tiledMatrix.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    template<typename T>
+    double tolerance()
+    {
+        return std::is_integral_v<T> ? 0.0 : std::is_same_v<T, float> ? 1e-4 : 1e-12;
+    }
+
+    template<typename T>
+    T element(std::size_t i, std::size_t j, std::size_t seed)
+    {
+        const double v = check::value(seed + i*7919 + j*104729)*(std::is_integral_v<T> ? 20 : 4);
+        return static_cast<T>(v);
+    }
+
+    template<typename T, Layout Order = Layout::ColumnMajor>
+    Matrix<T, utils::AlignedAllocator<T>, Order> reference(std::size_t line, std::size_t col, std::size_t seed)
+    {
+        Matrix<T, utils::AlignedAllocator<T>, Order> out(line, col);
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                out.view()(i, j) = element<T>(i, j, seed);
+        return out;
+    }
+
+    template<class V, class Expected>
+    bool matches(const V& view, std::size_t line, std::size_t col, Expected expected)
+    {
+        using T = std::decay_t<decltype(view(0, 0))>;
+        if((view.nLines() != line) || (view.nColumns() != col))
+            return false;
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+                if(!check::close(static_cast<double>(view(i, j)), static_cast<double>(expected(i, j)),
+                                 tolerance<T>()))
+                    return false;
+        return true;
+    }
+
+    template<typename T, class Expected>
+    bool matches(const TiledMatrix<T>& tiled, std::size_t line, std::size_t col, Expected expected)
+    {
+        return matches(tiled.toMatrix().view(), line, col, expected);
+    }
+
+    template<typename T>
+    void checkShape(std::size_t line, std::size_t col, std::size_t tile)
+    {
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col) + " tile "
+                                  + std::to_string(tile) + " budget " + std::to_string(utils::outOfCoreBudget());
+        const auto a = [](std::size_t i, std::size_t j){return element<T>(i, j, 1);};
+        const auto b = [](std::size_t i, std::size_t j){return element<T>(i, j, 2);};
+
+        const TiledMatrix<T> zero(line, col, tile);
+        check::expect(matches(zero, line, col, [](std::size_t, std::size_t){return T(0);})
+                      && (zero.nTiles() == ((line + tile - 1)/tile)*((col + tile - 1)/tile)),
+                      "zero matrix " + shape);
+        check::expect(matches(TiledMatrix<T>::fromMatrix(reference<T>(line, col, 1), tile), line, col, a)
+                      && matches(TiledMatrix<T>::fromMatrix(reference<T, Layout::RowMajor>(line, col, 1), tile),
+                                 line, col, a), "fromMatrix " + shape);
+        check::expect(matches(TiledMatrix<T>::fromMatrix(reference<T>(line, col, 1), tile).template
+                              toMatrix<utils::AlignedAllocator<T>, Layout::RowMajor>().view(), line, col, a),
+                      "toMatrix row-major " + shape);
+
+        // Element-wise operators, the divisor kept away from zero.
+        TiledMatrix<T> x = TiledMatrix<T>::fromMatrix(reference<T>(line, col, 1), tile);
+        const TiledMatrix<T> y = TiledMatrix<T>::fromMatrix(reference<T>(line, col, 2), tile);
+        x += y;
+        x *= T(2);
+        x -= y;
+        x *= y;
+        x += T(3);
+        check::expect(matches(x, line, col, [&](std::size_t i, std::size_t j){
+            return T(T(T(T(T(a(i, j) + b(i, j))*T(2)) - b(i, j))*b(i, j)) + T(3));
+        }), "element-wise operators " + shape);
+        TiledMatrix<T> d(line, col, tile);
+        d += T(4);
+        x /= d;
+        x -= T(1);
+        x /= T(2);
+        check::expect(matches(x, line, col, [&](std::size_t i, std::size_t j){
+            const T value = T(T(T(T(T(a(i, j) + b(i, j))*T(2)) - b(i, j))*b(i, j)) + T(3));
+            return T(T(T(value/T(4)) - T(1))/T(2));
+        }), "division " + shape);
+
+        // Reductions against the values in memory.
+        const Matrix<T> m = reference<T>(line, col, 1);
+        const TiledMatrix<T> tiled = TiledMatrix<T>::fromMatrix(m, tile);
+        double sum = 0, squares = 0;
+        T low = m.view()(0, 0), high = low;
+        for(std::size_t i=0; i<line; i++)
+            for(std::size_t j=0; j<col; j++)
+            {
+                const T v = m.view()(i, j);
+                sum += static_cast<double>(v);
+                squares += static_cast<double>(v)*static_cast<double>(v);
+                low = std::min(low, v);
+                high = std::max(high, v);
+            }
+        const double reductionTolerance = std::is_same_v<T, float> ? 1e-3 : 1e-9;
+        check::expect(check::close(static_cast<double>(tiled.sum()), sum, reductionTolerance)
+                      && check::close(static_cast<double>(tiled.norm()), std::sqrt(squares), reductionTolerance)
+                      && (tiled.min() == low) && (tiled.max() == high), "reductions " + shape);
+
+        check::expect(matches(transpose(tiled), col, line, [&](std::size_t i, std::size_t j){return a(j, i);}),
+                      "transpose " + shape);
+
+        // A (line x col) . B (col x 5).
+        const TiledMatrix<T> B = TiledMatrix<T>::fromMatrix(reference<T>(col, 5, 3), tile);
+        check::expect(matches(matmul(tiled, B), line, 5, [&](std::size_t i, std::size_t j){
+            double value = 0;
+            for(std::size_t k=0; k<col; k++)
+                value += static_cast<double>(a(i, k))*static_cast<double>(element<T>(k, j, 3));
+            return value;
+        }), "matmul " + shape);
+
+        // Matrix files, a tile size of their own on load.
+        const std::string file = (std::filesystem::temp_directory_path() / "geometry_check_tiled.mat").string();
+        tiled.save(file);
+        check::expect(matches(Matrix<T>::load(file).view(), line, col, a), "save " + shape);
+        check::expect(matches(TiledMatrix<T>::load(file, tile + 1), line, col, a), "load " + shape);
+        std::filesystem::remove(file);
+    }
+
+    // fn() throws Exeptions::SizeMismatch.
+    bool mismatch(const std::function<void()>& fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    template<typename T>
+    void checkErrors()
+    {
+        TiledMatrix<T> a(5, 5, 2);
+        const TiledMatrix<T> b(5, 5, 3), c(5, 4, 2);
+        check::expect(mismatch([&]{a += b;}), "different tile sizes");
+        check::expect(mismatch([&]{a -= c;}), "different shapes");
+        check::expect(mismatch([&]{matmul(c, a);}), "matmul shape mismatch");
+        check::expect(mismatch([]{TiledMatrix<T> none(5, 5, 0);}), "zero tile size");
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t budget: {std::size_t{1} << 30, std::size_t{1}})
+        {
+            utils::setOutOfCoreBudget(budget);
+            for(std::size_t line: {1, 7, 16, 37})
+                for(std::size_t col: {1, 8, 21})
+                    for(std::size_t tile: {1, 4, 8, 64})
+                        checkShape<T>(line, col, tile);
+        }
+        utils::setOutOfCoreBudget(std::size_t{1} << 30);
+        checkErrors<T>();
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<std::int32_t>();
+    return check::report("tiled");
+}
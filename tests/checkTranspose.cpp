@@ -0,0 +1,190 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Transposes against the index formula: out-of-place with leading
+dimensions and threads, square in place with a leading dimension,
+rectangular in place (every gcd case, lines longer than the scratch,
+scratch bounded and taken from the allocator), and Matrix::transposeInPlace
+with padding and both layouts.
+*/
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixOperations.hpp"
+#include "matrixParallel.hpp"
+#include "matrixTranspose.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    // Largest request seen, to check the scratch of the in-place transpose.
+    std::size_t largestAllocation = 0;
+
+    template<typename T>
+    struct CountingAllocator: std::allocator<T>
+    {
+        using value_type = T;
+        template<class U>
+        struct rebind {using other = CountingAllocator<U>;};
+
+        CountingAllocator() = default;
+        template<class U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(std::size_t n)
+        {
+            largestAllocation = std::max(largestAllocation, n);
+            return std::allocator<T>::allocate(n);
+        }
+    };
+
+    // Element (i, j) of a column-major buffer, distinct for every (i, j).
+    template<typename T>
+    T element(std::size_t i, std::size_t j)
+    {
+        return static_cast<T>(i*131 + j*7 + 1);
+    }
+
+    template<typename T>
+    void checkOutOfPlace(std::size_t rows, std::size_t cols, std::size_t nThreads)
+    {
+        const std::size_t ldSrc = rows + 3, ldDst = cols + 5;
+        std::vector<T> src(ldSrc*cols), dst(ldDst*rows, T(-1));
+        for(std::size_t j=0; j<cols; j++)
+            for(std::size_t i=0; i<rows; i++)
+                src[i + j*ldSrc] = element<T>(i, j);
+        utils::transpose(rows, cols, src.data(), ldSrc, dst.data(), ldDst, nThreads);
+        bool ok = true;
+        for(std::size_t i=0; i<rows; i++)
+            for(std::size_t j=0; j<ldDst; j++)
+                ok &= (dst[j + i*ldDst] == ((j < cols) ? element<T>(i, j) : T(-1)));
+        check::expect(ok, "transpose " + std::to_string(rows) + "x" + std::to_string(cols)
+                          + " threads " + std::to_string(nThreads));
+    }
+
+    template<typename T>
+    void checkSquare(std::size_t n)
+    {
+        const std::size_t ld = n + 2;
+        std::vector<T> data(ld*n);
+        for(std::size_t j=0; j<n; j++)
+            for(std::size_t i=0; i<ld; i++)
+                data[i + j*ld] = (i < n) ? element<T>(i, j) : T(-1);
+        utils::transposeSquareInPlace(n, data.data(), ld);
+        bool ok = true;
+        for(std::size_t j=0; j<n; j++)
+            for(std::size_t i=0; i<ld; i++)
+                ok &= (data[i + j*ld] == ((i < n) ? element<T>(j, i) : T(-1)));
+        check::expect(ok, "square in place " + std::to_string(n));
+    }
+
+    template<typename T>
+    void checkInPlace(std::size_t rows, std::size_t cols)
+    {
+        std::vector<T> data(rows*cols);
+        for(std::size_t j=0; j<cols; j++)
+            for(std::size_t i=0; i<rows; i++)
+                data[i + j*rows] = element<T>(i, j);
+        largestAllocation = 0;
+        utils::transposeInPlace(rows, cols, data.data(), CountingAllocator<T>());
+        bool ok = true;
+        for(std::size_t i=0; i<rows; i++)
+            for(std::size_t j=0; j<cols; j++)
+                ok &= (data[j + i*cols] == element<T>(i, j));
+        const std::string shape = std::to_string(rows) + "x" + std::to_string(cols);
+        check::expect(ok, "in place " + shape);
+        check::expect(largestAllocation <= utils::transposeScratch(rows, cols),
+                      "in place scratch " + shape + ": " + std::to_string(largestAllocation));
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t rows: {1, 2, 3, 4, 7, 8, 9, 16, 17, 31, 33, 64})
+            for(std::size_t cols: {1, 2, 5, 8, 12, 15, 16, 40, 63})
+            {
+                checkOutOfPlace<T>(rows, cols, 0);
+                checkInPlace<T>(rows, cols);
+            }
+        for(std::size_t n: {0, 1, 3, 8, 15, 16, 17, 64, 100})
+            checkSquare<T>(n);
+        // Long and thin, common gcd, and coprime shapes.
+        checkInPlace<T>(3, 20000);
+        checkInPlace<T>(20000, 3);
+        checkInPlace<T>(96, 360);
+        checkInPlace<T>(257, 129);
+        checkOutOfPlace<T>(517, 263, 0);
+        // Lines longer than the scratch, permuted along their cycles, and
+        // column groups narrowed to fit it.
+        checkInPlace<T>(3, 200003);
+        checkInPlace<T>(200003, 3);
+        checkInPlace<T>(4, 150000);
+        checkInPlace<T>(150000, 4);
+        checkInPlace<T>(40, 30000);
+    }
+
+    // A 3 x N matrix takes nowhere near a second copy.
+    void checkScratch()
+    {
+        const std::size_t n = 1000003;
+        std::vector<float> data(3*n);
+        largestAllocation = 0;
+        utils::transposeInPlace(3, n, data.data(), CountingAllocator<float>());
+        check::expect(largestAllocation <= 3*n/16, "3 x N scratch: " + std::to_string(largestAllocation));
+    }
+
+    template<Layout Order>
+    void checkMatrix(bool padded)
+    {
+        using M = Matrix<double, utils::AlignedAllocator<double, 64>, Order>;
+        M a = padded ? M::padded(37, 13) : M(37, 13);
+        for(std::size_t i=0; i<37; i++)
+            for(std::size_t j=0; j<13; j++)
+                a(i, j) = element<double>(i, j);
+        M b = a;
+        a.transposeInPlace();
+        b = transpose(b); // the expression path reading its destination
+        bool ok = (a.nLines() == 13) && (a.nColumns() == 37) && (b.nLines() == 13) && (b.nColumns() == 37);
+        for(std::size_t i=0; ok && (i<13); i++)
+            for(std::size_t j=0; j<37; j++)
+                ok &= (a(i, j) == element<double>(j, i)) && (b(i, j) == element<double>(j, i));
+        check::expect(ok, std::string("Matrix::transposeInPlace layout ") + std::to_string(int(Order))
+                          + (padded ? " padded" : ""));
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<std::int16_t>();
+    checkType<std::int8_t>();
+    checkScratch();
+    checkMatrix<Layout::ColumnMajor>(false);
+    checkMatrix<Layout::ColumnMajor>(true);
+    checkMatrix<Layout::RowMajor>(false);
+    checkMatrix<Layout::RowMajor>(true);
+
+    // Column tiles split across a pool, and capped.
+    utils::ThreadPool pool(3);
+    utils::setExecutionBackend(&pool);
+    utils::setParallelThreshold(1);
+    checkOutOfPlace<double>(517, 263, 0);
+    checkOutOfPlace<float>(300, 1000, 2);
+    checkInPlace<double>(96, 360);
+    utils::setExecutionBackend(nullptr);
+
+    return check::report("transpose");
+}
@@ -0,0 +1,239 @@
+/*
+Geometry library regression checks
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+
+Views against the index formula: row, column, block and transposed views
+and views of views, their iterators, getLine() / getColumn(), writes
+through views (assignment, compound operators, single values) with the
+elements around the window left alone, views inside expressions, and the
+overlapping assignments that must go through a temporary.
+*/
+
+// STANDARD INCLUDES
+#include <string>
+#include <vector>
+
+// LOCAL INCLUDES
+#include "check.hpp"
+#include "matrix.hpp"
+#include "matrixView.hpp"
+
+using namespace geometry;
+
+namespace {
+
+    // Element (i, j) of the reference matrix, distinct for every (i, j).
+    template<typename T>
+    T element(std::size_t i, std::size_t j)
+    {
+        return static_cast<T>(i*97 + j*5 + 1);
+    }
+
+    template<typename T>
+    Matrix<T> reference(std::size_t line, std::size_t col)
+    {
+        std::vector<T> values(line*col);
+        for(std::size_t j=0; j<col; j++)
+            for(std::size_t i=0; i<line; i++)
+                values[i + j*line] = element<T>(i, j);
+        Matrix<T> out(line, col);
+        out.setValues(values);
+        return out;
+    }
+
+    template<typename T>
+    T at(const Matrix<T>& m, std::size_t line, std::size_t col)
+    {
+        return m.at(line + col*m.nLines());
+    }
+
+    // view(i, j) == expected(i, j) for its whole shape, in the iterators
+    // too (column after column).
+    template<class V, class Expected>
+    bool matches(const V& view, std::size_t line, std::size_t col, Expected expected)
+    {
+        if((view.nLines() != line) || (view.nColumns() != col))
+            return false;
+        auto it = view.begin();
+        for(std::size_t j=0; j<col; j++)
+            for(std::size_t i=0; i<line; i++, ++it)
+                if(!(view(i, j) == expected(i, j)) || !(*it == expected(i, j)))
+                    return false;
+        return it == view.end();
+    }
+
+    // Every element of m outside lines [l0, l0+nl) x columns [c0, c0+nc)
+    // still holds its reference value.
+    template<typename T>
+    bool untouched(const Matrix<T>& m, std::size_t l0, std::size_t c0, std::size_t nl, std::size_t nc)
+    {
+        for(std::size_t j=0; j<m.nColumns(); j++)
+            for(std::size_t i=0; i<m.nLines(); i++)
+            {
+                const bool inside = (i >= l0) && (i < l0 + nl) && (j >= c0) && (j < c0 + nc);
+                if(!inside && !(at(m, i, j) == element<T>(i, j)))
+                    return false;
+            }
+        return true;
+    }
+
+    template<typename T>
+    void checkRead(std::size_t line, std::size_t col)
+    {
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col);
+        const Matrix<T> m = reference<T>(line, col);
+        check::expect(matches(m.view(), line, col, [](std::size_t i, std::size_t j){return element<T>(i, j);}),
+                      "view " + shape);
+        check::expect(matches(m.view().transposed(), col, line,
+                              [](std::size_t i, std::size_t j){return element<T>(j, i);}), "transposed " + shape);
+
+        bool rows = true, columns = true;
+        for(std::size_t i=0; i<line; i++)
+        {
+            rows &= matches(m.row(i), 1, col, [&](std::size_t, std::size_t j){return element<T>(i, j);});
+            const std::vector<T> copy = m.getLine(i);
+            rows &= (copy.size() == col);
+            for(std::size_t j=0; rows && (j<col); j++)
+                rows &= (copy[j] == element<T>(i, j));
+        }
+        for(std::size_t j=0; j<col; j++)
+        {
+            columns &= matches(m.column(j), line, 1, [&](std::size_t i, std::size_t){return element<T>(i, j);});
+            const std::vector<T> copy = m.getColumn(j);
+            columns &= (copy.size() == line);
+            for(std::size_t i=0; columns && (i<line); i++)
+                columns &= (copy[i] == element<T>(i, j));
+        }
+        check::expect(rows, "rows and getLine " + shape);
+        check::expect(columns, "columns and getColumn " + shape);
+
+        // Views of views keep the offsets and the strides.
+        if((line >= 3) && (col >= 5))
+        {
+            const ConstMatrixView<T> block = m.block(1, 2, line - 2, col - 3);
+            check::expect(matches(block, line - 2, col - 3,
+                                  [](std::size_t i, std::size_t j){return element<T>(i + 1, j + 2);}),
+                          "block " + shape);
+            check::expect(matches(block.transposed().row(1), 1, line - 2,
+                                  [](std::size_t, std::size_t j){return element<T>(j + 1, 3);}),
+                          "row of a transposed block " + shape);
+            check::expect(matches(block.block(1, 0, line - 3, 1).transposed(), 1, line - 3,
+                                  [](std::size_t, std::size_t j){return element<T>(j + 2, 2);}),
+                          "block of a block " + shape);
+        }
+
+        bool thrown = false;
+        try
+        {
+            m.block(line - 1, 0, 2, 1);
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            thrown = true;
+        }
+        check::expect(thrown, "block out of the matrix " + shape);
+    }
+
+    template<typename T>
+    void checkWrite(std::size_t line, std::size_t col)
+    {
+        const std::string shape = std::to_string(line) + "x" + std::to_string(col);
+        const std::size_t nl = line - 2, nc = col - 2;
+
+        Matrix<T> m = reference<T>(line, col);
+        m.block(1, 1, nl, nc) = T(-3);
+        check::expect(matches(m.block(1, 1, nl, nc), nl, nc, [](std::size_t, std::size_t){return T(-3);})
+                      && untouched(m, 1, 1, nl, nc), "block = value " + shape);
+
+        m = reference<T>(line, col);
+        m.block(1, 1, nl, nc) += T(2);
+        m.block(1, 1, nl, nc) *= m.block(0, 0, nl, nc) - T(1);
+        check::expect(matches(m.block(1, 1, nl, nc), nl, nc, [](std::size_t i, std::size_t j){
+            const T source = (i > 0) && (j > 0) ? T(element<T>(i, j) + T(2)) : element<T>(i, j);
+            return T((element<T>(i + 1, j + 1) + T(2))*(source - T(1)));
+        }) && untouched(m, 1, 1, nl, nc), "compound operators on a block " + shape);
+
+        m = reference<T>(line, col);
+        m.row(0) = m.row(line - 1);
+        check::expect(matches(m.row(0), 1, col, [&](std::size_t, std::size_t j){return element<T>(line - 1, j);})
+                      && untouched(m, 0, 0, 1, col), "row = row " + shape);
+
+        m = reference<T>(line, col);
+        m.column(col - 1) = m.column(0)*T(2) + m.column(1);
+        check::expect(matches(m.column(col - 1), line, 1, [](std::size_t i, std::size_t){
+            return T(element<T>(i, 0)*T(2) + element<T>(i, 1));
+        }) && untouched(m, 0, col - 1, line, 1), "column = expression of columns " + shape);
+
+        // Overlapping windows: the source is read before anything is written.
+        m = reference<T>(line, col);
+        m.block(1, 1, nl, nc) = m.block(0, 0, nl, nc);
+        check::expect(matches(m.block(1, 1, nl, nc), nl, nc, [](std::size_t i, std::size_t j){
+            return element<T>(i, j);
+        }) && untouched(m, 1, 1, nl, nc), "block = overlapping block " + shape);
+
+        m = reference<T>(line, col);
+        m.block(0, 1, line, col - 1) = m.block(0, 0, line, col - 1);
+        check::expect(matches(m.block(0, 1, line, col - 1), line, col - 1, [](std::size_t i, std::size_t j){
+            return element<T>(i, j);
+        }) && untouched(m, 0, 1, line, col - 1), "shift of whole columns " + shape);
+
+        const std::size_t n = std::min(line, col);
+        m = reference<T>(line, col);
+        MatrixView<T> square = m.block(0, 0, n, n);
+        square += square.transposed();
+        check::expect(matches(m.block(0, 0, n, n), n, n, [](std::size_t i, std::size_t j){
+            return T(element<T>(i, j) + element<T>(j, i));
+        }) && untouched(m, 0, 0, n, n), "v += v.transposed() " + shape);
+
+        // A matrix assigned a view of itself.
+        m = reference<T>(line, col);
+        m = m.view().transposed();
+        check::expect(matches(m.view(), col, line, [](std::size_t i, std::size_t j){return element<T>(j, i);}),
+                      "m = m.view().transposed() " + shape);
+        m = reference<T>(line, col);
+        m = m.block(1, 1, nl, nc) + T(1);
+        check::expect(matches(m.view(), nl, nc, [](std::size_t i, std::size_t j){
+            return T(element<T>(i + 1, j + 1) + T(1));
+        }), "m = m.block() + 1 " + shape);
+
+        // Iterators write through.
+        m = reference<T>(line, col);
+        MatrixView<T> row = m.row(1);
+        for(T& value: row)
+            value = T(7);
+        check::expect(matches(m.row(1), 1, col, [](std::size_t, std::size_t){return T(7);})
+                      && untouched(m, 1, 0, 1, col), "writing iterator " + shape);
+
+        bool thrown = false;
+        try
+        {
+            m.row(0) = m.column(0);
+        }
+        catch(const Exeptions::SizeMismatch&)
+        {
+            thrown = true;
+        }
+        check::expect(thrown || (line == col && line == 1), "row = column shape mismatch " + shape);
+    }
+
+    template<typename T>
+    void checkType()
+    {
+        for(std::size_t line: {1, 2, 3, 5, 17, 40})
+            for(std::size_t col: {1, 3, 5, 19})
+                checkRead<T>(line, col);
+        for(std::size_t line: {3, 4, 17, 40})
+            for(std::size_t col: {3, 5, 19})
+                checkWrite<T>(line, col);
+    }
+
+}
+
+int main()
+{
+    checkType<double>();
+    checkType<float>();
+    checkType<int>();
+    return check::report("view");
+}
@@ -0,0 +1,214 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__TILEDMATRIX_DECL__GUARD__2610
+#define GEOMETRY__TILEDMATRIX_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <array>
+#include <cstddef>
+#include <string>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "matrixAllocator.decl.hpp"
+#include "matrixFile.decl.hpp"
+#include "matrixSimd.decl.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // 1024 x 1024 tiles: 8 MiB of doubles, large sequential requests
+        // for the disk and enough work per tile to hide them.
+        constexpr std::size_t defaultTileSize = 1024;
+
+        // Bytes of tile buffers an out-of-core operation may hold (1 GiB by
+        // default). An operation holds depth steps of tiles, depth being
+        // what the budget allows up to maxPipelineDepth: two steps and more
+        // overlap I/O with compute, a budget below one step still runs one
+        // step at a time.
+        void setOutOfCoreBudget(std::size_t bytes);
+        std::size_t outOfCoreBudget();
+
+        constexpr std::size_t maxPipelineDepth = 4;
+
+        // Steps of stepBytes each that the budget holds once fixedBytes
+        // are set aside, within [1, maxPipelineDepth].
+        std::size_t pipelineDepth(std::size_t stepBytes, std::size_t fixedBytes = 0);
+
+        // Runs nSteps steps through depth buffer slots (slot = step % depth):
+        // load(step, slot) and store(step, slot) run on I/O threads,
+        // compute(step, slot) on the caller, in step order. The loads of
+        // the next depth - 1 steps are in flight while a step computes, and
+        // a slot is loaded again only once its previous store is done.
+        // Exceptions of any stage are rethrown here.
+        template<class Load, class Compute, class Store>
+        void tilePipeline(std::size_t nSteps, std::size_t depth, Load load, Compute compute, Store store);
+
+#ifdef GEOMETRY_MMAP
+        // Descriptor of a new, unlinked file of bytes zeros in directory
+        // (see TiledMatrix for the default one).
+        // -> Exceptions::FileError()
+        int scratchFile(const std::string& directory, std::size_t bytes);
+        std::string scratchDirectory(const std::string& directory);
+
+        // Positional I/O, safe from several threads on the same descriptor.
+        // -> Exceptions::FileError()
+        void readAt(int file, void* out, std::size_t bytes, std::size_t offset);
+        void writeAt(int file, const void* in, std::size_t bytes, std::size_t offset);
+#endif
+
+        // nLines x nColumns block between a column-major buffer (leading
+        // dimension ld) and strided storage (element (i, j) at
+        // i*rs + j*cs), column by column or through the transpose kernel.
+        template<typename T>
+        void copyFromStrided(std::size_t nLines, std::size_t nColumns,
+                             const T* src, std::size_t rs, std::size_t cs, T* dst, std::size_t ld);
+        template<typename T>
+        void copyToStrided(std::size_t nLines, std::size_t nColumns,
+                           const T* src, std::size_t ld, T* dst, std::size_t rs, std::size_t cs);
+
+    }
+
+#ifdef GEOMETRY_MMAP
+    // Out-of-core matrix: the elements live on local disk, in an unnamed
+    // scratch file, as square tiles of tileSize() x tileSize() elements
+    // (column-major, tiles stored column of tiles after column of tiles).
+    // Tiles at the right and bottom edges keep the full size, their
+    // padding is never read.
+    //
+    // Operations stream the tiles through utils::tilePipeline: the tiles
+    // of the next steps are read by I/O threads while the current one is
+    // computed (SIMD kernels, threads of the backend) and the results are
+    // written back behind it. The resident tiles are capped by
+    // utils::outOfCoreBudget(), never by the size of the matrix:
+    //     TiledMatrix<double> a = TiledMatrix<double>::load("a.mat");
+    //     a *= 2.0;
+    //     TiledMatrix<double> c = matmul(a, transpose(a));
+    //     c.save("c.mat");
+    // The scratch file goes in the given directory, else in the one of the
+    // GEOMETRY_SCRATCH_DIR environment variable, else in the temporary
+    // directory. It is unlinked as soon as it is created, so it vanishes
+    // with the matrix or the process.
+    template<class T>
+    class TiledMatrix
+    {
+    public: // types
+        using value_type = T;
+
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        // Zero matrix (sparse scratch file).
+        // -> Exceptions::FileError()
+        // -> Exceptions::SizeMismatch() for a zero tileSize
+        TiledMatrix(std::size_t line, std::size_t col, std::size_t tileSize = utils::defaultTileSize,
+                    const std::string& directory = "");
+
+        template<class Alloc, Layout Order>
+        static TiledMatrix<T> fromMatrix(const Matrix<T, Alloc, Order>& other,
+                                         std::size_t tileSize = utils::defaultTileSize,
+                                         const std::string& directory = "");
+        // Matrix file (see matrixFile.hpp) read through a mapping, tile by
+        // tile: the file may be larger than memory.
+        // -> Exceptions::FileError()
+        static TiledMatrix<T> load(const std::string& path, std::size_t tileSize = utils::defaultTileSize,
+                                   const std::string& directory = "");
+
+        TiledMatrix(TiledMatrix<T>&& other) noexcept;
+        TiledMatrix<T>& operator=(TiledMatrix<T>&& other) noexcept;
+        TiledMatrix(const TiledMatrix<T>&) = delete;
+        TiledMatrix<T>& operator=(const TiledMatrix<T>&) = delete;
+
+        // --------------------------- DESTRUCTORS ----------------------------
+        ~TiledMatrix();
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element-wise, in place, tile by tile.
+        // -> Exceptions::SizeMismatch() if dimensions or tile sizes differ
+        TiledMatrix<T>& operator+=(const TiledMatrix<T>& other);
+        TiledMatrix<T>& operator-=(const TiledMatrix<T>& other);
+        TiledMatrix<T>& operator*=(const TiledMatrix<T>& other); // Hadamard product
+        TiledMatrix<T>& operator/=(const TiledMatrix<T>& other);
+        TiledMatrix<T>& operator+=(T value);
+        TiledMatrix<T>& operator-=(T value);
+        TiledMatrix<T>& operator*=(T value);
+        TiledMatrix<T>& operator/=(T value);
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        std::size_t nLines()   const {return m_size[0];}
+        std::size_t nColumns() const {return m_size[1];}
+        const std::array<std::size_t, 2>& dimension() const {return m_size;}
+        std::size_t length() const {return this->nLines()*this->nColumns();}
+        std::size_t tileSize() const {return m_tileSize;}
+        std::size_t tileElements() const {return m_tileSize*m_tileSize;}
+        std::size_t nTileLines()   const {return (this->nLines() + m_tileSize - 1)/m_tileSize;}
+        std::size_t nTileColumns() const {return (this->nColumns() + m_tileSize - 1)/m_tileSize;}
+        std::size_t nTiles() const {return this->nTileLines()*this->nTileColumns();}
+        // Lines (columns) of the matrix in tile line i (tile column j).
+        std::size_t tileLines(std::size_t i) const;
+        std::size_t tileColumns(std::size_t j) const;
+        const std::string& directory() const {return m_directory;}
+
+        // Tile (i, j) into tileElements() values, leading dimension
+        // tileSize(). Safe from several threads.
+        // -> Exceptions::FileError()
+        void readTile(std::size_t i, std::size_t j, T* out) const;
+
+        // The whole matrix in memory.
+        template<class Alloc = utils::AlignedAllocator<T>, Layout Order = Layout::ColumnMajor>
+        Matrix<T, Alloc, Order> toMatrix() const;
+        // Column-major matrix file, written through a mapping.
+        // -> Exceptions::FileError()
+        void save(const std::string& path) const;
+
+        // -> Reductions, one pass over the tiles through the kernels of
+        //    matrixReduction.decl.hpp, tile results summed compensated.
+        //    Sums come in utils::accumulator_t<T>, norms in utils::real_t<T>
+        //    (see Matrix).
+        //    min() and max() of an empty matrix are T().
+        utils::accumulator_t<T> sum() const;
+        T min() const;
+        T max() const;
+        utils::real_t<T> norm() const; // Frobenius
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        // -> Exceptions::FileError()
+        void writeTile(std::size_t i, std::size_t j, const T* in);
+
+    // --------------------------- PROTECTED METHODS --------------------------
+    protected:
+        template<utils::ElementOp Op>
+        TiledMatrix<T>& apply(const TiledMatrix<T>& other);
+        template<utils::ElementOp Op>
+        TiledMatrix<T>& apply(T value);
+        // consume(i, j, tile) on the caller for every tile, in file order.
+        template<class Consume>
+        void stream(Consume consume) const;
+        // Every tile from source (same dimensions).
+        void assign(ConstMatrixView<T> source);
+        std::size_t tileOffset(std::size_t i, std::size_t j) const;
+
+        std::array<std::size_t, 2> m_size{0, 0}; // {lines, columns}
+        std::size_t m_tileSize{utils::defaultTileSize};
+        std::string m_directory{};
+        int m_file{-1};
+    };
+
+    // Tile (i, j) of the result is the transposed tile (j, i) of A.
+    // -> Exceptions::FileError()
+    template<typename T>
+    TiledMatrix<T> transpose(const TiledMatrix<T>& A);
+
+    // C(i, j) = sum over k of A(i, k).B(k, j), k innermost: one tile of C
+    // accumulates in memory while the pairs of tiles stream past it.
+    // -> Exceptions::SizeMismatch() if A.nColumns() != B.nLines() or the
+    //    tile sizes differ
+    template<typename T>
+    TiledMatrix<T> matmul(const TiledMatrix<T>& A, const TiledMatrix<T>& B);
+#endif
+}
+#endif
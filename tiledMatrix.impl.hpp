@@ -0,0 +1,629 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__TILEDMATRIX_IMPL__GUARD__2610
+#define GEOMETRY__TILEDMATRIX_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef GEOMETRY_MMAP
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// LOCAL INCLUDES
+#include "tiledMatrix.decl.hpp"
+#include "matrix.hpp"
+#include "matrixFile.hpp"
+#include "matrixProduct.hpp"
+#include "matrixReduction.hpp"
+#include "matrixSimd.hpp"
+#include "matrixTranspose.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    namespace utils{
+
+        // ----------------------------- CONFIGURATION ------------------------
+        inline std::atomic<std::size_t>& budgetSlot()
+        {
+            static std::atomic<std::size_t> budget{std::size_t{1} << 30};
+            return budget;
+        }
+
+        inline void setOutOfCoreBudget(std::size_t bytes)
+        {
+            budgetSlot().store(bytes);
+        }
+
+        inline std::size_t outOfCoreBudget()
+        {
+            return budgetSlot().load();
+        }
+
+        inline std::size_t pipelineDepth(std::size_t stepBytes, std::size_t fixedBytes)
+        {
+            const std::size_t budget = outOfCoreBudget();
+            if((stepBytes == 0) || (budget <= fixedBytes))
+                return 1;
+            return std::clamp<std::size_t>((budget - fixedBytes)/stepBytes, 1, maxPipelineDepth);
+        }
+
+        // ------------------------------- PIPELINE ---------------------------
+        template<class Load, class Compute, class Store>
+        void tilePipeline(std::size_t nSteps, std::size_t depth, Load load, Compute compute, Store store)
+        {
+            depth = std::max<std::size_t>(std::min(depth, nSteps), 1);
+            // Futures of std::async wait for their task when destroyed: no
+            // task outlives load and store, even when a stage throws.
+            std::vector<std::future<void>> loads(depth);
+            std::vector<std::future<void>> stores(depth);
+            auto startLoad = [&](std::size_t step)
+            {
+                const std::size_t slot = step % depth;
+                loads[slot] = std::async(std::launch::async,
+                    [&load, step, slot, previous = std::move(stores[slot])]() mutable
+                    {
+                        if(previous.valid())
+                            previous.get();
+                        load(step, slot);
+                    });
+            };
+
+            for(std::size_t step=0; step<std::min(depth, nSteps); step++)
+                startLoad(step);
+            for(std::size_t step=0; step<nSteps; step++)
+            {
+                const std::size_t slot = step % depth;
+                loads[slot].get();
+                compute(step, slot);
+                stores[slot] = std::async(std::launch::async, [&store, step, slot]{store(step, slot);});
+                if(step + depth < nSteps)
+                    startLoad(step + depth);
+            }
+            for(std::future<void>& pending: stores)
+                if(pending.valid())
+                    pending.get();
+        }
+
+#ifdef GEOMETRY_MMAP
+        // ------------------------------ SCRATCH FILES -----------------------
+        inline std::string scratchDirectory(const std::string& directory)
+        {
+            if(!directory.empty())
+                return directory;
+            if(const char* variable = std::getenv("GEOMETRY_SCRATCH_DIR"); variable && *variable)
+                return variable;
+            std::error_code error;
+            const std::filesystem::path path = std::filesystem::temp_directory_path(error);
+            return error ? std::string("/tmp") : path.string();
+        }
+
+        inline int scratchFile(const std::string& directory, std::size_t bytes)
+        {
+            std::string path = directory + "/geometry-tiles-XXXXXX";
+            const int file = ::mkstemp(path.data());
+            if(file < 0)
+                throw Exeptions::FileError(path, std::strerror(errno));
+            ::unlink(path.c_str()); // the descriptor keeps the file alive
+            if(::ftruncate(file, static_cast<off_t>(bytes)) != 0)
+            {
+                const int error = errno;
+                ::close(file);
+                throw Exeptions::FileError(path, std::strerror(error));
+            }
+            return file;
+        }
+
+        inline void readAt(int file, void* out, std::size_t bytes, std::size_t offset)
+        {
+            char* cursor = static_cast<char*>(out);
+            while(bytes > 0)
+            {
+                const ssize_t done = ::pread(file, cursor, std::min(bytes, fileChunk), static_cast<off_t>(offset));
+                if((done < 0) && (errno == EINTR))
+                    continue;
+                if(done <= 0)
+                    throw Exeptions::FileError("tile file", (done < 0) ? std::strerror(errno) : "unexpected end of file");
+                cursor += done;
+                bytes -= static_cast<std::size_t>(done);
+                offset += static_cast<std::size_t>(done);
+            }
+        }
+
+        inline void writeAt(int file, const void* in, std::size_t bytes, std::size_t offset)
+        {
+            const char* cursor = static_cast<const char*>(in);
+            while(bytes > 0)
+            {
+                const ssize_t done = ::pwrite(file, cursor, std::min(bytes, fileChunk), static_cast<off_t>(offset));
+                if((done < 0) && (errno == EINTR))
+                    continue;
+                if(done <= 0)
+                    throw Exeptions::FileError("tile file", (done < 0) ? std::strerror(errno) : "nothing written");
+                cursor += done;
+                bytes -= static_cast<std::size_t>(done);
+                offset += static_cast<std::size_t>(done);
+            }
+        }
+#endif
+
+        // ------------------------------- COPIES -----------------------------
+        template<typename T>
+        void copyFromStrided(std::size_t nLines, std::size_t nColumns,
+                             const T* src, std::size_t rs, std::size_t cs, T* dst, std::size_t ld)
+        {
+            if(rs == 1)
+            {
+                for(std::size_t col=0; col<nColumns; col++)
+                    std::copy(src + col*cs, src + col*cs + nLines, dst + col*ld);
+            }
+            else if(cs == 1) // row-major: src is the column-major nColumns x nLines block
+                transpose(nColumns, nLines, src, rs, dst, ld);
+            else
+            {
+                for(std::size_t col=0; col<nColumns; col++)
+                    for(std::size_t line=0; line<nLines; line++)
+                        dst[line + col*ld] = src[line*rs + col*cs];
+            }
+        }
+
+        template<typename T>
+        void copyToStrided(std::size_t nLines, std::size_t nColumns,
+                           const T* src, std::size_t ld, T* dst, std::size_t rs, std::size_t cs)
+        {
+            if(rs == 1)
+            {
+                for(std::size_t col=0; col<nColumns; col++)
+                    std::copy(src + col*ld, src + col*ld + nLines, dst + col*cs);
+            }
+            else if(cs == 1)
+                transpose(nLines, nColumns, src, ld, dst, rs);
+            else
+            {
+                for(std::size_t col=0; col<nColumns; col++)
+                    for(std::size_t line=0; line<nLines; line++)
+                        dst[line*rs + col*cs] = src[line + col*ld];
+            }
+        }
+
+    }
+
+#ifdef GEOMETRY_MMAP
+    // ============================= TILED MATRIX =============================
+    // ------------------------------ CONSTRUCTORS ----------------------------
+    template<class T>
+    TiledMatrix<T>::TiledMatrix(std::size_t line, std::size_t col, std::size_t tileSize,
+                                const std::string& directory):
+        m_size{line, col},
+        m_tileSize{tileSize},
+        m_directory{utils::scratchDirectory(directory)}
+    {
+        if(tileSize == 0)
+            throw Exeptions::SizeMismatch(0, static_cast<int>(utils::defaultTileSize));
+        m_file = utils::scratchFile(m_directory, this->nTiles()*this->tileElements()*sizeof(T));
+    }
+
+    template<class T>
+    template<class Alloc, Layout Order>
+    TiledMatrix<T> TiledMatrix<T>::fromMatrix(const Matrix<T, Alloc, Order>& other,
+                                              std::size_t tileSize, const std::string& directory)
+    {
+        TiledMatrix<T> result(other.nLines(), other.nColumns(), tileSize, directory);
+        result.assign(other.view());
+        return result;
+    }
+
+    template<class T>
+    TiledMatrix<T> TiledMatrix<T>::load(const std::string& path, std::size_t tileSize,
+                                        const std::string& directory)
+    {
+        const MappedMatrix<T> source(path);
+        TiledMatrix<T> result(source.nLines(), source.nColumns(), tileSize, directory);
+        result.assign(source.view());
+        return result;
+    }
+
+    template<class T>
+    TiledMatrix<T>::TiledMatrix(TiledMatrix<T>&& other) noexcept:
+        m_size{other.m_size},
+        m_tileSize{other.m_tileSize},
+        m_directory{std::move(other.m_directory)},
+        m_file{std::exchange(other.m_file, -1)}
+    {}
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator=(TiledMatrix<T>&& other) noexcept
+    {
+        if(this == &other)
+            return *this;
+        if(m_file >= 0)
+            ::close(m_file);
+        m_size = other.m_size;
+        m_tileSize = other.m_tileSize;
+        m_directory = std::move(other.m_directory);
+        m_file = std::exchange(other.m_file, -1);
+        return *this;
+    }
+
+    template<class T>
+    TiledMatrix<T>::~TiledMatrix()
+    {
+        if(m_file >= 0)
+            ::close(m_file);
+    }
+
+    // ------------------------------ OPERATORS -------------------------------
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator+=(const TiledMatrix<T>& other)
+    {
+        return this->template apply<utils::ElementOp::Add>(other);
+    }
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator-=(const TiledMatrix<T>& other)
+    {
+        return this->template apply<utils::ElementOp::Sub>(other);
+    }
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator*=(const TiledMatrix<T>& other)
+    {
+        return this->template apply<utils::ElementOp::Mul>(other);
+    }
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator/=(const TiledMatrix<T>& other)
+    {
+        return this->template apply<utils::ElementOp::Div>(other);
+    }
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator+=(T value)
+    {
+        return this->template apply<utils::ElementOp::Add>(value);
+    }
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator-=(T value)
+    {
+        return this->template apply<utils::ElementOp::Sub>(value);
+    }
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator*=(T value)
+    {
+        return this->template apply<utils::ElementOp::Mul>(value);
+    }
+
+    template<class T>
+    TiledMatrix<T>& TiledMatrix<T>::operator/=(T value)
+    {
+        return this->template apply<utils::ElementOp::Div>(value);
+    }
+
+    // --------------------------------- INFO ---------------------------------
+    template<class T>
+    std::size_t TiledMatrix<T>::tileLines(std::size_t i) const
+    {
+        return std::min(m_tileSize, this->nLines() - i*m_tileSize);
+    }
+
+    template<class T>
+    std::size_t TiledMatrix<T>::tileColumns(std::size_t j) const
+    {
+        return std::min(m_tileSize, this->nColumns() - j*m_tileSize);
+    }
+
+    template<class T>
+    void TiledMatrix<T>::readTile(std::size_t i, std::size_t j, T* out) const
+    {
+        utils::readAt(m_file, out, this->tileElements()*sizeof(T), this->tileOffset(i, j));
+    }
+
+    template<class T>
+    void TiledMatrix<T>::writeTile(std::size_t i, std::size_t j, const T* in)
+    {
+        utils::writeAt(m_file, in, this->tileElements()*sizeof(T), this->tileOffset(i, j));
+    }
+
+    template<class T>
+    template<class Alloc, Layout Order>
+    Matrix<T, Alloc, Order> TiledMatrix<T>::toMatrix() const
+    {
+        Matrix<T, Alloc, Order> result(this->nLines(), this->nColumns());
+        const MatrixView<T> target = result.view();
+        this->stream([&](std::size_t i, std::size_t j, const T* tile)
+        {
+            const std::size_t first = i*m_tileSize*target.lineStride() + j*m_tileSize*target.columnStride();
+            utils::copyToStrided(this->tileLines(i), this->tileColumns(j), tile, m_tileSize,
+                                 target.data() + first, target.lineStride(), target.columnStride());
+        });
+        return result;
+    }
+
+    template<class T>
+    void TiledMatrix<T>::save(const std::string& path) const
+    {
+        MappedMatrix<T> file = MappedMatrix<T>::create(path, this->nLines(), this->nColumns());
+        const std::size_t lead = file.leadingDimension();
+        T* data = file.data();
+        this->stream([&](std::size_t i, std::size_t j, const T* tile)
+        {
+            utils::copyToStrided(this->tileLines(i), this->tileColumns(j), tile, m_tileSize,
+                                 data + i*m_tileSize + j*m_tileSize*lead, 1, lead);
+        });
+        file.flush();
+    }
+
+    // ------------------------------- REDUCTIONS -----------------------------
+    template<class T>
+    utils::accumulator_t<T> TiledMatrix<T>::sum() const
+    {
+        utils::CompensatedSum<utils::accumulator_t<T>> total;
+        this->stream([&](std::size_t i, std::size_t j, const T* tile)
+        {
+            total.add(utils::reduce<utils::ReduceOp::Sum>(this->tileLines(i), this->tileColumns(j),
+                                                          tile, m_tileSize));
+        });
+        return total.result();
+    }
+
+    template<class T>
+    T TiledMatrix<T>::min() const
+    {
+        T result{};
+        bool first = true;
+        this->stream([&](std::size_t i, std::size_t j, const T* tile)
+        {
+            const T value = static_cast<T>(utils::reduce<utils::ReduceOp::Min>(this->tileLines(i), this->tileColumns(j),
+                                                                               tile, m_tileSize));
+            if(first || (value < result))
+                result = value;
+            first = false;
+        });
+        return result;
+    }
+
+    template<class T>
+    T TiledMatrix<T>::max() const
+    {
+        T result{};
+        bool first = true;
+        this->stream([&](std::size_t i, std::size_t j, const T* tile)
+        {
+            const T value = static_cast<T>(utils::reduce<utils::ReduceOp::Max>(this->tileLines(i), this->tileColumns(j),
+                                                                               tile, m_tileSize));
+            if(first || (result < value))
+                result = value;
+            first = false;
+        });
+        return result;
+    }
+
+    template<class T>
+    utils::real_t<T> TiledMatrix<T>::norm() const
+    {
+        utils::CompensatedSum<utils::real_t<T>> squares;
+        this->stream([&](std::size_t i, std::size_t j, const T* tile)
+        {
+            squares.add(utils::sumSquares(this->tileLines(i), this->tileColumns(j), tile, m_tileSize));
+        });
+        return std::sqrt(squares.result());
+    }
+
+    // --------------------------------- STREAMS ------------------------------
+    template<class T>
+    template<utils::ElementOp Op>
+    TiledMatrix<T>& TiledMatrix<T>::apply(const TiledMatrix<T>& other)
+    {
+        if(other.dimension() != m_size)
+            throw Exeptions::SizeMismatch(static_cast<int>(this->length()), static_cast<int>(other.length()));
+        if(other.tileSize() != m_tileSize)
+            throw Exeptions::SizeMismatch(static_cast<int>(m_tileSize), static_cast<int>(other.tileSize()));
+
+        const std::size_t elements = this->tileElements();
+        const std::size_t nTileLines = this->nTileLines();
+        const std::size_t depth = utils::pipelineDepth(2*elements*sizeof(T));
+        std::vector<T, utils::AlignedAllocator<T>> buffers(2*depth*elements);
+        auto tile = [&](std::size_t slot, std::size_t k) {return buffers.data() + (2*slot + k)*elements;};
+
+        utils::tilePipeline(this->nTiles(), depth,
+            [&](std::size_t step, std::size_t slot)
+            {
+                this->readTile(step%nTileLines, step/nTileLines, tile(slot, 0));
+                other.readTile(step%nTileLines, step/nTileLines, tile(slot, 1));
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                utils::elementWise<Op>(this->tileLines(step%nTileLines), this->tileColumns(step/nTileLines),
+                                       tile(slot, 0), m_tileSize, tile(slot, 1), m_tileSize,
+                                       tile(slot, 0), m_tileSize);
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                this->writeTile(step%nTileLines, step/nTileLines, tile(slot, 0));
+            });
+        return *this;
+    }
+
+    template<class T>
+    template<utils::ElementOp Op>
+    TiledMatrix<T>& TiledMatrix<T>::apply(T value)
+    {
+        const std::size_t elements = this->tileElements();
+        const std::size_t nTileLines = this->nTileLines();
+        const std::size_t depth = utils::pipelineDepth(elements*sizeof(T));
+        std::vector<T, utils::AlignedAllocator<T>> buffers(depth*elements);
+
+        utils::tilePipeline(this->nTiles(), depth,
+            [&](std::size_t step, std::size_t slot)
+            {
+                this->readTile(step%nTileLines, step/nTileLines, buffers.data() + slot*elements);
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                T* tile = buffers.data() + slot*elements;
+                utils::elementWise<Op>(this->tileLines(step%nTileLines), this->tileColumns(step/nTileLines),
+                                       tile, m_tileSize, value, tile, m_tileSize);
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                this->writeTile(step%nTileLines, step/nTileLines, buffers.data() + slot*elements);
+            });
+        return *this;
+    }
+
+    template<class T>
+    template<class Consume>
+    void TiledMatrix<T>::stream(Consume consume) const
+    {
+        const std::size_t elements = this->tileElements();
+        const std::size_t nTileLines = this->nTileLines();
+        const std::size_t depth = utils::pipelineDepth(elements*sizeof(T));
+        std::vector<T, utils::AlignedAllocator<T>> buffers(depth*elements);
+
+        utils::tilePipeline(this->nTiles(), depth,
+            [&](std::size_t step, std::size_t slot)
+            {
+                this->readTile(step%nTileLines, step/nTileLines, buffers.data() + slot*elements);
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                consume(step%nTileLines, step/nTileLines, static_cast<const T*>(buffers.data() + slot*elements));
+            },
+            [](std::size_t, std::size_t) {});
+    }
+
+    template<class T>
+    void TiledMatrix<T>::assign(ConstMatrixView<T> source)
+    {
+        const std::size_t elements = this->tileElements();
+        const std::size_t nTileLines = this->nTileLines();
+        const std::size_t depth = utils::pipelineDepth(elements*sizeof(T));
+        std::vector<T, utils::AlignedAllocator<T>> buffers(depth*elements);
+        const std::size_t rs = source.lineStride();
+        const std::size_t cs = source.columnStride();
+
+        // The copy out of source (page faults of a mapping) is the load.
+        utils::tilePipeline(this->nTiles(), depth,
+            [&](std::size_t step, std::size_t slot)
+            {
+                const std::size_t i = step%nTileLines;
+                const std::size_t j = step/nTileLines;
+                utils::copyFromStrided(this->tileLines(i), this->tileColumns(j),
+                                       source.data() + i*m_tileSize*rs + j*m_tileSize*cs, rs, cs,
+                                       buffers.data() + slot*elements, m_tileSize);
+            },
+            [](std::size_t, std::size_t) {},
+            [&](std::size_t step, std::size_t slot)
+            {
+                this->writeTile(step%nTileLines, step/nTileLines, buffers.data() + slot*elements);
+            });
+    }
+
+    template<class T>
+    std::size_t TiledMatrix<T>::tileOffset(std::size_t i, std::size_t j) const
+    {
+        return (j*this->nTileLines() + i)*this->tileElements()*sizeof(T);
+    }
+
+    // ------------------------------- TRANSPOSE ------------------------------
+    template<typename T>
+    TiledMatrix<T> transpose(const TiledMatrix<T>& A)
+    {
+        TiledMatrix<T> result(A.nColumns(), A.nLines(), A.tileSize(), A.directory());
+        const std::size_t tileSize = A.tileSize();
+        const std::size_t elements = A.tileElements();
+        const std::size_t nTileLines = result.nTileLines();
+        const std::size_t depth = utils::pipelineDepth(elements*sizeof(T));
+        std::vector<T, utils::AlignedAllocator<T>> buffers(depth*elements);
+
+        // Tiles are square: the whole tile is transposed in place, the
+        // padding going to the padding.
+        utils::tilePipeline(result.nTiles(), depth,
+            [&](std::size_t step, std::size_t slot)
+            {
+                A.readTile(step/nTileLines, step%nTileLines, buffers.data() + slot*elements);
+            },
+            [&](std::size_t, std::size_t slot)
+            {
+                utils::transposeSquareInPlace(tileSize, buffers.data() + slot*elements, tileSize);
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                result.writeTile(step%nTileLines, step/nTileLines, buffers.data() + slot*elements);
+            });
+        return result;
+    }
+
+    // -------------------------------- PRODUCT -------------------------------
+    template<typename T>
+    TiledMatrix<T> matmul(const TiledMatrix<T>& A, const TiledMatrix<T>& B)
+    {
+        if(A.nColumns() != B.nLines())
+            throw Exeptions::SizeMismatch(static_cast<int>(A.nColumns()), static_cast<int>(B.nLines()));
+        if(A.tileSize() != B.tileSize())
+            throw Exeptions::SizeMismatch(static_cast<int>(A.tileSize()), static_cast<int>(B.tileSize()));
+
+        TiledMatrix<T> C(A.nLines(), B.nColumns(), A.tileSize(), A.directory());
+        const std::size_t nDepth = A.nTileColumns();
+        if(nDepth == 0) // C stays zero
+            return C;
+
+        const std::size_t tileSize = A.tileSize();
+        const std::size_t elements = A.tileElements();
+        const std::size_t nTileLines = C.nTileLines();
+        const std::size_t depth = utils::pipelineDepth(3*elements*sizeof(T), elements*sizeof(T));
+        // Slot: tile of A, tile of B, finished tile of C.
+        std::vector<T, utils::AlignedAllocator<T>> buffers(3*depth*elements);
+        std::vector<T, utils::AlignedAllocator<T>> accumulator(elements);
+        auto tile = [&](std::size_t slot, std::size_t k) {return buffers.data() + (3*slot + k)*elements;};
+
+        // step = (j*nTileLines + i)*nDepth + k
+        utils::tilePipeline(C.nTiles()*nDepth, depth,
+            [&](std::size_t step, std::size_t slot)
+            {
+                const std::size_t k = step%nDepth;
+                const std::size_t i = (step/nDepth)%nTileLines;
+                const std::size_t j = (step/nDepth)/nTileLines;
+                A.readTile(i, k, tile(slot, 0));
+                B.readTile(k, j, tile(slot, 1));
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                const std::size_t k = step%nDepth;
+                const std::size_t i = (step/nDepth)%nTileLines;
+                const std::size_t j = (step/nDepth)/nTileLines;
+                utils::gemm(C.tileLines(i), C.tileColumns(j), A.tileColumns(k), static_cast<T>(1),
+                            tile(slot, 0), 1, tileSize, tile(slot, 1), 1, tileSize,
+                            static_cast<T>((k == 0) ? 0 : 1), accumulator.data(), 1, tileSize);
+                if(k + 1 == nDepth)
+                    std::copy(accumulator.begin(), accumulator.end(), tile(slot, 2));
+            },
+            [&](std::size_t step, std::size_t slot)
+            {
+                if(step%nDepth + 1 == nDepth)
+                    C.writeTile((step/nDepth)%nTileLines, (step/nDepth)/nTileLines, tile(slot, 2));
+            });
+        return C;
+    }
+#endif
+
+}
+#endif
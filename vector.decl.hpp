@@ -0,0 +1,130 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__VECTOR_DECL__GUARD__2610
+#define GEOMETRY__VECTOR_DECL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <cstddef>
+#include <initializer_list>
+
+// LOCAL INCLUDES
+#include "matrix.forward.hpp"
+#include "fixedMatrix.decl.hpp"
+#include "matrixBatch.decl.hpp"
+#include "matrixReduction.decl.hpp" // Norm
+
+namespace geometry{
+
+    // Column vector of fixed size: a FixedMatrix<T, N, 1> with vector
+    // accessors, so it keeps the inline storage, the element-wise operators
+    // and matmul(matrix, vector). Operators inherited from FixedMatrix
+    // return a FixedMatrix<T, N, 1>, which converts back implicitly.
+    template<class T, std::size_t N>
+    class Vector: public FixedMatrix<T, N, 1>
+    {
+    public: // METHODS
+        // --------------------------- CONSTRUCTORS ---------------------------
+        constexpr Vector() {} // --> all zeros
+
+        // -> Exceptions::SizeMismatch()
+        constexpr Vector(std::initializer_list<T> list): FixedMatrix<T, N, 1>(list) {}
+        constexpr Vector(const FixedMatrix<T, N, 1>& other): FixedMatrix<T, N, 1>(other) {}
+
+        // From a dynamic N x 1 matrix.
+        // -> Exceptions::SizeMismatch()
+        template<class Alloc, Layout Order>
+        explicit Vector(const Matrix<T, Alloc, Order>& other): FixedMatrix<T, N, 1>(other) {}
+
+        // Vector along an axis.
+        static constexpr Vector unit(std::size_t axis);
+
+        // ---------------------- OPERATORS OVERLOADING -----------------------
+        // -> Element access (unchecked, see GEOMETRY_CHECKED)
+        constexpr T operator[](std::size_t i) const {
+            GEOMETRY_CHECK_INDEX(i, N);
+            return this->m_data[i];
+        }
+        constexpr T& operator[](std::size_t i) {
+            GEOMETRY_CHECK_INDEX(i, N);
+            return this->m_data[i];
+        }
+
+        // ------------------- ASK INFO MEMBERS (-> const) --------------------
+        static constexpr std::size_t size() {return N;}
+
+        constexpr T x() const {static_assert(N >= 1); return this->m_data[0];}
+        constexpr T y() const {static_assert(N >= 2); return this->m_data[1];}
+        constexpr T z() const {static_assert(N >= 3); return this->m_data[2];}
+
+        // ----------------------- DATA MODIFIER MEMBERS ----------------------
+        constexpr T& x() {static_assert(N >= 1); return this->m_data[0];}
+        constexpr T& y() {static_assert(N >= 2); return this->m_data[1];}
+        constexpr T& z() {static_assert(N >= 3); return this->m_data[2];}
+    };
+
+    template<class T> using Vector2 = Vector<T, 2>;
+    template<class T> using Vector3 = Vector<T, 3>;
+    template<class T> using Vector4 = Vector<T, 4>;
+
+    // Structure of arrays of N-vectors: coordinate e of every point is one
+    // contiguous array (see MatrixBatch).
+    template<class T, std::size_t N> using VectorBatch = MatrixBatch<T, N, 1>;
+
+    // -> Single vectors. They take any N x 1 FixedMatrix, so results of the
+    // element-wise operators go straight in: norm(a - b).
+    template<class T, std::size_t N>
+    constexpr T dot(const FixedMatrix<T, N, 1>& a, const FixedMatrix<T, N, 1>& b);
+
+    template<class T>
+    constexpr Vector<T, 3> cross(const FixedMatrix<T, 3, 1>& a, const FixedMatrix<T, 3, 1>& b);
+    // z of the 3D cross product of (a, 0) and (b, 0).
+    template<class T>
+    constexpr T cross(const FixedMatrix<T, 2, 1>& a, const FixedMatrix<T, 2, 1>& b);
+
+    template<class T, std::size_t N>
+    T norm(const FixedMatrix<T, N, 1>& v, Norm kind = Norm::L2);
+
+    // Unit vector along v (L2). A zero vector stays zero.
+    template<class T, std::size_t N>
+    Vector<T, N> normalize(const FixedMatrix<T, N, 1>& v);
+
+    template<class T, std::size_t N>
+    T distance(const FixedMatrix<T, N, 1>& a, const FixedMatrix<T, N, 1>& b, Norm kind = Norm::L2);
+
+    // -> Whole point clouds in one call, one result per point. Points are
+    // either arrays of Vector (AoS), copied tile by tile into SoA buffers on
+    // the stack, or VectorBatch (SoA) read in place. The kernels run one
+    // point per register lane and the cloud is split across threads.
+    // Outputs may be the inputs.
+    template<class T, std::size_t N>
+    void dot(const Vector<T, N>* a, const Vector<T, N>* b, std::size_t count, T* out);
+    template<class T>
+    void cross(const Vector<T, 3>* a, const Vector<T, 3>* b, std::size_t count, Vector<T, 3>* out);
+    template<class T, std::size_t N>
+    void norm(const Vector<T, N>* v, std::size_t count, T* out, Norm kind = Norm::L2);
+    template<class T, std::size_t N>
+    void normalize(const Vector<T, N>* v, std::size_t count, Vector<T, N>* out);
+    template<class T, std::size_t N>
+    void distance(const Vector<T, N>* a, const Vector<T, N>* b, std::size_t count,
+                  T* out, Norm kind = Norm::L2);
+
+    // out holds a.size() values, out batches are resized.
+    // -> Exceptions::SizeMismatch() when batch sizes differ
+    template<class T, std::size_t N>
+    void dot(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b, T* out);
+    template<class T>
+    void cross(const VectorBatch<T, 3>& a, const VectorBatch<T, 3>& b, VectorBatch<T, 3>& out);
+    template<class T, std::size_t N>
+    void norm(const VectorBatch<T, N>& v, T* out, Norm kind = Norm::L2);
+    template<class T, std::size_t N>
+    void normalize(const VectorBatch<T, N>& v, VectorBatch<T, N>& out);
+    template<class T, std::size_t N>
+    void distance(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b,
+                  T* out, Norm kind = Norm::L2);
+
+}
+#endif
@@ -0,0 +1,13 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__VECTOR__GUARD__2610
+#define GEOMETRY__VECTOR__GUARD__2610
+
+#include "vector.decl.hpp"
+#include "vector.impl.hpp"
+
+#endif
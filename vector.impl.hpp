@@ -0,0 +1,476 @@
+/*
+Geometry library file
+Date: 17/10/2026
+Author: R. Tonneau (romain.tonneau@gmail.com)
+*/
+
+#ifndef GEOMETRY__VECTOR_IMPL__GUARD__2610
+#define GEOMETRY__VECTOR_IMPL__GUARD__2610
+
+// STANDARD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+// LOCAL INCLUDES
+#include "vector.decl.hpp"
+#include "fixedMatrix.hpp"
+#include "matrixBatch.hpp"
+#include "matrixSimd.hpp"
+#include "matrixParallel.hpp"
+#include "exceptions.hpp"
+
+namespace geometry{
+
+    // ============================ PUBLIC METHODS ============================
+    template<class T, std::size_t N>
+    constexpr Vector<T, N> Vector<T, N>::unit(std::size_t axis)
+    {
+        Vector out;
+        out[axis] = static_cast<T>(1);
+        return out;
+    }
+
+    // ============================ SINGLE VECTORS ============================
+    template<class T, std::size_t N>
+    constexpr T dot(const FixedMatrix<T, N, 1>& a, const FixedMatrix<T, N, 1>& b)
+    {
+        T out = static_cast<T>(0);
+        for(std::size_t i=0; i<N; i++)
+            out += a.m_data[i]*b.m_data[i];
+        return out;
+    }
+
+    template<class T>
+    constexpr Vector<T, 3> cross(const FixedMatrix<T, 3, 1>& a, const FixedMatrix<T, 3, 1>& b)
+    {
+        return {a(1,0)*b(2,0) - a(2,0)*b(1,0),
+                a(2,0)*b(0,0) - a(0,0)*b(2,0),
+                a(0,0)*b(1,0) - a(1,0)*b(0,0)};
+    }
+
+    template<class T>
+    constexpr T cross(const FixedMatrix<T, 2, 1>& a, const FixedMatrix<T, 2, 1>& b)
+    {
+        return a(0,0)*b(1,0) - a(1,0)*b(0,0);
+    }
+
+    template<class T, std::size_t N>
+    T norm(const FixedMatrix<T, N, 1>& v, Norm kind)
+    {
+        T out = static_cast<T>(0);
+        for(const T& elt: v)
+        {
+            const T magnitude = (elt < static_cast<T>(0)) ? static_cast<T>(-elt) : elt;
+            if(kind == Norm::L1)
+                out += magnitude;
+            else if(kind == Norm::L2)
+                out += elt*elt;
+            else
+                out = std::max(out, magnitude);
+        }
+        return (kind == Norm::L2) ? static_cast<T>(std::sqrt(out)) : out;
+    }
+
+    template<class T, std::size_t N>
+    Vector<T, N> normalize(const FixedMatrix<T, N, 1>& v)
+    {
+        static_assert(std::is_floating_point_v<T>, "normalize() needs a floating point vector");
+        const T length = norm(v);
+        if(length == static_cast<T>(0))
+            return v;
+        return v/length;
+    }
+
+    template<class T, std::size_t N>
+    T distance(const FixedMatrix<T, N, 1>& a, const FixedMatrix<T, N, 1>& b, Norm kind)
+    {
+        return norm(a - b, kind);
+    }
+
+    namespace utils{
+
+        // --------------------------- POINT KERNELS --------------------------
+        // Point clouds in SoA: coordinate e of point i is at p[e*stride + i],
+        // V::width points per register, same conventions as the batch
+        // kernels (see matrixBatch). Scalar results go to out[i] for i below
+        // count only.
+#define GEOMETRY_POINT_KERNELS(NAME, ATTRIBUTE)                                                   \
+        template<class V>                                                                         \
+        ATTRIBUTE void pointStore##NAME(typename V::value_type* out, typename V::reg value,       \
+                                        std::size_t i, std::size_t count)                         \
+        {                                                                                         \
+            if(i + V::width <= count)                                                             \
+                return V::store(out + i, value);                                                  \
+            typename V::value_type values[V::width];                                              \
+            V::store(values, value);                                                              \
+            std::copy(values, values + (count - i), out + i);                                     \
+        }                                                                                         \
+                                                                                                  \
+        template<class V, std::size_t N, Norm Kind>                                               \
+        ATTRIBUTE typename V::reg pointLength##NAME(const typename V::reg* x)                     \
+        {                                                                                         \
+            typename V::reg acc;                                                                  \
+            if constexpr (Kind == Norm::L2)                                                       \
+            {                                                                                     \
+                acc = V::mul(x[0], x[0]);                                                         \
+                for(std::size_t e=1; e<N; e++)                                                    \
+                    acc = V::fmadd(x[e], x[e], acc);                                              \
+                return V::sqrt(acc);                                                              \
+            }                                                                                     \
+            acc = V::abs(x[0]);                                                                   \
+            for(std::size_t e=1; e<N; e++)                                                        \
+                if constexpr (Kind == Norm::L1) acc = V::add(acc, V::abs(x[e]));                  \
+                else                            acc = V::max(acc, V::abs(x[e]));                  \
+            return acc;                                                                           \
+        }                                                                                         \
+                                                                                                  \
+        template<class V, std::size_t N>                                                          \
+        ATTRIBUTE void pointDot##NAME(const typename V::value_type* a, std::size_t strideA,       \
+                                      const typename V::value_type* b, std::size_t strideB,       \
+                                      typename V::value_type* out,                                \
+                                      std::size_t first, std::size_t last, std::size_t count)     \
+        {                                                                                         \
+            for(std::size_t i=first; (i<last) && (i<count); i+=V::width)                          \
+            {                                                                                     \
+                typename V::reg acc = V::mul(V::load(a + i), V::load(b + i));                     \
+                for(std::size_t e=1; e<N; e++)                                                    \
+                    acc = V::fmadd(V::load(a + e*strideA + i), V::load(b + e*strideB + i), acc);  \
+                pointStore##NAME<V>(out, acc, i, count);                                          \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        /* norm(a - b), or norm(a) without Difference. */                                         \
+        template<class V, std::size_t N, Norm Kind, bool Difference>                              \
+        ATTRIBUTE void pointNorm##NAME(const typename V::value_type* a, std::size_t strideA,      \
+                                       const typename V::value_type* b, std::size_t strideB,      \
+                                       typename V::value_type* out,                               \
+                                       std::size_t first, std::size_t last, std::size_t count)    \
+        {                                                                                         \
+            for(std::size_t i=first; (i<last) && (i<count); i+=V::width)                          \
+            {                                                                                     \
+                typename V::reg x[N];                                                             \
+                for(std::size_t e=0; e<N; e++)                                                    \
+                    if constexpr (Difference)                                                     \
+                        x[e] = V::sub(V::load(a + e*strideA + i), V::load(b + e*strideB + i));    \
+                    else                                                                          \
+                        x[e] = V::load(a + e*strideA + i);                                        \
+                pointStore##NAME<V>(out, pointLength##NAME<V, N, Kind>(x), i, count);             \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        template<class V>                                                                         \
+        ATTRIBUTE void pointCross##NAME(const typename V::value_type* a, std::size_t strideA,     \
+                                        const typename V::value_type* b, std::size_t strideB,     \
+                                        typename V::value_type* out, std::size_t strideOut,       \
+                                        std::size_t first, std::size_t last)                      \
+        {                                                                                         \
+            for(std::size_t i=first; i<last; i+=V::width)                                         \
+            {                                                                                     \
+                typename V::reg x[3], y[3];                                                       \
+                for(std::size_t e=0; e<3; e++)                                                    \
+                {                                                                                 \
+                    x[e] = V::load(a + e*strideA + i);                                            \
+                    y[e] = V::load(b + e*strideB + i);                                            \
+                }                                                                                 \
+                V::store(out + i,               batchMsub##NAME<V>(x[1], y[2], x[2], y[1]));      \
+                V::store(out + strideOut + i,   batchMsub##NAME<V>(x[2], y[0], x[0], y[2]));      \
+                V::store(out + 2*strideOut + i, batchMsub##NAME<V>(x[0], y[1], x[1], y[0]));      \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        /* Zero vectors stay zero: their length is raised to the smallest normal value. */       \
+        template<class V, std::size_t N>                                                          \
+        ATTRIBUTE void pointNormalize##NAME(const typename V::value_type* a, std::size_t strideA, \
+                                            typename V::value_type* out, std::size_t strideOut,   \
+                                            std::size_t first, std::size_t last)                  \
+        {                                                                                         \
+            using value_type = typename V::value_type;                                            \
+            const typename V::reg one = V::set1(static_cast<value_type>(1));                      \
+            const typename V::reg tiny = V::set1(std::numeric_limits<value_type>::min());         \
+            for(std::size_t i=first; i<last; i+=V::width)                                         \
+            {                                                                                     \
+                typename V::reg x[N];                                                             \
+                for(std::size_t e=0; e<N; e++)                                                    \
+                    x[e] = V::load(a + e*strideA + i);                                            \
+                const typename V::reg scale =                                                     \
+                    V::div(one, V::max(pointLength##NAME<V, N, Norm::L2>(x), tiny));              \
+                for(std::size_t e=0; e<N; e++)                                                    \
+                    V::store(out + e*strideOut + i, V::mul(x[e], scale));                         \
+            }                                                                                     \
+        }
+
+        GEOMETRY_POINT_KERNELS(Scalar, )
+#ifdef GEOMETRY_X86_SIMD
+        GEOMETRY_POINT_KERNELS(Sse2, __attribute__((target("sse2"))))
+        GEOMETRY_POINT_KERNELS(Avx2, __attribute__((target("avx2,fma"))))
+        GEOMETRY_POINT_KERNELS(Avx512, __attribute__((target("avx512f"))))
+#endif
+#undef GEOMETRY_POINT_KERNELS
+
+        // ------------------------------- DISPATCH ---------------------------
+        template<typename T, std::size_t N>
+        void pointDotSerial(const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+                            T* out, std::size_t first, std::size_t last, std::size_t count)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return pointDotAvx512<SimdVector<Isa::Avx512, T>, N>(a, strideA, b, strideB, out, first, last, count);
+                    case Isa::Avx2:   return pointDotAvx2<SimdVector<Isa::Avx2, T>, N>(a, strideA, b, strideB, out, first, last, count);
+                    case Isa::Sse2:   return pointDotSse2<SimdVector<Isa::Sse2, T>, N>(a, strideA, b, strideB, out, first, last, count);
+                    default: break;
+                }
+#endif
+            pointDotScalar<ScalarVector<T>, N>(a, strideA, b, strideB, out, first, last, count);
+        }
+
+        template<typename T, std::size_t N, Norm Kind, bool Difference>
+        void pointNormSerial(const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+                             T* out, std::size_t first, std::size_t last, std::size_t count)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return pointNormAvx512<SimdVector<Isa::Avx512, T>, N, Kind, Difference>(a, strideA, b, strideB, out, first, last, count);
+                    case Isa::Avx2:   return pointNormAvx2<SimdVector<Isa::Avx2, T>, N, Kind, Difference>(a, strideA, b, strideB, out, first, last, count);
+                    case Isa::Sse2:   return pointNormSse2<SimdVector<Isa::Sse2, T>, N, Kind, Difference>(a, strideA, b, strideB, out, first, last, count);
+                    default: break;
+                }
+#endif
+            pointNormScalar<ScalarVector<T>, N, Kind, Difference>(a, strideA, b, strideB, out, first, last, count);
+        }
+
+        // The norm is a template argument of the kernels: one switch here.
+        template<typename T, std::size_t N, bool Difference>
+        void pointNormSerial(Norm kind, const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+                             T* out, std::size_t first, std::size_t last, std::size_t count)
+        {
+            switch(kind)
+            {
+                case Norm::L1: return pointNormSerial<T, N, Norm::L1, Difference>(a, strideA, b, strideB, out, first, last, count);
+                case Norm::L2: return pointNormSerial<T, N, Norm::L2, Difference>(a, strideA, b, strideB, out, first, last, count);
+                default:       return pointNormSerial<T, N, Norm::Linf, Difference>(a, strideA, b, strideB, out, first, last, count);
+            }
+        }
+
+        template<typename T>
+        void pointCrossSerial(const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+                              T* out, std::size_t strideOut, std::size_t first, std::size_t last)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return pointCrossAvx512<SimdVector<Isa::Avx512, T>>(a, strideA, b, strideB, out, strideOut, first, last);
+                    case Isa::Avx2:   return pointCrossAvx2<SimdVector<Isa::Avx2, T>>(a, strideA, b, strideB, out, strideOut, first, last);
+                    case Isa::Sse2:   return pointCrossSse2<SimdVector<Isa::Sse2, T>>(a, strideA, b, strideB, out, strideOut, first, last);
+                    default: break;
+                }
+#endif
+            pointCrossScalar<ScalarVector<T>>(a, strideA, b, strideB, out, strideOut, first, last);
+        }
+
+        template<typename T, std::size_t N>
+        void pointNormalizeSerial(const T* a, std::size_t strideA, T* out, std::size_t strideOut,
+                                  std::size_t first, std::size_t last)
+        {
+#ifdef GEOMETRY_X86_SIMD
+            if constexpr (hasSimdVector<T>)
+                switch(activeIsa())
+                {
+                    case Isa::Avx512: return pointNormalizeAvx512<SimdVector<Isa::Avx512, T>, N>(a, strideA, out, strideOut, first, last);
+                    case Isa::Avx2:   return pointNormalizeAvx2<SimdVector<Isa::Avx2, T>, N>(a, strideA, out, strideOut, first, last);
+                    case Isa::Sse2:   return pointNormalizeSse2<SimdVector<Isa::Sse2, T>, N>(a, strideA, out, strideOut, first, last);
+                    default: break;
+                }
+#endif
+            pointNormalizeScalar<ScalarVector<T>, N>(a, strideA, out, strideOut, first, last);
+        }
+
+        // ----------------------------- AOS TILES ----------------------------
+        // Points per SoA tile of the AoS entry points: a few KiB per operand,
+        // so that the tiles stay in L1 between the copies and the kernel.
+        constexpr std::size_t pointTile = 256;
+
+        // One tile after the other, one range of tiles per thread:
+        // body(first point, number of points).
+        template<class Body>
+        void tileFor(std::size_t count, std::size_t work, Body body)
+        {
+            parallelFor((count + pointTile - 1)/pointTile, work, [&](std::size_t first, std::size_t last){
+                for(std::size_t tile=first; tile<last; tile++)
+                    body(tile*pointTile, std::min(pointTile, count - tile*pointTile));
+            });
+        }
+
+        // points[0, n) into tile, stride pointTile. The lanes up to the next
+        // multiple of lanes are zeroed: the kernels read whole registers.
+        template<class T, std::size_t N>
+        void gatherTile(const Vector<T, N>* points, std::size_t n, std::size_t lanes, T* tile)
+        {
+            const std::size_t end = (n + lanes - 1)/lanes*lanes;
+            for(std::size_t i=0; i<n; i++)
+                for(std::size_t e=0; e<N; e++)
+                    tile[e*pointTile + i] = points[i].m_data[e];
+            for(std::size_t e=0; e<N; e++)
+                std::fill(tile + e*pointTile + n, tile + e*pointTile + end, static_cast<T>(0));
+        }
+
+        // Both operands in the same pass, which keeps the two input streams
+        // in flight together.
+        template<class T, std::size_t N>
+        void gatherTile(const Vector<T, N>* a, const Vector<T, N>* b, std::size_t n,
+                        std::size_t lanes, T* tileA, T* tileB)
+        {
+            const std::size_t end = (n + lanes - 1)/lanes*lanes;
+            for(std::size_t i=0; i<n; i++)
+                for(std::size_t e=0; e<N; e++)
+                {
+                    tileA[e*pointTile + i] = a[i].m_data[e];
+                    tileB[e*pointTile + i] = b[i].m_data[e];
+                }
+            for(std::size_t e=0; e<N; e++)
+            {
+                std::fill(tileA + e*pointTile + n, tileA + e*pointTile + end, static_cast<T>(0));
+                std::fill(tileB + e*pointTile + n, tileB + e*pointTile + end, static_cast<T>(0));
+            }
+        }
+
+        template<class T, std::size_t N>
+        void scatterTile(const T* tile, std::size_t n, Vector<T, N>* points)
+        {
+            for(std::size_t i=0; i<n; i++)
+                for(std::size_t e=0; e<N; e++)
+                    points[i].m_data[e] = tile[e*pointTile + i];
+        }
+
+    }
+
+    // ============================= POINT CLOUDS =============================
+    // -> Arrays of Vector
+    template<class T, std::size_t N>
+    void dot(const Vector<T, N>* a, const Vector<T, N>* b, std::size_t count, T* out)
+    {
+        constexpr std::size_t lanes = VectorBatch<T, N>::lanes;
+        utils::tileFor(count, count*N, [&](std::size_t first, std::size_t n){
+            alignas(utils::storageAlignment) T tileA[N*utils::pointTile];
+            alignas(utils::storageAlignment) T tileB[N*utils::pointTile];
+            utils::gatherTile(a + first, b + first, n, lanes, tileA, tileB);
+            utils::pointDotSerial<T, N>(tileA, utils::pointTile, tileB, utils::pointTile,
+                                        out + first, 0, n, n);
+        });
+    }
+
+    template<class T>
+    void cross(const Vector<T, 3>* a, const Vector<T, 3>* b, std::size_t count, Vector<T, 3>* out)
+    {
+        constexpr std::size_t lanes = VectorBatch<T, 3>::lanes;
+        utils::tileFor(count, count*3, [&](std::size_t first, std::size_t n){
+            alignas(utils::storageAlignment) T tileA[3*utils::pointTile];
+            alignas(utils::storageAlignment) T tileB[3*utils::pointTile];
+            utils::gatherTile(a + first, b + first, n, lanes, tileA, tileB);
+            utils::pointCrossSerial<T>(tileA, utils::pointTile, tileB, utils::pointTile,
+                                       tileA, utils::pointTile, 0, (n + lanes - 1)/lanes*lanes);
+            utils::scatterTile(tileA, n, out + first);
+        });
+    }
+
+    template<class T, std::size_t N>
+    void norm(const Vector<T, N>* v, std::size_t count, T* out, Norm kind)
+    {
+        constexpr std::size_t lanes = VectorBatch<T, N>::lanes;
+        utils::tileFor(count, count*N, [&](std::size_t first, std::size_t n){
+            alignas(utils::storageAlignment) T tile[N*utils::pointTile];
+            utils::gatherTile(v + first, n, lanes, tile);
+            utils::pointNormSerial<T, N, false>(kind, tile, utils::pointTile, tile, utils::pointTile,
+                                                out + first, 0, n, n);
+        });
+    }
+
+    template<class T, std::size_t N>
+    void normalize(const Vector<T, N>* v, std::size_t count, Vector<T, N>* out)
+    {
+        static_assert(std::is_floating_point_v<T>, "normalize() needs a floating point vector");
+        constexpr std::size_t lanes = VectorBatch<T, N>::lanes;
+        utils::tileFor(count, count*N, [&](std::size_t first, std::size_t n){
+            alignas(utils::storageAlignment) T tile[N*utils::pointTile];
+            utils::gatherTile(v + first, n, lanes, tile);
+            utils::pointNormalizeSerial<T, N>(tile, utils::pointTile, tile, utils::pointTile,
+                                              0, (n + lanes - 1)/lanes*lanes);
+            utils::scatterTile(tile, n, out + first);
+        });
+    }
+
+    template<class T, std::size_t N>
+    void distance(const Vector<T, N>* a, const Vector<T, N>* b, std::size_t count, T* out, Norm kind)
+    {
+        constexpr std::size_t lanes = VectorBatch<T, N>::lanes;
+        utils::tileFor(count, count*N, [&](std::size_t first, std::size_t n){
+            alignas(utils::storageAlignment) T tileA[N*utils::pointTile];
+            alignas(utils::storageAlignment) T tileB[N*utils::pointTile];
+            utils::gatherTile(a + first, b + first, n, lanes, tileA, tileB);
+            utils::pointNormSerial<T, N, true>(kind, tileA, utils::pointTile, tileB, utils::pointTile,
+                                               out + first, 0, n, n);
+        });
+    }
+
+    // -> Batches, read in place
+    template<class T, std::size_t N>
+    void dot(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b, T* out)
+    {
+        if(a.size() != b.size())
+            throw Exeptions::SizeMismatch(a.size(), b.size());
+        utils::batchFor<VectorBatch<T, N>::lanes>(a.size(), a.size()*N, [&](std::size_t first, std::size_t last){
+            utils::pointDotSerial<T, N>(a.data(), a.stride(), b.data(), b.stride(), out, first, last, a.size());
+        });
+    }
+
+    template<class T>
+    void cross(const VectorBatch<T, 3>& a, const VectorBatch<T, 3>& b, VectorBatch<T, 3>& out)
+    {
+        if(a.size() != b.size())
+            throw Exeptions::SizeMismatch(a.size(), b.size());
+        out.resize(a.size());
+        utils::batchFor<VectorBatch<T, 3>::lanes>(a.size(), a.size()*3, [&](std::size_t first, std::size_t last){
+            utils::pointCrossSerial<T>(a.data(), a.stride(), b.data(), b.stride(),
+                                       out.data(), out.stride(), first, last);
+        });
+    }
+
+    template<class T, std::size_t N>
+    void norm(const VectorBatch<T, N>& v, T* out, Norm kind)
+    {
+        utils::batchFor<VectorBatch<T, N>::lanes>(v.size(), v.size()*N, [&](std::size_t first, std::size_t last){
+            utils::pointNormSerial<T, N, false>(kind, v.data(), v.stride(), v.data(), v.stride(),
+                                                out, first, last, v.size());
+        });
+    }
+
+    template<class T, std::size_t N>
+    void normalize(const VectorBatch<T, N>& v, VectorBatch<T, N>& out)
+    {
+        static_assert(std::is_floating_point_v<T>, "normalize() needs a floating point vector");
+        out.resize(v.size());
+        utils::batchFor<VectorBatch<T, N>::lanes>(v.size(), v.size()*N, [&](std::size_t first, std::size_t last){
+            utils::pointNormalizeSerial<T, N>(v.data(), v.stride(), out.data(), out.stride(), first, last);
+        });
+    }
+
+    template<class T, std::size_t N>
+    void distance(const VectorBatch<T, N>& a, const VectorBatch<T, N>& b, T* out, Norm kind)
+    {
+        if(a.size() != b.size())
+            throw Exeptions::SizeMismatch(a.size(), b.size());
+        utils::batchFor<VectorBatch<T, N>::lanes>(a.size(), a.size()*N, [&](std::size_t first, std::size_t last){
+            utils::pointNormSerial<T, N, true>(kind, a.data(), a.stride(), b.data(), b.stride(),
+                                               out, first, last, a.size());
+        });
+    }
+
+}
+
+#endif